@@ -0,0 +1,984 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <set>
+#include "logger.h"
+#include "tokenize.h"
+#include "schema.h"
+#include "rediscommand.h"
+#include "redisreply.h"
+#include "buffercalculator.h"
+
+using namespace std;
+using namespace swss;
+
+#define ASIC_TABLE_NAME                     "ASIC_TABLE"
+#define CFG_LOSSLESS_TRAFFIC_PATTERN_NAME   "LOSSLESS_TRAFFIC_PATTERN"
+#define BUFFER_PROFILE_FIELD                "profile"
+#define BUFFER_PROFILE_LIST_FIELD           "profile_list"
+
+namespace {
+
+// tonumber() of lua
+bool toNumber(const string &str, double &value)
+{
+    const char *begin = str.c_str();
+    char *end = nullptr;
+
+    value = strtod(begin, &end);
+    if (end == begin)
+        return false;
+
+    while (isspace(static_cast<unsigned char>(*end)))
+        end++;
+
+    return *end == '\0';
+}
+
+// Numbers are converted to strings by lua with "%.14g"
+string toString(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.14g", value);
+    return buf;
+}
+
+bool isEqual(double a, double b)
+{
+    return !(a < b) && !(a > b);
+}
+
+// The number of lanes of a port, counted in the same way as the lua plugins do
+int getNumberOfLanes(const string &lanes)
+{
+    int number = 1;
+    for (auto c : lanes)
+    {
+        if (c == ',')
+            number++;
+    }
+    return number;
+}
+
+// string.match(key, "Ethernet%d+"), the first port name in a key
+bool matchPort(const string &key, string &port)
+{
+    size_t pos = 0;
+    while ((pos = key.find("Ethernet", pos)) != string::npos)
+    {
+        size_t end = pos + 8;
+        while (end < key.size() && isdigit(static_cast<unsigned char>(key[end])))
+            end++;
+        if (end > pos + 8)
+        {
+            port = key.substr(pos, end - pos);
+            return true;
+        }
+        pos = end;
+    }
+    return false;
+}
+
+// string.match(key, "Ethernet%d+:([^%s]+)$"), the IDs following the port name in a key
+bool matchIds(const string &key, string &ids)
+{
+    size_t pos = 0;
+    while ((pos = key.find("Ethernet", pos)) != string::npos)
+    {
+        size_t start = pos + 8;
+        size_t end = start;
+        while (end < key.size() && isdigit(static_cast<unsigned char>(key[end])))
+            end++;
+        pos = start;
+        if (end == start || end >= key.size() || key[end] != ':' || end + 1 == key.size())
+            continue;
+
+        bool hasSpace = false;
+        for (size_t i = end + 1; i < key.size(); i++)
+        {
+            if (isspace(static_cast<unsigned char>(key[i])))
+            {
+                hasSpace = true;
+                break;
+            }
+        }
+        if (!hasSpace)
+        {
+            ids = key.substr(end + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+BufferCalculator::BufferCalculator(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb) :
+    m_applDb(applDb),
+    m_cfgLosslessTrafficPatternTable(cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_NAME),
+    m_stateAsicTable(stateDb, ASIC_TABLE_NAME)
+{
+    loadTable(m_cfgLosslessTrafficPatternTable);
+    loadTable(m_stateAsicTable);
+
+    // The buffer tables are in APPL_DB already on warm restart
+    for (auto table : {APP_BUFFER_POOL_TABLE_NAME, APP_BUFFER_PROFILE_TABLE_NAME,
+                        APP_BUFFER_PG_TABLE_NAME, APP_BUFFER_QUEUE_TABLE_NAME,
+                        APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME, APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME})
+    {
+        loadApplTable(table);
+    }
+}
+
+unique_ptr<BufferCalculator> BufferCalculator::create(const string &platform, DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb)
+{
+    if (platform == "mellanox" || platform == "vs")
+    {
+        return unique_ptr<BufferCalculator>(new MellanoxBufferCalculator(cfgDb, stateDb, applDb));
+    }
+
+    return nullptr;
+}
+
+bool BufferCalculator::isInputTable(const string &table)
+{
+    static const set<string> inputTables = {
+        CFG_PORT_TABLE_NAME,
+        CFG_BUFFER_POOL_TABLE_NAME,
+        CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER,
+        STATE_BUFFER_MAXIMUM_VALUE_TABLE
+    };
+
+    return inputTables.find(table) != inputTables.end();
+}
+
+void BufferCalculator::setEntry(const string &table, const string &key, const vector<FieldValueTuple> &fvs, bool merge)
+{
+    auto &entry = m_tables[table][key];
+
+    if (!merge)
+        entry.clear();
+
+    for (auto &fv : fvs)
+    {
+        entry[fvField(fv)] = fvValue(fv);
+    }
+}
+
+void BufferCalculator::delEntry(const string &table, const string &key)
+{
+    auto tableRef = m_tables.find(table);
+    if (tableRef != m_tables.end())
+    {
+        tableRef->second.erase(key);
+    }
+}
+
+void BufferCalculator::loadTable(Table &table)
+{
+    vector<string> keys;
+
+    table.getKeys(keys);
+    for (auto &key : keys)
+    {
+        vector<FieldValueTuple> fvs;
+        if (table.get(key, fvs))
+        {
+            setEntry(table.getTableName(), key, fvs);
+        }
+    }
+}
+
+// Loads an APPL_DB table as orchagent will have it once the updates pending in the ProducerStateTable are handled
+void BufferCalculator::loadApplTable(const string &table)
+{
+    Table applTable(m_applDb, table);
+    loadTable(applTable);
+
+    // The entries removed by the previous run but not yet handled by orchagent
+    RedisCommand smembers;
+    smembers.format("SMEMBERS %s_DEL_SET", table.c_str());
+    RedisReply r(m_applDb, smembers, REDIS_REPLY_ARRAY);
+    auto reply = r.getContext();
+    for (size_t i = 0; i < reply->elements; i++)
+    {
+        delEntry(table, string(reply->element[i]->str, reply->element[i]->len));
+    }
+
+    // The entries set by the previous run but not yet handled by orchagent, which are merged like HSET
+    Table pendingTable(m_applDb, "_" + table);
+    vector<string> keys;
+    pendingTable.getKeys(keys);
+    for (auto &key : keys)
+    {
+        vector<FieldValueTuple> fvs;
+        if (pendingTable.get(key, fvs))
+        {
+            setEntry(table, key, fvs, true);
+        }
+    }
+}
+
+const buffer_calc_table_t &BufferCalculator::getTable(const string &table)
+{
+    return m_tables[table];
+}
+
+const buffer_calc_entry_t *BufferCalculator::getEntry(const string &table, const string &key)
+{
+    auto &entries = m_tables[table];
+    auto entryRef = entries.find(key);
+
+    if (entryRef == entries.end())
+        return nullptr;
+
+    return &entryRef->second;
+}
+
+const buffer_calc_entry_t *BufferCalculator::getFirstEntry(const string &table, string *key)
+{
+    auto &entries = m_tables[table];
+
+    // ASIC_TABLE and LOSSLESS_TRAFFIC_PATTERN can be populated after buffermgrd starts
+    if (entries.empty() && table == ASIC_TABLE_NAME)
+        loadTable(m_stateAsicTable);
+    else if (entries.empty() && table == CFG_LOSSLESS_TRAFFIC_PATTERN_NAME)
+        loadTable(m_cfgLosslessTrafficPatternTable);
+
+    if (entries.empty())
+        return nullptr;
+
+    if (key)
+        *key = entries.begin()->first;
+
+    return &entries.begin()->second;
+}
+
+bool BufferCalculator::getField(const string &table, const string &key, const string &field, string &value)
+{
+    auto entry = getEntry(table, key);
+    if (!entry)
+        return false;
+
+    auto fieldRef = entry->find(field);
+    if (fieldRef == entry->end())
+        return false;
+
+    value = fieldRef->second;
+    return true;
+}
+
+bool BufferCalculator::getNumber(const string &table, const string &key, const string &field, double &value)
+{
+    string str;
+
+    return getField(table, key, field, str) && toNumber(str, value);
+}
+
+bool BufferCalculator::hasPendingEntries(const string &table)
+{
+    return m_applDb->exists(table + "_KEY_SET") || m_applDb->exists(table + "_DEL_SET");
+}
+
+void BufferApplTable::set(const string &key, const vector<FieldValueTuple> &values, const string &op, const string &prefix)
+{
+    ProducerStateTable::set(key, values, op, prefix);
+
+    // Fields are merged into the existing entry, like the HSET issued by the ProducerStateTable
+    if (m_calculator)
+        m_calculator->setEntry(getTableName(), key, values, true);
+}
+
+void BufferApplTable::del(const string &key, const string &op, const string &prefix)
+{
+    ProducerStateTable::del(key, op, prefix);
+
+    if (m_calculator)
+        m_calculator->delEntry(getTableName(), key);
+}
+
+// Models buffer_headroom_mellanox.lua
+vector<string> MellanoxBufferCalculator::calculateHeadroom(const string &speed, const string &cable_length, const string &mtu,
+                                                           const string &gearbox_delay, const string &lane_count)
+{
+    // pause quanta should be taken for each operating speed is defined in IEEE 802.3 31B.3.7
+    static const map<long, double> pause_quanta_per_speed = {
+        {800000, 905},
+        {400000, 905},
+        {200000, 453},
+        {100000, 394},
+        {50000, 147},
+        {40000, 118},
+        {25000, 80},
+        {10000, 67},
+        {1000, 2},
+        {100, 1}
+    };
+
+    double port_speed, cable, port_mtu, gearbox = 0;
+    if (!toNumber(speed, port_speed) || cable_length.empty() ||
+        !toNumber(cable_length.substr(0, cable_length.size() - 1), cable) ||
+        !toNumber(mtu, port_mtu))
+    {
+        SWSS_LOG_WARN("Invalid speed %s, cable length %s or mtu %s for headroom calculation", speed.c_str(), cable_length.c_str(), mtu.c_str());
+        return {};
+    }
+    toNumber(gearbox_delay, gearbox);
+    bool is_8lane = (lane_count == "8");
+
+    bool has_pause_quanta = false;
+    double pause_quanta = 0;
+    auto quantaRef = pause_quanta_per_speed.find(lround(port_speed));
+    if (quantaRef != pause_quanta_per_speed.end() && isEqual(port_speed, static_cast<double>(quantaRef->first)))
+    {
+        has_pause_quanta = true;
+        pause_quanta = quantaRef->second;
+    }
+
+    // Fetch ASIC info from ASIC table in STATE_DB
+    string asic_key;
+    auto asic = getFirstEntry(ASIC_TABLE_NAME, &asic_key);
+    double cell_size, pipeline_latency, mac_phy_delay, peer_response_time = 0;
+    if (!asic ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "cell_size", cell_size) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "pipeline_latency", pipeline_latency) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "mac_phy_delay", mac_phy_delay) ||
+        (!has_pause_quanta && !getNumber(ASIC_TABLE_NAME, asic_key, "peer_response_time", peer_response_time)))
+    {
+        SWSS_LOG_WARN("Unable to calculate headroom: ASIC_TABLE is not ready");
+        return {};
+    }
+    pipeline_latency *= 1024;
+    mac_phy_delay *= 1024;
+    peer_response_time *= 1024;
+
+    double kb_on_tile = 0;
+    if (asic_key.back() == '4' || asic_key.back() == '5')
+    {
+        // Calculate kB on tile for Spectrum-4 and Spectrum-5
+        // The last digit of ASIC table key (with the name convention of "MELLANOX-SPECTRUM-N") represents the generation of the ASIC.
+        kb_on_tile = port_speed / 1000 * 120 / 8;
+    }
+
+    // Fetch lossless traffic info from CONFIG_DB
+    string pattern_key;
+    double lossless_mtu, small_packet_percentage;
+    if (!getFirstEntry(CFG_LOSSLESS_TRAFFIC_PATTERN_NAME, &pattern_key) ||
+        !getNumber(CFG_LOSSLESS_TRAFFIC_PATTERN_NAME, pattern_key, "mtu", lossless_mtu) ||
+        !getNumber(CFG_LOSSLESS_TRAFFIC_PATTERN_NAME, pattern_key, "small_packet_percentage", small_packet_percentage))
+    {
+        SWSS_LOG_WARN("Unable to calculate headroom: LOSSLESS_TRAFFIC_PATTERN is not configured");
+        return {};
+    }
+
+    // Fetch over subscribe ratio
+    string param_key;
+    double over_subscribe_ratio, shp_size;
+    if (!getFirstEntry(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, &param_key))
+    {
+        SWSS_LOG_WARN("Unable to calculate headroom: DEFAULT_LOSSLESS_BUFFER_PARAMETER is not configured");
+        return {};
+    }
+    bool has_ratio = getNumber(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, param_key, "over_subscribe_ratio", over_subscribe_ratio);
+
+    // Fetch the shared headroom pool size
+    bool has_shp = getNumber(CFG_BUFFER_POOL_TABLE_NAME, "ingress_lossless_pool", "xoff", shp_size);
+
+    bool shp_enabled = (has_shp && !isEqual(shp_size, 0)) || (has_ratio && !isEqual(over_subscribe_ratio, 0));
+
+    // Calculate the headroom information
+    const double speed_of_light = 198000000;
+    const double minimal_packet_size = 64;
+    double speed_overhead = 0;
+
+    // Adjustment for 8-lane port
+    if (is_8lane)
+    {
+        pipeline_latency = pipeline_latency * 2;
+        speed_overhead = port_mtu;
+    }
+
+    double worst_case_factor;
+    if (cell_size > 2 * minimal_packet_size)
+        worst_case_factor = cell_size / minimal_packet_size;
+    else
+        worst_case_factor = (2 * cell_size) / (1 + cell_size);
+    worst_case_factor = ceil(worst_case_factor);
+
+    double small_packet_percentage_by_byte = 100 * minimal_packet_size / ((small_packet_percentage * minimal_packet_size + (100 - small_packet_percentage) * lossless_mtu) / 100);
+    double cell_occupancy = (100 - small_packet_percentage_by_byte + small_packet_percentage_by_byte * worst_case_factor) / 100;
+
+    double bytes_on_gearbox = 0;
+    if (!isEqual(gearbox, 0))
+        bytes_on_gearbox = port_speed * gearbox / (8 * 1024);
+
+    // If successfully get pause_quanta from the table, then calculate peer_response_time from it
+    if (has_pause_quanta)
+        peer_response_time = pause_quanta * 512 / 8;
+
+    double bytes_on_cable = 2 * cable * port_speed * 1000000000 / speed_of_light / (8 * 1000);
+    double propagation_delay = port_mtu + bytes_on_cable + 2 * bytes_on_gearbox + mac_phy_delay + peer_response_time + kb_on_tile;
+
+    // Calculate the xoff and xon and then round up at 1024 bytes
+    double xoff_value = lossless_mtu + propagation_delay * cell_occupancy;
+    xoff_value = ceil(xoff_value / 1024) * 1024;
+    double xon_value = ceil(pipeline_latency / 1024) * 1024;
+
+    double headroom_size;
+    if (shp_enabled)
+        headroom_size = xon_value;
+    else
+        headroom_size = xoff_value + xon_value + speed_overhead;
+    headroom_size = ceil(headroom_size / 1024) * 1024;
+
+    return {
+        "xon:" + toString(ceil(xon_value)),
+        "xoff:" + toString(ceil(xoff_value)),
+        "size:" + toString(ceil(headroom_size))
+    };
+}
+
+// Models buffer_check_headroom_mellanox.lua
+vector<string> MellanoxBufferCalculator::checkHeadroom(const string &port, const string &profile_name, const string &size,
+                                                       const string &xon, const string &xoff, const string &new_pg)
+{
+    // The number of PGs in a key, like get_number_of_pgs in the lua plugin
+    auto getNumberOfPgs = [](const string &key) -> double {
+        string range;
+        if (!matchIds(key, range))
+            return 0;
+        if (range.size() == 1)
+            return 1;
+        return 1 + (range.back() - '0') - (range.front() - '0');
+    };
+
+    // Initialize the accumulative size with 4096
+    // This is to absorb the possible deviation
+    double accumulative_size = 4096;
+    // Egress mirror size: 2 * maximum MTU (10k)
+    double egress_mirror_size = 20 * 1024;
+
+    // Fetch the threshold from STATE_DB
+    double max_headroom_size;
+    if (!getNumber(STATE_BUFFER_MAXIMUM_VALUE_TABLE, port, "max_headroom_size", max_headroom_size))
+        return {"result:true"};
+
+    string asic_key, lanes;
+    double pipeline_latency, cell_size, port_reserved_shp = 0, port_max_shp = 0;
+    if (!getFirstEntry(ASIC_TABLE_NAME, &asic_key) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "pipeline_latency", pipeline_latency) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "cell_size", cell_size))
+    {
+        SWSS_LOG_WARN("Unable to check headroom: ASIC_TABLE is not ready");
+        return {};
+    }
+    bool has_port_shp = getNumber(ASIC_TABLE_NAME, asic_key, "port_reserved_shp", port_reserved_shp) &&
+                        getNumber(ASIC_TABLE_NAME, asic_key, "port_max_shp", port_max_shp);
+
+    // We need to know whether it's a 8-lane port because it has extra pipeline latency
+    if (getField(CFG_PORT_TABLE_NAME, port, "lanes", lanes) && getNumberOfLanes(lanes) == 8)
+    {
+        // The pipeline latency should be adjusted accordingly for ports with 2 buffer units
+        pipeline_latency = pipeline_latency * 2 - 1;
+        egress_mirror_size = egress_mirror_size * 2;
+        port_reserved_shp = port_reserved_shp * 2;
+    }
+
+    double lossy_pg_size = pipeline_latency * 1024;
+    accumulative_size = accumulative_size + lossy_pg_size + egress_mirror_size;
+
+    double shp_size;
+    bool is_shp_enabled = getNumber(APP_BUFFER_POOL_TABLE_NAME, "ingress_lossless_pool", "xoff", shp_size) && !isEqual(shp_size, 0);
+    double accumulative_shared_headroom = 0;
+
+    // The PGs in APPL_DB, in which the ones pending removal have been skipped and the pending ones have been merged,
+    // like BUFFER_PG_TABLE_DEL_SET and _BUFFER_PG_TABLE are handled in the lua plugin
+    map<string, string> all_pgs;
+    auto &pgs = getTable(APP_BUFFER_PG_TABLE_NAME);
+    for (auto pgRef = pgs.lower_bound(port + ":"); pgRef != pgs.end() && pgRef->first.compare(0, port.size() + 1, port + ":") == 0; ++pgRef)
+    {
+        auto profileRef = pgRef->second.find(BUFFER_PROFILE_FIELD);
+        if (profileRef != pgRef->second.end())
+            all_pgs[pgRef->first] = profileRef->second;
+    }
+
+    if (!new_pg.empty() && getNumberOfPgs(new_pg) > 0)
+        all_pgs[new_pg] = profile_name;
+
+    vector<string> debuginfo;
+    debuginfo.push_back("debug:other overhead:" + toString(accumulative_size));
+
+    // Handle all the PGs, accumulate the sizes
+    // Assume there is only one lossless profile configured among all PGs on each port
+    for (auto &pg : all_pgs)
+    {
+        double current_profile_size = 0, current_profile_xon = 0, current_profile_xoff = 0;
+        bool has_xon, has_xoff;
+
+        if (pg.second != profile_name)
+        {
+            if (!getNumber(APP_BUFFER_PROFILE_TABLE_NAME, pg.second, "size", current_profile_size))
+            {
+                SWSS_LOG_WARN("Unable to check headroom: profile %s referenced by %s is not found", pg.second.c_str(), pg.first.c_str());
+                return {};
+            }
+            has_xon = getNumber(APP_BUFFER_PROFILE_TABLE_NAME, pg.second, "xon", current_profile_xon);
+            has_xoff = getNumber(APP_BUFFER_PROFILE_TABLE_NAME, pg.second, "xoff", current_profile_xoff);
+        }
+        else
+        {
+            if (!toNumber(size, current_profile_size))
+            {
+                SWSS_LOG_WARN("Unable to check headroom: invalid size %s of profile %s", size.c_str(), profile_name.c_str());
+                return {};
+            }
+            has_xon = toNumber(xon, current_profile_xon);
+            has_xoff = toNumber(xoff, current_profile_xoff);
+        }
+
+        if (isEqual(current_profile_size, 0))
+            current_profile_size = lossy_pg_size;
+        accumulative_size = accumulative_size + current_profile_size * getNumberOfPgs(pg.first);
+
+        if (is_shp_enabled && has_xon && has_xoff)
+        {
+            if (current_profile_size < current_profile_xon + current_profile_xoff)
+            {
+                accumulative_shared_headroom = accumulative_shared_headroom + (current_profile_xon + current_profile_xoff - current_profile_size) * getNumberOfPgs(pg.first);
+            }
+        }
+        debuginfo.push_back("debug:" APP_BUFFER_PG_TABLE_NAME ":" + pg.first + ":" + pg.second + ":" + toString(current_profile_size) + ":" +
+                            toString(getNumberOfPgs(pg.first)) + ":accu:" + toString(accumulative_size) + ":accu_shp:" + toString(accumulative_shared_headroom));
+    }
+
+    vector<string> ret;
+    if (max_headroom_size > accumulative_size)
+    {
+        if (is_shp_enabled)
+        {
+            if (!has_port_shp)
+            {
+                SWSS_LOG_WARN("Unable to check headroom: shared headroom pool parameters are missing in ASIC_TABLE");
+                return {};
+            }
+            double max_shp = (port_max_shp + port_reserved_shp) * cell_size;
+            ret.push_back(accumulative_shared_headroom > max_shp ? "result:false" : "result:true");
+            ret.push_back("debug:Accumulative headroom on port " + toString(accumulative_size) + ", the maximum available headroom " + toString(max_headroom_size) +
+                          ", the port SHP " + toString(accumulative_shared_headroom) + ", max SHP " + toString(max_shp));
+        }
+        else
+        {
+            ret.push_back("result:true");
+            ret.push_back("debug:Accumulative headroom on port " + toString(accumulative_size) + ", the maximum available headroom " + toString(max_headroom_size));
+        }
+    }
+    else
+    {
+        ret.push_back("result:false");
+        ret.push_back("debug:Accumulative headroom on port " + toString(accumulative_size) + " exceeds the maximum available headroom which is " + toString(max_headroom_size));
+    }
+
+    ret.insert(ret.end(), debuginfo.begin(), debuginfo.end());
+
+    return ret;
+}
+
+// Iterates all items in BUFFER_PG_TABLE or BUFFER_QUEUE_TABLE, like iterate_all_items in the lua plugin
+// Returns false in case a profile referenced by an item is not found
+bool MellanoxBufferCalculator::countBufferObjects(const string &table, bool check_lossless)
+{
+    set<string> lossless_ports;
+
+    for (auto &item : getTable(table))
+    {
+        // Count the number of priorities or queues in each BUFFER_PG or BUFFER_QUEUE item
+        // For example, there are:
+        //     3 queues in 'BUFFER_QUEUE_TABLE:Ethernet0:0-2'
+        //     2 priorities in 'BUFFER_PG_TABLE:Ethernet0:3-4'
+        string port, range;
+        if (!matchPort(item.first, port))
+            continue;
+
+        auto profileRef = item.second.find(BUFFER_PROFILE_FIELD);
+        if (profileRef == item.second.end())
+            return false;
+
+        auto &profile_name = profileRef->second;
+        auto refCountRef = m_profileRefCount.find(profile_name);
+        if (refCountRef == m_profileRefCount.end() || !matchIds(item.first, range))
+        {
+            // Indicate an error in case the referenced profile hasn't been inserted or has been removed
+            return false;
+        }
+
+        double size = 1;
+        if (range.size() > 1)
+        {
+            auto ids = tokenize(range, '-');
+            double start, end;
+            if (ids.size() < 2 || !toNumber(ids[0], start) || !toNumber(ids[1], end))
+                return false;
+            size = end - start + 1;
+        }
+        refCountRef->second += size;
+
+        auto losslessRef = m_ingressProfileIsLossless.find(profile_name);
+        if (m_portIs8Lanes[port] && losslessRef != m_ingressProfileIsLossless.end() && !losslessRef->second)
+        {
+            // Handle additional buffer reserved for lossy PG on 8-lane ports
+            m_lossyPg8Lanes += size;
+        }
+        if (check_lossless && losslessRef != m_ingressProfileIsLossless.end() && losslessRef->second)
+        {
+            if (lossless_ports.insert(port).second)
+                m_losslessPortCount++;
+        }
+    }
+
+    return true;
+}
+
+// Iterates all items in BUFFER_PORT_INGRESS/EGRESS_PROFILE_LIST, like iterate_profile_list in the lua plugin
+bool MellanoxBufferCalculator::countProfileLists(const string &table)
+{
+    for (auto &item : getTable(table))
+    {
+        auto listRef = item.second.find(BUFFER_PROFILE_LIST_FIELD);
+        if (listRef == item.second.end())
+            return true;
+
+        for (auto &profile : tokenize(listRef->second, ','))
+        {
+            // The ingress_lossy_profile is shared by both BUFFER_PG|<port>|0 and BUFFER_PORT_INGRESS_PROFILE_LIST
+            // It occupies buffers in BUFFER_PG but not in BUFFER_PORT_INGRESS_PROFILE_LIST
+            // The profile list references are counted against "<profile>_list" whose size is zero.
+            string profile_name = profile;
+            auto losslessRef = m_ingressProfileIsLossless.find(profile_name);
+            if (losslessRef != m_ingressProfileIsLossless.end() && !losslessRef->second)
+            {
+                profile_name += "_list";
+                m_profileRefCount.emplace(profile_name, 0);
+            }
+
+            auto refCountRef = m_profileRefCount.find(profile_name);
+            if (refCountRef == m_profileRefCount.end())
+                return false;
+            refCountRef->second++;
+        }
+    }
+
+    return true;
+}
+
+// The current sizes in APPL_DB of the pools whose size isn't configured, like fetch_buffer_pool_size_from_appldb in the lua plugin
+vector<string> MellanoxBufferCalculator::fetchBufferPoolSizeFromAppl(bool shp_enabled)
+{
+    vector<string> result;
+
+    for (auto &pool : getTable(CFG_BUFFER_POOL_TABLE_NAME))
+    {
+        if (pool.second.find("size") != pool.second.end())
+            continue;
+
+        auto &pool_name = pool.first;
+        string size, xoff;
+        if (!getField(APP_BUFFER_POOL_TABLE_NAME, pool_name, "size", size))
+            size = "0";
+
+        if (getField(APP_BUFFER_POOL_TABLE_NAME, pool_name, "xoff", xoff))
+        {
+            result.push_back(pool_name + ":" + size + ":" + xoff);
+        }
+        else if (shp_enabled && size == "0" && pool_name == "ingress_lossless_pool")
+        {
+            // Indicate the shared headroom pool is enabled by setting a very small buffer pool and shared headroom pool sizes
+            // See fetch_buffer_pool_size_from_appldb in the lua plugin
+            result.push_back(pool_name + ":2048:1024");
+        }
+        else
+        {
+            result.push_back(pool_name + ":" + size);
+        }
+    }
+
+    return result;
+}
+
+// Models buffer_pool_mellanox.lua
+vector<string> MellanoxBufferCalculator::calculateBufferPool()
+{
+    // Private headrom
+    const double private_headroom = 10 * 1024;
+    const double mgmt_pool_size = 256 * 1024;
+    const double egress_mirror_headroom = 10 * 1024;
+
+    m_profileRefCount.clear();
+    m_ingressProfileIsLossless.clear();
+    m_portIs8Lanes.clear();
+    m_lossyPg8Lanes = 0;
+    m_losslessPortCount = 0;
+
+    // Parse all the pools and seperate them according to the direction
+    vector<string> ipools, epools;
+    for (auto &pool : getTable(CFG_BUFFER_POOL_TABLE_NAME))
+    {
+        auto typeRef = pool.second.find("type");
+        if (typeRef == pool.second.end())
+            continue;
+        if (typeRef->second == "ingress")
+            ipools.push_back(pool.first);
+        else if (typeRef->second == "egress")
+            epools.push_back(pool.first);
+    }
+
+    auto &ports = getTable(CFG_PORT_TABLE_NAME);
+    double total_port = static_cast<double>(ports.size());
+    double port_count_8lanes = 0, admin_up_port = 0, admin_up_8lanes_port = 0;
+    for (auto &port : ports)
+    {
+        int number_of_lanes = 0;
+        auto lanesRef = port.second.find("lanes");
+        if (lanesRef != port.second.end())
+        {
+            number_of_lanes = getNumberOfLanes(lanesRef->second);
+            m_portIs8Lanes[port.first] = (number_of_lanes == 8);
+            if (number_of_lanes == 8)
+                port_count_8lanes++;
+        }
+
+        auto adminRef = port.second.find("admin_status");
+        if (adminRef != port.second.end() && adminRef->second == "up")
+        {
+            admin_up_port++;
+            if (number_of_lanes == 8)
+                admin_up_8lanes_port++;
+        }
+    }
+
+    // Whether shared headroom pool is enabled?
+    string param_key;
+    double over_subscribe_ratio = 0;
+    bool has_ratio = true;
+    if (getFirstEntry(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, &param_key))
+        has_ratio = getNumber(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, param_key, "over_subscribe_ratio", over_subscribe_ratio);
+
+    // Fetch the shared headroom pool size
+    double shp_size;
+    bool shp_enabled = has_ratio && !isEqual(over_subscribe_ratio, 0);
+    if (getNumber(CFG_BUFFER_POOL_TABLE_NAME, "ingress_lossless_pool", "xoff", shp_size) && !isEqual(shp_size, 0))
+        shp_enabled = true;
+    else
+        shp_size = 0;
+
+    // Fetch mmu_size
+    string asic_key;
+    double mmu_size, cell_size, pipeline_latency;
+    if (!getNumber(STATE_BUFFER_MAXIMUM_VALUE_TABLE, "global", "mmu_size", mmu_size) &&
+        !getNumber(CFG_BUFFER_POOL_TABLE_NAME, "egress_lossless_pool", "size", mmu_size))
+    {
+        SWSS_LOG_INFO("Unable to calculate buffer pool: mmu_size is not available");
+        return {};
+    }
+    if (!getFirstEntry(ASIC_TABLE_NAME, &asic_key) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "cell_size", cell_size) ||
+        !getNumber(ASIC_TABLE_NAME, asic_key, "pipeline_latency", pipeline_latency))
+    {
+        SWSS_LOG_WARN("Unable to calculate buffer pool: ASIC_TABLE is not ready");
+        return {};
+    }
+
+    double lossypg_reserved = pipeline_latency * 1024;
+    double lossypg_reserved_8lanes = (2 * pipeline_latency - 1) * 1024;
+
+    // Align mmu_size at cell size boundary, otherwise the sdk will complain and the syncd will fail
+    double number_of_cells = floor(mmu_size / cell_size);
+    double ceiling_mmu_size = number_of_cells * cell_size;
+
+    // Fetch names of all profiles and insert them into the look up table
+    for (auto &profile : getTable(APP_BUFFER_PROFILE_TABLE_NAME))
+    {
+        auto poolRef = profile.second.find("pool");
+        if (poolRef != profile.second.end() && find(ipools.begin(), ipools.end(), poolRef->second) != ipools.end())
+        {
+            // For ingress profiles, check whether it is lossless or lossy
+            // For lossy profiles, there is buffer implicitly reserved when they are applied on PGs
+            m_ingressProfileIsLossless[profile.first] = (profile.second.find("xoff") != profile.second.end());
+        }
+        m_profileRefCount[profile.first] = 0;
+    }
+
+    // Pool sizes are kept as they are and will be calculated later if orchagent hasn't handled all the updates,
+    // or any of the items references a profile not in APPL_DB
+    if (hasPendingEntries(APP_BUFFER_PROFILE_TABLE_NAME) ||
+        hasPendingEntries(APP_BUFFER_PG_TABLE_NAME) ||
+        hasPendingEntries(APP_BUFFER_QUEUE_TABLE_NAME) ||
+        hasPendingEntries(APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME) ||
+        hasPendingEntries(APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME) ||
+        !countBufferObjects(APP_BUFFER_PG_TABLE_NAME, true) ||
+        !countBufferObjects(APP_BUFFER_QUEUE_TABLE_NAME, false) ||
+        !countProfileLists(APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME) ||
+        !countProfileLists(APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME))
+    {
+        return fetchBufferPoolSizeFromAppl(shp_enabled);
+    }
+
+    vector<string> statistics;
+
+    // Fetch sizes of all of the profiles, accumulate them
+    double accumulative_occupied_buffer = 0;
+    double accumulative_xoff = 0;
+
+    for (auto &refCount : m_profileRefCount)
+    {
+        auto &name = refCount.first;
+        double size;
+        if (getNumber(APP_BUFFER_PROFILE_TABLE_NAME, name, "size", size))
+        {
+            // Handle the implicitly reserved buffer for lossy profile applied on PG
+            auto losslessRef = m_ingressProfileIsLossless.find(name);
+            if (losslessRef != m_ingressProfileIsLossless.end() && !losslessRef->second)
+                size = size + lossypg_reserved;
+            if (!isEqual(size, 0))
+            {
+                double xon, xoff;
+                if (isEqual(shp_size, 0) &&
+                    getNumber(APP_BUFFER_PROFILE_TABLE_NAME, name, "xon", xon) &&
+                    getNumber(APP_BUFFER_PROFILE_TABLE_NAME, name, "xoff", xoff) &&
+                    xon + xoff > size)
+                {
+                    accumulative_xoff = accumulative_xoff + (xon + xoff - size) * refCount.second;
+                }
+                accumulative_occupied_buffer = accumulative_occupied_buffer + size * refCount.second;
+            }
+            statistics.push_back("debug:" APP_BUFFER_PROFILE_TABLE_NAME ":" + name + ":" + toString(size) + ":" + toString(refCount.second));
+        }
+        else
+        {
+            statistics.push_back("debug:" APP_BUFFER_PROFILE_TABLE_NAME ":" + name + ":-:" + toString(refCount.second));
+        }
+    }
+
+    // Extra lossy xon buffer for ports with 8 lanes
+    double lossypg_extra_for_8lanes = (lossypg_reserved_8lanes - lossypg_reserved) * m_lossyPg8Lanes;
+    accumulative_occupied_buffer = accumulative_occupied_buffer + lossypg_extra_for_8lanes;
+
+    // Accumulate sizes for private headrooms
+    double accumulative_private_headroom = 0;
+    bool force_enable_shp = false;
+    if (accumulative_xoff > 0 && !shp_enabled)
+    {
+        force_enable_shp = true;
+        shp_size = 655360;
+        shp_enabled = true;
+    }
+    if (shp_enabled)
+    {
+        accumulative_private_headroom = m_losslessPortCount * private_headroom;
+        accumulative_occupied_buffer = accumulative_occupied_buffer + accumulative_private_headroom;
+        accumulative_xoff = accumulative_xoff - accumulative_private_headroom;
+        if (accumulative_xoff < 0)
+            accumulative_xoff = 0;
+    }
+
+    // Accumulate sizes for management PGs
+    double accumulative_management_pg = (admin_up_port - admin_up_8lanes_port) * lossypg_reserved + admin_up_8lanes_port * lossypg_reserved_8lanes;
+    accumulative_occupied_buffer = accumulative_occupied_buffer + accumulative_management_pg;
+
+    // Accumulate sizes for egress mirror and management pool
+    double accumulative_egress_mirror_overhead = admin_up_port * egress_mirror_headroom;
+    accumulative_occupied_buffer = accumulative_occupied_buffer + accumulative_egress_mirror_overhead + mgmt_pool_size;
+
+    // Fetch all the pools that need update
+    vector<string> pools_need_update;
+    int ingress_pool_count = 0;
+    bool has_ingress_lossless_pool_size = false;
+    double ingress_lossless_pool_size = 0;
+    for (auto &pool : ipools)
+    {
+        double size;
+        if (!getNumber(CFG_BUFFER_POOL_TABLE_NAME, pool, "size", size))
+        {
+            pools_need_update.push_back(pool);
+            ingress_pool_count++;
+        }
+        else if (pool == "ingress_lossless_pool" && shp_enabled && isEqual(shp_size, 0))
+        {
+            has_ingress_lossless_pool_size = true;
+            ingress_lossless_pool_size = size;
+        }
+    }
+
+    for (auto &pool : epools)
+    {
+        string size;
+        if (!getField(CFG_BUFFER_POOL_TABLE_NAME, pool, "size", size))
+            pools_need_update.push_back(pool);
+    }
+
+    if (shp_enabled && isEqual(shp_size, 0))
+    {
+        shp_size = ceil(accumulative_xoff / over_subscribe_ratio);
+        if (isEqual(shp_size, 0))
+            shp_size = 655360;
+    }
+
+    accumulative_occupied_buffer = accumulative_occupied_buffer + shp_size;
+
+    double available_buffer = mmu_size - accumulative_occupied_buffer;
+    double pool_size;
+    if (ingress_pool_count == 1)
+        pool_size = available_buffer;
+    else
+        pool_size = available_buffer / 2;
+
+    if (pool_size > ceiling_mmu_size)
+        pool_size = ceiling_mmu_size;
+
+    vector<string> result;
+    bool shp_deployed = false;
+    for (auto &pool_name : pools_need_update)
+    {
+        double percentage, effective_pool_size;
+        if (getNumber(CFG_BUFFER_POOL_TABLE_NAME, pool_name, "percentage", percentage) && percentage >= 0)
+            effective_pool_size = available_buffer * percentage / 100;
+        else
+            effective_pool_size = pool_size;
+
+        if (!isEqual(shp_size, 0) && pool_name == "ingress_lossless_pool")
+        {
+            result.push_back(pool_name + ":" + toString(ceil(effective_pool_size)) + ":" + toString(ceil(shp_size)));
+            shp_deployed = true;
+        }
+        else
+        {
+            result.push_back(pool_name + ":" + toString(ceil(effective_pool_size)));
+        }
+    }
+
+    if (!shp_deployed && !isEqual(shp_size, 0) && has_ingress_lossless_pool_size)
+    {
+        result.push_back("ingress_lossless_pool:" + toString(ceil(ingress_lossless_pool_size)) + ":" + toString(ceil(shp_size)));
+    }
+
+    result.push_back("debug:mmu_size:" + toString(mmu_size));
+    result.push_back("debug:accumulative size:" + toString(accumulative_occupied_buffer));
+    result.insert(result.end(), statistics.begin(), statistics.end());
+    result.push_back("debug:extra_8lanes:" + toString(lossypg_reserved_8lanes - lossypg_reserved) + ":" + toString(m_lossyPg8Lanes) + ":" + toString(port_count_8lanes));
+    result.push_back("debug:mgmt_pool:" + toString(mgmt_pool_size));
+    if (shp_enabled)
+    {
+        result.push_back("debug:accumulative_private_headroom:" + toString(accumulative_private_headroom));
+        result.push_back("debug:accumulative xoff:" + toString(accumulative_xoff));
+        result.push_back(string("debug:force enabled shp:") + (force_enable_shp ? "true" : "false"));
+    }
+    result.push_back("debug:accumulative_mgmt_pg:" + toString(accumulative_management_pg));
+    result.push_back("debug:egress_mirror:" + toString(accumulative_egress_mirror_overhead));
+    result.push_back(string("debug:shp_enabled:") + (shp_enabled ? "true" : "false"));
+    result.push_back("debug:shp_size:" + toString(shp_size));
+    result.push_back("debug:total port:" + toString(total_port) + " ports with 8 lanes:" + toString(port_count_8lanes));
+    result.push_back("debug:admin up port:" + toString(admin_up_port) + " admin up ports with 8 lanes:" + toString(admin_up_8lanes_port));
+
+    return result;
+}
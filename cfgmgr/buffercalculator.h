@@ -0,0 +1,143 @@
+#ifndef __BUFFERCALCULATOR__
+#define __BUFFERCALCULATOR__
+
+#include "dbconnector.h"
+#include "producerstatetable.h"
+#include "table.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace swss {
+
+typedef std::map<std::string, std::string> buffer_calc_entry_t;
+typedef std::map<std::string, buffer_calc_entry_t> buffer_calc_table_t;
+
+/*
+ * In-process replacement of the buffer_headroom_<vendor>.lua, buffer_check_headroom_<vendor>.lua
+ * and buffer_pool_<vendor>.lua plugins of the dynamic buffer manager.
+ *
+ * The plugins read everything from the databases on each run. The calculator keeps an image of the
+ * tables they read instead:
+ *  - CONFIG_DB and STATE_DB tables buffermgrd subscribes to, fed by the owner as they are received
+ *  - APPL_DB buffer tables, read from APPL_DB at start so that the entries left by the previous run
+ *    are counted on warm restart, then fed by the BufferApplTable producers as buffermgrd writes them
+ *  - ASIC_TABLE and LOSSLESS_TRAFFIC_PATTERN, read from the databases once
+ * The table names of the three databases don't overlap, so one image holds all of them.
+ *
+ * An APPL_DB entry in the image is what orchagent will have once it handles the pending updates:
+ * the entries in <table>_DEL_SET are dropped and the pending _<table> entries are merged,
+ * which is how buffer_check_headroom_<vendor>.lua reads the PGs. buffer_pool_<vendor>.lua only
+ * calculates with the entries orchagent has handled, which is checked by hasPendingEntries.
+ *
+ * The results are returned in the format of the corresponding lua plugin so that the callers
+ * handle both in the same way.
+ */
+class BufferCalculator
+{
+public:
+    BufferCalculator(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb);
+    virtual ~BufferCalculator() {}
+
+    // Returns the calculator of the vendor, or nullptr if the vendor's lua plugins should be used
+    static std::unique_ptr<BufferCalculator> create(const std::string &platform, DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb);
+
+    // Whether a CONFIG_DB or STATE_DB table buffermgrd subscribes to is read by the calculator
+    static bool isInputTable(const std::string &table);
+
+    void setEntry(const std::string &table, const std::string &key, const std::vector<FieldValueTuple> &fvs, bool merge = false);
+    void delEntry(const std::string &table, const std::string &key);
+
+    // The same arguments as the corresponding lua plugins
+    virtual std::vector<std::string> calculateHeadroom(const std::string &speed, const std::string &cable_length, const std::string &mtu,
+                                                       const std::string &gearbox_delay, const std::string &lane_count) = 0;
+    virtual std::vector<std::string> checkHeadroom(const std::string &port, const std::string &profile_name, const std::string &size,
+                                                   const std::string &xon, const std::string &xoff, const std::string &new_pg) = 0;
+    virtual std::vector<std::string> calculateBufferPool() = 0;
+
+protected:
+    const buffer_calc_table_t &getTable(const std::string &table);
+    const buffer_calc_entry_t *getEntry(const std::string &table, const std::string &key);
+    // The first entry of the table, like redis.call('KEYS', '<table>*')[1] in the lua plugins
+    const buffer_calc_entry_t *getFirstEntry(const std::string &table, std::string *key = nullptr);
+    bool getField(const std::string &table, const std::string &key, const std::string &field, std::string &value);
+    bool getNumber(const std::string &table, const std::string &key, const std::string &field, double &value);
+    // Whether orchagent hasn't handled all the updates of an APPL_DB table, like <table>_KEY_SET or <table>_DEL_SET existing
+    bool hasPendingEntries(const std::string &table);
+
+private:
+    std::map<std::string, buffer_calc_table_t> m_tables;
+    DBConnector *m_applDb;
+    Table m_cfgLosslessTrafficPatternTable;
+    Table m_stateAsicTable;
+
+    void loadTable(Table &table);
+    void loadApplTable(const std::string &table);
+};
+
+/*
+ * ProducerStateTable which mirrors the entries written by buffermgrd into the image of the calculator
+ */
+class BufferApplTable : public ProducerStateTable
+{
+public:
+    BufferApplTable(DBConnector *db, const std::string &tableName) :
+        ProducerStateTable(db, tableName),
+        m_calculator(nullptr)
+    {
+    }
+
+    void setCalculator(BufferCalculator *calculator)
+    {
+        m_calculator = calculator;
+    }
+
+    void set(const std::string &key,
+             const std::vector<FieldValueTuple> &values,
+             const std::string &op = SET_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void del(const std::string &key,
+             const std::string &op = DEL_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+private:
+    BufferCalculator *m_calculator;
+};
+
+/*
+ * Models buffer_headroom_mellanox.lua, buffer_check_headroom_mellanox.lua and buffer_pool_mellanox.lua,
+ * which are used by the vs platform as well
+ */
+class MellanoxBufferCalculator : public BufferCalculator
+{
+public:
+    MellanoxBufferCalculator(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb) :
+        BufferCalculator(cfgDb, stateDb, applDb)
+    {
+    }
+
+    std::vector<std::string> calculateHeadroom(const std::string &speed, const std::string &cable_length, const std::string &mtu,
+                                               const std::string &gearbox_delay, const std::string &lane_count) override;
+    std::vector<std::string> checkHeadroom(const std::string &port, const std::string &profile_name, const std::string &size,
+                                           const std::string &xon, const std::string &xoff, const std::string &new_pg) override;
+    std::vector<std::string> calculateBufferPool() override;
+
+private:
+    bool countBufferObjects(const std::string &table, bool check_lossless);
+    bool countProfileLists(const std::string &table);
+    std::vector<std::string> fetchBufferPoolSizeFromAppl(bool shp_enabled);
+
+    // State of one run of calculateBufferPool
+    std::map<std::string, double> m_profileRefCount;
+    std::map<std::string, bool> m_ingressProfileIsLossless;
+    std::map<std::string, bool> m_portIs8Lanes;
+    double m_lossyPg8Lanes;
+    double m_losslessPortCount;
+};
+
+}
+
+#endif /* __BUFFERCALCULATOR__ */
@@ -42,8 +42,8 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         m_applBufferPoolTable(applDb, APP_BUFFER_POOL_TABLE_NAME),
         m_applStateBufferPoolTable(applStateDb, APP_BUFFER_POOL_TABLE_NAME),
         m_applBufferProfileTable(applDb, APP_BUFFER_PROFILE_TABLE_NAME),
-        m_applBufferObjectTables{ProducerStateTable(applDb, APP_BUFFER_PG_TABLE_NAME), ProducerStateTable(applDb, APP_BUFFER_QUEUE_TABLE_NAME)},
-        m_applBufferProfileListTables{ProducerStateTable(applDb, APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME), ProducerStateTable(applDb, APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME)},
+        m_applBufferObjectTables{BufferApplTable(applDb, APP_BUFFER_PG_TABLE_NAME), BufferApplTable(applDb, APP_BUFFER_QUEUE_TABLE_NAME)},
+        m_applBufferProfileListTables{BufferApplTable(applDb, APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME), BufferApplTable(applDb, APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME)},
         m_statePortTable(stateDb, STATE_PORT_TABLE_NAME),
         m_stateBufferMaximumTable(stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE),
         m_stateBufferPoolTable(stateDb, STATE_BUFFER_POOL_TABLE_NAME),
@@ -53,7 +53,8 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         m_bufferPoolReady(false),
         m_bufferObjectsPending(true),
         m_bufferCompletelyInitialized(false),
-        m_mmuSizeNumber(0)
+        m_mmuSizeNumber(0),
+        m_sharedBufferPoolPending(false)
 {
     SWSS_LOG_ENTER();
 
@@ -121,6 +122,19 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         }
     }
 
+    m_bufferCalculator = BufferCalculator::create(platform, cfgDb, stateDb, applDb);
+    if (m_bufferCalculator)
+    {
+        SWSS_LOG_NOTICE("Buffer headroom and pool sizes are calculated in-process for platform %s", platform.c_str());
+        m_applBufferPoolTable.setCalculator(m_bufferCalculator.get());
+        m_applBufferProfileTable.setCalculator(m_bufferCalculator.get());
+        for (auto dir : m_bufferDirections)
+        {
+            m_applBufferObjectTables[dir].setCalculator(m_bufferCalculator.get());
+            m_applBufferProfileListTables[dir].setCalculator(m_bufferCalculator.get());
+        }
+    }
+
     // Init timer
     auto interv = timespec { .tv_sec = BUFFERMGR_TIMER_PERIOD, .tv_nsec = 0 };
     m_buffermgrPeriodtimer = new SelectableTimer(interv);
@@ -600,7 +614,7 @@ bool BufferMgrDynamic::needRefreshPortDueToEffectiveSpeed(port_info_t &portInfo,
 // Meta flows which are called by main flows
 void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 {
-    // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size and threshold
+    // Call vendor-specific calculator or lua plugin to calculate the xon, xoff, xon_offset, size and threshold
     vector<string> keys = {};
     vector<string> argv = {};
 
@@ -613,7 +627,9 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 
     try
     {
-        auto ret = swss::runRedisScript(*m_applDb, m_headroomSha, keys, argv);
+        auto ret = m_bufferCalculator ?
+            m_bufferCalculator->calculateHeadroom(headroom.speed, headroom.cable_length, headroom.port_mtu, m_identifyGearboxDelay, to_string(headroom.lane_count)) :
+            swss::runRedisScript(*m_applDb, m_headroomSha, keys, argv);
 
         if (ret.empty())
         {
@@ -690,7 +706,7 @@ void BufferMgrDynamic::recalculateSharedBufferPool()
             }
         }
 
-        auto ret = runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
+        auto ret = m_bufferCalculator ? m_bufferCalculator->calculateBufferPool() : runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
 
         // The format of the result:
         // a list of lines containing key, value pairs with colon as separator
@@ -854,8 +870,18 @@ void BufferMgrDynamic::checkSharedBufferPoolSize(bool force_update_during_initia
         }
     }
 
+    // The pool is recalculated once all the updates in the batch have been handled
     if (!m_mmuSize.empty())
+        m_sharedBufferPoolPending = true;
+}
+
+void BufferMgrDynamic::doPendingSharedBufferPoolUpdate()
+{
+    if (m_sharedBufferPoolPending)
+    {
+        m_sharedBufferPoolPending = false;
         recalculateSharedBufferPool();
+    }
 }
 
 // For buffer pool, only size can be updated on-the-fly
@@ -1075,7 +1101,9 @@ bool BufferMgrDynamic::isHeadroomResourceValid(const string &port, const buffer_
 
     try
     {
-        auto ret = runRedisScript(*m_applDb, m_checkHeadroomSha, keys, argv);
+        auto ret = m_bufferCalculator ?
+            m_bufferCalculator->checkHeadroom(port, profile.name, profile.size, profile.xon, profile.xoff, new_pg) :
+            runRedisScript(*m_applDb, m_checkHeadroomSha, keys, argv);
 
         // The format of the result:
         // a list of strings containing key, value pairs with colon as separator
@@ -3448,8 +3476,19 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
         return;
     }
 
+    bool isCalculatorInput = m_bufferCalculator && BufferCalculator::isInputTable(table_name);
+
     while (it != consumer.m_toSync.end())
     {
+        if (isCalculatorInput)
+        {
+            auto &tuple = it->second;
+            if (kfvOp(tuple) == SET_COMMAND)
+                m_bufferCalculator->setEntry(table_name, kfvKey(tuple), kfvFieldsValues(tuple));
+            else
+                m_bufferCalculator->delEntry(table_name, kfvKey(tuple));
+        }
+
         auto task_status = (this->*(m_bufferTableHandlerMap[table_name]))(it->second);
         switch (task_status)
         {
@@ -3470,6 +3509,8 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    doPendingSharedBufferPoolUpdate();
 }
 
 /*
@@ -3654,6 +3695,7 @@ void BufferMgrDynamic::cleanUpItemsForReclaimingBuffer(const string &port)
 void BufferMgrDynamic::doTask(SelectableTimer &timer)
 {
     checkSharedBufferPoolSize(true);
+    doPendingSharedBufferPoolUpdate();
     if (!m_bufferCompletelyInitialized)
     {
         handlePendingBufferObjects();
@@ -4,8 +4,10 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "buffercalculator.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -205,13 +207,13 @@ private:
     int m_waitApplyAdditionalZeroProfiles;
 
     // BUFFER_POOL table and cache
-    ProducerStateTable m_applBufferPoolTable;
+    BufferApplTable m_applBufferPoolTable;
     Table m_applStateBufferPoolTable;
     Table m_stateBufferPoolTable;
     buffer_pool_lookup_t m_bufferPoolLookup;
 
     // BUFFER_PROFILE table and caches
-    ProducerStateTable m_applBufferProfileTable;
+    BufferApplTable m_applBufferProfileTable;
     Table m_stateBufferProfileTable;
     // m_bufferProfileLookup - the cache for the following set:
     // 1. CFG_BUFFER_PROFILE
@@ -220,7 +222,7 @@ private:
     buffer_profile_lookup_t m_bufferProfileLookup;
 
     // BUFFER_PG table and caches
-    ProducerStateTable m_applBufferObjectTables[BUFFER_DIR_MAX];
+    BufferApplTable m_applBufferObjectTables[BUFFER_DIR_MAX];
     // m_portPgLookup - the cache for CFG_BUFFER_PG and APPL_BUFFER_PG
     // 1st level key: port name, 2nd level key: PGs
     // Updated in:
@@ -234,7 +236,7 @@ private:
     port_object_lookup_t m_portQueueLookup;
 
     // BUFFER_INGRESS_PROFILE_LIST/BUFFER_EGRESS_PROFILE_LIST table and caches
-    ProducerStateTable m_applBufferProfileListTables[BUFFER_DIR_MAX];
+    BufferApplTable m_applBufferProfileListTables[BUFFER_DIR_MAX];
     port_profile_list_lookup_t m_portProfileListLookups[BUFFER_DIR_MAX];
 
     //  table and caches
@@ -258,6 +260,11 @@ private:
     std::string m_bufferpoolSha;
     std::string m_checkHeadroomSha;
 
+    // In-process calculator used instead of the lua plugins, for the vendors providing one
+    std::unique_ptr<BufferCalculator> m_bufferCalculator;
+    // The shared buffer pool is recalculated once after a batch of table updates
+    bool m_sharedBufferPoolPending;
+
     // Parameters for headroom generation
     std::string m_mmuSize;
     unsigned long m_mmuSizeNumber;
@@ -294,6 +301,7 @@ private:
     void calculateHeadroomSize(buffer_profile_t &headroom);
     void checkSharedBufferPoolSize(bool force_update_during_initialization);
     void recalculateSharedBufferPool();
+    void doPendingSharedBufferPoolUpdate();
     task_process_status allocateProfile(const std::string &speed, const std::string &cable, const std::string &mtu, const std::string &threshold, const std::string &gearbox_model, long lane_count, std::string &profile_name);
     void releaseProfile(const std::string &profile_name);
     bool isHeadroomResourceValid(const std::string &port, const buffer_profile_t &profile, const std::string &new_pg);
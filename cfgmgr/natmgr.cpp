@@ -15,6 +15,8 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
+#include <sstream>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -70,6 +72,8 @@ NatMgr::NatMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, con
     m_natRefreshTimer = new SelectableTimer(refresh_interval);
     auto refresh_executor   = new ExecutableTimer(m_natRefreshTimer, this, "NAT_ENTRY_REFRESH_TIMER");
     Orch::addExecutor(refresh_executor);
+
+    loadIptablesRules();
 }
 
 /* To check the port init is done or not */
@@ -355,6 +359,9 @@ bool NatMgr::warmBootingInProgress(void)
 /* To flush all NAT entries */
 void NatMgr::flushAllNatEntries(void)
 {
+    /* The connections after the flush must see the rules queued so far, they are applied first */
+    commitIptablesRules();
+
     std::string res;
     const std::string cmds = std::string("") + CONNTRACK_CMD + FLUSH;
     int ret = swss::exec(cmds, res);
@@ -831,6 +838,9 @@ void NatMgr::deleteConntrackStaticTwiceNaptEntry(const string &snatKey, const st
 /* To Delete conntrack entries for matching Pool ip address */
 void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
 {
+    /* The connections after the delete must see the rules queued so far, they are applied first */
+    commitIptablesRules();
+
     std::string res, cmds;
 
     uint32_t ipv4_addr_low, ipv4_addr_high, ip, setIp;
@@ -881,6 +891,312 @@ void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
     }
 }
 
+/* Tag carried by every natmgrd iptables rule as a comment, so that the rules
+ * left in the kernel by a previous natmgrd can be told apart on start.
+ * The tag is a FNV-1a hash of the table, chain and rule specification.
+ */
+static string getIptablesRuleTag(const string &table, const string &chain, const string &spec)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const string &s : { table, chain, spec })
+    {
+        for (unsigned char c : s)
+        {
+            hash = (hash ^ c) * 0x100000001b3ULL;
+        }
+        hash = (hash ^ ' ') * 0x100000001b3ULL;
+    }
+
+    char tag[32];
+    snprintf(tag, sizeof(tag), "%s%016" PRIx64, IPTABLES_RULE_TAG, hash);
+    return tag;
+}
+
+/* Rule line in iptables-restore format, also used as iptables arguments */
+static string getIptablesRuleLine(const natIptablesRule_t &rule)
+{
+    string line = "-" + rule.opCmd + " " + rule.chain;
+
+    if (!rule.tag.empty())
+    {
+        line += " -m comment --comment " + rule.tag;
+    }
+
+    return line + " " + rule.spec;
+}
+
+/* To queue the iptables commands for the transactions applied at the end of the doTask pass, or right away by applyIptablesRules().
+ * The commands are joined by " && " and generated as:
+ * iptables -t table -opCmd chain rule-specification
+ * The rules failing to apply are reported by commitIptablesRules() with their owner.
+ */
+bool NatMgr::queueIptablesCmds(const string &cmds, const string &owner)
+{
+    size_t pos = 0;
+
+    while (pos < cmds.size())
+    {
+        size_t end = cmds.find(" && ", pos);
+        if (end == string::npos)
+        {
+            end = cmds.size();
+        }
+
+        istringstream iss(cmds.substr(pos, end - pos));
+        pos = end + 4;
+
+        natIptablesRule_t rule;
+        string cmd, table, opCmd, token;
+
+        iss >> cmd >> table >> rule.table >> opCmd >> rule.chain;
+        if ((cmd != IPTABLES_CMD) or (table != "-t") or rule.chain.empty() or
+            ((opCmd != "-" ADD) and (opCmd != "-" INSERT) and (opCmd != "-" DELETE)))
+        {
+            SWSS_LOG_ERROR("Unexpected iptables command in '%s'", cmds.c_str());
+            return false;
+        }
+        rule.opCmd = opCmd.substr(1);
+
+        while (iss >> token)
+        {
+            rule.spec += (rule.spec.empty() ? "" : " ") + token;
+        }
+        rule.tag = getIptablesRuleTag(rule.table, rule.chain, rule.spec);
+        rule.owner = owner;
+
+        /* The rule is already in the kernel, left by the previous natmgrd */
+        if (rule.opCmd != DELETE)
+        {
+            auto it = m_staleIptablesRules.find(rule.tag);
+            if (it != m_staleIptablesRules.end())
+            {
+                SWSS_LOG_INFO("Iptables rule %s %s is already in the kernel", rule.table.c_str(),
+                              getIptablesRuleLine(rule).c_str());
+                m_staleIptablesRules.erase(it);
+                continue;
+            }
+        }
+
+        m_pendingIptablesRules.push_back(rule);
+    }
+
+    return true;
+}
+
+/* To apply the rules queued by setRules right away, for the callers whose state depends on them being in the kernel.
+ * The rules queued before are committed first, so that the result is the one of setRules alone.
+ */
+bool NatMgr::applyIptablesRules(const function<bool()> &setRules)
+{
+    commitIptablesRules();
+
+    if (!setRules())
+    {
+        return false;
+    }
+
+    return (commitIptablesRules() == 0);
+}
+
+/* Untagged rule as added by a natmgrd older than the rule tags:
+ * iptables -t nat -A/-I PREROUTING/POSTROUTING ... -j DNAT/SNAT ...
+ * iptables -t mangle -A PREROUTING/POSTROUTING -i/-o port -j MARK ...
+ */
+static bool isUntaggedIptablesRule(const string &table, const string &chain, const string &spec)
+{
+    if ((chain != "PREROUTING") and (chain != "POSTROUTING"))
+    {
+        return false;
+    }
+
+    if (table == "nat")
+    {
+        return (spec.find("-j DNAT") != string::npos) or (spec.find("-j SNAT") != string::npos);
+    }
+
+    return (table == "mangle") and (!spec.compare(0, 3, "-i ") or !spec.compare(0, 3, "-o ")) and
+           (spec.find("-j MARK") != string::npos);
+}
+
+/* To read the natmgrd rules left in the kernel, the config replay claims them instead of adding them again.
+ * Untagged rules of an older natmgrd cannot be matched with the config, the tagged rules of the replay
+ * replace them and they are removed with the unclaimed ones.
+ */
+void NatMgr::loadIptablesRules(void)
+{
+    size_t untagged = 0;
+
+    for (const string table : { "nat", "mangle" })
+    {
+        string res;
+        const string cmds = string(IPTABLES_SAVE_CMD) + " -t " + table;
+
+        int ret = swss::exec(cmds, res);
+        if (ret)
+        {
+            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+            continue;
+        }
+
+        istringstream iss(res);
+        string line;
+        while (getline(iss, line))
+        {
+            /* -A chain ... -m comment --comment natmgrd:hash ... */
+            size_t chainEnd = line.find(' ', 3);
+            if (line.compare(0, 3, "-A ") or (chainEnd == string::npos))
+            {
+                continue;
+            }
+
+            natIptablesRule_t rule;
+
+            rule.table = table;
+            rule.opCmd = DELETE;
+            rule.chain = line.substr(3, chainEnd - 3);
+            rule.spec = line.substr(chainEnd + 1);
+            rule.owner = "the previous natmgrd";
+
+            size_t pos = line.find("--comment " IPTABLES_RULE_TAG);
+            if (pos == string::npos)
+            {
+                /* Never claimed, the tag of a config rule is not empty */
+                if (isUntaggedIptablesRule(table, rule.chain, rule.spec))
+                {
+                    m_staleIptablesRules.emplace("", rule);
+                    untagged++;
+                }
+                continue;
+            }
+
+            pos += strlen("--comment ");
+            m_staleIptablesRules.emplace(line.substr(pos, line.find(' ', pos) - pos), rule);
+        }
+    }
+
+    if (!m_staleIptablesRules.empty())
+    {
+        SWSS_LOG_NOTICE("Found %zu iptables rules from the previous natmgrd, %zu untagged",
+                        m_staleIptablesRules.size(), untagged);
+    }
+}
+
+/* To run iptables-restore on the given input, returns its rc with the command and its output */
+static int restoreIptablesRules(const string &input, string &cmds, string &res)
+{
+    /* iptables-restore reads the rules from a file, it may stop reading a pipe early on an error */
+    char path[] = "/tmp/natmgrd_iptables.XXXXXX";
+    int ret = -1;
+
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        ssize_t written = write(fd, input.data(), input.size());
+        close(fd);
+
+        if (written == static_cast<ssize_t>(input.size()))
+        {
+            cmds = string(IPTABLES_RESTORE_CMD) + " --noflush < " + path + " 2>&1";
+            ret = swss::exec(cmds, res);
+        }
+        else
+        {
+            cmds = string("write ") + path;
+        }
+        unlink(path);
+    }
+    else
+    {
+        cmds = string("mkstemp ") + path;
+        res = strerror(errno);
+    }
+
+    return ret;
+}
+
+/* To apply the queued iptables rules with one iptables-restore transaction per table, returns the number of rules that failed */
+size_t NatMgr::commitIptablesRules(void)
+{
+    /* Remove the rules of the previous natmgrd which are not in the config any more */
+    if (!m_staleIptablesRules.empty() and !warmBootingInProgress())
+    {
+        SWSS_LOG_NOTICE("Removing %zu stale iptables rules", m_staleIptablesRules.size());
+        for (auto &it : m_staleIptablesRules)
+        {
+            m_pendingIptablesRules.push_back(it.second);
+        }
+        m_staleIptablesRules.clear();
+    }
+
+    if (m_pendingIptablesRules.empty())
+    {
+        return 0;
+    }
+
+    vector<natIptablesRule_t> rules;
+    rules.swap(m_pendingIptablesRules);
+
+    /* The rules of a table are kept in order, the tables do not depend on each other */
+    vector<string> tables;
+    map<string, vector<const natIptablesRule_t *>> tableRules;
+    for (const auto &rule : rules)
+    {
+        auto &queued = tableRules[rule.table];
+        if (queued.empty())
+        {
+            tables.push_back(rule.table);
+        }
+        queued.push_back(&rule);
+    }
+
+    /* iptables-restore --noflush commits each table section on its own, a table is restored at a time
+     * so that a rejected one is known and only its rules are applied again one by one.
+     */
+    size_t failed = 0;
+    map<string, size_t> failedOwners;
+    for (const auto &table : tables)
+    {
+        string input = "*" + table + "\n";
+        for (const auto *rule : tableRules[table])
+        {
+            input += getIptablesRuleLine(*rule) + "\n";
+        }
+        input += "COMMIT\n";
+
+        string cmds, res;
+        int ret = restoreIptablesRules(input, cmds, res);
+        if (ret == 0)
+        {
+            SWSS_LOG_INFO("Applied %zu iptables rules to the %s table", tableRules[table].size(), table.c_str());
+            continue;
+        }
+
+        /* The transaction of the table is rejected as a whole, apply its rules one by one to keep the valid ones */
+        SWSS_LOG_WARN("Command '%s' failed with rc %d for %zu %s rules, applying them one by one: %s",
+                      cmds.c_str(), ret, tableRules[table].size(), table.c_str(), res.c_str());
+
+        for (const auto *rule : tableRules[table])
+        {
+            const string cmd = string(IPTABLES_CMD) + " -t " + table + " " + getIptablesRuleLine(*rule);
+
+            ret = swss::exec(cmd, res);
+            if (ret)
+            {
+                SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.c_str(), ret);
+                failedOwners[rule->owner]++;
+                failed++;
+            }
+        }
+    }
+
+    for (const auto &it : failedOwners)
+    {
+        SWSS_LOG_ERROR("Failed to apply %zu iptables rules of %s", it.second, it.first.c_str());
+    }
+
+    return failed;
+}
+
 /* Iptable rules are added in the mangles table, to support use of Loopback IP as NAT Public IP which is a typical use-case in DC scenarios. The way it works is that:
  *
  * *	The mangle table rules are processed first before the nat table rules.
@@ -899,8 +1215,6 @@ bool NatMgr::setMangleIptablesRules(const string &opCmd, const string &interface
      * iptables -t mangle -opCmd PREROUTING -i port -j MARK --set-mark nat_zone
      * iptables -t mangle -opCmd POSTROUTING -o port -j MARK --set-mark nat_zone
      */
-    std::string res;
-    int ret;
 
     if (nat_zone.empty())
     {
@@ -912,11 +1226,8 @@ bool NatMgr::setMangleIptablesRules(const string &opCmd, const string &interface
           + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " PREROUTING -i " + interface + " -j MARK --set-mark " + nat_zone + " && "
           + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " POSTROUTING -o " + interface + " -j MARK --set-mark " + nat_zone ;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
+    if (!queueIptablesCmds(cmds, "NAT zone " + nat_zone + " of " + interface))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
 
@@ -929,19 +1240,14 @@ bool NatMgr::setFullConeDnatIptablesRule(const string &opCmd)
     /* This rule in the PREROUTING chain should be the default rule at the end of the list
      * iptables -t nat -[A/D] PREROUTING -j DNAT --fullcone
      */
-    std::string res;
-    int ret;
 
     /* In case of fullcone, the --to-destination is ignored by the stack, giving an aribitrary value so that 
      * iptables doesn't fail for PREROUTING/DNAT rule */
     const std::string cmds = std::string("")
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + " -j DNAT --to-destination 1.1.1.1 --fullcone";
         
-    ret = swss::exec(cmds, res);
-
-    if (ret)
+    if (!queueIptablesCmds(cmds, "fullcone DNAT"))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
     return true;
@@ -956,9 +1262,7 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -j DNAT -d external_ip --to-destination internal_ip
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s internal_ip --to-source external_ip
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -968,11 +1272,8 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + external_ip + " --to-destination " + internal_ip + " && "
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + internal_ip + " --to-source " + external_ip ;
         
-        ret = swss::exec(cmds, res);
-
-        if (ret)
+        if (!queueIptablesCmds(cmds, "Static NAT " + external_ip))
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
             return false;
         }
     }
@@ -982,11 +1283,8 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING" + " -j DNAT -d " + internal_ip + " --to-destination " + external_ip + " && "
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + external_ip + " --to-source " + internal_ip ;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
+        if (!queueIptablesCmds(cmds, "Static NAT " + external_ip))
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
             return false;
         }
     }
@@ -1004,9 +1302,7 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -p prototype -j DNAT -d external_ip --dport external_port --to-destination internal_ip:internal_port
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -p prototype -j SNAT -s internal_ip --sport internal_port --to-source external_ip:external_port
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1018,11 +1314,8 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + internal_ip + " --sport " + internal_port + " --to-source " 
           + external_ip + ":" + external_port;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
+        if (!queueIptablesCmds(cmds, "Static NAPT " + external_ip + ":" + prototype + ":" + external_port))
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
             return false;
         }
     }
@@ -1034,11 +1327,8 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -p " + prototype + " -j SNAT -s " + external_ip + " --sport " + external_port + " --to-source "
           + internal_ip + ":" + internal_port;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
+        if (!queueIptablesCmds(cmds, "Static NAPT " + external_ip + ":" + prototype + ":" + external_port))
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
             return false;
         }
     }
@@ -1060,9 +1350,7 @@ bool NatMgr::setStaticTwiceNatIptablesRules(const string &opCmd, const string &i
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s translated_dst --to-source dst -d src 
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1076,11 +1364,8 @@ bool NatMgr::setStaticTwiceNatIptablesRules(const string &opCmd, const string &i
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + translated_dest_ip
           + " --to-source " + dest_ip + " -d " + src_ip;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
+    if (!queueIptablesCmds(cmds, "Static Twice NAT " + src_ip + " and " + dest_ip))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
 
@@ -1106,9 +1391,7 @@ bool NatMgr::setStaticTwiceNaptIptablesRules(const string &opCmd, const string &
      * -d src --dport src_l4_port
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1122,11 +1405,8 @@ bool NatMgr::setStaticTwiceNaptIptablesRules(const string &opCmd, const string &
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + translated_dest_ip + " --sport " + translated_dest_port
           + " --to-source " + dest_ip + ":" + dest_port + " -d " + src_ip + " --dport " +src_port;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
+    if (!queueIptablesCmds(cmds, "Static Twice NAPT " + src_ip + ":" + src_port + " and " + dest_ip + ":" + dest_port))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
 
@@ -1145,7 +1425,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
      * iptables -t nat -opCmd POSTROUTING -p udp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      * iptables -t nat -opCmd POSTROUTING -p icmp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
-    std::string res, cmd;
+    std::string cmd;
     std::string externalString = EMPTY_STRING;
     std::string fullcone = EMPTY_STRING;
     std::string prototype = EMPTY_STRING;
@@ -1219,10 +1499,8 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
+    if (!queueIptablesCmds(cmds, "Dynamic NAT " + external_ip + " of " + interface))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
 
@@ -1247,7 +1525,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
      * iptables -t nat -opCmd POSTROUTING -p icmp srcIpAddressString -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
 
-    std::string res, cmd;
+    std::string cmd;
     std::string srcIpAddressString = EMPTY_STRING, dstIpAddressString = EMPTY_STRING;
     std::string srcPortString = EMPTY_STRING, dstPortString = EMPTY_STRING;
     std::string externalString = EMPTY_STRING, fullcone = EMPTY_STRING;
@@ -1448,10 +1726,8 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
+    if (!queueIptablesCmds(cmds, "Dynamic NAT " + external_ip + " of " + interface + " with ACL rule"))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
         return false;
     }
 
@@ -2060,11 +2336,11 @@ void NatMgr::addStaticSingleNatEntry(const string &key)
     /* Add Static NAT iptables rule */
     if (!setStaticNatIptablesRules(INSERT, interface, key, m_staticNatEntry[key].local_ip, m_staticNatEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to add Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAT iptables rules to add for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Added Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAT iptables rules to add for %s", key.c_str());
     }
 }
 
@@ -2185,7 +2461,7 @@ void NatMgr::addStaticTwiceNatEntry(const string &key)
         }
 
         /* Add Static NAT iptables rule */
-        if (!setStaticTwiceNatIptablesRules(INSERT, interface, src, translated_src, dest, translated_dest))
+        if (!applyIptablesRules([&] { return setStaticTwiceNatIptablesRules(INSERT, interface, src, translated_src, dest, translated_dest); }))
         {
             SWSS_LOG_ERROR("Failed to add Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -2378,11 +2654,11 @@ void NatMgr::addStaticSingleNaptEntry(const string &key)
                                     m_staticNaptEntry[key].local_ip, m_staticNaptEntry[key].local_port,
                                     m_staticNaptEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to add Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAPT iptables rules to add for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Added Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAPT iptables rules to add for %s", key.c_str());
     }
 }
 
@@ -2545,8 +2821,8 @@ void NatMgr::addStaticTwiceNaptEntry(const string &key)
         }
 
         /* Add Static NAPT iptables rule */
-        if (!setStaticTwiceNaptIptablesRules(INSERT, interface, prototype, src, src_port, translated_src, translated_src_port,
-            dest, dest_port, translated_dest, translated_dest_port))
+        if (!applyIptablesRules([&] { return setStaticTwiceNaptIptablesRules(INSERT, interface, prototype, src, src_port, translated_src, translated_src_port,
+            dest, dest_port, translated_dest, translated_dest_port); }))
         {
             SWSS_LOG_ERROR("Failed to add Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -2708,11 +2984,11 @@ void NatMgr::removeStaticSingleNatEntry(const string &key)
     /* Remove Static NAT iptables rule */
     if (!setStaticNatIptablesRules(DELETE, interface, key, m_staticNatEntry[key].local_ip, m_staticNatEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to delete Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAT iptables rules to delete for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Deleted Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAT iptables rules to delete for %s", key.c_str());
     }
 
     m_staticNatEntry[key].interface = NONE_STRING;
@@ -2835,7 +3111,7 @@ void NatMgr::removeStaticTwiceNatEntry(const string &key)
         SWSS_LOG_INFO("Deleted Static Twice NAT for %s and %s from APPL_DB", key.c_str(), (*it).first.c_str());
 
         /* Delete Static NAT iptables rule */
-        if (!setStaticTwiceNatIptablesRules(DELETE, interface, src, translated_src, dest, translated_dest))
+        if (!applyIptablesRules([&] { return setStaticTwiceNatIptablesRules(DELETE, interface, src, translated_src, dest, translated_dest); }))
         {
             SWSS_LOG_ERROR("Failed to delete Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -3020,11 +3296,11 @@ void NatMgr::removeStaticSingleNaptEntry(const string &key)
                                     m_staticNaptEntry[key].local_ip, m_staticNaptEntry[key].local_port,
                                     m_staticNaptEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to delete Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAPT iptables rules to delete for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Deleted Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAPT iptables rules to delete for %s", key.c_str());
     }
 
     m_staticNaptEntry[key].interface = NONE_STRING;
@@ -3173,8 +3449,8 @@ void NatMgr::removeStaticTwiceNaptEntry(const string &key)
         SWSS_LOG_INFO("Deleted Static Twice NAPT for %s and %s from APPL_DB", key.c_str(), (*it).first.c_str());
 
         /* Delete Static NAPT iptables rule */
-        if (!setStaticTwiceNaptIptablesRules(DELETE, interface, prototype, src, src_port, translated_src, translated_src_port,
-                                             dest, dest_port, translated_dest, translated_dest_port))
+        if (!applyIptablesRules([&] { return setStaticTwiceNaptIptablesRules(DELETE, interface, prototype, src, src_port, translated_src, translated_src_port,
+                                                                             dest, dest_port, translated_dest, translated_dest_port); }))
         {
             SWSS_LOG_ERROR("Failed to delete Static Twice NAPT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -3348,11 +3624,11 @@ void NatMgr::addStaticSingleNatIptables(const string &key)
     /* Add Static NAT iptables rule */
     if (!setStaticNatIptablesRules(INSERT, interface, key, m_staticNatEntry[key].local_ip, m_staticNatEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to add Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAT iptables rules to add for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Added Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAT iptables rules to add for %s", key.c_str());
     }
 }
 
@@ -3422,7 +3698,7 @@ void NatMgr::addStaticTwiceNatIptables(const string &key)
         }
 
         /* Add Static NAT iptables rule */
-        if (!setStaticTwiceNatIptablesRules(INSERT, interface, src, translated_src, dest, translated_dest))
+        if (!applyIptablesRules([&] { return setStaticTwiceNatIptablesRules(INSERT, interface, src, translated_src, dest, translated_dest); }))
         {
             SWSS_LOG_ERROR("Failed to add Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -3580,11 +3856,11 @@ void NatMgr::addStaticSingleNaptIptables(const string &key)
                                     m_staticNaptEntry[key].local_ip, m_staticNaptEntry[key].local_port,
                                     m_staticNaptEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to add Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAPT iptables rules to add for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Added Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAPT iptables rules to add for %s", key.c_str());
     }
 }
 
@@ -3680,8 +3956,8 @@ void NatMgr::addStaticTwiceNaptIptables(const string &key)
         }
 
         /* Add Static NAPT iptables rule */
-        if (!setStaticTwiceNaptIptablesRules(INSERT, interface, prototype, src, src_port, translated_src, translated_src_port,
-            dest, dest_port, translated_dest, translated_dest_port))
+        if (!applyIptablesRules([&] { return setStaticTwiceNaptIptablesRules(INSERT, interface, prototype, src, src_port, translated_src, translated_src_port,
+            dest, dest_port, translated_dest, translated_dest_port); }))
         {
             SWSS_LOG_ERROR("Failed to add Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -3831,11 +4107,11 @@ void NatMgr::removeStaticSingleNatIptables(const string &key)
     /* Remove Static NAT iptables rule */
     if (!setStaticNatIptablesRules(DELETE, interface, key, m_staticNatEntry[key].local_ip, m_staticNatEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to delete Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAT iptables rules to delete for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Deleted Static NAT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAT iptables rules to delete for %s", key.c_str());
     }
 }
 
@@ -3904,7 +4180,7 @@ void NatMgr::removeStaticTwiceNatIptables(const string &key)
         }
 
         /* Delete Static NAT iptables rule */
-        if (!setStaticTwiceNatIptablesRules(DELETE, interface, src, translated_src, dest, translated_dest))
+        if (!applyIptablesRules([&] { return setStaticTwiceNatIptablesRules(DELETE, interface, src, translated_src, dest, translated_dest); }))
         {
             SWSS_LOG_ERROR("Failed to delete Static Twice NAT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -4075,11 +4351,11 @@ void NatMgr::removeStaticSingleNaptIptables(const string &key)
                                     m_staticNaptEntry[key].local_ip, m_staticNaptEntry[key].local_port,
                                     m_staticNaptEntry[key].nat_type))
     {
-        SWSS_LOG_ERROR("Failed to delete Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_ERROR("Failed to queue the Static NAPT iptables rules to delete for %s", key.c_str());
     }
     else
     {
-        SWSS_LOG_INFO("Deleted Static NAPT iptables rules for %s", key.c_str());
+        SWSS_LOG_INFO("Queued the Static NAPT iptables rules to delete for %s", key.c_str());
     }
 }
 
@@ -4175,8 +4451,8 @@ void NatMgr::removeStaticTwiceNaptIptables(const string &key)
         }
 
         /* Delete Static NAPT iptables rule */
-        if (!setStaticTwiceNaptIptablesRules(DELETE, interface, prototype, src, src_port, translated_src, translated_src_port,
-                                             dest, dest_port, translated_dest, translated_dest_port))
+        if (!applyIptablesRules([&] { return setStaticTwiceNaptIptablesRules(DELETE, interface, prototype, src, src_port, translated_src, translated_src_port,
+                                                                             dest, dest_port, translated_dest, translated_dest_port); }))
         {
             SWSS_LOG_ERROR("Failed to delete Static Twice NAPT iptables rules for %s and %s", key.c_str(), (*it).first.c_str());
         }
@@ -4265,6 +4541,9 @@ void NatMgr::removeStaticTwiceNaptIptables(const string &key)
 /* To set conntrack for the Static NAT entries */
 void NatMgr::setStaticNatConntrackEntries(string mode)
 {
+    /* The entries are set for the rules queued so far, they are applied first */
+    commitIptablesRules();
+
     bool isEntryModified = false;
 
     /* Check the NAT is enabled, otherwise return */
@@ -4386,6 +4665,9 @@ void NatMgr::setStaticTwiceNatConntrackEntry(const string &key, string &mode)
 /* To set the conntrack for Static NAPT entries */
 void NatMgr::setStaticNaptConntrackEntries(string mode)
 {
+    /* The entries are set for the rules queued so far, they are applied first */
+    commitIptablesRules();
+
     bool isEntryModified = false;
 
     /* Check the NAT is enabled, otherwise return */
@@ -4563,7 +4845,7 @@ void NatMgr::setDynamicAllForwardOrAclbasedRules(const string &opCmd, const stri
                 setNaptPoolIpTable(opCmd, ip_range, port_range);
 
                 /* Set dynamic iptables rule with acls*/
-                if (!setDynamicNatIptablesRulesWithAcl(opCmd, pool_interface, ip_range, port_range, (*it).second, m_natBindingInfo[dynamicKey].static_key))
+                if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithAcl(opCmd, pool_interface, ip_range, port_range, (*it).second, m_natBindingInfo[dynamicKey].static_key); }))
                 {
                     SWSS_LOG_ERROR("Failed to %s dynamic iptables acl rules for Rule id %s for Table %s", opCmd == ADD ? "add" : "delete",
                                    aclRuleKeys[1].c_str(), aclId.c_str());
@@ -4606,7 +4888,7 @@ void NatMgr::setDynamicAllForwardOrAclbasedRules(const string &opCmd, const stri
         setNaptPoolIpTable(opCmd, ip_range, port_range);
 
         /* Set dynamic iptables rule without acls*/
-        if (!setDynamicNatIptablesRulesWithoutAcl(opCmd, pool_interface, ip_range, port_range, m_natBindingInfo[dynamicKey].static_key))
+        if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithoutAcl(opCmd, pool_interface, ip_range, port_range, m_natBindingInfo[dynamicKey].static_key); }))
         {
             SWSS_LOG_ERROR("Failed to %s dynamic iptables rules for %s", opCmd == ADD ? "add" : "delete", dynamicKey.c_str());
         }
@@ -4849,7 +5131,7 @@ void NatMgr::addDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(DELETE, ip_range);
 
                     /* Set dynamic iptables rule without acl */
-                    if (!setDynamicNatIptablesRulesWithoutAcl(DELETE, poolInterface, ip_range, port_range, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithoutAcl(DELETE, poolInterface, ip_range, port_range, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to remove dynamic iptables rules for %s", aclKey.c_str());
                     }
@@ -4873,7 +5155,7 @@ void NatMgr::addDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                 setDnatPoolfromNatPool(ADD, ip_range);
 
                 /* Set dynamic iptables rule with acls*/
-                if (!setDynamicNatIptablesRulesWithAcl(ADD, poolInterface, ip_range, port_range, m_natAclRuleInfo[aclKey], (*it).second.static_key))
+                if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithAcl(ADD, poolInterface, ip_range, port_range, m_natAclRuleInfo[aclKey], (*it).second.static_key); }))
                 {
                     SWSS_LOG_ERROR("Failed to add dynamic iptables acl rules for Rule id %s for Table %s", aclRuleId.c_str(), aclTableId.c_str());
                 }
@@ -4906,7 +5188,7 @@ void NatMgr::addDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(ADD, ip_range);
 
                     /* Add dynamic iptables rule with acls */
-                    if (!setDynamicNatIptablesRulesWithAcl(ADD, poolInterface, ip_range, port_range, (*it2).second, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithAcl(ADD, poolInterface, ip_range, port_range, (*it2).second, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to add dynamic iptables acl rules for Rule id %s for Table %s", aclRuleKeys[1].c_str(), aclTableId.c_str());
                     }
@@ -4928,7 +5210,7 @@ void NatMgr::addDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(DELETE, ip_range);
 
                     /* Delete dynamic iptables rule without acl */
-                    if (!setDynamicNatIptablesRulesWithoutAcl(DELETE, poolInterface, ip_range, port_range, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithoutAcl(DELETE, poolInterface, ip_range, port_range, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to remove dynamic iptables rules for %s", aclKey.c_str());
                     }
@@ -5049,7 +5331,7 @@ void NatMgr::removeDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                 setDnatPoolfromNatPool(DELETE, ip_range);
 
                 /* Delete dynamic iptables rule with acls*/
-                if (!setDynamicNatIptablesRulesWithAcl(DELETE, poolInterface, ip_range, port_range, m_natAclRuleInfo[aclKey], (*it).second.static_key))
+                if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithAcl(DELETE, poolInterface, ip_range, port_range, m_natAclRuleInfo[aclKey], (*it).second.static_key); }))
                 {
                     SWSS_LOG_ERROR("Failed to delete dynamic iptables acl rules for Rule id %s for Table %s", aclRuleId.c_str(), aclTableId.c_str());
                 }
@@ -5087,7 +5369,7 @@ void NatMgr::removeDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(ADD, ip_range);
 
                     /* Set dynamic iptables rule without acl */
-                    if (!setDynamicNatIptablesRulesWithoutAcl(ADD, poolInterface, ip_range, port_range, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithoutAcl(ADD, poolInterface, ip_range, port_range, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to add dynamic iptables rules for %s", aclKey.c_str());
                     }
@@ -5123,7 +5405,7 @@ void NatMgr::removeDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(DELETE, ip_range);
 
                     /* Delete dynamic iptables rule with acls */
-                    if (!setDynamicNatIptablesRulesWithAcl(DELETE, poolInterface, ip_range, port_range, (*it2).second, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithAcl(DELETE, poolInterface, ip_range, port_range, (*it2).second, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to delete dynamic iptables acl rules for Rule id %s for Table %s", aclRuleKeys[1].c_str(), aclTableId.c_str());
                     }
@@ -5145,7 +5427,7 @@ void NatMgr::removeDynamicNatRuleByAcl(const string &aclKey, bool isRuleId)
                     setDnatPoolfromNatPool(ADD, ip_range);
 
                     /* Add dynamic iptables rule without acl */
-                    if (!setDynamicNatIptablesRulesWithoutAcl(ADD, poolInterface, ip_range, port_range, (*it).second.static_key))
+                    if (!applyIptablesRules([&] { return setDynamicNatIptablesRulesWithoutAcl(ADD, poolInterface, ip_range, port_range, (*it).second.static_key); }))
                     {
                         SWSS_LOG_ERROR("Failed to add dynamic iptables rules for %s", aclKey.c_str());
                     }
@@ -8196,6 +8478,12 @@ void NatMgr::doTask(Consumer &consumer)
         SWSS_LOG_ERROR("Unknown config table %s ", table_name.c_str());
         throw runtime_error("NatMgr doTask failure.");
     }
+
+    size_t failed = commitIptablesRules();
+    if (failed)
+    {
+        SWSS_LOG_ERROR("%zu iptables rules of the %s update failed", failed, table_name.c_str());
+    }
 }
 
 /* To parse the timeout notifications */
@@ -26,6 +26,7 @@
 #include <unistd.h>
 #include <set>
 #include <map>
+#include <functional>
 #include <string>
 
 namespace swss {
@@ -125,6 +126,7 @@ namespace swss {
 #define NAT_ENTRY_REFRESH_PERIOD   86400    // 1 day
 #define REDIRECT_TO_DEV_NULL       " &> /dev/null"
 #define FLUSH                      " -F"
+#define IPTABLES_RULE_TAG          "natmgrd:"
 
 const char ip_address_delimiter = '/';
 
@@ -178,6 +180,16 @@ typedef struct{
     std::string ip_protocol;
 } natAclRule_t;
 
+/* Iptables rule queued for the iptables-restore transaction */
+typedef struct {
+    std::string table;
+    std::string opCmd;
+    std::string chain;
+    std::string spec;
+    std::string tag;
+    std::string owner;  /* Config the rule is for, in the failure logs */
+} natIptablesRule_t;
+
 /* Containers to store NAT Info */
 
 /* To store NAT Pool configuration,
@@ -251,6 +263,7 @@ public:
     void removeStaticNatIptables(const std::string port = NONE_STRING);
     void removeStaticNaptIptables(const std::string port = NONE_STRING);
     void removeDynamicNatRules(const std::string port = NONE_STRING, const std::string ipPrefix = NONE_STRING);
+    size_t commitIptablesRules(void);
 
 private:
     /* Declare APPL_DB, CFG_DB and STATE_DB tables */
@@ -276,6 +289,11 @@ private:
     natDnatPool_map_t        m_natDnatPoolInfo;
     SelectableTimer          *m_natRefreshTimer;
 
+    /* Iptables rules queued by the current doTask pass */
+    std::vector<natIptablesRule_t>                   m_pendingIptablesRules;
+    /* Rules left in the kernel by the previous natmgrd, by tag, not yet claimed by the config */
+    std::multimap<std::string, natIptablesRule_t>    m_staleIptablesRules;
+
     /* Declare doTask related functions */
     void doTask(Consumer &consumer);
     void doTask(SelectableTimer &timer);
@@ -366,6 +384,9 @@ private:
     bool isGlobalIpMatching(const std::string &intf_keys, const std::string &global_ip);
     bool getIpEnabledIntf(const std::string &global_ip, std::string &interface);
     void setNaptPoolIpTable(const std::string &opCmd, const std::string &nat_ip, const std::string &nat_port);
+    bool queueIptablesCmds(const std::string &cmds, const std::string &owner);
+    bool applyIptablesRules(const std::function<bool()> &setRules);
+    void loadIptablesRules(void);
     bool setFullConeDnatIptablesRule(const std::string &opCmd);
     bool setMangleIptablesRules(const std::string &opCmd, const std::string &interface, const std::string &nat_zone);
     bool setStaticNatIptablesRules(const std::string &opCmd, const std::string &interface, const std::string &external_ip, const std::string &internal_ip, const std::string &nat_type);
@@ -93,6 +93,10 @@ void cleanup()
         natmgr->removeDynamicNatRules();
 
         natmgr->cleanupMangleIpTables();
+        if (natmgr->commitIptablesRules())
+        {
+            SWSS_LOG_ERROR("Failed to remove all the NAT iptables rules");
+        }
         natmgr->cleanupPoolIpTable();
     }
 }
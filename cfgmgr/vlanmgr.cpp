@@ -1,4 +1,5 @@
 #include <string.h>
+#include <fstream>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -115,29 +116,43 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
     EXEC_WITH_ERROR_THROW(no_ll_learn_cmd, res);
 }
 
+/*
+ * Run the operations queued in m_kernelBatch. The first failed one throws
+ * like EXEC_WITH_ERROR_THROW() does for its command.
+ */
+void VlanMgr::commitKernelBatch()
+{
+    m_kernelBatch.commit();
+
+    for (size_t i = 0; i < m_kernelBatch.size(); i++)
+    {
+        if (!m_kernelBatch.isOk(i))
+        {
+            string error = m_kernelBatch.getError(i);
+            m_kernelBatch.clear();
+            throw runtime_error(error);
+        }
+    }
+    m_kernelBatch.clear();
+}
+
 bool VlanMgr::addHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
-    //               /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + BRIDGE_CMD + " vlan add vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self && "
-      + IP_CMD + " link add link " + DOT1Q_BRIDGE_NAME
-               + " up"
-               + " name " + VLAN_PREFIX + std::to_string(vlan_id)
-               + " address " + gMacAddress.to_string()
-               + " type vlan id " + std::to_string(vlan_id) + "\"";
+    string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    // Netlink equivalent of:
+    // /sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
+    // /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}
+    m_kernelBatch.clear();
+    m_kernelBatch.addBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), false, true);
+    m_kernelBatch.addVlanLink(DOT1Q_BRIDGE_NAME, vlan_alias, static_cast<uint16_t>(vlan_id), gMacAddress.to_string());
+    commitKernelBatch();
 
-    res.clear();
-    const std::string echo_cmd = std::string("")
-      + ECHO_CMD + " 0 > /proc/sys/net/ipv4/conf/" + VLAN_PREFIX + std::to_string(vlan_id) + "/arp_evict_nocarrier";
-    swss::exec(echo_cmd, res);
+    // echo 0 > /proc/sys/net/ipv4/conf/Vlan{{vlan_id}}/arp_evict_nocarrier, a failure is ignored
+    ofstream arp_evict_nocarrier("/proc/sys/net/ipv4/conf/" + vlan_alias + "/arp_evict_nocarrier");
+    arp_evict_nocarrier << "0" << endl;
 
     return true;
 }
@@ -146,16 +161,13 @@ bool VlanMgr::removeHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link del Vlan{{vlan_id}} &&
-    //               /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + IP_CMD + " link del " + VLAN_PREFIX + std::to_string(vlan_id) + " && "
-      + BRIDGE_CMD + " vlan del vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self\"";
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    // Netlink equivalent of:
+    // /sbin/ip link del Vlan{{vlan_id}} &&
+    // /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self
+    m_kernelBatch.clear();
+    m_kernelBatch.delLink(VLAN_PREFIX + std::to_string(vlan_id));
+    m_kernelBatch.delBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), true);
+    commitKernelBatch();
 
     return true;
 }
@@ -272,6 +284,38 @@ bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const str
     return true;
 }
 
+/*
+ * Netlink equivalent of addHostVlanMember(), queued in m_kernelBatch so that
+ * many members are added with a few syscalls. Returns the index of the first
+ * of the three operations.
+ */
+size_t VlanMgr::queueHostVlanMember(int vlan_id, const string &port_alias, const string& tagging_mode)
+{
+    SWSS_LOG_ENTER();
+
+    bool untagged = tagging_mode == "untagged" || tagging_mode == "priority_tagged";
+
+    size_t index = m_kernelBatch.setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+    m_kernelBatch.delBridgeVlan(port_alias, static_cast<uint16_t>(stoi(DEFAULT_VLAN_ID)));
+    m_kernelBatch.addBridgeVlan(port_alias, static_cast<uint16_t>(vlan_id), untagged);
+
+    return index;
+}
+
+bool VlanMgr::isHostVlanMemberAdded(size_t index)
+{
+    for (size_t i = index; i < index + 3; i++)
+    {
+        if (!m_kernelBatch.isOk(i))
+        {
+            SWSS_LOG_INFO("%s", m_kernelBatch.getError(i).c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
 {
     SWSS_LOG_ENTER();
@@ -590,8 +634,44 @@ void VlanMgr::processUntaggedVlanMembers(string vlan, const string &members)
     return;
 }
 
+void VlanMgr::setVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const string &port_alias,
+                                 const string &tagging_mode)
+{
+    string vlan_alias = VLAN_PREFIX + to_string(vlan_id);
+    string key = vlan_alias + DEFAULT_KEY_SEPARATOR + port_alias;
+    m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
+
+    vector<FieldValueTuple> fvVector;
+    FieldValueTuple s("state", "ok");
+    fvVector.push_back(s);
+    m_stateVlanMemberTable.set(kfvKey(t), fvVector);
+
+    m_vlanMemberReplay.erase(kfvKey(t));
+    m_PortVlanMember[port_alias][vlan_alias] = tagging_mode;
+}
+
 void VlanMgr::doVlanMemberTask(Consumer &consumer)
 {
+    struct PendingMember
+    {
+        SyncMap::iterator it;
+        int vlan_id;
+        string port_alias;
+        string tagging_mode;
+        size_t index;
+    };
+    vector<PendingMember> pendingMembers;
+    struct RemovedMember
+    {
+        string key;
+        int vlan_id;
+        string port_alias;
+        size_t index;
+    };
+    vector<RemovedMember> removedMembers;
+
+    m_kernelBatch.clear();
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -664,39 +744,20 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addHostVlanMember(vlan_id, port_alias, tagging_mode))
-            {
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
-
-                vector<FieldValueTuple> fvVector;
-                FieldValueTuple s("state", "ok");
-                fvVector.push_back(s);
-                m_stateVlanMemberTable.set(kfvKey(t), fvVector);
-
-                m_vlanMemberReplay.erase(kfvKey(t));
-                m_PortVlanMember[port_alias][vlan_alias] = tagging_mode;
-            }
-            else
-            {
-                SWSS_LOG_INFO("Netdevice for  %s not ready, delaying", kfvKey(t).c_str());
-                it++;
-                continue;
-            }
+            /* Programmed together with the other members once the loop is done */
+            pendingMembers.push_back(PendingMember{it, vlan_id, port_alias, tagging_mode,
+                                                   queueHostVlanMember(vlan_id, port_alias, tagging_mode)});
+            it++;
+            continue;
         }
         else if (op == DEL_COMMAND)
         {
             if (isVlanMemberStateOk(kfvKey(t)))
             {
-                removeHostVlanMember(vlan_id, port_alias);
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.del(key);
-                m_stateVlanMemberTable.del(kfvKey(t));
-                m_PortVlanMember[port_alias].erase(vlan_alias);
+                /* Removed together with the other members once the loop is done */
+                removedMembers.push_back(RemovedMember{kfvKey(t), vlan_id, port_alias,
+                                                       m_kernelBatch.delBridgeVlan(port_alias,
+                                                                                   static_cast<uint16_t>(vlan_id))});
             }
             else
             {
@@ -711,6 +772,82 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         /* Other than the case of member port/lag is not ready, no retry will be performed */
         it = consumer.m_toSync.erase(it);
     }
+
+    if (!pendingMembers.empty() || !removedMembers.empty())
+    {
+        m_kernelBatch.commit();
+    }
+
+    for (auto &member : pendingMembers)
+    {
+        /*
+         * Members the batch failed to add go through the shell commands,
+         * which also report the error as before.
+         */
+        if (isHostVlanMemberAdded(member.index) ||
+            addHostVlanMember(member.vlan_id, member.port_alias, member.tagging_mode))
+        {
+            setVlanMemberState(member.it->second, member.vlan_id, member.port_alias, member.tagging_mode);
+            consumer.m_toSync.erase(member.it);
+        }
+        else
+        {
+            SWSS_LOG_INFO("Netdevice for  %s not ready, delaying", kfvKey(member.it->second).c_str());
+        }
+    }
+
+    /*
+     * As removeHostVlanMember() does, a port left without any VLAN is detached
+     * from the bridge. Members the batch failed to remove go through it.
+     */
+    set<string> detachPorts;
+    for (auto &member : removedMembers)
+    {
+        if (m_kernelBatch.isOk(member.index))
+        {
+            detachPorts.insert(member.port_alias);
+        }
+        else
+        {
+            SWSS_LOG_INFO("%s", m_kernelBatch.getError(member.index).c_str());
+            removeHostVlanMember(member.vlan_id, member.port_alias);
+        }
+
+        string vlan_alias = VLAN_PREFIX + to_string(member.vlan_id);
+        m_appVlanMemberTableProducer.del(vlan_alias + DEFAULT_KEY_SEPARATOR + member.port_alias);
+        m_stateVlanMemberTable.del(member.key);
+        m_PortVlanMember[member.port_alias].erase(vlan_alias);
+    }
+    m_kernelBatch.clear();
+
+    if (!detachPorts.empty())
+    {
+        set<string> vlanPorts;
+        bool dumped = m_kernelBatch.getBridgeVlanPorts(vlanPorts);
+        if (!dumped)
+        {
+            SWSS_LOG_INFO("Bridge VLANs not available, detaching ports by the configured members");
+        }
+
+        for (auto &port_alias : detachPorts)
+        {
+            if (dumped ? !vlanPorts.count(port_alias) : m_PortVlanMember[port_alias].empty())
+            {
+                m_kernelBatch.setLinkMaster(port_alias, "");
+            }
+        }
+
+        m_kernelBatch.commit();
+        for (size_t i = 0; i < m_kernelBatch.size(); i++)
+        {
+            if (!m_kernelBatch.isOk(i))
+            {
+                SWSS_LOG_ERROR("%s", m_kernelBatch.getError(i).c_str());
+            }
+        }
+        m_kernelBatch.clear();
+    }
+
     if (!replayDone && m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
     {
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netlinkbatch.h"
 
 #include <set>
 #include <map>
@@ -29,18 +30,24 @@ private:
     std::set<std::string> m_vlanMemberReplay;
     bool replayDone;
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_PortVlanMember;
-    
+    NetlinkBatch m_kernelBatch;
+
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
     void doVlanMemberTask(Consumer &consumer);
     void processUntaggedVlanMembers(std::string vlan, const std::string &members);
 
+    void commitKernelBatch();
     bool addHostVlan(int vlan_id);
     bool removeHostVlan(int vlan_id);
     bool setHostVlanAdminState(int vlan_id, const std::string &admin_status);
     bool setHostVlanMtu(int vlan_id, uint32_t mtu);
     bool setHostVlanMac(int vlan_id, const std::string &mac);
     bool addHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
+    size_t queueHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
+    bool isHostVlanMemberAdded(size_t index);
+    void setVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const std::string &port_alias,
+                            const std::string &tagging_mode);
     bool removeHostVlanMember(int vlan_id, const std::string &port_alias);
     bool isMemberStateOk(const std::string &alias);
     bool isVlanStateOk(const std::string &alias);
@@ -1,4 +1,5 @@
 #include <string>
+#include <chrono>
 #include <netinet/in.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
@@ -102,19 +103,34 @@ void FdbSync::processCfgEvpnNvo()
 
 void FdbSync::updateAllLocalMac()
 {
+    NetlinkBatch batch;
+    string op = m_isEvpnNvoExist ? "replace" : "del";
+
+    auto start = chrono::steady_clock::now();
     for ( auto it = m_fdb_mac.begin(); it != m_fdb_mac.end(); ++it )
     {
-        if (m_isEvpnNvoExist)
-        {
-            /* Add the Local FDB entry into Kernel */
-            addLocalMac(it->first, "replace");
-        }
-        else
+        /* Add the Local FDB entries into Kernel, or delete them from Kernel */
+        addLocalMac(batch, it->first, op);
+    }
+
+    if (batch.size() == 0)
+    {
+        return;
+    }
+
+    size_t failed = batch.commit();
+    for (size_t i = 0; failed != 0 && i < batch.size(); i++)
+    {
+        if (!batch.isOk(i))
         {
-            /* Delete the Local FDB entry from Kernel */
-            addLocalMac(it->first, "del");
+            SWSS_LOG_INFO("Failed %s", batch.getError(i).c_str());
         }
     }
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    SWSS_LOG_NOTICE("Local MAC %s of %zu entries took %.3f s, %zu failed (%.0f MACs/s)",
+                    op.c_str(), batch.size(), elapsed, failed,
+                    elapsed > 0 ? static_cast<double>(batch.size()) / elapsed : 0);
 }
 
 void FdbSync::processStateFdb()
@@ -354,9 +370,9 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
     return;
 }
 
-void FdbSync::addLocalMac(string key, string op)
+void FdbSync::addLocalMac(NetlinkBatch &batch, string key, string op)
 {
-    char *type;
+    NetlinkBatch::FdbType type;
     string port_name = "";
     string mac = "";
     string vlan = "";
@@ -384,25 +400,22 @@ void FdbSync::addLocalMac(string key, string op)
 
         if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
         {
-            type = "dynamic extern_learn";
+            type = NetlinkBatch::FDB_DYNAMIC_EXT_LEARN;
         }
         else
         {
-            type = "static";
+            type = NetlinkBatch::FDB_STATIC;
         }
 
-        const std::string cmds = std::string("")
-                + " bridge fdb " + op + " " + mac + " dev "
-                + port_name + " master " + type  + " vlan " + vlan;
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
+        uint16_t vid = static_cast<uint16_t>(atoi(vlan.c_str()));
+        if (op == "replace")
         {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+            batch.replaceFdb(port_name, mac, vid, type);
+        }
+        else
+        {
+            batch.delFdb(port_name, mac, vid, type);
         }
-
-        SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
     }
     return;
 }
@@ -8,6 +8,7 @@
 #include "subscriberstatetable.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
+#include "lib/netlinkbatch.h"
 
 /*
  * Default timer interval for fdbsyncd reconcillation 
@@ -145,7 +146,8 @@ private:
     };
     std::unordered_map<int, intf> m_intf_info;
 
-    void addLocalMac(std::string key, std::string op);
+    /* Queue the kernel update of a local MAC on batch */
+    void addLocalMac(NetlinkBatch &batch, std::string key, std::string op);
     void macAddVxlan(std::string key, struct in_addr vtep, std::string type, uint32_t vni, std::string intf_name);
     void macDelVxlan(std::string auxkey);
     void macDelVxlanDB(std::string key);
@@ -268,28 +268,34 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
          */
         bool isRaw = isRawProcessing(nl_hdr);
 
-        nl_msg *msg = nlmsg_convert(nl_hdr);
-        if (msg == NULL)
-        {
-            throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
-        }
-
-        nlmsg_set_proto(msg, NETLINK_ROUTE);
-
         if (isRaw)
         {
             /* EVPN Type5 Add route processing */
             processRawMsg(nl_hdr);
+            continue;
         }
 	else if(nl_hdr->nlmsg_type == RTM_NEWNEXTHOP || nl_hdr->nlmsg_type == RTM_DELNEXTHOP)
         {
             /* rtnl api dont support RTM_NEWNEXTHOP/RTM_DELNEXTHOP yet. Processing as raw message*/
             processRawMsg(nl_hdr);
+            continue;
         }
-        else
+
+        /* Plain routes are decoded in place, without a libnl route object */
+        if (m_routesync->isRawRouteDecodeEnabled() && m_routesync->onRouteMsgFast(nl_hdr))
         {
-            NetDispatcher::getInstance().onNetlinkMessage(msg);
+            continue;
         }
+
+        nl_msg *msg = nlmsg_convert(nl_hdr);
+        if (msg == NULL)
+        {
+            throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+        }
+
+        nlmsg_set_proto(msg, NETLINK_ROUTE);
+
+        NetDispatcher::getInstance().onNetlinkMessage(msg);
         nlmsg_free(msg);
     }
 }
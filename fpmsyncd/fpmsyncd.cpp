@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <iostream>
 #include <inttypes.h>
 #include "logger.h"
@@ -25,6 +26,18 @@ static int gFlushTimeout = FLUSH_TIMEOUT;
 // consider the traffic is small if pipeline contains < 500 entries
 #define SMALL_TRAFFIC 500
 
+/*
+ * Route updates are held for up to ROUTE_FLUSH_INTERVAL milliseconds, or until
+ * ROUTE_FLUSH_THRESHOLD prefixes are dirty, so that a flapping prefix is
+ * written once with its final state.
+ */
+#define ROUTE_FLUSH_INTERVAL 50
+#define ROUTE_FLUSH_THRESHOLD 1000
+// route writer counters are published to COUNTERS_DB every 10 seconds
+#define ROUTE_STATS_INTERVAL 10
+#define COUNTERS_FPMSYNCD_ROUTE_TABLE "FPMSYNCD_ROUTE_STATS"
+#define ROUTE_STATS_KEY "ROUTE_WRITER"
+
 /**
  * @brief fpmsyncd invokes redispipeline's flush with a timer
  * 
@@ -69,10 +82,48 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
     return true;
 }
 
+void usage()
+{
+    cout << "Usage: fpmsyncd [-i flush_interval] [-b flush_threshold]" << endl;
+    cout << "       -i flush_interval: milliseconds a route update is held to merge further updates of the" << endl;
+    cout << "                          same prefix, 0 writes updates right away (default " << ROUTE_FLUSH_INTERVAL << ")" << endl;
+    cout << "       -b flush_threshold: number of pending prefixes which triggers a flush before" << endl;
+    cout << "                           flush_interval expires (default " << ROUTE_FLUSH_THRESHOLD << ")" << endl;
+}
+
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
 
+    int opt;
+    long flushInterval = ROUTE_FLUSH_INTERVAL;
+    long flushThreshold = ROUTE_FLUSH_THRESHOLD;
+
+    while ((opt = getopt(argc, argv, "i:b:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'i':
+            flushInterval = atol(optarg);
+            break;
+        case 'b':
+            flushThreshold = atol(optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (flushInterval < 0 || flushThreshold <= 0)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
     const auto routeResponseChannelName = std::string("APPL_DB_") + APP_ROUTE_TABLE_NAME + "_RESPONSE_CHANNEL";
 
     DBConnector db("APPL_DB", 0);
@@ -83,7 +134,20 @@ int main(int argc, char **argv)
     std::unique_ptr<NotificationConsumer> routeResponseChannel;
 
     RedisPipeline pipeline(&db, ROUTE_SYNC_PPL_SIZE);
-    RouteSync sync(&pipeline);
+
+    /*
+     * Routes are written to APPL_DB by a dedicated thread, so it needs its
+     * own connection and pipeline. The FPM loop below only decodes messages
+     * and queues the resulting updates.
+     */
+    DBConnector routeDb("APPL_DB", 0);
+    RedisPipeline routePipeline(&routeDb, ROUTE_SYNC_PPL_SIZE);
+    RouteSync sync(&pipeline, &routePipeline);
+    sync.getRouteWriter()->setFlushPolicy(static_cast<size_t>(flushThreshold),
+                                          std::chrono::milliseconds(flushInterval));
+
+    DBConnector countersDb("COUNTERS_DB", 0);
+    Table routeStatsTable(&countersDb, COUNTERS_FPMSYNCD_ROUTE_TABLE);
 
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
@@ -97,6 +161,8 @@ int main(int argc, char **argv)
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &sync);
 
+    sync.setRawRouteDecodeEnabled(true);
+
     rtnl_route_read_protocol_names(DefaultRtProtoPath);
     nlmsg_set_default_size(FPM_MAX_MSG_LEN);
 
@@ -120,6 +186,7 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            SelectableTimer routeStatsTimer(timespec{ROUTE_STATS_INTERVAL, 0});
            
             /*
              * Pipeline should be flushed right away to deal with state pending
@@ -134,14 +201,22 @@ int main(int argc, char **argv)
             s.addSelectable(&fpm);
             s.addSelectable(&netlink);
             s.addSelectable(&deviceMetadataTableSubscriber);
+            s.addSelectable(&routeStatsTimer);
+            routeStatsTimer.start();
 
             if (sync.isSuppressionEnabled())
             {
                 s.addSelectable(routeResponseChannel.get());
             }
 
-            /* If warm-restart feature is enabled, execute 'restoration' logic */
-            bool warmStartEnabled = sync.getWarmStartHelper().checkAndStart();
+            /*
+             * If warm-restart feature is enabled, execute 'restoration' logic.
+             * Starting the cycle clears ROUTE_TABLE, owned by the route writer.
+             */
+            bool warmStartEnabled = false;
+            sync.getRouteWriter()->runExclusive([&] {
+                warmStartEnabled = sync.getWarmStartHelper().checkAndStart();
+            });
             if (warmStartEnabled)
             {
                 /* Obtain warm-restart timer defined for routing application */
@@ -240,6 +315,10 @@ int main(int argc, char **argv)
                         s.removeSelectable(&eoiuCheckTimer);
                     }
                 }
+                else if (temps == &routeStatsTimer)
+                {
+                    routeStatsTable.set(ROUTE_STATS_KEY, sync.getRouteWriter()->getStats());
+                }
                 else if (temps == &deviceMetadataTableSubscriber)
                 {
                     std::deque<KeyOpFieldsValuesTuple> keyOpFvsQueue;
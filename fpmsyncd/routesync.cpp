@@ -145,12 +145,12 @@ static decltype(auto) makeNlAddr(const T& ip)
 }
 
 
-RouteSync::RouteSync(RedisPipeline *pipeline) :
+RouteSync::RouteSync(RedisPipeline *pipeline, RedisPipeline *routePipeline) :
     // When the feature ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED is enabled, route events must be sent to orchagent via the ZMQ channel.
     m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED, false)),
-    m_routeTable(createProducerStateTable(pipeline, APP_ROUTE_TABLE_NAME, true, m_zmqClient)),
+    m_routeTable(createProducerStateTable(routePipeline ? routePipeline : pipeline, APP_ROUTE_TABLE_NAME, true, m_zmqClient)),
     m_nexthop_groupTable(pipeline, APP_NEXTHOP_GROUP_TABLE_NAME, true),
-    m_label_routeTable(createProducerStateTable(pipeline, APP_LABEL_ROUTE_TABLE_NAME, true, m_zmqClient)),
+    m_label_routeTable(createProducerStateTable(routePipeline ? routePipeline : pipeline, APP_LABEL_ROUTE_TABLE_NAME, true, m_zmqClient)),
     m_vnet_routeTable(pipeline, APP_VNET_RT_TABLE_NAME, true),
     m_vnet_tunnelTable(pipeline, APP_VNET_RT_TUNNEL_TABLE_NAME, true),
     m_warmStartHelper(pipeline, m_routeTable.get(), APP_ROUTE_TABLE_NAME, "bgp", "bgp"),
@@ -161,6 +161,20 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
     rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+
+    if (routePipeline)
+    {
+        m_routeWriter = make_unique<RouteWriter>(routePipeline);
+        m_routeWriter->start();
+    }
+}
+
+RouteSync::~RouteSync()
+{
+    if (m_routeWriter)
+    {
+        m_routeWriter->stop();
+    }
 }
 
 void RouteSync::setRouteWithWarmRestart(const std::string& key,
@@ -170,7 +184,11 @@ void RouteSync::setRouteWithWarmRestart(const std::string& key,
 {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
 
-    if (!warmRestartInProgress)
+    if (!warmRestartInProgress && m_routeWriter)
+    {
+        m_routeWriter->push(table.get(), key, cmd, fvVector);
+    }
+    else if (!warmRestartInProgress)
     {
         if (cmd == SET_COMMAND)
         {
@@ -1621,39 +1639,13 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     string mpls_list;
     string weights;
 
-    string nhg_id_key;
     uint32_t nhg_id = rtnl_route_get_nh_id(route_obj);
     if(nhg_id)
     {
-        const auto itg = m_nh_groups.find(nhg_id);
-        if(itg == m_nh_groups.end())
+        if (!getNextHopGroupRouteFields(nhg_id, rtnl_route_get_family(route_obj), destipprefix, fvVector))
         {
-            SWSS_LOG_ERROR("NextHop group id %d not found. Dropping the route %s", nhg_id, destipprefix);
             return;
         }
-        NextHopGroup& nhg = itg->second;
-        if(nhg.group.size() == 0)
-        {
-        // Using route-table only for single next-hop
-        string nexthops = nhg.nexthop.empty() ? (rtnl_route_get_family(route_obj) == AF_INET ? "0.0.0.0" : "::") : nhg.nexthop;
-        string ifnames, weights;
-
-        getNextHopGroupFields(nhg, nexthops, ifnames, weights, rtnl_route_get_family(route_obj));
-
-        FieldValueTuple gw("nexthop", nexthops.c_str());
-        FieldValueTuple intf("ifname", ifnames.c_str());
-        fvVector.push_back(gw);
-        fvVector.push_back(intf);
-
-        SWSS_LOG_DEBUG("NextHop group id %d is a single nexthop address. Filling the route table %s with nexthop and ifname", nhg_id, destipprefix);
-        }
-        else
-        {
-            nhg_id_key = getNextHopGroupKeyAsString(nhg_id);
-            FieldValueTuple nhg("nexthop_group", nhg_id_key.c_str());
-            fvVector.push_back(nhg);
-            installNextHopGroup(nhg_id);
-        }
 
         fvVector.push_back(proto);
 
@@ -1737,6 +1729,321 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     }
 }
 
+/*
+ * Fill the fields of a route using next hop group nhg_id
+ * @arg nhg_id          Next hop group id
+ * @arg af              Address family of the route
+ * @arg destipprefix    Route key, for logging
+ * @arg fvVector        (output) Route fields
+ *
+ * Return false if the next hop group is unknown
+ */
+bool RouteSync::getNextHopGroupRouteFields(uint32_t nhg_id, uint8_t af, const char *destipprefix,
+                                           vector<FieldValueTuple>& fvVector)
+{
+    const auto itg = m_nh_groups.find(nhg_id);
+    if(itg == m_nh_groups.end())
+    {
+        SWSS_LOG_ERROR("NextHop group id %d not found. Dropping the route %s", nhg_id, destipprefix);
+        return false;
+    }
+
+    NextHopGroup& nhg = itg->second;
+    if(nhg.group.size() == 0)
+    {
+        // Using route-table only for single next-hop
+        string nexthops, ifnames, weights;
+
+        getNextHopGroupFields(nhg, nexthops, ifnames, weights, af);
+
+        fvVector.emplace_back("nexthop", nexthops);
+        fvVector.emplace_back("ifname", ifnames);
+
+        SWSS_LOG_DEBUG("NextHop group id %d is a single nexthop address. Filling the route table %s with nexthop and ifname", nhg_id, destipprefix);
+    }
+    else
+    {
+        fvVector.emplace_back("nexthop_group", getNextHopGroupKeyAsString(nhg_id));
+        installNextHopGroup(nhg_id);
+    }
+
+    return true;
+}
+
+/*
+ * Handle regular route straight from the netlink message
+ * @arg h               Netlink message
+ *
+ * Covers IPv4/IPv6 unicast and blackhole routes, in the default VRF or in a
+ * VRF, with plain, ECMP or next hop group next hops. The route is decoded into
+ * scratch buffers reused across messages, and written exactly as onRouteMsg()
+ * would write it.
+ *
+ * Return false if the message must go through libnl (onMsg) instead
+ */
+bool RouteSync::onRouteMsgFast(struct nlmsghdr *h)
+{
+    if (h->nlmsg_type != RTM_NEWROUTE && h->nlmsg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    if (len < 0)
+    {
+        return false;
+    }
+
+    struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+    size_t addr_len;
+
+    if (rtm->rtm_family == AF_INET)
+    {
+        addr_len = IPV4_MAX_BYTE;
+    }
+    else if (rtm->rtm_family == AF_INET6)
+    {
+        addr_len = IPV6_MAX_BYTE;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (rtm->rtm_dst_len > addr_len * 8)
+    {
+        return false;
+    }
+
+    struct rtattr *tb[RTA_MAX + 1] = {0};
+    netlink_parse_rtattr(tb, RTA_MAX, RTM_RTA(rtm), len);
+
+    /* Encapsulated and MPLS next hops are left to libnl */
+    if (tb[RTA_ENCAP] || tb[RTA_ENCAP_TYPE] || tb[RTA_VIA] || tb[RTA_NEWDST])
+    {
+        return false;
+    }
+
+    /* libnl keys a route without RTA_DST as "none", keep that on the libnl path */
+    if (!tb[RTA_DST] || RTA_PAYLOAD(tb[RTA_DST]) != addr_len)
+    {
+        return false;
+    }
+
+    char destipprefix[IFNAMSIZ + MAX_ADDR_SIZE + 2] = {0};
+    size_t pos = 0;
+
+    unsigned int table = tb[RTA_TABLE] ? *(uint32_t *)RTA_DATA(tb[RTA_TABLE]) : rtm->rtm_table;
+    if (table)
+    {
+        char master_name[IFNAMSIZ] = {0};
+        getIfName(table, master_name, IFNAMSIZ);
+
+        /* VNET, management VRF and invalid VRF routes are handled by onMsg() */
+        if (strncmp(master_name, VRF_PREFIX, strlen(VRF_PREFIX)))
+        {
+            return false;
+        }
+
+        pos = strlen(master_name);
+        memcpy(destipprefix, master_name, pos);
+        destipprefix[pos++] = ':';
+    }
+
+    inet_ntop(rtm->rtm_family, RTA_DATA(tb[RTA_DST]), destipprefix + pos, MAX_ADDR_SIZE);
+    if (rtm->rtm_dst_len != addr_len * 8)
+    {
+        pos = strlen(destipprefix);
+        snprintf(destipprefix + pos, sizeof(destipprefix) - pos, "/%u", rtm->rtm_dst_len);
+    }
+
+    vector<FieldValueTuple> &fvVector = m_rawFvVector;
+    fvVector.clear();
+
+    if (h->nlmsg_type == RTM_DELROUTE)
+    {
+        setRouteWithWarmRestart(destipprefix, fvVector, m_routeTable, DEL_COMMAND);
+        SWSS_LOG_INFO("RouteTable del msg: %s", destipprefix);
+        return true;
+    }
+
+    /* Only read the next hops once we know they are needed */
+    uint32_t nhg_id = tb[RTA_NH_ID] ? *(uint32_t *)RTA_DATA(tb[RTA_NH_ID]) : 0;
+    if (rtm->rtm_type == RTN_UNICAST && !nhg_id && !decodeNextHops(rtm, tb, addr_len))
+    {
+        return false;
+    }
+
+    if (!isSuppressionEnabled())
+    {
+        sendOffloadReply(h);
+    }
+    FieldValueTuple proto("protocol", getProtocolString(rtm->rtm_protocol));
+
+    switch (rtm->rtm_type)
+    {
+        case RTN_BLACKHOLE:
+        {
+            fvVector.emplace_back("blackhole", "true");
+            fvVector.push_back(proto);
+            setRouteWithWarmRestart(destipprefix, fvVector, m_routeTable, SET_COMMAND);
+            SWSS_LOG_INFO("RouteTable set blackhole msg: %s", destipprefix);
+            return true;
+        }
+        case RTN_UNICAST:
+            break;
+
+        case RTN_MULTICAST:
+        case RTN_BROADCAST:
+        case RTN_LOCAL:
+            SWSS_LOG_INFO("BUM routes aren't supported yet (%s)", destipprefix);
+            return true;
+
+        default:
+            return true;
+    }
+
+    if (nhg_id)
+    {
+        if (!getNextHopGroupRouteFields(nhg_id, rtm->rtm_family, destipprefix, fvVector))
+        {
+            return true;
+        }
+
+        fvVector.push_back(proto);
+        setRouteWithWarmRestart(destipprefix, fvVector, m_routeTable, SET_COMMAND);
+        SWSS_LOG_INFO("RouteTable set msg with NHG: %s nhg_id:%d", destipprefix, nhg_id);
+        return true;
+    }
+
+    /* Skip routes to eth0 or docker0, see onRouteMsg() */
+    if (m_rawNextHopCount == 1 && (m_rawIntfList == "eth0" || m_rawIntfList == "docker0"))
+    {
+        SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
+                    destipprefix, m_rawGwList.c_str(), m_rawIntfList.c_str());
+        setRouteWithWarmRestart(destipprefix, fvVector, m_routeTable, DEL_COMMAND);
+        SWSS_LOG_INFO("RouteTable del msg for eth0/docker0 route: %s", destipprefix);
+        return true;
+    }
+
+    fvVector.push_back(proto);
+    fvVector.emplace_back("nexthop", m_rawGwList);
+    fvVector.emplace_back("ifname", m_rawIntfList);
+    fvVector.emplace_back("weight", m_rawWeights);
+
+    setRouteWithWarmRestart(destipprefix, fvVector, m_routeTable, SET_COMMAND);
+    SWSS_LOG_INFO("RouteTable set msg: %s nexthop:%s ifname:%s mpls:na weight:%s",
+                  destipprefix, m_rawGwList.c_str(), m_rawIntfList.c_str(), m_rawWeights.c_str());
+    return true;
+}
+
+/*
+ * Append one next hop to the scratch next hop lists
+ * @arg family      Address family of the route
+ * @arg gateway     RTA_GATEWAY attribute, may be NULL
+ * @arg if_index    Next hop interface index
+ * @arg weight      Next hop weight, 0 means the default weight of 1
+ */
+void RouteSync::appendNextHop(uint8_t family, struct rtattr *gateway,
+                              unsigned int if_index, uint8_t weight)
+{
+    if (m_rawNextHopCount++)
+    {
+        m_rawGwList += NHG_DELIMITER;
+        m_rawIntfList += NHG_DELIMITER;
+        m_rawWeights += NHG_DELIMITER;
+    }
+
+    char buf[MAX_ADDR_SIZE + 1] = {0};
+    if (gateway)
+    {
+        inet_ntop(family, RTA_DATA(gateway), buf, MAX_ADDR_SIZE);
+        m_rawGwList += buf;
+    }
+    else
+    {
+        m_rawGwList += family == AF_INET6 ? "::" : "0.0.0.0";
+    }
+
+    char if_name[IFNAMSIZ] = "0";
+    m_rawIntfList += getIfName(if_index, if_name, IFNAMSIZ) ? if_name : "unknown";
+
+    snprintf(buf, sizeof(buf), "%u", weight ? weight : 1);
+    m_rawWeights += buf;
+}
+
+/*
+ * Decode the next hops of a unicast route into the scratch next hop lists
+ * @arg rtm         Route message
+ * @arg tb          Parsed route attributes
+ * @arg addr_len    Address length of the route family
+ *
+ * Return false if a next hop needs libnl
+ */
+bool RouteSync::decodeNextHops(struct rtmsg *rtm, struct rtattr **tb, size_t addr_len)
+{
+    m_rawGwList.clear();
+    m_rawIntfList.clear();
+    m_rawWeights.clear();
+    m_rawNextHopCount = 0;
+
+    if (tb[RTA_GATEWAY] && RTA_PAYLOAD(tb[RTA_GATEWAY]) != addr_len)
+    {
+        return false;
+    }
+
+    if (!tb[RTA_MULTIPATH])
+    {
+        if (!tb[RTA_GATEWAY] && !tb[RTA_OIF])
+        {
+            return false;
+        }
+
+        appendNextHop(rtm->rtm_family, tb[RTA_GATEWAY],
+                      tb[RTA_OIF] ? *(uint32_t *)RTA_DATA(tb[RTA_OIF]) : 0, 0);
+        return true;
+    }
+
+    /* libnl merges RTA_GATEWAY/RTA_OIF into the multipath list */
+    if (tb[RTA_GATEWAY] || tb[RTA_OIF])
+    {
+        return false;
+    }
+
+    struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(tb[RTA_MULTIPATH]);
+    int len = (int)RTA_PAYLOAD(tb[RTA_MULTIPATH]);
+    struct rtattr *subtb[RTA_MAX + 1];
+
+    while (len >= (int)sizeof(*rtnh) && rtnh->rtnh_len <= len)
+    {
+        if (rtnh->rtnh_len < sizeof(*rtnh))
+        {
+            return false;
+        }
+
+        memset(subtb, 0, sizeof(subtb));
+        netlink_parse_rtattr(subtb, RTA_MAX, RTNH_DATA(rtnh),
+                             (int)(rtnh->rtnh_len - sizeof(*rtnh)));
+
+        if (subtb[RTA_ENCAP] || subtb[RTA_ENCAP_TYPE] || subtb[RTA_VIA] || subtb[RTA_NEWDST])
+        {
+            return false;
+        }
+
+        if (subtb[RTA_GATEWAY] && RTA_PAYLOAD(subtb[RTA_GATEWAY]) != addr_len)
+        {
+            return false;
+        }
+
+        appendNextHop(rtm->rtm_family, subtb[RTA_GATEWAY], rtnh->rtnh_ifindex, rtnh->rtnh_hops);
+
+        len -= NLMSG_ALIGN(rtnh->rtnh_len);
+        rtnh = RTNH_NEXT(rtnh);
+    }
+
+    return m_rawNextHopCount > 0;
+}
+
 /*
  * Handle Nexthop msg
  * @arg nlmsghdr      Netlink messaged
@@ -2524,6 +2831,11 @@ void RouteSync::markRoutesOffloaded(swss::DBConnector& db)
 {
     SWSS_LOG_ENTER();
 
+    if (m_routeWriter)
+    {
+        m_routeWriter->drain();
+    }
+
     sendOffloadReply(db, APP_ROUTE_TABLE_NAME);
 }
 
@@ -2538,7 +2850,15 @@ void RouteSync::onWarmStartEnd(DBConnector& applStateDb)
 
     if (m_warmStartHelper.inProgress())
     {
-        m_warmStartHelper.reconcile();
+        /* Reconciliation writes ROUTE_TABLE, which the writer thread owns */
+        if (m_routeWriter)
+        {
+            m_routeWriter->runExclusive([this] { m_warmStartHelper.reconcile(); });
+        }
+        else
+        {
+            m_warmStartHelper.reconcile();
+        }
         SWSS_LOG_NOTICE("Warm-Restart reconciliation processed.");
     }
 }
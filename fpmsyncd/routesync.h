@@ -8,6 +8,7 @@
 #include "netmsg.h"
 #include "linkcache.h"
 #include "fpminterface.h"
+#include "routewriter.h"
 #include "warmRestartHelper.h"
 #include <string.h>
 #include <bits/stdc++.h>
@@ -47,12 +48,30 @@ class RouteSync : public NetMsg
 public:
     enum { MAX_ADDR_SIZE = 64 };
 
-    RouteSync(RedisPipeline *pipeline);
+    /*
+     * When routePipeline is given, ROUTE_TABLE and LABEL_ROUTE_TABLE are bound
+     * to it and written from a RouteWriter thread instead of the caller's.
+     */
+    RouteSync(RedisPipeline *pipeline, RedisPipeline *routePipeline = nullptr);
+    ~RouteSync();
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
 
+    /* Handle regular route without libnl, returns false if not supported */
+    bool onRouteMsgFast(struct nlmsghdr *h);
+
+    void setRawRouteDecodeEnabled(bool enabled)
+    {
+        m_isRawRouteDecodeEnabled = enabled;
+    }
+
+    bool isRawRouteDecodeEnabled() const
+    {
+        return m_isRawRouteDecodeEnabled;
+    }
+
     void setSuppressionEnabled(bool enabled);
 
     bool isSuppressionEnabled() const
@@ -86,6 +105,11 @@ public:
         return m_warmStartHelper;
     }
 
+    RouteWriter* getRouteWriter()
+    {
+        return m_routeWriter.get();
+    }
+
 private:
     /* ZMQ client */
     shared_ptr<ZmqClient> m_zmqClient;
@@ -109,12 +133,32 @@ private:
     ProducerStateTable  m_nexthop_groupTable;
     map<uint32_t,NextHopGroup> m_nh_groups;
 
+    /* Writer of m_routeTable and m_label_routeTable, if pipelined */
+    unique_ptr<RouteWriter> m_routeWriter;
+
     bool                m_isSuppressionEnabled{false};
+    bool                m_isRawRouteDecodeEnabled{false};
     FpmInterface*       m_fpmInterface {nullptr};
 
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
+    /* Scratch buffers of onRouteMsgFast(), reused across messages */
+    vector<FieldValueTuple> m_rawFvVector;
+    string m_rawGwList;
+    string m_rawIntfList;
+    string m_rawWeights;
+    size_t m_rawNextHopCount{0};
+
+    /* Decode next hops of a raw unicast route into the scratch buffers */
+    bool decodeNextHops(struct rtmsg *rtm, struct rtattr **tb, size_t addr_len);
+    void appendNextHop(uint8_t family, struct rtattr *gateway,
+                       unsigned int if_index, uint8_t weight);
+
+    /* Fill route fields from next hop group */
+    bool getNextHopGroupRouteFields(uint32_t nhg_id, uint8_t af, const char *destipprefix,
+                                    vector<FieldValueTuple>& fvVector);
+
     /* Handle label route */
     void onLabelRouteMsg(int nlmsg_type, struct nl_object *obj);
 
@@ -0,0 +1,245 @@
+#include <inttypes.h>
+#include "logger.h"
+#include "fpmsyncd/routewriter.h"
+
+using namespace std;
+using namespace swss;
+
+#define ROUTE_WRITER_POP_TIMEOUT 500  // 500 milliseconds
+
+RouteUpdateQueue::RouteUpdateQueue(size_t capacity) :
+    m_capacity(capacity),
+    m_shutdown(false)
+{
+}
+
+bool RouteUpdateQueue::push(ProducerStateTable *table, const string &key,
+                            const string &op, const vector<FieldValueTuple> &fvs)
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    auto it = m_index.find(make_pair(table, key));
+    if (it != m_index.end())
+    {
+        RouteUpdate &update = *it->second;
+
+        /* The consumer must still see the DEL before the new SET */
+        if (op == SET_COMMAND && update.op == DEL_COMMAND)
+        {
+            update.delFirst = true;
+        }
+        else if (op == DEL_COMMAND)
+        {
+            update.delFirst = false;
+        }
+
+        update.op = op;
+        update.fvs = fvs;
+        return false;
+    }
+
+    m_notFull.wait(lock, [this] { return m_index.size() < m_capacity || m_shutdown; });
+
+    m_updates.push_back(RouteUpdate{table, key, op, fvs, false, chrono::steady_clock::now()});
+    m_index.emplace(make_pair(table, key), prev(m_updates.end()));
+
+    lock.unlock();
+    m_notEmpty.notify_one();
+    return true;
+}
+
+bool RouteUpdateQueue::pop(vector<RouteUpdate> &batch, size_t maxCount,
+                           chrono::milliseconds timeout, size_t threshold,
+                           chrono::milliseconds holdTime)
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    m_notEmpty.wait_for(lock, timeout, [this] { return !m_updates.empty() || m_shutdown; });
+
+    if (m_updates.empty())
+    {
+        return !m_shutdown;
+    }
+
+    /* Only the caller pops, so the oldest update stays at the front */
+    if (holdTime.count() > 0)
+    {
+        m_notEmpty.wait_until(lock, m_updates.front().queued + holdTime,
+                              [this, threshold] { return m_updates.size() >= threshold || m_shutdown; });
+    }
+
+    while (!m_updates.empty() && batch.size() < maxCount)
+    {
+        RouteUpdate &update = m_updates.front();
+        m_index.erase(make_pair(update.table, update.key));
+        batch.push_back(move(update));
+        m_updates.pop_front();
+    }
+
+    lock.unlock();
+    m_notFull.notify_all();
+    return true;
+}
+
+void RouteUpdateQueue::shutdown()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+}
+
+size_t RouteUpdateQueue::size() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_updates.size();
+}
+
+RouteWriter::RouteWriter(RedisPipeline *pipeline, size_t queueSize, size_t batchSize) :
+    m_pipeline(pipeline),
+    m_queue(queueSize),
+    m_batchSize(batchSize),
+    m_flushThreshold(0),
+    m_flushIntervalMs(0),
+    m_pushed(0),
+    m_flushed(0),
+    m_received(0),
+    m_coalesced(0),
+    m_written(0),
+    m_batches(0)
+{
+}
+
+RouteWriter::~RouteWriter()
+{
+    stop();
+}
+
+void RouteWriter::setFlushPolicy(size_t threshold, chrono::milliseconds interval)
+{
+    m_flushThreshold = threshold;
+    m_flushIntervalMs = static_cast<int64_t>(interval.count());
+
+    SWSS_LOG_NOTICE("Route writer flush threshold %zu, flush interval %" PRId64 " ms",
+                    threshold, static_cast<int64_t>(interval.count()));
+}
+
+void RouteWriter::start()
+{
+    if (m_thread.joinable())
+    {
+        return;
+    }
+
+    m_thread = thread(&RouteWriter::run, this);
+    SWSS_LOG_NOTICE("Route writer started, batch size %zu", m_batchSize);
+}
+
+void RouteWriter::stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    m_queue.shutdown();
+    m_thread.join();
+
+    SWSS_LOG_NOTICE("Route writer stopped: %" PRIu64 " updates received, %" PRIu64
+                    " suppressed, %" PRIu64 " written in %" PRIu64 " batches",
+                    m_received.load(), m_coalesced.load(), m_written.load(), m_batches.load());
+}
+
+void RouteWriter::push(ProducerStateTable *table, const string &key,
+                       const string &op, const vector<FieldValueTuple> &fvs)
+{
+    m_received++;
+
+    if (!m_queue.push(table, key, op, fvs))
+    {
+        m_coalesced++;
+        return;
+    }
+
+    lock_guard<mutex> lock(m_drainMutex);
+    m_pushed++;
+}
+
+void RouteWriter::drain()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    unique_lock<mutex> lock(m_drainMutex);
+    m_drained.wait(lock, [this] { return m_flushed >= m_pushed; });
+}
+
+vector<FieldValueTuple> RouteWriter::getStats() const
+{
+    return {
+        {"received", to_string(m_received.load())},
+        {"suppressed", to_string(m_coalesced.load())},
+        {"written", to_string(m_written.load())},
+        {"batches", to_string(m_batches.load())},
+        {"pending", to_string(getPending())}
+    };
+}
+
+void RouteWriter::run()
+{
+    vector<RouteUpdate> batch;
+    batch.reserve(m_batchSize);
+
+    while (m_queue.pop(batch, m_batchSize, chrono::milliseconds(ROUTE_WRITER_POP_TIMEOUT),
+                       m_flushThreshold, chrono::milliseconds(m_flushIntervalMs)))
+    {
+        if (batch.empty())
+        {
+            continue;
+        }
+
+        write(batch);
+        batch.clear();
+    }
+}
+
+void RouteWriter::write(vector<RouteUpdate> &batch)
+{
+    {
+        lock_guard<mutex> lock(m_writeMutex);
+
+        for (auto &update : batch)
+        {
+            if (update.op == SET_COMMAND)
+            {
+                if (update.delFirst)
+                {
+                    update.table->del(update.key);
+                }
+                update.table->set(update.key, update.fvs);
+            }
+            else
+            {
+                update.table->del(update.key);
+            }
+        }
+
+        m_pipeline->flush();
+    }
+
+    m_written += batch.size();
+    m_batches++;
+
+    {
+        lock_guard<mutex> lock(m_drainMutex);
+        m_flushed += batch.size();
+    }
+    m_drained.notify_all();
+
+    SWSS_LOG_DEBUG("Route writer flushed %zu updates", batch.size());
+}
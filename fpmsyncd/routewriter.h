@@ -0,0 +1,160 @@
+#ifndef __ROUTEWRITER__
+#define __ROUTEWRITER__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "producerstatetable.h"
+#include "redispipeline.h"
+
+namespace swss {
+
+/*
+ * A pending APPL_DB write. A DEL followed by a SET of the same key collapses
+ * into a single update with delFirst set, so stale fields of the old entry
+ * are still cleared by the consumer.
+ */
+struct RouteUpdate
+{
+    ProducerStateTable *table;
+    std::string key;
+    std::string op;
+    std::vector<FieldValueTuple> fvs;
+    bool delFirst;
+    /* Time the key became dirty, kept when later updates are merged */
+    std::chrono::steady_clock::time_point queued;
+};
+
+/*
+ * Bounded queue between the FPM decode stage and the APPL_DB writer.
+ * Updates are coalesced per table and key: a key keeps its position in the
+ * queue and only its latest state is written. The capacity bounds the number
+ * of distinct pending keys, push() blocks while the queue is full.
+ */
+class RouteUpdateQueue
+{
+public:
+    RouteUpdateQueue(size_t capacity);
+
+    /* Returns false if the update was merged into a pending one */
+    bool push(ProducerStateTable *table, const std::string &key,
+              const std::string &op, const std::vector<FieldValueTuple> &fvs);
+
+    /*
+     * Move up to maxCount updates into batch, waiting at most timeout for the
+     * first one. With a holdTime, the updates are then held until threshold
+     * keys are pending or the oldest one has waited for holdTime, so that
+     * further updates of the same keys are merged. Returns false once the
+     * queue is shut down and empty.
+     */
+    bool pop(std::vector<RouteUpdate> &batch, size_t maxCount,
+             std::chrono::milliseconds timeout, size_t threshold = 0,
+             std::chrono::milliseconds holdTime = std::chrono::milliseconds(0));
+
+    /* Wake up all waiters, pop() drains the remaining updates then fails */
+    void shutdown();
+
+    size_t size() const;
+
+private:
+    typedef std::pair<ProducerStateTable *, std::string> UpdateKey;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+
+    size_t m_capacity;
+    bool m_shutdown;
+
+    std::list<RouteUpdate> m_updates;
+    std::map<UpdateKey, std::list<RouteUpdate>::iterator> m_index;
+};
+
+/*
+ * Second stage of the fpmsyncd pipeline: a worker thread which drains the
+ * update queue in batches into its own RedisPipeline, so netlink decoding
+ * never waits for Redis round-trips.
+ *
+ * The pipeline and the tables bound to it are owned by the writer thread
+ * while it runs; any other user must go through runExclusive().
+ */
+class RouteWriter
+{
+public:
+    enum { DEFAULT_QUEUE_SIZE = 100000 };
+    enum { DEFAULT_BATCH_SIZE = 1000 };
+
+    RouteWriter(RedisPipeline *pipeline, size_t queueSize = DEFAULT_QUEUE_SIZE,
+                size_t batchSize = DEFAULT_BATCH_SIZE);
+    ~RouteWriter();
+
+    /*
+     * Hold pending updates until threshold keys are dirty or the oldest one
+     * is interval old, instead of writing them as soon as the thread is
+     * free. Takes effect from the next batch.
+     */
+    void setFlushPolicy(size_t threshold, std::chrono::milliseconds interval);
+
+    void start();
+    void stop();
+
+    void push(ProducerStateTable *table, const std::string &key,
+              const std::string &op, const std::vector<FieldValueTuple> &fvs);
+
+    /* Block until every update pushed so far has been flushed to Redis */
+    void drain();
+
+    /* Run f while the writer thread is paused, then flush the pipeline */
+    template <typename F>
+    void runExclusive(F f)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        f();
+        m_pipeline->flush();
+    }
+
+    uint64_t getReceived() const { return m_received; }
+    uint64_t getCoalesced() const { return m_coalesced; }
+    uint64_t getWritten() const { return m_written; }
+    uint64_t getBatches() const { return m_batches; }
+    size_t getPending() const { return m_queue.size(); }
+
+    /* Counters as field-values, for publishing */
+    std::vector<FieldValueTuple> getStats() const;
+
+private:
+    RedisPipeline *m_pipeline;
+    RouteUpdateQueue m_queue;
+    size_t m_batchSize;
+    std::atomic<size_t> m_flushThreshold;
+    std::atomic<int64_t> m_flushIntervalMs;
+
+    std::thread m_thread;
+    std::mutex m_writeMutex;
+
+    /* Updates pushed and flushed, used by drain() */
+    std::mutex m_drainMutex;
+    std::condition_variable m_drained;
+    uint64_t m_pushed;
+    uint64_t m_flushed;
+
+    std::atomic<uint64_t> m_received;
+    std::atomic<uint64_t> m_coalesced;
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_batches;
+
+    void run();
+    void write(std::vector<RouteUpdate> &batch);
+};
+
+}
+
+#endif
@@ -0,0 +1,679 @@
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <regex>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/if_bridge.h>
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "logger.h"
+#include "exec.h"
+#include "macaddress.h"
+#include "netlinkbatch.h"
+
+using namespace std;
+using namespace swss;
+
+#define NETLINK_BATCH_CHUNK_SIZE   32768
+/* Acks of a chunk must fit in the socket receive buffer, or they are dropped */
+#define NETLINK_BATCH_CHUNK_OPS    128
+#define NETLINK_BATCH_RECV_SIZE    32768
+#define NETLINK_BATCH_TIMEOUT      5  // 5 seconds
+
+/* Commands equivalent to the netlink requests, as run by the cfgmgr daemons */
+#define NETLINK_BATCH_IP_CMD       "/sbin/ip"
+#define NETLINK_BATCH_BRIDGE_CMD   "/sbin/bridge"
+
+#ifndef NTF_STICKY
+#define NTF_STICKY                 (1 << 6)
+#endif
+
+/* Same quoting as shellquote() of the cfgmgr daemons */
+static string quote(const string &str)
+{
+    static const regex re("([$`\"\\\n])");
+    return "\"" + regex_replace(str, re, "\\$1") + "\"";
+}
+
+NetlinkBatch::NetlinkBatch(Mode mode) :
+    m_mode(mode),
+    m_socket(-1),
+    m_seq(static_cast<uint32_t>(time(NULL)))
+{
+    if (m_mode == SHELL)
+    {
+        return;
+    }
+
+    m_socket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_socket < 0)
+    {
+        SWSS_LOG_WARN("Failed to open netlink socket, falling back to shell commands: %s", strerror(errno));
+        m_mode = SHELL;
+        return;
+    }
+
+    /* Acks of failed requests do not need to carry the request back */
+    int one = 1;
+    setsockopt(m_socket, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+
+    struct timeval timeout = { NETLINK_BATCH_TIMEOUT, 0 };
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+NetlinkBatch::~NetlinkBatch()
+{
+    if (m_socket >= 0)
+    {
+        close(m_socket);
+    }
+}
+
+size_t NetlinkBatch::setLinkMaster(const string &ifname, const string &master)
+{
+    // The command should be generated as:
+    // /sbin/ip link set {{ifname}} master {{master}}|nomaster
+    string cmd = string(NETLINK_BATCH_IP_CMD " link set ") + quote(ifname) +
+                 (master.empty() ? " nomaster" : " master " + quote(master));
+
+    uint32_t masterIndex = 0;
+    if (!master.empty() && m_mode == NETLINK)
+    {
+        masterIndex = if_nametoindex(master.c_str());
+        if (!masterIndex)
+        {
+            return fail(cmd, ENODEV);
+        }
+    }
+
+    size_t index = addLinkRequest(cmd, RTM_SETLINK, 0, AF_UNSPEC, ifname);
+    if (!m_ops[index].done && m_mode == NETLINK)
+    {
+        addAttr(IFLA_MASTER, &masterIndex, sizeof(masterIndex));
+    }
+
+    return index;
+}
+
+size_t NetlinkBatch::addBridgeVlan(const string &ifname, uint16_t vid, bool pvidUntagged, bool self)
+{
+    // The command should be generated as:
+    // /sbin/bridge vlan add vid {{vid}} dev {{ifname}} [pvid untagged] [self]
+    string cmd = string(NETLINK_BATCH_BRIDGE_CMD " vlan add vid ") + to_string(vid) + " dev " + quote(ifname) +
+                 (pvidUntagged ? " pvid untagged" : "") + (self ? " self" : "");
+
+    size_t index = addLinkRequest(cmd, RTM_SETLINK, 0, AF_BRIDGE, ifname);
+    if (!m_ops[index].done && m_mode == NETLINK)
+    {
+        struct bridge_vlan_info info = {};
+        info.vid = vid;
+        if (pvidUntagged)
+        {
+            info.flags = BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED;
+        }
+
+        addBridgeVlanInfo(info, self);
+    }
+
+    return index;
+}
+
+size_t NetlinkBatch::delBridgeVlan(const string &ifname, uint16_t vid, bool self)
+{
+    // The command should be generated as:
+    // /sbin/bridge vlan del vid {{vid}} dev {{ifname}} [self]
+    string cmd = string(NETLINK_BATCH_BRIDGE_CMD " vlan del vid ") + to_string(vid) + " dev " + quote(ifname) +
+                 (self ? " self" : "");
+
+    size_t index = addLinkRequest(cmd, RTM_DELLINK, 0, AF_BRIDGE, ifname);
+    if (!m_ops[index].done && m_mode == NETLINK)
+    {
+        struct bridge_vlan_info info = {};
+        info.vid = vid;
+
+        addBridgeVlanInfo(info, self);
+    }
+
+    return index;
+}
+
+size_t NetlinkBatch::addVlanLink(const string &link, const string &ifname, uint16_t vid, const string &mac)
+{
+    // The command should be generated as:
+    // /sbin/ip link add link {{link}} up name {{ifname}} address {{mac}} type vlan id {{vid}}
+    string cmd = string(NETLINK_BATCH_IP_CMD " link add link ") + quote(link) + " up name " + quote(ifname) +
+                 " address " + quote(mac) + " type vlan id " + to_string(vid);
+
+    if (m_mode == SHELL)
+    {
+        m_ops.push_back(Op{cmd, 0, 0, false, 0, ""});
+        return m_ops.size() - 1;
+    }
+
+    uint8_t lladdr[ETHER_ADDR_LEN];
+    if (!MacAddress::parseMacString(mac, lladdr) || ifname.empty() || ifname.size() >= IFNAMSIZ)
+    {
+        return fail(cmd, EINVAL);
+    }
+
+    uint32_t linkIndex = static_cast<uint32_t>(getIfindex(link));
+    if (!linkIndex)
+    {
+        return fail(cmd, ENODEV);
+    }
+
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_flags = IFF_UP;
+    ifi.ifi_change = IFF_UP;
+
+    size_t index = addRequest(cmd, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, &ifi, sizeof(ifi));
+    addAttr(IFLA_LINK, &linkIndex, sizeof(linkIndex));
+    addAttr(IFLA_IFNAME, ifname.c_str(), ifname.size() + 1);
+    addAttr(IFLA_ADDRESS, lladdr, sizeof(lladdr));
+
+    size_t linkInfo = beginNest(IFLA_LINKINFO);
+    addAttr(IFLA_INFO_KIND, "vlan", sizeof("vlan"));
+    size_t infoData = beginNest(IFLA_INFO_DATA);
+    addAttr(IFLA_VLAN_ID, &vid, sizeof(vid));
+    endNest(infoData);
+    endNest(linkInfo);
+
+    return index;
+}
+
+size_t NetlinkBatch::delLink(const string &ifname)
+{
+    // The command should be generated as:
+    // /sbin/ip link del {{ifname}}
+    string cmd = string(NETLINK_BATCH_IP_CMD " link del ") + quote(ifname);
+
+    return addLinkRequest(cmd, RTM_DELLINK, 0, AF_UNSPEC, ifname);
+}
+
+size_t NetlinkBatch::replaceFdb(const string &ifname, const string &mac, uint16_t vid, FdbType type)
+{
+    return addFdbRequest("replace", RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, ifname, mac, vid, type);
+}
+
+size_t NetlinkBatch::delFdb(const string &ifname, const string &mac, uint16_t vid, FdbType type)
+{
+    return addFdbRequest("del", RTM_DELNEIGH, 0, ifname, mac, vid, type);
+}
+
+size_t NetlinkBatch::commit()
+{
+    if (m_mode == NETLINK)
+    {
+        commitNetlink();
+    }
+    else
+    {
+        commitShell();
+    }
+
+    size_t failed = 0;
+    for (const auto &op : m_ops)
+    {
+        if (op.error)
+        {
+            SWSS_LOG_INFO("%s failed: %s", op.cmd.c_str(),
+                          m_mode == NETLINK ? strerror(op.error) : op.output.c_str());
+            failed++;
+        }
+    }
+
+    SWSS_LOG_DEBUG("Committed %zu kernel operations, %zu failed", m_ops.size(), failed);
+    return failed;
+}
+
+bool NetlinkBatch::isOk(size_t index) const
+{
+    return m_ops[index].done && !m_ops[index].error;
+}
+
+string NetlinkBatch::getError(size_t index) const
+{
+    const Op &op = m_ops[index];
+
+    if (!op.done)
+    {
+        return op.cmd + " : not committed";
+    }
+
+    if (m_mode == SHELL)
+    {
+        return op.cmd + " : " + op.output;
+    }
+
+    return op.cmd + " : " + strerror(op.error);
+}
+
+void NetlinkBatch::clear()
+{
+    m_requests.clear();
+    m_ops.clear();
+    m_ifindexes.clear();
+}
+
+bool NetlinkBatch::getBridgeVlanPorts(set<string> &ports)
+{
+    if (m_mode != NETLINK)
+    {
+        return false;
+    }
+
+    struct
+    {
+        struct nlmsghdr hdr;
+        struct ifinfomsg ifi;
+        char attrs[RTA_SPACE(sizeof(uint32_t))];
+    } req = {};
+
+    req.hdr.nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(sizeof(req.ifi)));
+    req.hdr.nlmsg_type = RTM_GETLINK;
+    req.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.hdr.nlmsg_seq = ++m_seq;
+    req.ifi.ifi_family = AF_BRIDGE;
+
+    struct rtattr *rta = reinterpret_cast<struct rtattr *>(reinterpret_cast<char *>(&req) + req.hdr.nlmsg_len);
+    uint32_t mask = RTEXT_FILTER_BRVLAN;
+    rta->rta_type = IFLA_EXT_MASK;
+    rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(sizeof(mask)));
+    memcpy(RTA_DATA(rta), &mask, sizeof(mask));
+    req.hdr.nlmsg_len += static_cast<uint32_t>(RTA_SPACE(sizeof(mask)));
+
+    struct sockaddr_nl addr = {};
+    addr.nl_family = AF_NETLINK;
+
+    if (sendto(m_socket, &req, req.hdr.nlmsg_len, 0,
+               reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        SWSS_LOG_ERROR("Failed to request the bridge VLANs: %s", strerror(errno));
+        return false;
+    }
+
+    /* Link messages can be large, the dump is read with the biggest size a message may have */
+    vector<char> buf(65536);
+    while (true)
+    {
+        ssize_t len = recv(m_socket, buf.data(), buf.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            SWSS_LOG_ERROR("Failed to dump the bridge VLANs: %s", strerror(errno));
+            return false;
+        }
+
+        size_t remaining = static_cast<size_t>(len);
+        for (struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(buf.data());
+             NLMSG_OK(hdr, remaining); hdr = NLMSG_NEXT(hdr, remaining))
+        {
+            if (hdr->nlmsg_seq != req.hdr.nlmsg_seq)
+            {
+                continue;
+            }
+
+            if (hdr->nlmsg_type == NLMSG_DONE)
+            {
+                return true;
+            }
+
+            if (hdr->nlmsg_type == NLMSG_ERROR)
+            {
+                struct nlmsgerr *err = static_cast<struct nlmsgerr *>(NLMSG_DATA(hdr));
+                SWSS_LOG_ERROR("Failed to dump the bridge VLANs: %s", strerror(-err->error));
+                return false;
+            }
+
+            if (hdr->nlmsg_type != RTM_NEWLINK)
+            {
+                continue;
+            }
+
+            string ifname;
+            bool hasVlan = false;
+            size_t attrLen = IFLA_PAYLOAD(hdr);
+            for (struct rtattr *attr = IFLA_RTA(NLMSG_DATA(hdr)); RTA_OK(attr, attrLen);
+                 attr = RTA_NEXT(attr, attrLen))
+            {
+                if (attr->rta_type == IFLA_IFNAME)
+                {
+                    ifname = static_cast<const char *>(RTA_DATA(attr));
+                }
+                else if ((attr->rta_type & NLA_TYPE_MASK) == IFLA_AF_SPEC)
+                {
+                    size_t nestLen = RTA_PAYLOAD(attr);
+                    for (struct rtattr *nested = static_cast<struct rtattr *>(RTA_DATA(attr)); RTA_OK(nested, nestLen);
+                         nested = RTA_NEXT(nested, nestLen))
+                    {
+                        hasVlan |= nested->rta_type == IFLA_BRIDGE_VLAN_INFO;
+                    }
+                }
+            }
+
+            if (hasVlan)
+            {
+                ports.insert(ifname);
+            }
+        }
+    }
+}
+
+int NetlinkBatch::getIfindex(const string &ifname)
+{
+    auto it = m_ifindexes.find(ifname);
+    if (it != m_ifindexes.end())
+    {
+        return it->second;
+    }
+
+    int ifindex = static_cast<int>(if_nametoindex(ifname.c_str()));
+    m_ifindexes[ifname] = ifindex;
+    return ifindex;
+}
+
+size_t NetlinkBatch::addRequest(const string &cmd, uint16_t type, uint16_t flags,
+                                const void *payload, size_t length)
+{
+    size_t offset = m_requests.size();
+    m_requests.resize(offset + NLMSG_SPACE(length));
+
+    struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(&m_requests[offset]);
+    hdr->nlmsg_len = static_cast<uint32_t>(NLMSG_LENGTH(length));
+    hdr->nlmsg_type = type;
+    hdr->nlmsg_flags = static_cast<uint16_t>(NLM_F_REQUEST | NLM_F_ACK | flags);
+    hdr->nlmsg_seq = ++m_seq;
+    hdr->nlmsg_pid = 0;
+    memcpy(NLMSG_DATA(hdr), payload, length);
+
+    m_ops.push_back(Op{cmd, offset, 0, false, 0, ""});
+    return m_ops.size() - 1;
+}
+
+size_t NetlinkBatch::addLinkRequest(const string &cmd, uint16_t type, uint16_t flags,
+                                    uint8_t family, const string &ifname)
+{
+    if (m_mode == SHELL)
+    {
+        m_ops.push_back(Op{cmd, 0, 0, false, 0, ""});
+        return m_ops.size() - 1;
+    }
+
+    int ifindex = getIfindex(ifname);
+    if (!ifindex)
+    {
+        return fail(cmd, ENODEV);
+    }
+
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = family;
+    ifi.ifi_index = ifindex;
+
+    return addRequest(cmd, type, flags, &ifi, sizeof(ifi));
+}
+
+size_t NetlinkBatch::addFdbRequest(const string &op, uint16_t type, uint16_t flags, const string &ifname,
+                                   const string &mac, uint16_t vid, FdbType fdbType)
+{
+    static const char *typeNames[] = { "static", "sticky static", "dynamic extern_learn" };
+
+    // The command should be generated as:
+    // /sbin/bridge fdb {{op}} {{mac}} dev {{ifname}} master {{type}} vlan {{vid}}
+    string cmd = string(NETLINK_BATCH_BRIDGE_CMD " fdb ") + op + " " + quote(mac) + " dev " + quote(ifname) +
+                 " master " + typeNames[fdbType] + " vlan " + to_string(vid);
+
+    if (m_mode == SHELL)
+    {
+        m_ops.push_back(Op{cmd, 0, 0, false, 0, ""});
+        return m_ops.size() - 1;
+    }
+
+    uint8_t lladdr[ETHER_ADDR_LEN];
+    if (!MacAddress::parseMacString(mac, lladdr))
+    {
+        return fail(cmd, EINVAL);
+    }
+
+    int ifindex = getIfindex(ifname);
+    if (!ifindex)
+    {
+        return fail(cmd, ENODEV);
+    }
+
+    /* The neighbor state and flags the bridge command sets for the same keywords */
+    struct ndmsg ndm = {};
+    ndm.ndm_family = PF_BRIDGE;
+    ndm.ndm_ifindex = ifindex;
+    ndm.ndm_flags = NTF_MASTER;
+    switch (fdbType)
+    {
+    case FDB_STICKY_STATIC:
+        ndm.ndm_flags |= NTF_STICKY;
+        /* fall through */
+    case FDB_STATIC:
+        ndm.ndm_state = NUD_NOARP | NUD_REACHABLE;
+        break;
+    case FDB_DYNAMIC_EXT_LEARN:
+        ndm.ndm_state = NUD_REACHABLE;
+        ndm.ndm_flags |= NTF_EXT_LEARNED;
+        break;
+    }
+
+    size_t index = addRequest(cmd, type, flags, &ndm, sizeof(ndm));
+    addAttr(NDA_LLADDR, lladdr, sizeof(lladdr));
+    addAttr(NDA_VLAN, &vid, sizeof(vid));
+
+    return index;
+}
+
+void NetlinkBatch::addAttr(uint16_t type, const void *data, size_t length)
+{
+    Op &op = m_ops.back();
+    size_t offset = m_requests.size();
+
+    m_requests.resize(offset + RTA_SPACE(length));
+
+    struct rtattr *rta = reinterpret_cast<struct rtattr *>(&m_requests[offset]);
+    rta->rta_type = type;
+    rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(length));
+    if (length)
+    {
+        memcpy(RTA_DATA(rta), data, length);
+    }
+
+    struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(&m_requests[op.offset]);
+    hdr->nlmsg_len = static_cast<uint32_t>(m_requests.size() - op.offset);
+}
+
+/* VLAN of a bridge port, or of the bridge itself with self */
+void NetlinkBatch::addBridgeVlanInfo(const struct bridge_vlan_info &info, bool self)
+{
+    size_t nest = beginNest(IFLA_AF_SPEC);
+    if (self)
+    {
+        uint16_t flags = BRIDGE_FLAGS_SELF;
+        addAttr(IFLA_BRIDGE_FLAGS, &flags, sizeof(flags));
+    }
+    addAttr(IFLA_BRIDGE_VLAN_INFO, &info, sizeof(info));
+    endNest(nest);
+}
+
+size_t NetlinkBatch::beginNest(uint16_t type)
+{
+    size_t offset = m_requests.size();
+    addAttr(static_cast<uint16_t>(type | NLA_F_NESTED), nullptr, 0);
+    return offset;
+}
+
+void NetlinkBatch::endNest(size_t offset)
+{
+    struct rtattr *rta = reinterpret_cast<struct rtattr *>(&m_requests[offset]);
+    rta->rta_len = static_cast<unsigned short>(m_requests.size() - offset);
+}
+
+size_t NetlinkBatch::fail(const string &cmd, int error)
+{
+    m_ops.push_back(Op{cmd, 0, 0, true, error, ""});
+    return m_ops.size() - 1;
+}
+
+void NetlinkBatch::commitNetlink()
+{
+    /* Requests were appended in operation order, lengths follow from the offsets */
+    size_t end = m_requests.size();
+    for (size_t i = m_ops.size(); i-- > 0;)
+    {
+        if (m_ops[i].done)
+        {
+            continue;
+        }
+        m_ops[i].length = end - m_ops[i].offset;
+        end = m_ops[i].offset;
+    }
+
+    size_t first = 0;
+    while (first < m_ops.size())
+    {
+        if (m_ops[first].done)
+        {
+            first++;
+            continue;
+        }
+
+        size_t last = first;
+        size_t chunk = m_ops[first].length;
+        size_t count = 1;
+        while (last + 1 < m_ops.size() &&
+               (m_ops[last + 1].done ||
+                (chunk + m_ops[last + 1].length <= NETLINK_BATCH_CHUNK_SIZE && count < NETLINK_BATCH_CHUNK_OPS)))
+        {
+            last++;
+            if (!m_ops[last].done)
+            {
+                chunk += m_ops[last].length;
+                count++;
+            }
+        }
+
+        sendChunk(first, last);
+        first = last + 1;
+    }
+}
+
+void NetlinkBatch::sendChunk(size_t first, size_t last)
+{
+    size_t offset = m_ops[first].offset;
+    size_t length = 0;
+    size_t pending = 0;
+    for (size_t i = first; i <= last; i++)
+    {
+        if (!m_ops[i].done)
+        {
+            length = m_ops[i].offset + m_ops[i].length - offset;
+            pending++;
+        }
+    }
+
+    struct sockaddr_nl addr = {};
+    addr.nl_family = AF_NETLINK;
+
+    if (sendto(m_socket, &m_requests[offset], length, 0,
+               reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        int error = errno;
+        for (size_t i = first; i <= last; i++)
+        {
+            if (!m_ops[i].done)
+            {
+                m_ops[i].done = true;
+                m_ops[i].error = error;
+            }
+        }
+        return;
+    }
+
+    /*
+     * Acks are matched to the operations by sequence number. An ack of another
+     * request, such as a late one of a previous chunk, is ignored.
+     */
+    unordered_map<uint32_t, size_t> bySeq;
+    for (size_t i = first; i <= last; i++)
+    {
+        if (!m_ops[i].done)
+        {
+            bySeq[reinterpret_cast<struct nlmsghdr *>(&m_requests[m_ops[i].offset])->nlmsg_seq] = i;
+        }
+    }
+
+    vector<char> buf(NETLINK_BATCH_RECV_SIZE);
+    int error = 0;
+    while (pending)
+    {
+        ssize_t len = recv(m_socket, buf.data(), buf.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            error = errno;
+            break;
+        }
+
+        size_t remaining = static_cast<size_t>(len);
+        for (struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(buf.data());
+             NLMSG_OK(hdr, remaining); hdr = NLMSG_NEXT(hdr, remaining))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR)
+            {
+                continue;
+            }
+
+            auto it = bySeq.find(hdr->nlmsg_seq);
+            if (it == bySeq.end())
+            {
+                SWSS_LOG_INFO("Ignoring netlink ack of unknown sequence %u", hdr->nlmsg_seq);
+                continue;
+            }
+
+            struct nlmsgerr *err = static_cast<struct nlmsgerr *>(NLMSG_DATA(hdr));
+            m_ops[it->second].done = true;
+            m_ops[it->second].error = -err->error;
+            bySeq.erase(it);
+            pending--;
+        }
+    }
+
+    /* Only the operations without an ack failed with the receive error */
+    for (size_t i = first; i <= last; i++)
+    {
+        if (!m_ops[i].done)
+        {
+            m_ops[i].done = true;
+            m_ops[i].error = error ? error : ETIMEDOUT;
+        }
+    }
+}
+
+void NetlinkBatch::commitShell()
+{
+    for (auto &op : m_ops)
+    {
+        if (op.done)
+        {
+            continue;
+        }
+
+        op.done = true;
+        op.error = swss::exec(op.cmd, op.output);
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct bridge_vlan_info;
+
+namespace swss {
+
+/*
+ * Batched kernel programming over rtnetlink for the cfgmgr daemons and fdbsyncd.
+ *
+ * Operations are queued and sent by commit() with as many requests per
+ * sendmsg() as fit in a chunk. Each request is acked separately, so the
+ * result of every operation is available afterwards. Requests are handled
+ * by the kernel in order, a later operation may depend on an earlier one.
+ *
+ * Every operation also keeps its ip/bridge command equivalent. In SHELL
+ * mode, or if the netlink socket cannot be opened, commit() runs those
+ * commands one by one instead.
+ */
+class NetlinkBatch
+{
+public:
+    enum Mode
+    {
+        NETLINK,
+        SHELL
+    };
+
+    /* Bridge FDB entry types, as the bridge fdb command keywords */
+    enum FdbType
+    {
+        FDB_STATIC,             /* static */
+        FDB_STICKY_STATIC,      /* sticky static */
+        FDB_DYNAMIC_EXT_LEARN   /* dynamic extern_learn */
+    };
+
+    NetlinkBatch(Mode mode = NETLINK);
+    ~NetlinkBatch();
+
+    Mode getMode() const { return m_mode; }
+    size_t size() const { return m_ops.size(); }
+
+    /* Queue an operation, returns its index in the batch */
+    size_t setLinkMaster(const std::string &ifname, const std::string &master);
+    /* With self, the VLAN of the bridge device itself */
+    size_t addBridgeVlan(const std::string &ifname, uint16_t vid, bool pvidUntagged, bool self = false);
+    size_t delBridgeVlan(const std::string &ifname, uint16_t vid, bool self = false);
+    /* VLAN device {{ifname}} of {{link}}, created up */
+    size_t addVlanLink(const std::string &link, const std::string &ifname, uint16_t vid, const std::string &mac);
+    size_t delLink(const std::string &ifname);
+    /* FDB entry of a bridge port, on the bridge it is a member of */
+    size_t replaceFdb(const std::string &ifname, const std::string &mac, uint16_t vid, FdbType type);
+    size_t delFdb(const std::string &ifname, const std::string &mac, uint16_t vid, FdbType type);
+
+    /* Run the queued operations, returns the number of failed ones */
+    size_t commit();
+
+    bool isOk(size_t index) const;
+    /* "<command> : <error>", as reported for a failed shell command */
+    std::string getError(size_t index) const;
+
+    /* Drop the queued operations and their results */
+    void clear();
+
+    /*
+     * Ports with at least one bridge VLAN, as bridge vlan show lists them.
+     * Queried right away, not batched. False in SHELL mode or on error.
+     */
+    bool getBridgeVlanPorts(std::set<std::string> &ports);
+
+private:
+    struct Op
+    {
+        std::string cmd;
+        size_t offset;
+        size_t length;
+        bool done;
+        int error;
+        std::string output;
+    };
+
+    Mode m_mode;
+    int m_socket;
+    uint32_t m_seq;
+
+    /* Requests of the queued operations, back to back */
+    std::vector<char> m_requests;
+    std::vector<Op> m_ops;
+    /* Interface indexes looked up by the queued operations */
+    std::unordered_map<std::string, int> m_ifindexes;
+
+    int getIfindex(const std::string &ifname);
+    size_t addRequest(const std::string &cmd, uint16_t type, uint16_t flags,
+                      const void *payload, size_t length);
+    size_t addLinkRequest(const std::string &cmd, uint16_t type, uint16_t flags,
+                          uint8_t family, const std::string &ifname);
+    size_t addFdbRequest(const std::string &op, uint16_t type, uint16_t flags, const std::string &ifname,
+                         const std::string &mac, uint16_t vid, FdbType fdbType);
+    void addBridgeVlanInfo(const struct bridge_vlan_info &info, bool self);
+    void addAttr(uint16_t type, const void *data, size_t length);
+    size_t beginNest(uint16_t type);
+    void endNest(size_t offset);
+    size_t fail(const std::string &cmd, int error);
+
+    void commitNetlink();
+    void commitShell();
+    void sendChunk(size_t first, size_t last);
+};
+
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <regex>
+#include <sstream>
 
 #include "dbconnector.h"
 #include "logger.h"
@@ -32,6 +33,39 @@ std::set<std::string> swss::load_zmq_tables()
     return tables;
 }
 
+std::map<std::string, size_t> swss::load_zmq_batch_sizes(const std::string &config_file)
+{
+    std::map<std::string, size_t> batch_sizes;
+    std::ifstream file(config_file);
+    if (!file.is_open())
+    {
+        return batch_sizes;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::string table;
+        long long size = 0;
+        if (!(iss >> table))
+        {
+            continue;
+        }
+
+        if (!(iss >> size) || size <= 0)
+        {
+            SWSS_LOG_WARN("Ignoring invalid ZMQ batch size config: %s", line.c_str());
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("ZMQ table %s batch size: %lld", table.c_str(), size);
+        batch_sizes[table] = static_cast<size_t>(size);
+    }
+
+    return batch_sizes;
+}
+
 int swss::get_zmq_port()
 {
     auto zmq_port = ORCH_ZMQ_PORT;
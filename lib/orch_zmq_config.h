@@ -1,6 +1,7 @@
 #ifndef SWSS_ORCH_ZMQ_CONFIG_H
 #define SWSS_ORCH_ZMQ_CONFIG_H
 
+#include <map>
 #include <memory>
 #include <string.h>
 #include <set>
@@ -25,10 +26,18 @@
  */
 #define ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED "orch_northbond_route_zmq_enabled"
 
+/*
+ * Per table limit of the entries orchagent takes from a ZMQ table at a time.
+ * Each line is "<table name> <limit>", tables which are not listed have no limit.
+ */
+#define ZMQ_BATCH_CONFIGFILE            "/etc/swss/orch_zmq_batch.conf"
+
 namespace swss {
 
 std::set<std::string> load_zmq_tables();
 
+std::map<std::string, size_t> load_zmq_batch_sizes(const std::string &config_file = ZMQ_BATCH_CONFIGFILE);
+
 int get_zmq_port();
 
 std::shared_ptr<ZmqClient> create_zmq_client(std::string zmq_address, std::string vrf="");
@@ -2,14 +2,19 @@
 #include "timestamp.h"
 #include "logger.h"
 #include <cstring>
+#include <ctime>
+#include <vector>
 
 using namespace swss;
 
+#define REC_WRITER_INTERVAL 100  // 100 milliseconds
+
 const std::string Recorder::DEFAULT_DIR = ".";
 const std::string Recorder::REC_START = "|recording started";
 const std::string Recorder::SWSS_FNAME = "swss.rec";
 const std::string Recorder::SAIREDIS_FNAME = "sairedis.rec";
 const std::string Recorder::RESPPUB_FNAME = "responsepublisher.rec";
+const std::string Recorder::REC_BINARY_MAGIC = std::string("SWSSREC\x01", 8);
 
 
 Recorder& Recorder::Instance()
@@ -52,6 +57,20 @@ SaiRedisRec::SaiRedisRec()
 }
 
 
+/* Same format as swss::getTimestamp(), for entries queued earlier */
+static std::string formatTimestamp(const struct timeval &tv)
+{
+    char buffer[64];
+    struct tm tm;
+
+    localtime_r(&tv.tv_sec, &tm);
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm);
+    snprintf(&buffer[size], 32, "%06ld", (long)tv.tv_usec);
+
+    return std::string(buffer);
+}
+
+
 void RecWriter::startRec(bool exit_if_failure)
 {
     if (!isRecord())
@@ -60,7 +79,7 @@ void RecWriter::startRec(bool exit_if_failure)
     }
 
     fname = getLoc() + "/" + getFile();
-    record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
+    openFile();
     if (!record_ofs.is_open())
     {
         SWSS_LOG_ERROR("%s Recorder: Failed to open recording file %s: error %s", getName().c_str(), fname.c_str(), strerror(errno));
@@ -71,15 +90,54 @@ void RecWriter::startRec(bool exit_if_failure)
         else
         {
             setRecord(false);
+            return;
         }
     }
-    record_ofs << swss::getTimestamp() << Recorder::REC_START << std::endl;
-    SWSS_LOG_NOTICE("%s Recorder: Recording started at %s", getName().c_str(), fname.c_str());
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    writeEntry(tv, Recorder::REC_START.substr(1));
+    record_ofs.flush();
+
+    if (isAsync() && !m_writer.joinable())
+    {
+        m_stop = false;
+        m_writer = std::thread(&RecWriter::runWriter, this);
+        m_running = true;
+    }
+
+    SWSS_LOG_NOTICE("%s Recorder: Recording started at %s%s", getName().c_str(), fname.c_str(),
+                    isAsync() ? " (async)" : "");
+}
+
+
+void RecWriter::stopRec()
+{
+    if (m_writer.joinable())
+    {
+        m_running = false;
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_stop = true;
+        }
+        m_writerCv.notify_one();
+        m_writer.join();
+
+        /* Entries queued by record() calls that still saw the writer running */
+        while (m_queueing.load())
+        {
+            std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        writePending();
+    }
 }
 
 
 RecWriter::~RecWriter()
 {
+    stopRec();
+
     if (record_ofs.is_open())
     {
         record_ofs.close();      
@@ -93,11 +151,46 @@ void RecWriter::record(const std::string& val)
     {
         return ;
     }
+
+    if (isAsync())
+    {
+        m_queueing++;
+        if (m_running)
+        {
+            RecEntry *entry = new RecEntry;
+            gettimeofday(&entry->tv, NULL);
+            entry->val = val;
+            entry->next = m_pending.load(std::memory_order_relaxed);
+            while (!m_pending.compare_exchange_weak(entry->next, entry,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+            m_queueing--;
+            return;
+        }
+        m_queueing--;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    /* The writer has stopped, entries it left queued go first */
+    if (m_pending.load(std::memory_order_acquire))
+    {
+        writePending();
+    }
+
     if (isRotate())
     {
         setRotate(false);
         logfileReopen();
     }
+
+    if (isBinary())
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        writeEntry(tv, val);
+        record_ofs.flush();
+        return;
+    }
     record_ofs << swss::getTimestamp() << "|" << val << std::endl;
 }
 
@@ -110,7 +203,7 @@ void RecWriter::logfileReopen()
      * empty file here.
      */
     record_ofs.close();
-    record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
+    openFile();
 
     if (!record_ofs.is_open())
     {
@@ -119,3 +212,137 @@ void RecWriter::logfileReopen()
     }
     SWSS_LOG_INFO("%s Recorder: LogRotate request handled", getName().c_str());
 }
+
+
+void RecWriter::openFile()
+{
+    if (!isBinary())
+    {
+        record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
+        return;
+    }
+
+    record_ofs.open(fname, std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+    if (record_ofs.is_open() && record_ofs.tellp() == 0)
+    {
+        record_ofs << Recorder::REC_BINARY_MAGIC;
+    }
+}
+
+
+void RecWriter::writeEntry(const struct timeval &tv, const std::string &val)
+{
+    if (!isBinary())
+    {
+        record_ofs << formatTimestamp(tv) << "|" << val << '\n';
+        return;
+    }
+
+    uint32_t length = static_cast<uint32_t>(val.size());
+    uint64_t sec = static_cast<uint64_t>(tv.tv_sec);
+    uint32_t usec = static_cast<uint32_t>(tv.tv_usec);
+
+    record_ofs.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    record_ofs.write(reinterpret_cast<const char *>(&sec), sizeof(sec));
+    record_ofs.write(reinterpret_cast<const char *>(&usec), sizeof(usec));
+    record_ofs.write(val.data(), val.size());
+}
+
+
+void RecWriter::writePending()
+{
+    RecEntry *entry = m_pending.exchange(nullptr, std::memory_order_acquire);
+
+    /* Restore the recording order */
+    RecEntry *ordered = nullptr;
+    while (entry)
+    {
+        RecEntry *next = entry->next;
+        entry->next = ordered;
+        ordered = entry;
+        entry = next;
+    }
+
+    if (isRotate())
+    {
+        setRotate(false);
+        logfileReopen();
+    }
+
+    if (!ordered)
+    {
+        return;
+    }
+
+    while (ordered)
+    {
+        RecEntry *next = ordered->next;
+        writeEntry(ordered->tv, ordered->val);
+        delete ordered;
+        ordered = next;
+    }
+
+    record_ofs.flush();
+}
+
+
+void RecWriter::runWriter()
+{
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+
+    while (!m_stop)
+    {
+        m_writerCv.wait_for(lock, std::chrono::milliseconds(REC_WRITER_INTERVAL));
+
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> recLock(m_mutex);
+            writePending();
+        }
+        lock.lock();
+    }
+}
+
+
+bool Recorder::toText(std::istream &in, std::ostream &out)
+{
+    std::string magic(REC_BINARY_MAGIC.size(), '\0');
+    if (!in.read(&magic[0], magic.size()) || magic != REC_BINARY_MAGIC)
+    {
+        return false;
+    }
+
+    std::vector<char> val;
+    while (true)
+    {
+        uint32_t length;
+        uint64_t sec;
+        uint32_t usec;
+
+        if (!in.read(reinterpret_cast<char *>(&length), sizeof(length)))
+        {
+            /* Clean end of file */
+            return in.gcount() == 0;
+        }
+
+        if (!in.read(reinterpret_cast<char *>(&sec), sizeof(sec)) ||
+            !in.read(reinterpret_cast<char *>(&usec), sizeof(usec)))
+        {
+            return false;
+        }
+
+        val.resize(length);
+        if (length && !in.read(val.data(), length))
+        {
+            return false;
+        }
+
+        struct timeval tv;
+        tv.tv_sec = static_cast<time_t>(sec);
+        tv.tv_usec = static_cast<suseconds_t>(usec);
+
+        out << formatTimestamp(tv) << "|";
+        out.write(val.data(), length);
+        out << '\n';
+    }
+}
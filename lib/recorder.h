@@ -5,6 +5,11 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <sys/time.h>
 
 namespace swss {
 
@@ -17,6 +22,8 @@ public:
     void setLocation(const std::string& loc) { m_location = loc; }
     void setFileName(const std::string& name) { m_filename = name; }
     void setName(const std::string& name)  { m_name = name; }
+    void setAsync(bool async)  { m_async = async; }
+    void setBinary(bool binary)  { m_binary = binary; }
 
     /* getters */
     bool isRecord()  { return m_recording; }
@@ -24,28 +31,66 @@ public:
     std::string getLoc() { return m_location; }
     std::string getFile() { return m_filename; }
     std::string getName() { return m_name; }
+    bool isAsync()  { return m_async; }
+    bool isBinary()  { return m_binary; }
 
 private:
     bool m_recording;
-    bool m_rotate;
+    std::atomic<bool> m_rotate{false};
+    bool m_async = false;
+    bool m_binary = false;
     std::string m_location;
     std::string m_filename;
     std::string m_name;
 };
 
+/*
+ * In async mode record() only queues the entry, a writer thread appends the
+ * queued entries to the file in batches with a single flush. In binary mode
+ * entries are framed as below instead of text lines, see Recorder::toText()
+ * for the conversion back to the text format.
+ *
+ *   file:  REC_BINARY_MAGIC, then one frame per entry
+ *   frame: uint32_t length, uint64_t tv_sec, uint32_t tv_usec, length bytes
+ *          (native byte order)
+ */
 class RecWriter : public RecBase {
 public:
     RecWriter() = default;
     virtual ~RecWriter();
     void startRec(bool exit_if_failure);
+    /* Write out the pending entries and stop the writer thread */
+    void stopRec();
     void record(const std::string& val);
 
 protected:
     void logfileReopen();
 
 private:
+    struct RecEntry {
+        struct timeval tv;
+        std::string val;
+        RecEntry *next;
+    };
+
     std::ofstream record_ofs;
     std::string fname;
+    std::mutex m_mutex;
+
+    /* Entries pushed by record() in async mode, most recent first */
+    std::atomic<RecEntry *> m_pending{nullptr};
+    std::atomic<bool> m_running{false};
+    /* record() calls queueing an entry, stopRec() waits for them before the last drain */
+    std::atomic<int> m_queueing{0};
+    std::thread m_writer;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCv;
+    bool m_stop = false;
+
+    void openFile();
+    void writeEntry(const struct timeval &tv, const std::string &val);
+    void writePending();
+    void runWriter();
 };
 
 class SwSSRec : public RecWriter {
@@ -73,6 +118,10 @@ public:
     static const std::string SWSS_FNAME;
     static const std::string SAIREDIS_FNAME;
     static const std::string RESPPUB_FNAME;
+    static const std::string REC_BINARY_MAGIC;
+
+    /* Convert a binary recording to the text format, false if it is malformed */
+    static bool toText(std::istream &in, std::ostream &out);
 
     Recorder() = default;
     /* Individual Handlers */
@@ -0,0 +1,187 @@
+#include <stdexcept>
+#include "logger.h"
+#include "natmirror.h"
+
+using namespace std;
+using namespace swss;
+
+static bool isStaticEntry(const vector<FieldValueTuple> &values)
+{
+    for (const auto &fv : values)
+    {
+        if (fvField(fv) == "entry_type")
+        {
+            return fvValue(fv) == "static";
+        }
+    }
+    return false;
+}
+
+NatKeyspaceSubscriber::NatKeyspaceSubscriber(DBConnector *db, const string &tableName)
+{
+    Table table(db, tableName);
+
+    m_keyPrefix = "__keyspace@" + to_string(db->getDbId()) + "__:" + table.getKeyName("");
+    psubscribe(db, m_keyPrefix + "*");
+}
+
+uint64_t NatKeyspaceSubscriber::readData()
+{
+    redisReply *reply = nullptr;
+
+    /* The notifications are not kept by redis, all the replies available are read now */
+    if (redisGetReply(m_subscribe->getContext(), reinterpret_cast<void**>(&reply)) != REDIS_OK)
+    {
+        throw runtime_error("Unable to read redis reply");
+    }
+    m_events.emplace_back(make_shared<RedisReply>(reply));
+
+    int status;
+    do
+    {
+        reply = nullptr;
+        status = redisGetReplyFromReader(m_subscribe->getContext(), reinterpret_cast<void**>(&reply));
+        if (reply != nullptr && status == REDIS_OK)
+        {
+            m_events.emplace_back(make_shared<RedisReply>(reply));
+        }
+    } while (reply != nullptr && status == REDIS_OK);
+
+    if (status != REDIS_OK)
+    {
+        throw runtime_error("Unable to read redis reply");
+    }
+    return 0;
+}
+
+bool NatKeyspaceSubscriber::hasData()
+{
+    return !m_events.empty();
+}
+
+bool NatKeyspaceSubscriber::hasCachedData()
+{
+    return m_events.size() > 1;
+}
+
+void NatKeyspaceSubscriber::pops(deque<pair<string, string>> &events)
+{
+    while (!m_events.empty())
+    {
+        auto message = m_events.front()->getReply<RedisMessage>();
+        m_events.pop_front();
+
+        if (message.type != "pmessage" || message.channel.compare(0, m_keyPrefix.size(), m_keyPrefix))
+        {
+            continue;
+        }
+        events.emplace_back(message.channel.substr(m_keyPrefix.size()), message.data);
+    }
+}
+
+NatTableMirror::NatTableMirror(DBConnector *appDb, const string &tableName) :
+    m_tableName(tableName),
+    m_table(appDb, tableName)
+{
+    /* Subscribe first, an entry written while the table is read is notified */
+    m_subscriber = make_unique<NatKeyspaceSubscriber>(appDb, tableName);
+
+    vector<string> keys;
+    m_table.getKeys(keys);
+    for (const auto &key : keys)
+    {
+        bool isStatic = false;
+        if (lookup(key, isStatic))
+        {
+            m_entries[key] = { isStatic, false };
+        }
+    }
+
+    SWSS_LOG_NOTICE("Loaded %zu entries of %s", m_entries.size(), tableName.c_str());
+    m_lookups = 0;
+}
+
+void NatTableMirror::sync()
+{
+    SWSS_LOG_ENTER();
+
+    deque<pair<string, string>> events;
+    m_subscriber->pops(events);
+
+    for (const auto &event : events)
+    {
+        onKeyspaceEvent(event.first, event.second);
+    }
+}
+
+void NatTableMirror::onKeyspaceEvent(const string &key, const string &op)
+{
+    /*
+     * A del is applied whoever wrote the entry, natmgrd may delete a static
+     * entry written over a natsyncd's one.
+     */
+    if (op == "del")
+    {
+        m_entries.erase(key);
+        return;
+    }
+
+    /* natsyncd's own write, applied by orchagent */
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->second.own)
+    {
+        return;
+    }
+
+    bool isStatic = false;
+    if (lookup(key, isStatic))
+    {
+        m_entries[key] = { isStatic, false };
+    }
+    else
+    {
+        m_entries.erase(key);
+    }
+}
+
+bool NatTableMirror::find(const string &key, bool &isStatic, bool verify)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    /* Not in the table yet is still natsyncd's entry */
+    if (verify && it->second.own && lookup(key, isStatic) && isStatic)
+    {
+        SWSS_LOG_NOTICE("Entry %s of %s was replaced by a static entry", key.c_str(), m_tableName.c_str());
+        it->second = { true, false };
+    }
+
+    isStatic = it->second.isStatic;
+    return true;
+}
+
+bool NatTableMirror::lookup(const string &key, bool &isStatic)
+{
+    vector<FieldValueTuple> values;
+
+    m_lookups++;
+    if (!m_table.get(key, values))
+    {
+        return false;
+    }
+    isStatic = isStaticEntry(values);
+    return true;
+}
+
+void NatTableMirror::set(const string &key, const vector<FieldValueTuple> &values)
+{
+    m_entries[key] = { isStaticEntry(values), true };
+}
+
+void NatTableMirror::del(const string &key)
+{
+    m_entries.erase(key);
+}
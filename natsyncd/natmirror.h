@@ -0,0 +1,100 @@
+#ifndef __NATMIRROR_H__
+#define __NATMIRROR_H__
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dbconnector.h"
+#include "redisselect.h"
+#include "redisreply.h"
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Keyspace notifications of a table, without the values.
+ *
+ * Unlike SubscriberStateTable, the entry is not read back from the table for every
+ * notification, the subscriber only reports the key and the operation.
+ */
+class NatKeyspaceSubscriber : public RedisSelect
+{
+public:
+    NatKeyspaceSubscriber(DBConnector *db, const std::string &tableName);
+
+    uint64_t readData() override;
+    bool hasData() override;
+    bool hasCachedData() override;
+
+    /* Key and operation (hset, del, ...) of the notifications read so far */
+    void pops(std::deque<std::pair<std::string, std::string>> &events);
+
+private:
+    std::string m_keyPrefix;
+    std::deque<std::shared_ptr<RedisReply>> m_events;
+};
+
+/*
+ * Local index of the keys of an APP_DB NAT table, and whether each entry is static.
+ *
+ * natsyncd checks the NAT, NAPT, twice NAT and pool tables for every conntrack
+ * notification. The index is kept current from the writes of natsyncd and from
+ * the keyspace notifications of the table, which carry the entries written by
+ * natmgrd, so the checks don't need a Redis lookup.
+ *
+ * The set notifications of the keys natsyncd wrote are its own writes coming
+ * back through orchagent, they are skipped. The entry of another key is looked
+ * up once for its entry_type. Deletes are always applied.
+ */
+class NatTableMirror
+{
+public:
+    NatTableMirror(DBConnector *appDb, const std::string &tableName);
+
+    const std::string &getTableName() const { return m_tableName; }
+    Selectable *getSelectable() { return m_subscriber.get(); }
+
+    /* Apply the updates notified on the table */
+    void sync();
+    void onKeyspaceEvent(const std::string &key, const std::string &op);
+
+    /*
+     * Returns false if the entry doesn't exist, otherwise if it is static in isStatic.
+     * With verify, an entry natsyncd wrote is checked in the table, natmgrd may have
+     * replaced it with a static one since.
+     */
+    bool find(const std::string &key, bool &isStatic, bool verify = false);
+    bool exists(const std::string &key) const { return m_entries.find(key) != m_entries.end(); }
+    size_t size() const { return m_entries.size(); }
+
+    /* Number of entries read from the table, since the mirror was loaded */
+    uint64_t getLookupCount() const { return m_lookups; }
+
+    /* Record an entry natsyncd writes to the table */
+    void set(const std::string &key, const std::vector<FieldValueTuple> &values);
+    void del(const std::string &key);
+
+private:
+    struct MirrorEntry
+    {
+        bool isStatic;
+        /* Written by natsyncd */
+        bool own;
+    };
+
+    std::string m_tableName;
+    Table m_table;
+    std::unique_ptr<NatKeyspaceSubscriber> m_subscriber;
+    std::unordered_map<std::string, MirrorEntry> m_entries;
+    uint64_t m_lookups = 0;
+
+    /* Returns false if the entry is not in the table */
+    bool lookup(const std::string &key, bool &isStatic);
+};
+
+}
+
+#endif /* __NATMIRROR_H__ */
@@ -15,6 +15,8 @@
  */
 
 #include <string>
+#include <chrono>
+#include <cinttypes>
 #include <netinet/in.h>
 #include <netlink/netfilter/ct.h>
 #include <netlink/utils.h>
@@ -26,6 +28,7 @@
 #include "netmsg.h"
 #include "linkcache.h"
 
+#include "select.h"
 #include "natsync.h"
 #include "warm_restart.h"
 
@@ -38,15 +41,16 @@ using namespace swss;
 #define CT_UDP_EXPIRY_TIMEOUT   600 /* Max conntrack timeout in the user configurable range */
 
 NatSync::NatSync(RedisPipeline *pipelineAppDB, DBConnector *appDb, DBConnector *stateDb, NfNetlink *nfnl) :
-    m_natTable(appDb, APP_NAT_TABLE_NAME),
-    m_naptTable(appDb, APP_NAPT_TABLE_NAME),
-    m_natTwiceTable(appDb, APP_NAT_TWICE_TABLE_NAME),
-    m_naptTwiceTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
-    m_natCheckTable(appDb, APP_NAT_TABLE_NAME),
-    m_naptCheckTable(appDb, APP_NAPT_TABLE_NAME),
-    m_twiceNatCheckTable(appDb, APP_NAT_TWICE_TABLE_NAME),
-    m_twiceNaptCheckTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
-    m_naptPoolCheckTable(appDb, APP_NAPT_POOL_IP_TABLE_NAME),
+    m_pipeline(pipelineAppDB),
+    m_natTable(pipelineAppDB, APP_NAT_TABLE_NAME, true),
+    m_naptTable(pipelineAppDB, APP_NAPT_TABLE_NAME, true),
+    m_natTwiceTable(pipelineAppDB, APP_NAT_TWICE_TABLE_NAME, true),
+    m_naptTwiceTable(pipelineAppDB, APP_NAPT_TWICE_TABLE_NAME, true),
+    m_natMirror(appDb, APP_NAT_TABLE_NAME),
+    m_naptMirror(appDb, APP_NAPT_TABLE_NAME),
+    m_naptPoolMirror(appDb, APP_NAPT_POOL_IP_TABLE_NAME),
+    m_twiceNatMirror(appDb, APP_NAT_TWICE_TABLE_NAME),
+    m_twiceNaptMirror(appDb, APP_NAPT_TWICE_TABLE_NAME),
     m_stateNatRestoreTable(stateDb, STATE_NAT_RESTORE_TABLE_NAME)
 {
     nfsock = nfnl;
@@ -71,6 +75,77 @@ NatSync::~NatSync()
     }
 }
 
+void NatSync::addMirrorSelectables(Select &s)
+{
+    for (auto mirror : {&m_natMirror, &m_naptMirror, &m_naptPoolMirror, &m_twiceNatMirror, &m_twiceNaptMirror})
+    {
+        s.addSelectable(mirror->getSelectable());
+    }
+}
+
+bool NatSync::syncMirror(Selectable *sel)
+{
+    for (auto mirror : {&m_natMirror, &m_naptMirror, &m_naptPoolMirror, &m_twiceNatMirror, &m_twiceNaptMirror})
+    {
+        if (mirror->getSelectable() == sel)
+        {
+            mirror->sync();
+            return true;
+        }
+    }
+    return false;
+}
+
+void NatSync::setAppEntry(ProducerStateTable &table, NatTableMirror &mirror, const string &key,
+                          const vector<FieldValueTuple> &values)
+{
+    table.set(key, values);
+    mirror.set(key, values);
+}
+
+void NatSync::delAppEntry(ProducerStateTable &table, NatTableMirror &mirror, const string &key)
+{
+    table.del(key);
+    mirror.del(key);
+}
+
+/*
+ * Write the APP_DB updates of the conntrack notifications read so far, and report
+ * the flow install rate once per NAT_RATE_REPORT_INTERVAL of installing flows.
+ */
+void NatSync::flush()
+{
+    SWSS_LOG_ENTER();
+
+    m_pipeline->flush();
+
+    auto now = chrono::steady_clock::now();
+    if (m_flowsInstalled != m_flowsFlushed)
+    {
+        m_flowsFlushed = m_flowsInstalled;
+        m_rateEnd = now;
+    }
+
+    if (m_flowsFlushed == 0 || (now - m_rateStart) < chrono::seconds(NAT_RATE_REPORT_INTERVAL))
+    {
+        return;
+    }
+
+    /* The idle time after the last flow installed is not counted */
+    double elapsed = chrono::duration<double>(m_rateEnd - m_rateStart).count();
+    uint64_t lookups = 0;
+    for (auto mirror : {&m_natMirror, &m_naptMirror, &m_naptPoolMirror, &m_twiceNatMirror, &m_twiceNaptMirror})
+    {
+        lookups += mirror->getLookupCount();
+    }
+    SWSS_LOG_NOTICE("Installed %zu NAT flows in %.3f s (%.0f flows/s), %zu NAT and %zu NAPT entries in APP_DB, "
+                    "%" PRIu64 " APP_DB lookups since start",
+                    m_flowsFlushed, elapsed, elapsed > 0 ? static_cast<double>(m_flowsFlushed) / elapsed : 0,
+                    m_natMirror.size(), m_naptMirror.size(), lookups);
+
+    m_flowsInstalled = m_flowsFlushed = 0;
+}
+
 /* To check the port init is done or not */
 bool NatSync::isPortInitDone(DBConnector *app_db)
 {
@@ -243,6 +318,12 @@ void NatSync::onMsg(int nlmsg_type, struct nl_object *obj)
   
     nlmsg_type = NFNL_MSG_TYPE(nlmsg_type);
 
+    /* The rate window starts with the notification installing its first flow */
+    if (m_flowsInstalled == 0)
+    {
+        m_rateStart = chrono::steady_clock::now();
+    }
+
     SWSS_LOG_DEBUG("Conntrack entry notification, msg type :%s (%d)",
         (((nlmsg_type == IPCTNL_MSG_CT_NEW) ? "CT_NEW" : ((nlmsg_type == IPCTNL_MSG_CT_DELETE) ? "CT_DELETE" : "OTHER"))),
         nlmsg_type);
@@ -302,9 +383,8 @@ void NatSync::onMsg(int nlmsg_type, struct nl_object *obj)
 bool NatSync::matchingSnaptPoolExists(const IpAddress &natIp)
 {
     string key             = natIp.to_string();
-    std::vector<FieldValueTuple> values;
 
-    if (m_naptPoolCheckTable.get(key, values))
+    if (m_naptPoolMirror.exists(key))
     {
         SWSS_LOG_INFO("Matching pool IP exists for NAT IP %s", key.c_str());
         return true;
@@ -317,9 +397,8 @@ bool NatSync::matchingSnaptEntryExists(const naptEntry &entry)
 {
     string key             = entry.orig_src_ip.to_string() + ":" + to_string(entry.orig_src_l4_port);
     string reverseEntryKey = entry.nat_src_ip.to_string() + ":" + to_string(entry.nat_src_l4_port);
-    std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (m_naptMirror.exists(key) || m_naptMirror.exists(reverseEntryKey))
     {
         SWSS_LOG_INFO("Matching SNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -332,9 +411,8 @@ bool NatSync::matchingDnaptEntryExists(const naptEntry &entry)
 {
     string key             = entry.orig_dest_ip.to_string() + ":" + to_string(entry.orig_dst_l4_port);
     string reverseEntryKey = entry.nat_dest_ip.to_string() + ":" + to_string(entry.nat_dst_l4_port);
-    std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (m_naptMirror.exists(key) || m_naptMirror.exists(reverseEntryKey))
     {
         SWSS_LOG_INFO("Matching DNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -400,25 +478,22 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
         string tmpKey             = key + entry.orig_src_ip.to_string() + ":" + entry.orig_dest_ip.to_string();
         string tmpReverseEntryKey = reverseEntryKey + entry.nat_dest_ip.to_string() + ":" + entry.nat_src_ip.to_string();
 
-        std::vector<FieldValueTuple> values;
-        if (m_twiceNatCheckTable.get(tmpKey, values))
+        bool isStatic = false;
+        if (m_twiceNatMirror.find(tmpKey, isStatic, !addFlag))
         {
             src_port_natted = dst_port_natted = false;
 
-            for (auto iter : values)
+            /* If a matching Static Twice NAT entry exists in the APP_DB,
+             * it has higher priority than the dynamic twice nat entry. */
+            if (isStatic)
             {
-                /* If a matching Static Twice NAT entry exists in the APP_DB,
-                 * it has higher priority than the dynamic twice nat entry. */
-                if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
+                SWSS_LOG_INFO("Static Twice NAT %s: entry exists, not processing twice NAT entry notification", opStr.c_str());
+                if (m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    SWSS_LOG_INFO("Static Twice NAT %s: entry exists, not processing twice NAT entry notification", opStr.c_str());
-                    if (m_AppRestartAssist->isWarmStartInProgress())
-                    {
-                       m_AppRestartAssist->insertToMap(APP_NAT_TWICE_TABLE_NAME, tmpKey, fvVector, (!addFlag));
-                       m_AppRestartAssist->insertToMap(APP_NAT_TWICE_TABLE_NAME, tmpReverseEntryKey, reverseFvVector, (!addFlag));
-                    }
-                    return 1;
+                   m_AppRestartAssist->insertToMap(APP_NAT_TWICE_TABLE_NAME, tmpKey, fvVector, (!addFlag));
+                   m_AppRestartAssist->insertToMap(APP_NAT_TWICE_TABLE_NAME, tmpReverseEntryKey, reverseFvVector, (!addFlag));
                 }
+                return 1;
             }
             if (addFlag)
             {
@@ -446,23 +521,20 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
             reverseEntryKey += ":" + nat_dst_l4_port + ":" + entry.nat_src_ip.to_string()
                           + ":" + nat_src_l4_port;
 
-            std::vector<FieldValueTuple> values;
+            bool isStatic = false;
             /* If a matching Static Twice NAPT entry exists in the APP_DB,
              * it has higher priority than the dynamic twice napt entry. */
-            if (m_twiceNaptCheckTable.get(key, values))
+            if (m_twiceNaptMirror.find(key, isStatic, !addFlag))
             {
-                for (auto iter : values)
+                if (isStatic)
                 {
-                    if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
+                    SWSS_LOG_INFO("Static Twice NAPT %s: entry exists, not processing dynamic twice NAPT entry", opStr.c_str());
+                    if (m_AppRestartAssist->isWarmStartInProgress())
                     {
-                        SWSS_LOG_INFO("Static Twice NAPT %s: entry exists, not processing dynamic twice NAPT entry", opStr.c_str());
-                        if (m_AppRestartAssist->isWarmStartInProgress())
-                        {
-                            m_AppRestartAssist->insertToMap(APP_NAPT_TWICE_TABLE_NAME, key, fvVector, (!addFlag));
-                            m_AppRestartAssist->insertToMap(APP_NAPT_TWICE_TABLE_NAME, reverseEntryKey, reverseFvVector, (!addFlag));
-                        }
-                        return 1;
+                        m_AppRestartAssist->insertToMap(APP_NAPT_TWICE_TABLE_NAME, key, fvVector, (!addFlag));
+                        m_AppRestartAssist->insertToMap(APP_NAPT_TWICE_TABLE_NAME, reverseEntryKey, reverseFvVector, (!addFlag));
                     }
+                    return 1;
                 }
                 if (addFlag)
                 {
@@ -490,10 +562,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.set(key, fvVector);
+                    setAppEntry(m_naptTwiceTable, m_twiceNaptMirror, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s added to APP_DB", key.c_str());
                     setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
-                    m_naptTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    m_flowsInstalled++;
+                    setAppEntry(m_naptTwiceTable, m_twiceNaptMirror, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -506,9 +579,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.del(key);
+                    delAppEntry(m_naptTwiceTable, m_twiceNaptMirror, key);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s deleted from APP_DB", key.c_str());
-                    m_naptTwiceTable.del(reverseEntryKey);
+                    delAppEntry(m_naptTwiceTable, m_twiceNaptMirror, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -531,10 +604,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.set(key, fvVector);
+                    setAppEntry(m_natTwiceTable, m_twiceNatMirror, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s added to APP_DB", key.c_str());
                     setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
-                    m_natTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    m_flowsInstalled++;
+                    setAppEntry(m_natTwiceTable, m_twiceNatMirror, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -547,9 +621,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.del(key);
+                    delAppEntry(m_natTwiceTable, m_twiceNatMirror, key);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s deleted from APP_DB", key.c_str());
-                    m_natTwiceTable.del(reverseEntryKey);
+                    delAppEntry(m_natTwiceTable, m_twiceNatMirror, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -587,23 +661,20 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 key             += ":" + src_l4_port;
                 reverseEntryKey += ":" + nat_src_l4_port;
 
-                std::vector<FieldValueTuple> values;
+                bool isStatic = false;
                 /* We check for existence of reverse nat entry in the app-db because the same dnat static entry
                  * would be reported as snat entry from the kernel if a packet that is forwarded in the kernel
                  * is matched by the iptables rules corresponding to the dnat static entry */
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = m_naptMirror.find(key, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAPT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("SNAPT %s: static entry exists, not processing the NAPT notification", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAPT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("SNAPT %s: static entry exists, not processing the NAPT notification", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -621,22 +692,19 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(key);
+                                delAppEntry(m_naptTable, m_naptMirror, key);
                                 SWSS_LOG_NOTICE("SNAPT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = m_naptMirror.find(reverseEntryKey, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAPT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("SNAPT %s: static reverse entry exists, not processing dynamic NAPT entry", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAPT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("SNAPT %s: static reverse entry exists, not processing dynamic NAPT entry", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -654,7 +722,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(reverseEntryKey);
+                                delAppEntry(m_naptTable, m_naptMirror, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -684,10 +752,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.set(key, fvVector);
+                            setAppEntry(m_naptTable, m_naptMirror, key, fvVector);
                             SWSS_LOG_NOTICE("SNAPT entry with key %s added to APP_DB", key.c_str());
                             setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                            m_naptTable.set(reverseEntryKey, reverseFvVector);
+                            m_flowsInstalled++;
+                            setAppEntry(m_naptTable, m_naptMirror, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -701,20 +770,17 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 key             += entry.orig_src_ip.to_string();
                 reverseEntryKey += entry.nat_src_ip.to_string();
 
-                std::vector<FieldValueTuple> values;
+                bool isStatic = false;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = m_natMirror.find(key, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("SNAT %s: static entry exists, not processing the NAT notification", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("SNAT %s: static entry exists, not processing the NAT notification", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -732,22 +798,19 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(key);
+                                delAppEntry(m_natTable, m_natMirror, key);
                                 SWSS_LOG_NOTICE("SNAT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = m_natMirror.find(reverseEntryKey, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("SNAT %s: static reverse entry exists, not adding dynamic NAT entry", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("SNAT %s: static reverse entry exists, not adding dynamic NAT entry", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -765,7 +828,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(reverseEntryKey);
+                                delAppEntry(m_natTable, m_natMirror, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -789,10 +852,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_natTable.set(key, fvVector);
+                            setAppEntry(m_natTable, m_natMirror, key, fvVector);
                             SWSS_LOG_NOTICE("SNAT entry with key %s added to APP_DB", key.c_str());
                             setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                            m_natTable.set(reverseEntryKey, reverseFvVector);
+                            m_flowsInstalled++;
+                            setAppEntry(m_natTable, m_natMirror, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -829,20 +893,17 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 key             += ":" + dst_l4_port;
                 reverseEntryKey += ":" + nat_dst_l4_port;
 
-                std::vector<FieldValueTuple> values;
+                bool isStatic = false;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = m_naptMirror.find(key, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAPT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("DNAPT %s: static entry exists, not processing the NAPT notification", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAPT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("DNAPT %s: static entry exists, not processing the NAPT notification", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -851,21 +912,18 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(key);
+                            delAppEntry(m_naptTable, m_naptMirror, key);
                             SWSS_LOG_NOTICE("DNAPT entry with key %s deleted from APP_DB", key.c_str());
                         }
                      }
-                     if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                     if ((reverseEntryExists = m_naptMirror.find(reverseEntryKey, isStatic, !addFlag)))
                      {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAPT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("DNAPT %s: static reverse entry exists, not adding dynamic NAPT entry", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAPT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("DNAPT %s: static reverse entry exists, not adding dynamic NAPT entry", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -874,7 +932,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(reverseEntryKey);
+                            delAppEntry(m_naptTable, m_naptMirror, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -894,10 +952,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_naptTable.set(key, fvVector);
+                        setAppEntry(m_naptTable, m_naptMirror, key, fvVector);
                         SWSS_LOG_NOTICE("DNAPT entry with key %s added to APP_DB", key.c_str());
                         setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                        m_naptTable.set(reverseEntryKey, reverseFvVector);
+                        m_flowsInstalled++;
+                        setAppEntry(m_naptTable, m_naptMirror, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
@@ -909,20 +968,17 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 key             += entry.orig_dest_ip.to_string();
                 reverseEntryKey += entry.nat_dest_ip.to_string();
 
-                std::vector<FieldValueTuple> values;
+                bool isStatic = false;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = m_natMirror.find(key, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("DNAT %s: static entry exists, not processing the NAT notification", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("DNAT %s: static entry exists, not processing the NAT notification", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -931,21 +987,18 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(key);
+                            delAppEntry(m_natTable, m_natMirror, key);
                             SWSS_LOG_NOTICE("DNAT entry with key %s deleted from APP_DB", key.c_str());
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = m_natMirror.find(reverseEntryKey, isStatic, !addFlag)))
                     {
-                        for (auto iter : values)
+                        if (isStatic)
                         {
-                            if ((fvField(iter) == "entry_type") && (fvValue(iter) == "static"))
-                            {
-                                /* If a matching Static NAT entry exists in the APP_DB,
-                                 * it has higher priority than the dynamic napt entry. */
-                                SWSS_LOG_INFO("DNAT %s: static reverse entry exists, not adding dynamic NAT entry", opStr.c_str());
-                                return 1;
-                            }
+                            /* If a matching Static NAT entry exists in the APP_DB,
+                             * it has higher priority than the dynamic napt entry. */
+                            SWSS_LOG_INFO("DNAT %s: static reverse entry exists, not adding dynamic NAT entry", opStr.c_str());
+                            return 1;
                         }
                         if (addFlag)
                         {
@@ -954,7 +1007,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(reverseEntryKey);
+                            delAppEntry(m_natTable, m_natMirror, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -968,10 +1021,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_natTable.set(key, fvVector);
+                        setAppEntry(m_natTable, m_natMirror, key, fvVector);
                         SWSS_LOG_NOTICE("DNAT entry with key %s added to APP_DB", key.c_str());
                         setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                        m_natTable.set(reverseEntryKey, reverseFvVector);
+                        m_flowsInstalled++;
+                        setAppEntry(m_natTable, m_natMirror, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
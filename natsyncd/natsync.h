@@ -24,9 +24,12 @@
 #include "warmRestartAssist.h"
 #include "ipaddress.h"
 #include "nfnetlink.h"
+#include "select.h"
+#include "natmirror.h"
 #include <linux/netfilter/nfnetlink_conntrack.h>
 #include <linux/netfilter/nf_conntrack_common.h>
 #include <unistd.h>
+#include <chrono>
 
 // The timeout value (in seconds) for natsyncd reconcilation logic
 #define DEFAULT_NATSYNC_WARMSTART_TIMER 30
@@ -36,6 +39,9 @@
 
 #define RESTORE_NAT_WAIT_TIME_OUT 120
 
+/* Interval (in seconds) of the flow install rate reports */
+#define NAT_RATE_REPORT_INTERVAL 10
+
 namespace swss {
 
 struct naptEntry;
@@ -48,6 +54,13 @@ public:
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    /* The mirrors of the APP_DB tables are updated on their keyspace notifications */
+    void addMirrorSelectables(Select &s);
+    bool syncMirror(Selectable *sel);
+
+    /* Write the APP_DB updates queued while processing conntrack notifications */
+    void flush();
+
     bool isNatRestoreDone();
     bool isPortInitDone(DBConnector *app_db);
 
@@ -66,23 +79,35 @@ private:
     bool        matchingDnaptEntryExists(const naptEntry &entry);
     int         addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFlag);
 
+    void        setAppEntry(ProducerStateTable &table, NatTableMirror &mirror, const std::string &key,
+                            const std::vector<FieldValueTuple> &values);
+    void        delAppEntry(ProducerStateTable &table, NatTableMirror &mirror, const std::string &key);
+
     std::shared_ptr<swss::NotificationProducer> setTimeoutNotifier;
 
+    RedisPipeline     *m_pipeline;
+
     ProducerStateTable m_natTable;
     ProducerStateTable m_naptTable;
     ProducerStateTable m_natTwiceTable;
     ProducerStateTable m_naptTwiceTable;
 
-    Table              m_natCheckTable;
-    Table              m_naptCheckTable;
-    Table              m_naptPoolCheckTable;
-    Table              m_twiceNatCheckTable;
-    Table              m_twiceNaptCheckTable;
+    NatTableMirror     m_natMirror;
+    NatTableMirror     m_naptMirror;
+    NatTableMirror     m_naptPoolMirror;
+    NatTableMirror     m_twiceNatMirror;
+    NatTableMirror     m_twiceNaptMirror;
 
     Table              m_stateNatRestoreTable;
     AppRestartAssist  *m_AppRestartAssist;
 
     NfNetlink          *nfsock;
+
+    /* Flows installed in the current rate window, and written to APP_DB */
+    size_t             m_flowsInstalled = 0;
+    size_t             m_flowsFlushed = 0;
+    std::chrono::steady_clock::time_point m_rateStart;
+    std::chrono::steady_clock::time_point m_rateEnd;
 };
 
 struct naptEntry
@@ -11,6 +11,9 @@
 using namespace std;
 using namespace swss;
 
+/* Timeout (in milliseconds) of the select, to report the flow install rate when idle */
+#define NATSYNC_SELECT_TIMEOUT 1000
+
 int main(int argc, char **argv)
 {
     Logger::linkToDbNative("natsyncd");
@@ -71,22 +74,30 @@ int main(int argc, char **argv)
             nfnl.dumpRequest(IPCTNL_MSG_CT_GET);
 
             s.addSelectable(&nfnl);
+            sync.addMirrorSelectables(s);
             while (true)
             {
                 Selectable *temps;
-                s.select(&temps);
-                /*
-                 * If warmstart is in progress, we check the reconcile timer,
-                 * if timer expired, we stop the timer and start the reconcile process
-                 */
-                if (sync.getRestartAssist()->isWarmStartInProgress())
+                if (s.select(&temps, NATSYNC_SELECT_TIMEOUT) == Select::OBJECT)
                 {
-                    if (sync.getRestartAssist()->checkReconcileTimer(temps))
+                    sync.syncMirror(temps);
+
+                    /*
+                     * If warmstart is in progress, we check the reconcile timer,
+                     * if timer expired, we stop the timer and start the reconcile process
+                     */
+                    if (sync.getRestartAssist()->isWarmStartInProgress())
                     {
-                        sync.getRestartAssist()->stopReconcileTimer(s);
-                        sync.getRestartAssist()->reconcile();
+                        if (sync.getRestartAssist()->checkReconcileTimer(temps))
+                        {
+                            sync.getRestartAssist()->stopReconcileTimer(s);
+                            sync.getRestartAssist()->reconcile();
+                        }
                     }
                 }
+
+                /* The APP_DB updates are written once per netlink read */
+                sync.flush();
             }
         }
         catch (const std::exception& e)
@@ -20,12 +20,14 @@ using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *cfgDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
-    m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
-    m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
+    m_cfgPeerSwitchTable(cfgDb, CFG_PEER_SWITCH_TABLE_NAME),
     m_cfgVlanInterfaceTable(cfgDb, CFG_VLAN_INTF_TABLE_NAME),
-    m_cfgPeerSwitchTable(cfgDb, CFG_PEER_SWITCH_TABLE_NAME)
+    m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
+    m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
+    m_processedCount(0),
+    m_lastStatsCount(0)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -56,6 +58,107 @@ bool NeighSync::isNeighRestoreDone()
     return false;
 }
 
+void NeighSync::publishStats(Table &statsTable)
+{
+    uint64_t rate = (m_processedCount - m_lastStatsCount) / NEIGH_STATS_INTERVAL;
+    m_lastStatsCount = m_processedCount;
+
+    statsTable.set(NEIGH_STATS_KEY, {{"processed", to_string(m_processedCount)},
+                                     {"processed_per_sec", to_string(rate)}});
+    SWSS_LOG_INFO("Processed %s neighbor messages, %s per second",
+                  to_string(m_processedCount).c_str(), to_string(rate).c_str());
+}
+
+void NeighSync::loadConfigTables()
+{
+    doPeerSwitchTask(m_cfgPeerSwitchTable);
+    doInterfaceTask(m_cfgVlanInterfaceTable);
+    doInterfaceTask(m_cfgLagInterfaceTable);
+    doInterfaceTask(m_cfgInterfaceTable);
+}
+
+void NeighSync::addConfigSelectables(Select &s)
+{
+    s.addSelectable(&m_cfgPeerSwitchTable);
+    s.addSelectable(&m_cfgVlanInterfaceTable);
+    s.addSelectable(&m_cfgLagInterfaceTable);
+    s.addSelectable(&m_cfgInterfaceTable);
+}
+
+bool NeighSync::processConfigTable(Selectable *temps)
+{
+    if (temps == &m_cfgPeerSwitchTable)
+    {
+        doPeerSwitchTask(m_cfgPeerSwitchTable);
+        return true;
+    }
+
+    if (temps == &m_cfgVlanInterfaceTable || temps == &m_cfgLagInterfaceTable ||
+        temps == &m_cfgInterfaceTable)
+    {
+        doInterfaceTask(*static_cast<SubscriberStateTable *>(temps));
+        return true;
+    }
+
+    return false;
+}
+
+void NeighSync::doPeerSwitchTask(SubscriberStateTable &table)
+{
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    table.pops(entries);
+
+    for (const auto &entry : entries)
+    {
+        if (kfvOp(entry) == SET_COMMAND)
+        {
+            m_peerSwitches.insert(kfvKey(entry));
+        }
+        else
+        {
+            m_peerSwitches.erase(kfvKey(entry));
+        }
+    }
+}
+
+void NeighSync::doInterfaceTask(SubscriberStateTable &table)
+{
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    table.pops(entries);
+
+    for (const auto &entry : entries)
+    {
+        const string &key = kfvKey(entry);
+
+        /* Only the interface entries carry the link local setting, not the IP prefixes */
+        if (key.find(table.getTableNameSeparator()) != string::npos)
+        {
+            continue;
+        }
+
+        bool enabled = false;
+        if (kfvOp(entry) == SET_COMMAND)
+        {
+            for (const auto &fv : kfvFieldsValues(entry))
+            {
+                if (fvField(fv) == "ipv6_use_link_local_only")
+                {
+                    enabled = fvValue(fv) == "enable";
+                }
+            }
+        }
+
+        if (enabled)
+        {
+            m_linkLocalIntfs.insert(key);
+        }
+        else
+        {
+            m_linkLocalIntfs.erase(key);
+        }
+    }
+}
+
 void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
     char ipStr[MAX_ADDR_SIZE + 1] = {0};
@@ -64,14 +167,14 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     string key;
     string family;
     string intfName;
-    std::vector<std::string> peerSwitchKeys;
-    m_cfgPeerSwitchTable.getKeys(peerSwitchKeys);
-    bool is_dualtor = peerSwitchKeys.size() > 0;
+    bool is_dualtor = !m_peerSwitches.empty();
 
     if ((nlmsg_type != RTM_NEWNEIGH) && (nlmsg_type != RTM_GETNEIGH) &&
         (nlmsg_type != RTM_DELNEIGH))
         return;
 
+    m_processedCount++;
+
     if (rtnl_neigh_get_family(neigh) == AF_INET)
         family = IPV4_NAME;
     else if (rtnl_neigh_get_family(neigh) == AF_INET6)
@@ -192,46 +295,18 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 /* To check the ipv6 link local is enabled on a given port */
 bool NeighSync::isLinkLocalEnabled(const string &port)
 {
-    vector<FieldValueTuple> values;
-
-    if (!port.compare(0, strlen("Vlan"), "Vlan"))
-    {
-        if (!m_cfgVlanInterfaceTable.get(port, values))
-        {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
-        }
-    }
-    else if (!port.compare(0, strlen("PortChannel"), "PortChannel"))
-    {
-        if (!m_cfgLagInterfaceTable.get(port, values))
-        {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
-        }
-    }
-    else if (!port.compare(0, strlen("Ethernet"), "Ethernet"))
-    {
-        if (!m_cfgInterfaceTable.get(port, values))
-        {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
-        }
-    }
-    else
+    if (port.compare(0, strlen("Vlan"), "Vlan") &&
+        port.compare(0, strlen("PortChannel"), "PortChannel") &&
+        port.compare(0, strlen("Ethernet"), "Ethernet"))
     {
         SWSS_LOG_INFO("IPv6 Link local is not supported for %s ", port.c_str());
         return false;
     }
 
-    auto it = std::find_if(values.begin(), values.end(), [](const FieldValueTuple& t){ return t.first == "ipv6_use_link_local_only";});
-    if (it != values.end())
+    if (m_linkLocalIntfs.find(port) != m_linkLocalIntfs.end())
     {
-        if (it->second == "enable")
-        {
-            SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
-            return true;
-        }
+        SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
+        return true;
     }
 
     SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
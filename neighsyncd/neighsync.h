@@ -1,8 +1,14 @@
 #ifndef __NEIGHSYNC__
 #define __NEIGHSYNC__
 
+#include <set>
+#include <string>
+
 #include "dbconnector.h"
+#include "table.h"
 #include "producerstatetable.h"
+#include "subscriberstatetable.h"
+#include "select.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
@@ -16,6 +22,11 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 180
 
+/* Interval (in seconds) of the neighsyncd statistics written to COUNTERS_DB */
+#define NEIGH_STATS_INTERVAL 10
+#define COUNTERS_NEIGHSYNCD_TABLE "NEIGHSYNCD_STATS"
+#define NEIGH_STATS_KEY "NEIGH_SYNC"
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -30,17 +41,49 @@ public:
 
     bool isNeighRestoreDone();
 
+    /*
+     * The CONFIG_DB tables consulted for every neighbor are cached locally
+     * and kept up to date from their keyspace notifications.
+     * loadConfigTables() applies the current content, the subscribers then
+     * need to be added to the select loop, where processConfigTable() must
+     * be called with every selected object.
+     */
+    void loadConfigTables();
+    void addConfigSelectables(Select &s);
+    bool processConfigTable(Selectable *temps);
+
+    /* Number of netlink neighbor messages handled so far */
+    uint64_t getProcessedCount() const
+    {
+        return m_processedCount;
+    }
+
+    /*
+     * Write the processed message count and the rate since the previous call,
+     * expected every NEIGH_STATS_INTERVAL seconds, to NEIGH_STATS_KEY
+     */
+    void publishStats(Table &statsTable);
+
     AppRestartAssist *getRestartAssist()
     {
         return m_AppRestartAssist;
     }
 
 private:
-    Table m_stateNeighRestoreTable, m_cfgPeerSwitchTable;
+    Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
-    Table m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+    SubscriberStateTable m_cfgPeerSwitchTable;
+    SubscriberStateTable m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+
+    std::set<std::string> m_peerSwitches;
+    /* Interfaces with ipv6_use_link_local_only enabled */
+    std::set<std::string> m_linkLocalIntfs;
+    uint64_t m_processedCount;
+    uint64_t m_lastStatsCount;
 
+    void doPeerSwitchTask(SubscriberStateTable &table);
+    void doInterfaceTask(SubscriberStateTable &table);
     bool isLinkLocalEnabled(const std::string &port);
 };
 
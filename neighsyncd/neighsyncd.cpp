@@ -4,6 +4,8 @@
 #include <chrono>
 #include "logger.h"
 #include "select.h"
+#include "selectabletimer.h"
+#include "table.h"
 #include "netdispatcher.h"
 #include "netlink.h"
 #include "neighsyncd/neighsync.h"
@@ -19,8 +21,11 @@ int main(int argc, char **argv)
     RedisPipeline pipelineAppDB(&appDb);
     DBConnector stateDb("STATE_DB", 0);
     DBConnector cfgDb("CONFIG_DB", 0);
+    DBConnector countersDb("COUNTERS_DB", 0);
+    Table statsTable(&countersDb, COUNTERS_NEIGHSYNCD_TABLE);
 
     NeighSync sync(&pipelineAppDB, &stateDb, &cfgDb);
+    sync.loadConfigTables();
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWNEIGH, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELNEIGH, &sync);
@@ -31,6 +36,7 @@ int main(int argc, char **argv)
         {
             NetLink netlink;
             Select s;
+            SelectableTimer statsTimer(timespec{NEIGH_STATS_INTERVAL, 0});
 
             using namespace std::chrono;
             /*
@@ -67,10 +73,24 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+            sync.addConfigSelectables(s);
+            s.addSelectable(&statsTimer);
+            statsTimer.start();
+
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                if (temps == &statsTimer)
+                {
+                    sync.publishStats(statsTable);
+                }
+                else
+                {
+                    sync.processConfigTable(temps);
+                }
+
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -83,6 +103,9 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                /* NEIGH_TABLE is buffered, write what this netlink batch produced */
+                pipelineAppDB.flush();
             }
         }
         catch (const std::exception& e)
@@ -27,6 +27,7 @@ extern sai_acl_api_t*    sai_acl_api;
 extern sai_port_api_t*   sai_port_api;
 extern sai_switch_api_t* sai_switch_api;
 extern sai_object_id_t   gSwitchId;
+extern size_t            gMaxBulkSize;
 extern PortsOrch*        gPortsOrch;
 extern CrmOrch *gCrmOrch;
 extern SwitchOrch *gSwitchOrch;
@@ -1249,11 +1250,20 @@ bool AclRule::createRule()
     SWSS_LOG_ENTER();
 
     vector<sai_attribute_t> rule_attrs;
-    sai_object_id_t range_objects[2];
-    sai_object_list_t range_object_list = {0, range_objects};
+    if (!getRuleAttrs(rule_attrs))
+    {
+        return false;
+    }
+
+    auto status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    return createRulePost(status);
+}
+
+bool AclRule::getRuleAttrs(vector<sai_attribute_t> &rule_attrs)
+{
+    SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
-    sai_status_t status;
 
     // store table oid this rule belongs to
     attr.id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
@@ -1277,6 +1287,7 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
+    m_rangeOids.clear();
     if (!m_rangeConfig.empty())
     {
         for (const auto& rangeConfig: m_rangeConfig)
@@ -1287,17 +1298,19 @@ bool AclRule::createRule()
             if (!range)
             {
                 // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
+                AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+                m_rangeOids.clear();
                 return false;
             }
 
             m_ranges.push_back(range);
-            range_objects[range_object_list.count++] = range->getOid();
+            m_rangeOids.push_back(range->getOid());
         }
 
         attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
         attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.objlist = range_object_list;
+        attr.value.aclfield.data.objlist.count = (uint32_t)m_rangeOids.size();
+        attr.value.aclfield.data.objlist.list = m_rangeOids.data();
         rule_attrs.push_back(attr);
     }
 
@@ -1315,7 +1328,13 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    return true;
+}
+
+bool AclRule::createRulePost(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
@@ -1325,7 +1344,7 @@ bool AclRule::createRule()
         }
         SWSS_LOG_ERROR("Failed to create ACL rule %s, rv:%d",
                 m_id.c_str(), status);
-        AclRange::remove(range_objects, range_object_list.count);
+        AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
         decreaseNextHopRefCount();
     }
 
@@ -1392,6 +1411,13 @@ bool AclRule::removeRule()
     }
 
     auto status = sai_acl_api->remove_acl_entry(m_ruleOid);
+    return removeRulePost(status);
+}
+
+bool AclRule::removeRulePost(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         if (status == SAI_STATUS_ITEM_NOT_FOUND)
@@ -1428,6 +1454,103 @@ bool AclRule::remove()
     return res;
 }
 
+bool AclRule::isBulkSupported() const
+{
+    return true;
+}
+
+bool AclRule::bulkCreateCounter(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_createCounter || m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    vector<sai_attribute_t> counter_attrs;
+    getCounterAttrs(counter_attrs);
+    bulker.create_entry(&m_counterOid, (uint32_t)counter_attrs.size(), counter_attrs.data());
+
+    return true;
+}
+
+bool AclRule::bulkCreateCounterPost()
+{
+    // The bulker leaves the OID of an object it failed to create null
+    return createCounterPost(m_counterOid != SAI_NULL_OBJECT_ID ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE);
+}
+
+bool AclRule::bulkCreateRule(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_attribute_t> rule_attrs;
+    if (!getRuleAttrs(rule_attrs))
+    {
+        removeCounter();
+        return false;
+    }
+
+    bulker.create_entry(&m_ruleOid, (uint32_t)rule_attrs.size(), rule_attrs.data());
+
+    return true;
+}
+
+bool AclRule::bulkCreateRulePost()
+{
+    if (!createRulePost(m_ruleOid != SAI_NULL_OBJECT_ID ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE))
+    {
+        removeCounter();
+        return false;
+    }
+
+    return true;
+}
+
+bool AclRule::bulkRemoveRule(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_ruleOid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    bulker.remove_entry(&m_bulkRemoveStatus, m_ruleOid);
+
+    return true;
+}
+
+bool AclRule::bulkRemoveRulePost()
+{
+    if (!removeRulePost(m_bulkRemoveStatus))
+    {
+        return false;
+    }
+
+    return removeRanges();
+}
+
+bool AclRule::bulkRemoveCounter(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_counterOid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    bulker.remove_entry(&m_bulkRemoveStatus, m_counterOid);
+
+    return true;
+}
+
+bool AclRule::bulkRemoveCounterPost()
+{
+    return removeCounterPost(m_bulkRemoveStatus);
+}
+
 void AclRule::updateInPorts()
 {
     SWSS_LOG_ENTER();
@@ -1885,7 +2008,6 @@ bool AclRule::createCounter()
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> counter_attrs;
 
     if (m_counterOid != SAI_NULL_OBJECT_ID)
@@ -1893,6 +2015,16 @@ bool AclRule::createCounter()
         return true;
     }
 
+    getCounterAttrs(counter_attrs);
+
+    auto status = sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data());
+    return createCounterPost(status);
+}
+
+void AclRule::getCounterAttrs(vector<sai_attribute_t> &counter_attrs) const
+{
+    sai_attribute_t attr;
+
     attr.id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
     attr.value.oid = m_pTable->getOid();
     counter_attrs.push_back(attr);
@@ -1903,8 +2035,13 @@ bool AclRule::createCounter()
         attr.value.booldata = true;
         counter_attrs.push_back(attr);
     }
+}
 
-    if (sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data()) != SAI_STATUS_SUCCESS)
+bool AclRule::createCounterPost(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
         return false;
@@ -1946,7 +2083,15 @@ bool AclRule::removeCounter()
         return true;
     }
 
-    if (sai_acl_api->remove_acl_counter(m_counterOid) != SAI_STATUS_SUCCESS)
+    auto status = sai_acl_api->remove_acl_counter(m_counterOid);
+    return removeCounterPost(status);
+}
+
+bool AclRule::removeCounterPost(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove ACL counter for rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
         return false;
@@ -2294,6 +2439,12 @@ bool AclRuleMirror::removeRule()
     return deactivate();
 }
 
+bool AclRuleMirror::isBulkSupported() const
+{
+    // The entry follows the state of the mirror session
+    return false;
+}
+
 bool AclRuleMirror::activate()
 {
     SWSS_LOG_ENTER();
@@ -3192,6 +3343,12 @@ bool AclRuleDTelWatchListEntry::createRule()
     return activate();
 }
 
+bool AclRuleDTelWatchListEntry::isBulkSupported() const
+{
+    // The entry follows the state of the INT session
+    return false;
+}
+
 bool AclRuleDTelWatchListEntry::removeRule()
 {
     return deactivate();
@@ -4164,6 +4321,59 @@ void AclOrch::queryAclActionAttrEnumValues(const string &action_name,
     m_switchOrch->set_switch_capability(fvVector);
 }
 
+/*
+ * sai_acl_api_t has no bulk calls, the ACL bulkers program counters and entries
+ * through the generic SAI bulk object API, one call per flushed batch.
+ */
+static sai_status_t createAclCounters(sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+        const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+        sai_object_id_t *object_id, sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, SAI_OBJECT_TYPE_ACL_COUNTER, object_count,
+            attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+static sai_status_t removeAclCounters(uint32_t object_count, const sai_object_id_t *object_id,
+        sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(SAI_OBJECT_TYPE_ACL_COUNTER, object_count, object_id, mode, object_statuses);
+}
+
+static sai_status_t createAclEntries(sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+        const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+        sai_object_id_t *object_id, sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, SAI_OBJECT_TYPE_ACL_ENTRY, object_count,
+            attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+static sai_status_t removeAclEntries(uint32_t object_count, const sai_object_id_t *object_id,
+        sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(SAI_OBJECT_TYPE_ACL_ENTRY, object_count, object_id, mode, object_statuses);
+}
+
+template <>
+ObjectBulker<sai_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_acl_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_t object_type) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size),
+    error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR)
+{
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_ACL_COUNTER:
+            create_entries = createAclCounters;
+            remove_entries = removeAclCounters;
+            break;
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+            create_entries = createAclEntries;
+            remove_entries = removeAclEntries;
+            break;
+        default:
+            throw std::invalid_argument("Invalid object type for sai_acl_api_t: " + sai_serialize_object_type(object_type));
+    }
+}
+
 AclOrch::AclOrch(vector<TableConnector>& connectors, DBConnector* stateDb, SwitchOrch *switchOrch,
         PortsOrch *portOrch, MirrorOrch *mirrorOrch, NeighOrch *neighOrch, RouteOrch *routeOrch, DTelOrch *dtelOrch) :
         Orch(connectors),
@@ -4180,7 +4390,9 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, DBConnector* stateDb, Switc
             StatsMode::READ,
             ACL_COUNTER_DEFAULT_POLLING_INTERVAL_MS,
             ACL_COUNTER_DEFAULT_ENABLED_STATE
-        )
+        ),
+        gAclCounterBulker(sai_acl_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_ACL_COUNTER),
+        gAclEntryBulker(sai_acl_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_ACL_ENTRY)
 {
     SWSS_LOG_ENTER();
 
@@ -5486,6 +5698,10 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    // Rules added to or removed from the tables through the ACL bulkers
+    std::deque<std::pair<SyncMap::iterator, AclRuleContext>> bulk_contexts;
+    set<string> bulk_keys;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -5498,6 +5714,13 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 
         SWSS_LOG_INFO("OP: %s, TABLE_ID: %s, RULE_ID: %s", op.c_str(), table_id.c_str(), rule_id.c_str());
 
+        // Complete the batched operation on the rule before handling the next one
+        if (bulk_keys.find(key) != bulk_keys.end())
+        {
+            processBulkAclRules(consumer, bulk_contexts);
+            bulk_keys.clear();
+        }
+
         if (table_id.empty())
         {
             SWSS_LOG_WARN("ACL rule with RULE_ID: %s is not valid as TABLE_ID is empty", rule_id.c_str());
@@ -5546,6 +5769,7 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             {
                 SWSS_LOG_ERROR("Error while creating ACL rule %s: %s", rule_id.c_str(), e.what());
                 it = consumer.m_toSync.erase(it);
+                processBulkAclRules(consumer, bulk_contexts);
                 return;
             }
             bool bHasTCPFlag = false;
@@ -5630,7 +5854,14 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
-                if (addAclRule(newRule, table_id))
+                if (newRule->isBulkSupported() && !isUsingEgrSetDscp(table_id) &&
+                    m_AclTables[table_oid].rules.find(rule_id) == m_AclTables[table_oid].rules.end())
+                {
+                    bulk_contexts.emplace_back(it, AclRuleContext(newRule, table_id, table_oid, true));
+                    bulk_keys.insert(key);
+                    it++;
+                }
+                else if (addAclRule(newRule, table_id))
                 {
                     setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
                     it = consumer.m_toSync.erase(it);
@@ -5651,7 +5882,25 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if (removeAclRule(table_id, rule_id))
+            sai_object_id_t table_oid = getTableById(table_id);
+            shared_ptr<AclRule> rule;
+            if (table_oid != SAI_NULL_OBJECT_ID)
+            {
+                auto rule_it = m_AclTables[table_oid].rules.find(rule_id);
+                if (rule_it != m_AclTables[table_oid].rules.end())
+                {
+                    rule = rule_it->second;
+                }
+            }
+
+            if (rule && rule->isBulkSupported() &&
+                m_egrDscpRuleMetadata.find(table_id + ":" + rule_id) == m_egrDscpRuleMetadata.end())
+            {
+                bulk_contexts.emplace_back(it, AclRuleContext(rule, table_id, table_oid, false));
+                bulk_keys.insert(key);
+                it++;
+            }
+            else if (removeAclRule(table_id, rule_id))
             {
                 removeAclRuleStatus(table_id, rule_id);
                 it = consumer.m_toSync.erase(it);
@@ -5669,6 +5918,140 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
         }
     }
+
+    processBulkAclRules(consumer, bulk_contexts);
+}
+
+void AclOrch::processBulkAclRules(Consumer &consumer, std::deque<std::pair<SyncMap::iterator, AclRuleContext>> &contexts)
+{
+    SWSS_LOG_ENTER();
+
+    if (contexts.empty())
+    {
+        return;
+    }
+
+    // Removal: entries first, then the counters they reference
+    for (auto &it_ctx : contexts)
+    {
+        auto &ctx = it_ctx.second;
+        if (ctx.add)
+        {
+            continue;
+        }
+
+        if (ctx.rule->hasCounter())
+        {
+            deregisterFlexCounter(*ctx.rule);
+        }
+        ctx.rule_queued = ctx.rule->bulkRemoveRule(gAclEntryBulker);
+    }
+    gAclEntryBulker.flush();
+
+    for (auto &it_ctx : contexts)
+    {
+        auto &ctx = it_ctx.second;
+        if (ctx.add)
+        {
+            continue;
+        }
+
+        ctx.ok = !ctx.rule_queued || ctx.rule->bulkRemoveRulePost();
+        if (ctx.ok)
+        {
+            ctx.counter_queued = ctx.rule->bulkRemoveCounter(gAclCounterBulker);
+        }
+    }
+    gAclCounterBulker.flush();
+
+    // Creation: counters first, as entries reference them
+    for (auto &it_ctx : contexts)
+    {
+        auto &ctx = it_ctx.second;
+        if (!ctx.add)
+        {
+            if (ctx.counter_queued)
+            {
+                ctx.ok = ctx.rule->bulkRemoveCounterPost();
+            }
+            continue;
+        }
+
+        ctx.counter_queued = ctx.rule->bulkCreateCounter(gAclCounterBulker);
+    }
+    gAclCounterBulker.flush();
+
+    for (auto &it_ctx : contexts)
+    {
+        auto &ctx = it_ctx.second;
+        if (!ctx.add)
+        {
+            continue;
+        }
+
+        // A rule whose counter could not be created is not installed
+        if (ctx.counter_queued && !ctx.rule->bulkCreateCounterPost())
+        {
+            ctx.ok = false;
+            continue;
+        }
+
+        ctx.rule_queued = ctx.rule->bulkCreateRule(gAclEntryBulker);
+        ctx.ok = ctx.rule_queued;
+    }
+    gAclEntryBulker.flush();
+
+    for (auto &it_ctx : contexts)
+    {
+        auto &it = it_ctx.first;
+        auto &ctx = it_ctx.second;
+        const auto rule_id = ctx.rule->getId();
+        auto &table = m_AclTables[ctx.table_oid];
+
+        if (ctx.add)
+        {
+            if (ctx.rule_queued)
+            {
+                ctx.ok = ctx.rule->bulkCreateRulePost();
+            }
+
+            if (!ctx.ok)
+            {
+                SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                        rule_id.c_str(), table.id.c_str());
+                setAclRuleStatus(ctx.table_id, rule_id, AclObjectStatus::PENDING_CREATION);
+                continue;
+            }
+
+            table.rules[rule_id] = ctx.rule;
+            SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s",
+                    rule_id.c_str(), table.id.c_str());
+            if (ctx.rule->hasCounter())
+            {
+                registerFlexCounter(*ctx.rule);
+            }
+            setAclRuleStatus(ctx.table_id, rule_id, AclObjectStatus::ACTIVE);
+        }
+        else
+        {
+            if (!ctx.ok)
+            {
+                SWSS_LOG_ERROR("Failed to delete ACL rule %s in table %s",
+                        rule_id.c_str(), table.id.c_str());
+                setAclRuleStatus(ctx.table_id, rule_id, AclObjectStatus::PENDING_REMOVAL);
+                continue;
+            }
+
+            table.rules.erase(rule_id);
+            SWSS_LOG_NOTICE("Successfully deleted ACL rule %s in table %s",
+                    rule_id.c_str(), table.id.c_str());
+            removeAclRuleStatus(ctx.table_id, rule_id);
+        }
+
+        consumer.m_toSync.erase(it);
+    }
+
+    contexts.clear();
 }
 
 void AclOrch::doAclTableTypeTask(Consumer &consumer)
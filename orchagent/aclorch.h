@@ -8,6 +8,7 @@
 #include <tuple>
 #include <map>
 #include <condition_variable>
+#include <deque>
 
 #include "orch.h"
 #include "switchorch.h"
@@ -17,6 +18,7 @@
 #include "observer.h"
 #include "vxlanorch.h"
 #include "flex_counter_manager.h"
+#include "bulker.h"
 
 #include "acltable.h"
 
@@ -330,6 +332,19 @@ public:
     virtual bool enableCounter();
     virtual bool disableCounter();
 
+    // Rules which program more than their counter and entry on creation are not bulked
+    virtual bool isBulkSupported() const;
+    // Queue the counter or the entry of the rule to the bulker, return false if nothing is queued
+    bool bulkCreateCounter(ObjectBulker<sai_acl_api_t> &bulker);
+    bool bulkCreateRule(ObjectBulker<sai_acl_api_t> &bulker);
+    bool bulkRemoveRule(ObjectBulker<sai_acl_api_t> &bulker);
+    bool bulkRemoveCounter(ObjectBulker<sai_acl_api_t> &bulker);
+    // Complete the queued operation once the bulker is flushed
+    bool bulkCreateCounterPost();
+    bool bulkCreateRulePost();
+    bool bulkRemoveRulePost();
+    bool bulkRemoveCounterPost();
+
     string getId() const;
     string getTableId() const;
     sai_object_id_t getOid() const;
@@ -355,6 +370,13 @@ protected:
     virtual bool removeRanges();
     virtual bool removeRule();
 
+    void getCounterAttrs(vector<sai_attribute_t> &counter_attrs) const;
+    bool getRuleAttrs(vector<sai_attribute_t> &rule_attrs);
+    bool createCounterPost(sai_status_t status);
+    bool createRulePost(sai_status_t status);
+    bool removeCounterPost(sai_status_t status);
+    bool removeRulePost(sai_status_t status);
+
     virtual bool updatePriority(const AclRule& updatedRule);
     virtual bool updateMatches(const AclRule& updatedRule);
     virtual bool updateActions(const AclRule& updatedRule);
@@ -386,9 +408,12 @@ protected:
 
     vector<AclRangeConfig> m_rangeConfig;
     vector<AclRange*> m_ranges;
+    // Range list of the entry, referenced by its attributes until it is created
+    vector<sai_object_id_t> m_rangeOids;
 
 private:
     bool m_createCounter;
+    sai_status_t m_bulkRemoveStatus = SAI_STATUS_NOT_EXECUTED;
 };
 
 class AclRulePacket: public AclRule
@@ -424,6 +449,7 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    bool isBulkSupported() const override;
 
     bool activate();
     bool deactivate();
@@ -444,6 +470,7 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    bool isBulkSupported() const override;
 
     bool activate();
     bool deactivate();
@@ -555,6 +582,26 @@ private:
     AclOrch *m_pAclOrch = nullptr;
 };
 
+/*
+ * Keeps track of an ACL rule add or remove batched in a doTask pass. Counters
+ * and entries of all the batched rules are programmed through the ACL bulkers.
+ */
+struct AclRuleContext
+{
+    shared_ptr<AclRule>         rule;
+    string                      table_id;
+    sai_object_id_t             table_oid;
+    bool                        add = true;
+    bool                        counter_queued = false;
+    bool                        rule_queued = false;
+    bool                        ok = true;
+
+    AclRuleContext(shared_ptr<AclRule> rule, const string &table_id, sai_object_id_t table_oid, bool add)
+        : rule(rule), table_id(table_id), table_oid(table_oid), add(add)
+    {
+    }
+};
+
 class AclOrch : public Orch, public Observer
 {
 public:
@@ -647,6 +694,7 @@ private:
     void doAclTableTask(Consumer &consumer);
     void doAclRuleTask(Consumer &consumer);
     void doAclTableTypeTask(Consumer &consumer);
+    void processBulkAclRules(Consumer &consumer, std::deque<std::pair<SyncMap::iterator, AclRuleContext>> &contexts);
     void init(vector<TableConnector>& connectors, PortsOrch *portOrch, MirrorOrch *mirrorOrch, NeighOrch *neighOrch, RouteOrch *routeOrch);
     void initDefaultTableTypes(const string& platform, const string& sub_platform);
 
@@ -714,6 +762,9 @@ private:
     acl_capabilities_t m_aclCapabilities;
     acl_action_enum_values_capabilities_t m_aclEnumActionCapabilities;
     FlexCounterManager m_flex_counter_manager;
+
+    ObjectBulker<sai_acl_api_t> gAclCounterBulker;
+    ObjectBulker<sai_acl_api_t> gAclEntryBulker;
 };
 
 #endif /* SWSS_ACLORCH_H */
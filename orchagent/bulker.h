@@ -1,6 +1,8 @@
 #pragma once
 
 #include <assert.h>
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,6 +12,7 @@
 #include "sai.h"
 #include "logger.h"
 #include "sai_serialize.h"
+#include "table.h"
 
 typedef sai_status_t (*sai_bulk_set_outbound_ca_to_pa_entry_attribute_fn) (
         _In_ uint32_t object_count,
@@ -412,6 +415,16 @@ struct SaiBulkerTraits<sai_neighbor_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_acl_api_t>
+{
+    // sai_acl_api_t has no bulk calls, see ObjectBulker<sai_acl_api_t>
+    using entry_t = sai_object_id_t;
+    using api_t = sai_acl_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_dash_meter_api_t>
 {
@@ -510,6 +523,167 @@ struct SaiBulkerTraits<sai_dash_outbound_port_map_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_outbound_port_map_port_range_entry_attribute_fn;
 };
 
+/*
+ * Flush policy of a bulker:
+ * - max_bulk_size bounds the number of entries in one SAI bulk call.
+ * - With a latency target, the entries of a flush are split into calls sized
+ *   from the measured time of the previous calls, so a call does not hold
+ *   syncd much longer than the target. The size doesn't go below
+ *   min_bulk_size, as tiny calls cost more round trips than they save.
+ * - With a max age, flush_due() turns true once the oldest pending entry is
+ *   older than max_age, so the orch can flush a few entries early instead of
+ *   waiting for a full batch.
+ * A zero max_age or latency_target disables the policy.
+ */
+struct BulkerPolicy
+{
+    size_t                      max_bulk_size = 0;      // 0 keeps the size given to the constructor
+    size_t                      min_bulk_size = 16;     // floor of the size adapted to the latency target
+    std::chrono::microseconds   max_age{0};
+    std::chrono::microseconds   latency_target{0};
+};
+
+struct BulkerStats
+{
+    uint64_t                    batches = 0;            // SAI bulk calls issued
+    uint64_t                    items = 0;              // entries passed to the calls
+    uint64_t                    failures = 0;           // entries the calls failed to program
+    std::chrono::microseconds   flush_latency{0};       // total time spent in the calls
+    std::chrono::microseconds   max_flush_latency{0};   // longest call
+    size_t                      bulk_size = 0;          // size of the next calls
+
+    double items_per_batch() const
+    {
+        return batches ? static_cast<double>(items) / static_cast<double>(batches) : 0;
+    }
+
+    double failure_rate() const
+    {
+        return items ? static_cast<double>(failures) / static_cast<double>(items) : 0;
+    }
+
+    std::vector<swss::FieldValueTuple> getFieldValues() const
+    {
+        return {
+            { "batches", std::to_string(batches) },
+            { "items", std::to_string(items) },
+            { "failures", std::to_string(failures) },
+            { "items_per_batch", std::to_string(items_per_batch()) },
+            { "failure_rate", std::to_string(failure_rate()) },
+            { "avg_latency_us", std::to_string(batches ? flush_latency.count() / static_cast<int64_t>(batches) : 0) },
+            { "max_latency_us", std::to_string(max_flush_latency.count()) },
+            { "bulk_size", std::to_string(bulk_size) }
+        };
+    }
+};
+
+/*
+ * Applies a BulkerPolicy and collects the BulkerStats of a bulker. The bulk
+ * size follows the latency target: it is halved after a call over the target
+ * and grown by a quarter after a full call under half the target.
+ */
+class BulkerPacer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    void set_policy(const BulkerPolicy &policy)
+    {
+        m_policy = policy;
+        m_bulk_size = 0;
+    }
+
+    const BulkerStats& stats() const
+    {
+        return m_stats;
+    }
+
+    size_t bulk_size(size_t max_bulk_size) const
+    {
+        if (m_policy.latency_target.count() == 0 || m_bulk_size == 0)
+        {
+            return max_bulk_size;
+        }
+        return std::min(m_bulk_size, max_bulk_size);
+    }
+
+    // An entry is queued
+    void queued()
+    {
+        if (!m_pending)
+        {
+            m_pending = true;
+            m_oldest = clock::now();
+        }
+    }
+
+    // The queued entries are flushed
+    void flushed()
+    {
+        m_pending = false;
+    }
+
+    bool due(size_t pending_count, size_t max_bulk_size) const
+    {
+        if (!m_pending || pending_count == 0)
+        {
+            return false;
+        }
+        if (pending_count >= bulk_size(max_bulk_size))
+        {
+            return true;
+        }
+        return m_policy.max_age.count() != 0 && clock::now() - m_oldest >= m_policy.max_age;
+    }
+
+    static size_t failed_count(const std::vector<sai_status_t> &statuses)
+    {
+        return static_cast<size_t>(std::count_if(statuses.begin(), statuses.end(),
+                [](sai_status_t status) { return status != SAI_STATUS_SUCCESS; }));
+    }
+
+    // A SAI bulk call of count entries, failures of them failed, took elapsed
+    void record(size_t count, size_t failures, clock::duration elapsed, size_t max_bulk_size)
+    {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+
+        m_stats.batches++;
+        m_stats.items += count;
+        m_stats.failures += failures;
+        m_stats.flush_latency += latency;
+        m_stats.max_flush_latency = std::max(m_stats.max_flush_latency, latency);
+
+        if (m_policy.latency_target.count() == 0)
+        {
+            m_stats.bulk_size = max_bulk_size;
+            return;
+        }
+
+        size_t size = bulk_size(max_bulk_size);
+        size_t min_size = std::min(std::max<size_t>(1, m_policy.min_bulk_size), max_bulk_size);
+        if (latency > m_policy.latency_target)
+        {
+            m_bulk_size = std::max(min_size, std::min(size, count) / 2);
+        }
+        else if (count >= size && latency * 2 < m_policy.latency_target)
+        {
+            m_bulk_size = std::min(max_bulk_size, size + std::max<size_t>(1, size / 4));
+        }
+        else
+        {
+            m_bulk_size = size;
+        }
+        m_stats.bulk_size = m_bulk_size;
+    }
+
+private:
+    BulkerPolicy                m_policy;
+    BulkerStats                 m_stats;
+    size_t                      m_bulk_size = 0;        // adapted bulk size, 0 until the first call
+    bool                        m_pending = false;
+    clock::time_point           m_oldest;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -552,6 +726,7 @@ public:
         attrs.insert(attrs.end(), attr_list, attr_list + attr_count);
         it->second.second = object_status;
         SWSS_LOG_INFO("EntityBulker.create_entry %zu, %zu, %d\n", creating_entries.size(), it->second.first.size(), inserted);
+        pacer.queued();
         *object_status = SAI_STATUS_NOT_EXECUTED;
         return *object_status;
     }
@@ -595,6 +770,7 @@ public:
                 std::forward_as_tuple(object_status));
         bool inserted = rc.second;
         SWSS_LOG_INFO("EntityBulker.remove_entry %zu, %d\n", removing_entries.size(), inserted);
+        pacer.queued();
 
         *object_status = SAI_STATUS_NOT_EXECUTED;
         return *object_status;
@@ -622,11 +798,14 @@ public:
         attrs.emplace_back(std::piecewise_construct,
                 std::forward_as_tuple(*attr),
                 std::forward_as_tuple(object_status));
+        pacer.queued();
         *object_status = SAI_STATUS_NOT_EXECUTED;
     }
 
     void flush()
     {
+        size_t bulk_size = pacer.bulk_size(max_bulk_size);
+
         // Removing
         if (!removing_entries.empty())
         {
@@ -640,7 +819,7 @@ public:
                 {
                     rs.push_back(entry);
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= bulk_size)
                     {
                         flush_removing_entries(rs);
                     }
@@ -669,7 +848,7 @@ public:
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= bulk_size)
                     {
                         flush_creating_entries(rs, tss, cs);
                     }
@@ -701,7 +880,7 @@ public:
                         ts.push_back(attr);
                         status_vector.push_back(object_status);
 
-                        if (rs.size() >= max_bulk_size)
+                        if (rs.size() >= bulk_size)
                         {
                             flush_setting_entries(rs, ts, status_vector);
                         }
@@ -712,6 +891,8 @@ public:
 
             setting_entries.clear();
         }
+
+        pacer.flushed();
     }
 
     void clear()
@@ -719,6 +900,27 @@ public:
         removing_entries.clear();
         creating_entries.clear();
         setting_entries.clear();
+        pacer.flushed();
+    }
+
+    void set_policy(const BulkerPolicy &policy)
+    {
+        if (policy.max_bulk_size)
+        {
+            max_bulk_size = policy.max_bulk_size;
+        }
+        pacer.set_policy(policy);
+    }
+
+    const BulkerStats& stats() const
+    {
+        return pacer.stats();
+    }
+
+    // The pending entries fill a bulk call or waited longer than the policy allows
+    bool flush_due() const
+    {
+        return pacer.due(creating_entries.size() + removing_entries.size() + setting_entries.size(), max_bulk_size);
     }
 
     size_t creating_entries_count() const
@@ -772,6 +974,8 @@ private:
 
     size_t max_bulk_size;
 
+    BulkerPacer                                             pacer;
+
     typename Ts::bulk_create_entry_fn                       create_entries;
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
@@ -785,7 +989,9 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = BulkerPacer::clock::now();
         sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        pacer.record(count, BulkerPacer::failed_count(statuses), BulkerPacer::clock::now() - start, max_bulk_size);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush removing_entries %zu\n", count);
@@ -822,8 +1028,10 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = BulkerPacer::clock::now();
         sai_status_t status = (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        pacer.record(count, BulkerPacer::failed_count(statuses), BulkerPacer::clock::now() - start, max_bulk_size);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush creating_entries %zu\n", count);
@@ -862,8 +1070,10 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = BulkerPacer::clock::now();
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        pacer.record(count, BulkerPacer::failed_count(statuses), BulkerPacer::clock::now() - start, max_bulk_size);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush setting_entries, count %zu\n", count);
@@ -905,13 +1115,9 @@ template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
     create_entries = api->create_fdb_entries;
     remove_entries = api->remove_fdb_entries;
     set_entries_attribute = api->set_fdb_entries_attribute;
-    */
 }
 
 template <>
@@ -990,6 +1196,12 @@ public:
         throw std::logic_error("Not implemented");
     }
 
+    ObjectBulker(typename Ts::api_t* next_hop_group_api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_t object_type) :
+        max_bulk_size(max_bulk_size)
+    {
+        throw std::logic_error("Not implemented");
+    }
+
     sai_status_t create_entry(
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
@@ -1004,11 +1216,28 @@ public:
 
         auto& last_attrs = std::get<1>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
+        pacer.queued();
 
         *object_id = SAI_NULL_OBJECT_ID; // not created immediately, postponed until flush
         return SAI_STATUS_NOT_EXECUTED;
     }
 
+    // Same as above, the SAI status of the entry is also written to object_status on flush
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+
+        create_entry(object_id, attr_count, attr_list);
+        creating_statuses[object_id] = object_status;
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+        return *object_status;
+    }
+
     sai_status_t remove_entry(
         _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id)
@@ -1025,6 +1254,7 @@ public:
         }
 
         removing_entries.emplace(object_id, object_status);
+        pacer.queued();
         *object_status = SAI_STATUS_NOT_EXECUTED;
         return *object_status;
     }
@@ -1055,6 +1285,8 @@ public:
 
     void flush()
     {
+        size_t bulk_size = pacer.bulk_size(max_bulk_size);
+
         // Removing
         if (!removing_entries.empty())
         {
@@ -1067,7 +1299,7 @@ public:
                 {
                     rs.push_back(entry);
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= bulk_size)
                     {
                         flush_removing_entries(rs);
                     }
@@ -1096,7 +1328,7 @@ public:
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= bulk_size)
                     {
                         flush_creating_entries(rs, tss, cs);
                     }
@@ -1105,6 +1337,7 @@ public:
             flush_creating_entries(rs, tss, cs);
 
             creating_entries.clear();
+            creating_statuses.clear();
         }
 
         // Setting
@@ -1124,7 +1357,7 @@ public:
                     rs.push_back(entry);
                     ts.push_back(attr);
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= bulk_size)
                     {
                         flush_setting_entries(rs, ts);
                     }
@@ -1135,13 +1368,42 @@ public:
             setting_entries.clear();
         }
         */
+
+        pacer.flushed();
     }
 
     void clear()
     {
         removing_entries.clear();
         creating_entries.clear();
+        creating_statuses.clear();
         setting_entries.clear();
+        pacer.flushed();
+    }
+
+    void set_policy(const BulkerPolicy &policy)
+    {
+        if (policy.max_bulk_size)
+        {
+            max_bulk_size = policy.max_bulk_size;
+        }
+        pacer.set_policy(policy);
+    }
+
+    void set_error_mode(sai_bulk_op_error_mode_t mode)
+    {
+        error_mode = mode;
+    }
+
+    const BulkerStats& stats() const
+    {
+        return pacer.stats();
+    }
+
+    // The pending entries fill a bulk call or waited longer than the policy allows
+    bool flush_due() const
+    {
+        return pacer.due(creating_entries.size() + removing_entries.size(), max_bulk_size);
     }
 
     size_t creating_entries_count() const
@@ -1180,11 +1442,19 @@ private:
 
     size_t max_bulk_size;
 
+    sai_bulk_op_error_mode_t error_mode = SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR;
+
+    BulkerPacer                                             pacer;
+
     std::vector<std::pair<                                  // A vector of pair of
             sai_object_id_t *,                              // - object_id
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
+                                                            // A map of
+                                                            // OUT object_id -> OUT object_status
+    std::unordered_map<sai_object_id_t *, sai_status_t *>   creating_statuses;
+
     std::unordered_map<                                     // A map of
             sai_object_id_t,                                // object_id -> (OUT object_status, attributes)
             std::pair<
@@ -1213,7 +1483,9 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        auto start = BulkerPacer::clock::now();
+        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), error_mode, statuses.data());
+        pacer.record(count, BulkerPacer::failed_count(statuses), BulkerPacer::clock::now() - start, max_bulk_size);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
@@ -1248,8 +1520,10 @@ private:
         size_t count = rs.size();
         std::vector<sai_object_id_t> object_ids(count);
         std::vector<sai_status_t> statuses(count);
+        auto start = BulkerPacer::clock::now();
         sai_status_t status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            , error_mode, object_ids.data(), statuses.data());
+        pacer.record(count, BulkerPacer::failed_count(statuses), BulkerPacer::clock::now() - start, max_bulk_size);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", count);
@@ -1265,6 +1539,12 @@ private:
             create_statuses.emplace(object_ids[i], statuses[i]);
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+
+            auto found_status = creating_statuses.find(pid);
+            if (found_status != creating_statuses.end())
+            {
+                *found_status->second = statuses[i];
+            }
         }
 
         rs.clear();
@@ -1373,6 +1653,14 @@ inline ObjectBulker<sai_dash_tunnel_api_t>::ObjectBulker(SaiBulkerTraits<sai_das
     }
 }
 
+/*
+ * ACL counters and entries are programmed with sai_bulk_object_create/remove
+ * for the object type given, ignoring errors so that one bad rule does not
+ * hold back the rest of the batch. Defined in aclorch.cpp.
+ */
+template <>
+ObjectBulker<sai_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_acl_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_t object_type);
+
 template <>
 inline ObjectBulker<sai_dash_outbound_port_map_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_outbound_port_map_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
     switch_id(switch_id),
@@ -119,6 +119,7 @@ void CbfNhgOrch::doTask(Consumer& consumer)
                         }
 
                         m_syncdNextHopGroups.emplace(index, NhgEntry<CbfNhg>(move(cbf_nhg)));
+                        notifyNhgAdded(index);
                     }
                 }
             }
@@ -405,6 +405,9 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
 
     m_pollingInterval = chrono::seconds(CRM_POLLING_INTERVAL_DEFAULT);
 
+    // Counter updates from other orchs are serialized by m_mutex
+    declareResources({}, { ORCH_RESOURCE_CRM });
+
     for (const auto &res : crmResTypeNameMap)
     {
         m_resourcesMap.emplace(res.first, CrmResourceEntry(res.second, CRM_THRESHOLD_TYPE_DEFAULT, CRM_THRESHOLD_LOW_DEFAULT, CRM_THRESHOLD_HIGH_DEFAULT));
@@ -441,6 +444,8 @@ void CrmOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     string table_name = consumer.getTableName();
 
     if (table_name != CFG_CRM_TABLE_NAME)
@@ -543,6 +548,8 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
@@ -558,6 +565,8 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
@@ -573,6 +582,8 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
@@ -588,6 +599,8 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
@@ -627,6 +640,8 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
@@ -643,6 +658,8 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
@@ -658,6 +675,8 @@ void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string ta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmP4rtTableKey(table_name)].usedCounter++;
@@ -673,6 +692,8 @@ void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string ta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmP4rtTableKey(table_name)].usedCounter--;
@@ -688,6 +709,8 @@ void CrmOrch::incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         if (resource == CrmResourceType::CRM_DASH_IPV4_ACL_GROUP)
@@ -721,6 +744,8 @@ void CrmOrch::decCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     try
     {
         if (resource == CrmResourceType::CRM_DASH_IPV4_ACL_GROUP)
@@ -752,6 +777,8 @@ void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     getResAvailableCounters();
     updateCrmCountersTable();
     checkCrmThresholds();
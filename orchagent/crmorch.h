@@ -3,6 +3,7 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include "orch.h"
 #include "port.h"
 #include "events.h"
@@ -125,6 +126,9 @@ private:
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
+    // Protects m_resourcesMap, the used counters are updated by orchs run on the scheduler workers
+    std::recursive_mutex m_mutex;
+
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
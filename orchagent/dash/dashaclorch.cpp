@@ -82,6 +82,8 @@ DashAclOrch::DashAclOrch(DBConnector *db, const vector<string> &tables, DashOrch
 
 {
     SWSS_LOG_ENTER();
+
+    declareResources({ ORCH_RESOURCE_DASH_ENI }, { ORCH_RESOURCE_DASH_ACL });
 }
 
 DashAclGroupMgr& DashAclOrch::getDashAclGroupMgr()
@@ -63,6 +63,8 @@ DashHaOrch::DashHaOrch(DBConnector *db, const vector<string> &tables, DashOrch *
 {
     SWSS_LOG_ENTER();
 
+    declareResources({ ORCH_RESOURCE_DASH_ENI }, { ORCH_RESOURCE_DASH_HA });
+
     dash_ha_set_result_table_ = make_unique<Table>(app_state_db, APP_DASH_HA_SET_TABLE_NAME);
     dash_ha_scope_result_table_ = make_unique<Table>(app_state_db, APP_DASH_HA_SCOPE_TABLE_NAME);
 
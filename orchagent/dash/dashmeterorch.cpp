@@ -27,6 +27,8 @@ DashMeterOrch::DashMeterOrch(DBConnector *db, const vector<string> &tables, Dash
     m_dash_orch(dash_orch)
 {
     SWSS_LOG_ENTER();
+
+    declareResources({ ORCH_RESOURCE_DASH_ENI }, { ORCH_RESOURCE_DASH_METER });
 }
 
 sai_object_id_t DashMeterOrch::getMeterPolicyOid(const string& meter_policy) const
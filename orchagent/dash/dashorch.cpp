@@ -68,6 +68,8 @@ DashOrch::DashOrch(DBConnector *db, vector<string> &tableName, DBConnector *app_
 {
     SWSS_LOG_ENTER();
 
+    declareResources({ ORCH_RESOURCE_DASH_METER, ORCH_RESOURCE_DASH_ROUTE, ORCH_RESOURCE_DASH_VNET }, { ORCH_RESOURCE_DASH_ENI });
+
     m_asic_db = std::shared_ptr<DBConnector>(new DBConnector("ASIC_DB", 0));
     m_counter_db = std::shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     m_eni_name_table = make_unique<Table>(m_counter_db.get(), COUNTERS_ENI_NAME_MAP);
@@ -550,7 +552,8 @@ bool DashOrch::addEniObject(const string& eni, EniEntry& entry)
 
     const string &vnet = entry.metadata.vnet();
 
-    if (!vnet.empty() && gVnetNameToId.find(vnet) == gVnetNameToId.end())
+    auto vnet_it = gVnetNameToId.find(vnet);
+    if (!vnet.empty() && vnet_it == gVnetNameToId.end())
     {
         SWSS_LOG_INFO("Retry as vnet %s not found", vnet.c_str());
         return false;
@@ -592,7 +595,7 @@ bool DashOrch::addEniObject(const string& eni, EniEntry& entry)
     vector<sai_attribute_t> eni_attrs;
 
     eni_attr.id = SAI_ENI_ATTR_VNET_ID;
-    eni_attr.value.oid = gVnetNameToId[entry.metadata.vnet()];
+    eni_attr.value.oid = vnet_it != gVnetNameToId.end() ? vnet_it->second : SAI_NULL_OBJECT_ID;
     eni_attrs.push_back(eni_attr);
 
     bool has_qos = qos_entries_.find(entry.metadata.qos()) != qos_entries_.end();
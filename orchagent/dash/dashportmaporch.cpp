@@ -22,6 +22,7 @@ DashPortMapOrch::DashPortMapOrch(swss::DBConnector *db, std::vector<std::string>
                                                                                                                                                          port_map_range_bulker_(sai_dash_outbound_port_map_api, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
+    declareResources({}, { ORCH_RESOURCE_DASH_PORT_MAP });
     dash_port_map_result_table_ = std::make_unique<swss::Table>(app_state_db, APP_DASH_OUTBOUND_PORT_MAP_TABLE_NAME);
     dash_port_map_range_result_table_ = std::make_unique<swss::Table>(app_state_db, APP_DASH_OUTBOUND_PORT_MAP_RANGE_TABLE_NAME);
 }
@@ -22,6 +22,7 @@
 #include "dashtunnelorch.h"
 
 #include "taskworker.h"
+#include "pbdecoder.h"
 #include "pbutils.h"
 #include "dash_api/route_type.pb.h"
 #include "directory.h"
@@ -52,6 +53,7 @@ DashRouteOrch::DashRouteOrch(DBConnector *db, vector<string> &tableName, DashOrc
     dash_orch_(dash_orch)
 {
     SWSS_LOG_ENTER();
+    declareResources({ ORCH_RESOURCE_DASH_ENI, ORCH_RESOURCE_DASH_TUNNEL, ORCH_RESOURCE_DASH_VNET }, { ORCH_RESOURCE_DASH_ROUTE });
     dash_route_result_table_ = make_unique<Table>(app_state_db, APP_DASH_ROUTE_TABLE_NAME);
     dash_route_rule_result_table_ = make_unique<Table>(app_state_db, APP_DASH_ROUTE_RULE_TABLE_NAME);
     dash_route_group_result_table_ = make_unique<Table>(app_state_db, APP_DASH_ROUTE_GROUP_TABLE_NAME);
@@ -74,21 +76,29 @@ bool DashRouteOrch::addOutboundRouting(const string& key, OutboundRoutingBulkCon
     }
 
     std::string routing_type_str = dash::route_type::RoutingType_Name(ctxt.metadata.routing_type());
-    if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_VNET &&
-        ctxt.metadata.has_vnet() && gVnetNameToId.find(ctxt.metadata.vnet()) == gVnetNameToId.end())
+    const std::string *vnet = nullptr;
+    if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_VNET && ctxt.metadata.has_vnet())
     {
-        SWSS_LOG_INFO("Retry as vnet %s not found for routing type %s",
-                      ctxt.metadata.vnet().c_str(),
-                      routing_type_str.c_str());
-        return false;
+        vnet = &ctxt.metadata.vnet();
     }
-    if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_VNET_DIRECT &&
-        ctxt.metadata.has_vnet_direct() && gVnetNameToId.find(ctxt.metadata.vnet_direct().vnet()) == gVnetNameToId.end())
+    else if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_VNET_DIRECT && ctxt.metadata.has_vnet_direct())
     {
-        SWSS_LOG_INFO("Retry as vnet %s not found for routing type %s",
-                      ctxt.metadata.vnet_direct().vnet().c_str(),
-                      routing_type_str.c_str());
-        return false;
+        vnet = &ctxt.metadata.vnet_direct().vnet();
+    }
+
+    // gVnetNameToId is owned by DashVnetOrch, look it up without inserting
+    sai_object_id_t vnet_oid = SAI_NULL_OBJECT_ID;
+    if (vnet != nullptr)
+    {
+        auto vnet_it = gVnetNameToId.find(*vnet);
+        if (vnet_it == gVnetNameToId.end())
+        {
+            SWSS_LOG_INFO("Retry as vnet %s not found for routing type %s",
+                          vnet->c_str(),
+                          routing_type_str.c_str());
+            return false;
+        }
+        vnet_oid = vnet_it->second;
     }
 
     sai_outbound_routing_entry_t outbound_routing_entry;
@@ -119,7 +129,7 @@ bool DashRouteOrch::addOutboundRouting(const string& key, OutboundRoutingBulkCon
         && !ctxt.metadata.vnet().empty())
     {   
         outbound_routing_attr.id = SAI_OUTBOUND_ROUTING_ENTRY_ATTR_DST_VNET_ID;
-        outbound_routing_attr.value.oid = gVnetNameToId[ctxt.metadata.vnet()];
+        outbound_routing_attr.value.oid = vnet_oid;
         outbound_routing_attrs.push_back(outbound_routing_attr);
     }
     else if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_VNET_DIRECT
@@ -128,7 +138,7 @@ bool DashRouteOrch::addOutboundRouting(const string& key, OutboundRoutingBulkCon
         && (ctxt.metadata.vnet_direct().overlay_ip().has_ipv4() || ctxt.metadata.vnet_direct().overlay_ip().has_ipv6()))
     {
         outbound_routing_attr.id = SAI_OUTBOUND_ROUTING_ENTRY_ATTR_DST_VNET_ID;
-        outbound_routing_attr.value.oid = gVnetNameToId[ctxt.metadata.vnet_direct().vnet()];
+        outbound_routing_attr.value.oid = vnet_oid;
         outbound_routing_attrs.push_back(outbound_routing_attr);
 
         outbound_routing_attr.id = SAI_OUTBOUND_ROUTING_ENTRY_ATTR_OVERLAY_IP;
@@ -282,6 +292,21 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
 
+    PbBatchDecoder<dash::route::Route> decoded("OutboundRouting", consumer.m_toSync,
+        [](const string&, dash::route::Route& metadata)
+        {
+            if (metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_UNSPECIFIED)
+            {
+                // Route::action_type is deprecated in favor of Route::routing_type. For messages still using the old action_type field,
+                // copy it to the new routing_type field. All subsequent operations will use the new field.
+                #pragma GCC diagnostic push
+                #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+                metadata.set_routing_type(metadata.action_type());
+                #pragma GCC diagnostic pop
+            }
+            return true;
+        });
+
     auto it = consumer.m_toSync.begin();
     uint32_t result;
     while (it != consumer.m_toSync.end())
@@ -318,21 +343,12 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                if (!decoded.take(it->second, ctxt.metadata))
                 {
                     SWSS_LOG_WARN("Requires protobuff at OutboundRouting :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
                     continue;
                 }
-                if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_UNSPECIFIED)
-                {
-                    // Route::action_type is deprecated in favor of Route::routing_type. For messages still using the old action_type field,
-                    // copy it to the new routing_type field. All subsequent operations will use the new field.
-                    #pragma GCC diagnostic push
-                    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-                    ctxt.metadata.set_routing_type(ctxt.metadata.action_type());
-                    #pragma GCC diagnostic pop
-                }
                 if (addOutboundRouting(key, ctxt))
                 {
                     it = consumer.m_toSync.erase(it);
@@ -428,10 +444,16 @@ bool DashRouteOrch::addInboundRouting(const string& key, InboundRoutingBulkConte
         SWSS_LOG_INFO("Retry as ENI entry %s not found", ctxt.eni.c_str());
         return false;
     }
-    if (ctxt.metadata.has_vnet() && gVnetNameToId.find(ctxt.metadata.vnet()) == gVnetNameToId.end())
+    sai_object_id_t vnet_oid = SAI_NULL_OBJECT_ID;
+    if (ctxt.metadata.has_vnet())
     {
-        SWSS_LOG_INFO("Retry as vnet %s not found", ctxt.metadata.vnet().c_str());
-        return false;
+        auto vnet_it = gVnetNameToId.find(ctxt.metadata.vnet());
+        if (vnet_it == gVnetNameToId.end())
+        {
+            SWSS_LOG_INFO("Retry as vnet %s not found", ctxt.metadata.vnet().c_str());
+            return false;
+        }
+        vnet_oid = vnet_it->second;
     }
 
     sai_inbound_routing_entry_t inbound_routing_entry;
@@ -454,7 +476,7 @@ bool DashRouteOrch::addInboundRouting(const string& key, InboundRoutingBulkConte
     if (ctxt.metadata.has_vnet())
     {
         inbound_routing_attr.id = SAI_INBOUND_ROUTING_ENTRY_ATTR_SRC_VNET_ID;
-        inbound_routing_attr.value.oid = gVnetNameToId[ctxt.metadata.vnet()];
+        inbound_routing_attr.value.oid = vnet_oid;
         inbound_routing_attrs.push_back(inbound_routing_attr);
     }
 
@@ -568,6 +590,8 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
 
+    PbBatchDecoder<dash::route_rule::RouteRule> decoded("InboundRouting", consumer.m_toSync);
+
     auto it = consumer.m_toSync.begin();
     uint32_t result;
     while (it != consumer.m_toSync.end())
@@ -611,7 +635,7 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                if (!decoded.take(it->second, ctxt.metadata))
                 {
                     SWSS_LOG_WARN("Requires protobuff at InboundRouting :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
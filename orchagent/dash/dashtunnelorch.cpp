@@ -59,6 +59,7 @@ DashTunnelOrch::DashTunnelOrch(
     ZmqOrch(db, tables, zmqServer)
 {
     SWSS_LOG_ENTER();
+    declareResources({ ORCH_RESOURCE_DASH_ENI }, { ORCH_RESOURCE_DASH_TUNNEL });
     dash_tunnel_result_table_ = std::make_unique<swss::Table>(app_state_db, APP_DASH_TUNNEL_TABLE_NAME);
 }
 
@@ -24,6 +24,7 @@
 #include "dashtunnelorch.h"
 
 #include "taskworker.h"
+#include "pbdecoder.h"
 #include "pbutils.h"
 
 using namespace std;
@@ -45,6 +46,7 @@ DashVnetOrch::DashVnetOrch(DBConnector *db, vector<string> &tables, DBConnector
     ZmqOrch(db, tables, zmqServer)
 {
     SWSS_LOG_ENTER();
+    declareResources({ ORCH_RESOURCE_DASH_ENI, ORCH_RESOURCE_DASH_TUNNEL }, { ORCH_RESOURCE_DASH_VNET });
     dash_vnet_result_table_ = make_unique<Table>(app_state_db, APP_DASH_VNET_TABLE_NAME);
     dash_vnet_map_result_table_ = make_unique<Table>(app_state_db, APP_DASH_VNET_MAPPING_TABLE_NAME);
 }
@@ -173,6 +175,8 @@ void DashVnetOrch::doTaskVnetTable(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
 
+    PbBatchDecoder<dash::vnet::Vnet> decoded("Vnet", consumer.m_toSync);
+
     auto it = consumer.m_toSync.begin();
     uint32_t result;
     while (it != consumer.m_toSync.end())
@@ -200,7 +204,7 @@ void DashVnetOrch::doTaskVnetTable(ConsumerBase& consumer)
             vnet_ctxt.vnet_name = key;
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), vnet_ctxt.metadata))
+                if (!decoded.take(it->second, vnet_ctxt.metadata))
                 {
                     SWSS_LOG_WARN("Requires protobuff at Vnet :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -693,6 +697,22 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
 
+    PbBatchDecoder<dash::vnet_mapping::VnetMapping> decoded("VnetMap", consumer.m_toSync,
+        [](const string&, dash::vnet_mapping::VnetMapping& metadata)
+        {
+            if (metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_UNSPECIFIED)
+            {
+                // VnetMapping::action_type is deprecated in favor of VnetMapping::routing_type. For messages still using the old action_type field,
+                // copy it to the new routing_type field. All subsequent operations will use the new field.
+                #pragma GCC diagnostic push
+                #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+                SWSS_LOG_WARN("VnetMapping::action_type is deprecated. Use VnetMapping::routing_type instead");
+                metadata.set_routing_type(metadata.action_type());
+                #pragma GCC diagnostic pop
+            }
+            return true;
+        });
+
     auto it = consumer.m_toSync.begin();
     uint32_t result;
     while (it != consumer.m_toSync.end())
@@ -728,22 +748,12 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                if (!decoded.take(it->second, ctxt.metadata))
                 {
                     SWSS_LOG_WARN("Requires protobuff at VnetMap :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
                     continue;
                 }
-                if (ctxt.metadata.routing_type() == dash::route_type::RoutingType::ROUTING_TYPE_UNSPECIFIED)
-                {
-                    // VnetMapping::action_type is deprecated in favor of VnetMapping::routing_type. For messages still using the old action_type field,
-                    // copy it to the new routing_type field. All subsequent operations will use the new field.
-                    #pragma GCC diagnostic push
-                    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-                    SWSS_LOG_WARN("VnetMapping::action_type is deprecated. Use VnetMapping::routing_type instead");
-                    ctxt.metadata.set_routing_type(ctxt.metadata.action_type());
-                    #pragma GCC diagnostic pop
-                }
                 if (addVnetMap(key, ctxt))
                 {
                     it = consumer.m_toSync.erase(it);
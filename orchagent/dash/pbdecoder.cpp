@@ -0,0 +1,226 @@
+#include <algorithm>
+
+#include "pbdecoder.h"
+
+using namespace std;
+
+/* Number of threads decoding DASH protobuf messages, the orchagent thread included */
+size_t gPbDecodeThreads = 1;
+
+/* Smaller batches are decoded on the calling thread, waking the pool would cost more */
+#define PB_DECODE_MIN_PARALLEL  64
+/* Number of messages a thread claims at a time */
+#define PB_DECODE_CHUNK         16
+
+#define PB_DECODE_STATS_INTERVAL_SEC    1
+#define PB_DECODE_STATS_TABLE           "PB_DECODE_STATS"
+#define PB_DECODE_STATS_KEY             "DASH"
+
+double PbDecodeStats::throughput() const
+{
+    if (elapsed.count() == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(messages) * 1e9 / static_cast<double>(elapsed.count());
+}
+
+vector<swss::FieldValueTuple> PbDecodeStats::getFieldValues() const
+{
+    return {
+        { "batches", to_string(batches) },
+        { "messages", to_string(messages) },
+        { "failures", to_string(failures) },
+        { "elapsed_us", to_string(chrono::duration_cast<chrono::microseconds>(elapsed).count()) },
+        { "messages_per_sec", to_string(static_cast<uint64_t>(throughput())) }
+    };
+}
+
+PbDecodePool &PbDecodePool::getInstance()
+{
+    static PbDecodePool pool;
+    return pool;
+}
+
+PbDecodePool::~PbDecodePool()
+{
+    stopWorkers();
+}
+
+void PbDecodePool::setThreadCount(size_t threads)
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> runLock(m_runMutex);
+
+    // The workers of gPbDecodeThreads are not started any more
+    call_once(m_startOnce, [] {});
+    stopWorkers();
+    startWorkers(threads);
+}
+
+size_t PbDecodePool::getThreadCount()
+{
+    lock_guard<mutex> runLock(m_runMutex);
+
+    ensureStarted();
+    return m_workers.size() + 1;
+}
+
+void PbDecodePool::ensureStarted()
+{
+    call_once(m_startOnce, [this] { startWorkers(gPbDecodeThreads); });
+}
+
+void PbDecodePool::startWorkers(size_t threads)
+{
+    SWSS_LOG_ENTER();
+
+    m_exit = false;
+
+    // The calling thread decodes too, so start one thread less
+    for (size_t i = 1; i < threads; i++)
+    {
+        m_workers.emplace_back(&PbDecodePool::workerLoop, this, m_generation);
+    }
+
+    if (threads > 1)
+    {
+        SWSS_LOG_NOTICE("Protobuf decode pool started with %zu threads", threads);
+    }
+}
+
+void PbDecodePool::stopWorkers()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_workCv.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+void PbDecodePool::run(size_t count, const function<void(size_t)> &task)
+{
+    lock_guard<mutex> runLock(m_runMutex);
+
+    ensureStarted();
+    if (m_workers.empty() || count < PB_DECODE_MIN_PARALLEL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_next = 0;
+        m_active = m_workers.size();
+        m_generation++;
+    }
+    m_workCv.notify_all();
+
+    runTasks();
+
+    unique_lock<mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this] { return m_active == 0; });
+    m_task = nullptr;
+}
+
+void PbDecodePool::runTasks()
+{
+    for (size_t first = m_next.fetch_add(PB_DECODE_CHUNK); first < m_count;
+         first = m_next.fetch_add(PB_DECODE_CHUNK))
+    {
+        size_t last = min(first + PB_DECODE_CHUNK, m_count);
+        for (size_t i = first; i < last; i++)
+        {
+            (*m_task)(i);
+        }
+    }
+}
+
+void PbDecodePool::workerLoop(uint64_t generation)
+{
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_workCv.wait(lock, [&] { return m_exit || m_generation != generation; });
+            if (m_exit)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        runTasks();
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (--m_active == 0)
+            {
+                m_doneCv.notify_one();
+            }
+        }
+    }
+}
+
+void PbDecodePool::record(const string &table, size_t messages, size_t failures, chrono::nanoseconds elapsed)
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> lock(m_statsMutex);
+
+    m_stats.batches++;
+    m_stats.messages += messages;
+    m_stats.failures += failures;
+    m_stats.elapsed += elapsed;
+
+    double ms = static_cast<double>(elapsed.count()) / 1e6;
+    SWSS_LOG_INFO("Decoded %zu %s messages in %.3f ms, %zu failed (%.0f msg/s, %.0f msg/s overall)",
+                  messages, table.c_str(), ms, failures,
+                  ms > 0 ? static_cast<double>(messages) * 1e3 / ms : 0, m_stats.throughput());
+
+    exportStats();
+}
+
+PbDecodeStats PbDecodePool::getStats() const
+{
+    lock_guard<mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void PbDecodePool::resetStats()
+{
+    lock_guard<mutex> lock(m_statsMutex);
+    m_stats = PbDecodeStats();
+    m_lastStatsExport = chrono::steady_clock::time_point();
+}
+
+void PbDecodePool::exportStats()
+{
+    auto now = chrono::steady_clock::now();
+    if (now - m_lastStatsExport < chrono::seconds(PB_DECODE_STATS_INTERVAL_SEC))
+    {
+        return;
+    }
+    m_lastStatsExport = now;
+
+    if (!m_statsTable)
+    {
+        m_countersDb = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+        m_statsTable = make_unique<swss::Table>(m_countersDb.get(), PB_DECODE_STATS_TABLE);
+    }
+
+    m_statsTable->set(PB_DECODE_STATS_KEY, m_stats.getFieldValues());
+}
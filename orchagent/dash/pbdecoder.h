@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <swss/logger.h>
+
+#include <orch.h>
+
+#include "taskworker.h"
+
+/*
+ * Statistics of the protobuf decode stage, accumulated over all batches
+ */
+struct PbDecodeStats
+{
+    uint64_t batches = 0;
+    uint64_t messages = 0;
+    uint64_t failures = 0;
+    // Wall clock time spent decoding batches
+    std::chrono::nanoseconds elapsed{0};
+
+    // Messages decoded per second of decode time
+    double throughput() const;
+
+    std::vector<swss::FieldValueTuple> getFieldValues() const;
+};
+
+/*
+ * Thread pool decoding the protobuf messages of consumer batches, shared by the DASH orchs.
+ *
+ * The orchs program SAI on the orchagent thread. The protobuf parsing of a whole m_toSync batch
+ * is done ahead of that, on the pool, so the SAI stage only picks up decoded messages.
+ * The calling thread decodes too. With a single thread, or for a small batch, the batch is
+ * decoded on the calling thread only. Batches run one at a time, a caller waits for the batch
+ * of another thread to be done. The stats are exported to COUNTERS_DB.
+ */
+class PbDecodePool
+{
+public:
+    static PbDecodePool &getInstance();
+    ~PbDecodePool();
+
+    PbDecodePool(const PbDecodePool&) = delete;
+    PbDecodePool& operator=(const PbDecodePool&) = delete;
+
+    // Number of threads decoding a batch, the calling thread included (default gPbDecodeThreads)
+    void setThreadCount(size_t threads);
+    size_t getThreadCount();
+
+    // Runs task(i) for each i in [0, count) and returns once all are done. The task must not throw.
+    void run(size_t count, const std::function<void(size_t)> &task);
+
+    void record(const std::string &table, size_t messages, size_t failures, std::chrono::nanoseconds elapsed);
+    PbDecodeStats getStats() const;
+    void resetStats();
+
+private:
+    PbDecodePool() = default;
+
+    // Starts the workers of gPbDecodeThreads on first use, unless setThreadCount() was called
+    void ensureStarted();
+    // Writes the stats to COUNTERS_DB, at most once per interval
+    void exportStats();
+    void startWorkers(size_t threads);
+    void stopWorkers();
+    void workerLoop(uint64_t generation);
+    void runTasks();
+
+    // Serializes run() and setThreadCount(), the job state below is for a single batch
+    std::mutex m_runMutex;
+    std::once_flag m_startOnce;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_doneCv;
+    const std::function<void(size_t)> *m_task = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next{0};
+    size_t m_active = 0;
+    uint64_t m_generation = 0;
+    bool m_exit = false;
+
+    mutable std::mutex m_statsMutex;
+    PbDecodeStats m_stats;
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::unique_ptr<swss::Table> m_statsTable;
+    std::chrono::steady_clock::time_point m_lastStatsExport;
+};
+
+/*
+ * Protobuf messages of the SET entries of a consumer batch, decoded on the PbDecodePool when
+ * the batch is constructed.
+ *
+ * Entries are looked up by address, so the batch must not be changed other than by erasing
+ * entries while the messages are taken. An entry which was not decoded ahead is decoded when
+ * it is taken.
+ */
+template<typename MessageType>
+class PbBatchDecoder
+{
+public:
+    // Runs on the pool after a message is parsed, to validate or normalize it. Returns false
+    // for an invalid message.
+    using Prepare = std::function<bool(const std::string &key, MessageType &msg)>;
+
+    PbBatchDecoder(const std::string &table, const SyncMap &toSync, const Prepare &prepare = nullptr) :
+        m_prepare(prepare)
+    {
+        SWSS_LOG_ENTER();
+
+        std::vector<const swss::KeyOpFieldsValuesTuple *> tuples;
+        for (const auto &it : toSync)
+        {
+            if (kfvOp(it.second) == SET_COMMAND)
+            {
+                tuples.push_back(&it.second);
+            }
+        }
+
+        if (tuples.empty())
+        {
+            return;
+        }
+
+        m_messages.resize(tuples.size());
+        m_valid.assign(tuples.size(), 0);
+
+        auto start = std::chrono::steady_clock::now();
+        PbDecodePool::getInstance().run(tuples.size(), [&](size_t i)
+        {
+            m_valid[i] = decode(*tuples[i], m_messages[i]);
+        });
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        size_t failures = 0;
+        m_index.reserve(tuples.size());
+        for (size_t i = 0; i < tuples.size(); i++)
+        {
+            m_index.emplace(tuples[i], i);
+            if (!m_valid[i])
+            {
+                failures++;
+            }
+        }
+
+        PbDecodePool::getInstance().record(table, tuples.size(), failures,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+    }
+
+    // Moves the decoded message of an entry into msg, returns false if it could not be decoded
+    bool take(const swss::KeyOpFieldsValuesTuple &tuple, MessageType &msg)
+    {
+        auto found = m_index.find(&tuple);
+        if (found == m_index.end())
+        {
+            return decode(tuple, msg);
+        }
+
+        size_t i = found->second;
+        m_index.erase(found);
+        msg.Swap(&m_messages[i]);
+        return m_valid[i];
+    }
+
+private:
+    Prepare m_prepare;
+    std::vector<MessageType> m_messages;
+    // Not a vector<bool>, the elements are written concurrently
+    std::vector<char> m_valid;
+    std::unordered_map<const swss::KeyOpFieldsValuesTuple *, size_t> m_index;
+
+    bool decode(const swss::KeyOpFieldsValuesTuple &tuple, MessageType &msg) const
+    {
+        if (!parsePbMessage(kfvFieldsValues(tuple), msg))
+        {
+            return false;
+        }
+        return !m_prepare || m_prepare(kfvKey(tuple), msg);
+    }
+};
@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <iostream>
 #include <vector>
+#include <set>
 #include <unordered_map>
 #include <utility>
 #include <inttypes.h>
@@ -21,6 +22,7 @@ extern sai_object_id_t  gSwitchId;
 extern CrmOrch *        gCrmOrch;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
+extern size_t           gMaxBulkSize;
 
 const int FdbOrch::fdborch_pri = 20;
 
@@ -29,7 +31,8 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    gFdbBulker(sai_fdb_api, gMaxBulkSize)
 {
     for(auto it: appFdbTables)
     {
@@ -37,6 +40,10 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     }
 
     m_portsOrch->attach(this);
+
+    // FDB changes are pushed to observers (NeighOrch, MirrorOrch) from doTask()
+    declareResources({ ORCH_RESOURCE_VXLAN, ORCH_RESOURCE_MLAG },
+                     { ORCH_RESOURCE_FDB, ORCH_RESOURCE_PORT, ORCH_RESOURCE_NEIGH, ORCH_RESOURCE_MIRROR });
     m_flushNotificationsConsumer = new NotificationConsumer(applDbConnector, "FLUSHFDBREQUEST");
     auto flushNotifier = new Notifier(m_flushNotificationsConsumer, this, "FLUSHFDBREQUEST");
     Orch::addExecutor(flushNotifier);
@@ -73,10 +80,10 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     const Port& port = update.port;
     const MacAddress& mac = entry.mac;
     string portName = port.m_alias;
-    Port vlan;
 
     oldFdbData.origin = FDB_ORIGIN_INVALID;
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    const Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate \
                          vlan port from bv_id 0x%" PRIx64, entry.bv_id);
@@ -84,7 +91,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 
     // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    string key = "Vlan" + to_string(vlan->m_vlan_info.vlan_id) + ":" + mac.to_string();
 
     if (update.add)
     {
@@ -185,10 +192,10 @@ void FdbOrch::clearFdbEntry(const FdbEntry& entry)
     update.add = false;
 
     /* Fetch Vlan and decrement the counter */
-    Port temp_vlan;
-    if (m_portsOrch->getPort(entry.bv_id, temp_vlan))
+    const Port *temp_vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (temp_vlan != nullptr)
     {
-        m_portsOrch->decrFdbCount(temp_vlan.m_alias, 1);
+        m_portsOrch->decrFdbCount(temp_vlan->m_alias, 1);
     }
 
     /* Decrement port fdb_counter */
@@ -345,9 +352,9 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     else
                     {
                         port.m_fdb_count--;
-                        m_portsOrch->setPort(port.m_alias, port);
+                        m_portsOrch->decrFdbCount(port.m_alias, 1);
                         vlan.m_fdb_count--;
-                        m_portsOrch->setPort(vlan.m_alias, vlan);
+                        m_portsOrch->decrFdbCount(vlan.m_alias, 1);
                     }
                     // Continue to add (update/move) the MAC
                 }
@@ -407,9 +414,9 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
         update.type = "dynamic";
         update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        m_portsOrch->incrFdbCount(update.port.m_alias, 1);
         vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->incrFdbCount(vlan.m_alias, 1);
 
         storeFdbEntryState(update);
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -532,12 +539,12 @@ void FdbOrch::update(sai_fdb_event_t        type,
         if (!update.port.m_alias.empty())
         {
             update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
+            m_portsOrch->decrFdbCount(update.port.m_alias, 1);
         }
         if (!vlan.m_alias.empty())
         {
             vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            m_portsOrch->decrFdbCount(vlan.m_alias, 1);
         }
         storeFdbEntryState(update);
 
@@ -609,10 +616,10 @@ void FdbOrch::update(sai_fdb_event_t        type,
         if (!port_old.m_alias.empty())
         {
             port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            m_portsOrch->decrFdbCount(port_old.m_alias, 1);
         }
         update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        m_portsOrch->incrFdbCount(update.port.m_alias, 1);
         update.sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
         storeFdbEntryState(update);
 
@@ -726,6 +733,11 @@ void FdbOrch::doTask(Consumer& consumer)
         origin = FDB_ORIGIN_MCLAG_ADVERTIZED;
     }
 
+    /* SAI operations of this pass are queued in the bulker and the tasks are
+     * completed once it is flushed */
+    std::deque<std::pair<SyncMap::iterator, FdbContext>> bulk_ctx;
+    std::set<FdbEntry> bulk_entries;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -764,6 +776,14 @@ void FdbOrch::doTask(Consumer& consumer)
         entry.mac = MacAddress(keys[1]);
         entry.bv_id = vlan.m_vlan_info.vlan_oid;
 
+        /* An earlier operation on the same MAC is still in the bulker, the
+         * outcome of this one depends on it */
+        if (bulk_entries.find(entry) != bulk_entries.end())
+        {
+            processBulkFdbEntries(consumer, bulk_ctx, origin);
+            bulk_entries.clear();
+        }
+
         if (op == SET_COMMAND)
         {
             string port = "";
@@ -865,50 +885,43 @@ void FdbOrch::doTask(Consumer& consumer)
             fdbData.vni = vni;
             fdbData.is_flush_pending = false;
             fdbData.discard = discard;
-            if (addFdbEntry(entry, port, fdbData))
-            {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
-                {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
-                    {
-                        m_mclagFdbStateTable.del(key);
-                    }
-                }
-
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-                {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
-                    if(!remote_ip.length())
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
-                }
-                it = consumer.m_toSync.erase(it);
+            FdbContext ctx(entry, true, true);
+            ctx.port_name = port;
+            ctx.fdbData = fdbData;
+            if (!addFdbEntry(ctx))
+            {
+                it++;
+            }
+            else if (ctx.pending)
+            {
+                bulk_entries.insert(entry);
+                bulk_ctx.emplace_back(it++, std::move(ctx));
             }
             else
-                it++;
+            {
+                completeFdbTask(ctx, origin);
+                it = consumer.m_toSync.erase(it);
+            }
         }
         else if (op == DEL_COMMAND)
         {
-            if (removeFdbEntry(entry, origin))
+            FdbContext ctx(entry, false, true);
+            ctx.origin = origin;
+            if (!removeFdbEntry(ctx))
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
-                {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    m_mclagFdbStateTable.del(key);
-                    SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
-                }
-
-                it = consumer.m_toSync.erase(it);
+                it++;
+            }
+            else if (ctx.pending)
+            {
+                bulk_entries.insert(entry);
+                bulk_ctx.emplace_back(it++, std::move(ctx));
             }
             else
-                it++;
-
+            {
+                completeFdbTask(ctx, origin);
+                it = consumer.m_toSync.erase(it);
+            }
         }
         else
         {
@@ -916,6 +929,59 @@ void FdbOrch::doTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    processBulkFdbEntries(consumer, bulk_ctx, origin);
+}
+
+void FdbOrch::processBulkFdbEntries(Consumer& consumer,
+                                    std::deque<std::pair<SyncMap::iterator, FdbContext>>& bulk_ctx,
+                                    FdbOrigin origin)
+{
+    SWSS_LOG_ENTER();
+
+    if (bulk_ctx.empty())
+    {
+        return;
+    }
+
+    gFdbBulker.flush();
+
+    for (auto& task : bulk_ctx)
+    {
+        FdbContext& ctx = task.second;
+        bool done = ctx.add ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx);
+        if (done)
+        {
+            completeFdbTask(ctx, origin);
+            consumer.m_toSync.erase(task.first);
+        }
+    }
+
+    bulk_ctx.clear();
+}
+
+/* Update the MCLAG remote FDB state once a task from APPL_DB is done */
+void FdbOrch::completeFdbTask(const FdbContext& ctx, FdbOrigin origin)
+{
+    if (origin != FDB_ORIGIN_MCLAG_ADVERTIZED)
+    {
+        return;
+    }
+
+    string key = "Vlan" + to_string(ctx.vlan.m_vlan_info.vlan_id) + ":" + ctx.entry.mac.to_string();
+    if (ctx.add)
+    {
+        if (ctx.fdbData.type == "dynamic_local")
+        {
+            m_mclagFdbStateTable.del(key);
+        }
+    }
+    else
+    {
+        m_mclagFdbStateTable.del(key);
+        SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
+                "Mac: %s Vlan: %d ", ctx.entry.mac.to_string().c_str(), ctx.vlan.m_vlan_info.vlan_id);
+    }
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -1276,8 +1342,29 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
 {
-    Port vlan;
-    Port port;
+    FdbContext ctx(entry, true, false);
+    ctx.port_name = port_name;
+    ctx.fdbData = fdbData;
+
+    if (!addFdbEntry(ctx))
+    {
+        return false;
+    }
+
+    return !ctx.pending || addFdbEntryPost(ctx);
+}
+
+/*
+ * Validate the FDB entry and issue its create or set; returns true when the
+ * entry is done or its SAI operation is pending (ctx.pending), false to retry
+ */
+bool FdbOrch::addFdbEntry(FdbContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    FdbData& fdbData = ctx.fdbData;
+    Port& vlan = ctx.vlan;
+    Port& port = ctx.port;
     string end_point_ip = "";
 
     VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
@@ -1317,17 +1404,16 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         return true;
     }
 
-    sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    Port oldPort;
-    string oldType;
+    Port& oldPort = ctx.oldPort;
+    string& oldType = ctx.oldType;
     string oldRemoteIp;
-    FdbOrigin oldOrigin = FDB_ORIGIN_INVALID ;
-    bool macUpdate = false;
+    FdbOrigin& oldOrigin = ctx.oldOrigin;
+    bool& macUpdate = ctx.macUpdate;
 
     auto it = m_entries.find(entry);
     if (it != m_entries.end())
@@ -1503,11 +1589,61 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 oldOrigin, fdbData.origin);
         for (auto itr : attrs)
         {
-            status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            ctx.object_statuses.emplace_back();
+            if (ctx.bulk_op)
+            {
+                gFdbBulker.set_entry_attribute(&ctx.object_statuses.back(), &fdb_entry, &itr);
+            }
+            else
+            {
+                ctx.object_statuses.back() = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            }
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
+
+        ctx.object_statuses.emplace_back();
+        if (ctx.bulk_op)
+        {
+            gFdbBulker.create_entry(&ctx.object_statuses.back(), &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        }
+        else
+        {
+            ctx.object_statuses.back() = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        }
+    }
+
+    ctx.pending = true;
+    return true;
+}
+
+/* Complete the FDB entry once the SAI create or set is done */
+bool FdbOrch::addFdbEntryPost(FdbContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
+    Port& vlan = ctx.vlan;
+    Port& port = ctx.port;
+    const Port& oldPort = ctx.oldPort;
+    const string& oldType = ctx.oldType;
+    FdbOrigin oldOrigin = ctx.oldOrigin;
+    bool macUpdate = ctx.macUpdate;
+
+    SWSS_LOG_ENTER();
+
+    ctx.pending = false;
+
+    if (macUpdate)
+    {
+        for (auto status : ctx.object_statuses)
+        {
             if (status != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                SWSS_LOG_ERROR("macUpdate-Failed for FDB %s in %s on %s, rv:%d",
+                            entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
@@ -1517,17 +1653,13 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         }
         if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            m_portsOrch->decrFdbCount(oldPort.m_alias, 1);
+            m_portsOrch->incrFdbCount(port.m_alias, 1);
         }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
-
-        status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        sai_status_t status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
@@ -1539,12 +1671,13 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
-        port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->incrFdbCount(port.m_alias, 1);
+        m_portsOrch->incrFdbCount(vlan.m_alias, 1);
     }
 
+    /* Pick up the FDB counters of the port for the observers */
+    m_portsOrch->getPort(port.m_alias, port);
+
     FdbData storeFdbData = fdbData;
     storeFdbData.bridge_port_id = port.m_bridge_port_id;
     // overwrite the type and origin
@@ -1629,8 +1762,27 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
-    Port vlan;
-    Port port;
+    FdbContext ctx(entry, false, false);
+    ctx.origin = origin;
+
+    if (!removeFdbEntry(ctx))
+    {
+        return false;
+    }
+
+    return !ctx.pending || removeFdbEntryPost(ctx);
+}
+
+/*
+ * Validate the FDB entry and issue its remove; returns true when the entry is
+ * done or its SAI operation is pending (ctx.pending), false to retry
+ */
+bool FdbOrch::removeFdbEntry(FdbContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    FdbOrigin& origin = ctx.origin;
+    Port& vlan = ctx.vlan;
+    Port& port = ctx.port;
 
     SWSS_LOG_ENTER();
 
@@ -1652,7 +1804,8 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         return true;
     }
 
-    FdbData fdbData = it->second;
+    FdbData& fdbData = ctx.fdbData;
+    fdbData = it->second;
     if (!m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
     {
         SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate port from bridge_port_id 0x%" PRIx64, fdbData.bridge_port_id);
@@ -1689,15 +1842,40 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-
-    sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    ctx.object_statuses.emplace_back();
+    if (ctx.bulk_op)
+    {
+        gFdbBulker.remove_entry(&ctx.object_statuses.back(), &fdb_entry);
+    }
+    else
+    {
+        ctx.object_statuses.back() = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    }
+
+    ctx.pending = true;
+    return true;
+}
+
+/* Complete the FDB entry once the SAI remove is done */
+bool FdbOrch::removeFdbEntryPost(FdbContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+    Port& vlan = ctx.vlan;
+    Port& port = ctx.port;
+
+    SWSS_LOG_ENTER();
+
+    ctx.pending = false;
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
+    sai_status_t status = ctx.object_statuses.front();
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
@@ -1712,12 +1890,13 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
             entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
 
-    port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
+    m_portsOrch->decrFdbCount(port.m_alias, 1);
+    m_portsOrch->decrFdbCount(vlan.m_alias, 1);
     (void)m_entries.erase(entry);
 
+    /* Pick up the FDB counters of the port for the observers */
+    m_portsOrch->getPort(port.m_alias, port);
+
     // Remove in StateDb
     if ((fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
     {
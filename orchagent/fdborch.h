@@ -1,9 +1,12 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <deque>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 enum FdbOrigin
 {
@@ -81,6 +84,35 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+/*
+ * Keeps track of an FDB entry add or remove. With bulk_op the SAI operation
+ * is queued in the bulker and the entry is completed after the flush.
+ */
+struct FdbContext
+{
+    FdbEntry                    entry;
+    bool                        add = true;
+    bool                        bulk_op = false;
+    bool                        pending = false;        // waiting for the SAI status
+
+    string                      port_name;              // add only
+    FdbData                     fdbData = {};
+    FdbOrigin                   origin = FDB_ORIGIN_PROVISIONED;   // remove only
+
+    Port                        vlan;
+    Port                        port;
+    Port                        oldPort;
+    string                      oldType;
+    FdbOrigin                   oldOrigin = FDB_ORIGIN_INVALID;
+    bool                        macUpdate = false;
+    std::deque<sai_status_t>    object_statuses;        // one per SAI create/remove/set
+
+    FdbContext(const FdbEntry &entry, bool add, bool bulk_op)
+        : entry(entry), add(add), bulk_op(bulk_op)
+    {
+    }
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -116,6 +148,7 @@ private:
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
     shared_ptr<DBConnector> m_notificationsDb;
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
 
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
@@ -124,6 +157,14 @@ private:
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(FdbContext& ctx);
+    bool addFdbEntryPost(FdbContext& ctx);
+    bool removeFdbEntry(FdbContext& ctx);
+    bool removeFdbEntryPost(FdbContext& ctx);
+    void processBulkFdbEntries(Consumer& consumer,
+                               std::deque<std::pair<SyncMap::iterator, FdbContext>>& bulk_ctx,
+                               FdbOrigin origin);
+    void completeFdbTask(const FdbContext& ctx, FdbOrigin origin);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
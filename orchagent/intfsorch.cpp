@@ -79,6 +79,16 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
 
+    /* Interfaces waiting for a port or a VRF are parked until it is created */
+    if (gPortsOrch)
+    {
+        gPortsOrch->attach(this);
+    }
+    if (m_vrfOrch)
+    {
+        m_vrfOrch->attach(this);
+    }
+
     string rifRatePluginName = "rif_rates.lua";
     string rifRateSha;
 
@@ -657,6 +667,18 @@ bool IntfsOrch::removeIntf(const string& alias, sai_object_id_t vrf_id, const Ip
     return true;
 }
 
+void IntfsOrch::update(SubjectType type, void *cntx)
+{
+    SWSS_LOG_ENTER();
+
+    if (type != SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED)
+    {
+        return;
+    }
+
+    retryToSync(*static_cast<Constraint *>(cntx));
+}
+
 void IntfsOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -824,7 +846,7 @@ void IntfsOrch::doTask(Consumer &consumer)
         {
             if (!m_vrfOrch->isVRFexists(vrf_name))
             {
-                it++;
+                it = consumer.addToRetry(it, Constraint(RETRY_CST_VRF, vrf_name));
                 continue;
             }
             vrf_id = m_vrfOrch->getVRFid(vrf_name);
@@ -918,8 +940,8 @@ void IntfsOrch::doTask(Consumer &consumer)
                 }
                 else
                 {
-                    /* TODO: Resolve the dependency relationship and add ref_count to port */
-                    it++;
+                    /* TODO: add ref_count to port */
+                    it = consumer.addToRetry(it, Constraint(RETRY_CST_PORT, alias));
                     continue;
                 }
             }
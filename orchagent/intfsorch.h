@@ -2,6 +2,7 @@
 #define SWSS_INTFSORCH_H
 
 #include "orch.h"
+#include "observer.h"
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
@@ -30,11 +31,13 @@ struct IntfsEntry
 
 typedef map<string, IntfsEntry> IntfsTable;
 
-class IntfsOrch : public Orch
+class IntfsOrch : public Orch, public Observer
 {
 public:
     IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb);
 
+    void update(SubjectType type, void *cntx);
+
     sai_object_id_t getRouterIntfsId(const string&);
     bool isPrefixSubnet(const IpPrefix&, const string&);
     bool isInbandIntfInMgmtVrf(const string& alias);
@@ -53,7 +53,11 @@ extern size_t gMaxBulkSize;
 #define DEFAULT_BATCH_SIZE  128
 extern int gBatchSize;
 
+extern size_t gOrchWorkers;
+extern size_t gPbDecodeThreads;
+
 bool gRingMode = false;
+int gRingSize = RING_SIZE;
 bool gSyncMode = false;
 sai_redis_communication_mode_t gRedisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_REDIS_ASYNC;
 string gAsicInstance;
@@ -79,7 +83,7 @@ uint32_t create_switch_timeout = 0;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R] [-n ring_size] [-w workers] [-p decode_threads] [-x record_mode]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -103,6 +107,13 @@ void usage()
     cout << "    -v vrf: VRF name (default empty)" << endl;
     cout << "    -I heart_beat_interval: Heart beat interval in millisecond (default 10)" << endl;
     cout << "    -R enable the ring thread feature" << endl;
+    cout << "    -n ring_size: depth of each ring buffer lane in ring thread mode (default 30)" << endl;
+    cout << "    -w workers: number of threads running independent orchs concurrently (default 1)" << endl;
+    cout << "    -p decode_threads: number of threads decoding DASH protobuf messages (default 1)" << endl;
+    cout << "    -x record_mode: how swss.rec and responsepublisher.rec are written (default sync)" << endl;
+    cout << "                    sync: each record is written and flushed by the recording thread" << endl;
+    cout << "                    async: records are written in batches by a background thread" << endl;
+    cout << "                    binary: as async, in a binary format converted back to text by swssrecconv" << endl;
 }
 
 void sighup_handler(int signo)
@@ -367,9 +378,10 @@ int main(int argc, char **argv)
     string vrf;
     string responsepublisher_rec_filename = Recorder::RESPPUB_FNAME;
     int record_type = 3; // Only swss and sairedis recordings enabled by default.
+    string record_mode = "sync";
     long heartBeatInterval = HEART_BEAT_INTERVAL_MSECS_DEFAULT;
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:I:R")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:I:Rn:w:p:x:")) != -1)
     {
         switch (opt)
         {
@@ -487,6 +499,59 @@ int main(int argc, char **argv)
         case 'R':
             gRingMode = true;
             break;
+        case 'n':
+            {
+                auto size = atoi(optarg);
+                if (size > 1)
+                {
+                    gRingSize = size;
+                    SWSS_LOG_NOTICE("Setting ring buffer lane depth as %d", gRingSize);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for ring buffer lane depth: %d. Ignoring.", size);
+                }
+            }
+            break;
+        case 'w':
+            {
+                auto workers = atoi(optarg);
+                if (workers > 0)
+                {
+                    gOrchWorkers = workers;
+                    SWSS_LOG_NOTICE("Setting orch scheduler workers as %zu", gOrchWorkers);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for orch scheduler workers: %d. Ignoring.", workers);
+                }
+            }
+            break;
+        case 'p':
+            {
+                auto threads = atoi(optarg);
+                if (threads > 0)
+                {
+                    gPbDecodeThreads = threads;
+                    SWSS_LOG_NOTICE("Setting protobuf decode threads as %zu", gPbDecodeThreads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for protobuf decode threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'x':
+            if (optarg == string("sync") || optarg == string("async") || optarg == string("binary"))
+            {
+                record_mode = optarg;
+                SWSS_LOG_NOTICE("Setting record mode as %s", optarg);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Invalid input for record mode: %s. Ignoring.", optarg);
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -512,6 +577,8 @@ int main(int argc, char **argv)
     );
     Recorder::Instance().swss.setLocation(record_location);
     Recorder::Instance().swss.setFileName(swss_rec_filename);
+    Recorder::Instance().swss.setAsync(record_mode != "sync");
+    Recorder::Instance().swss.setBinary(record_mode == "binary");
     Recorder::Instance().swss.startRec(true);
 
     Recorder::Instance().respub.setRecord(
@@ -520,6 +587,8 @@ int main(int argc, char **argv)
     );
     Recorder::Instance().respub.setLocation(record_location);
     Recorder::Instance().respub.setFileName(responsepublisher_rec_filename);
+    Recorder::Instance().respub.setAsync(record_mode != "sync");
+    Recorder::Instance().respub.setBinary(record_mode == "binary");
     Recorder::Instance().respub.startRec(false);
 
     // Instantiate database connectors
@@ -836,7 +905,7 @@ int main(int argc, char **argv)
 
     if (gRingMode) {
         /* Initialize the ring before OrchDaemon initializing Orchs */
-        orchDaemon->enableRingBuffer();
+        orchDaemon->enableRingBuffer(gRingSize);
     }
 
     if (!orchDaemon->init())
@@ -336,7 +336,8 @@ void RouteOrch::doLabelTask(ConsumerBase& consumer)
 
         // Go through the bulker results
         auto it_prev = consumer.m_toSync.begin();
-        m_bulkNhgReducedRefCnt.clear();
+        /* Emptied by removeBulkNhgReducedRefCnt(), each entry holds a reference on its id */
+        assert(m_bulkNhgReducedRefCnt.empty());
         while (it_prev != it)
         {
             KeyOpFieldsValuesTuple t = it_prev->second;
@@ -407,13 +408,7 @@ void RouteOrch::doLabelTask(ConsumerBase& consumer)
         }
 
         /* Remove next hop group if the reference count decreases to zero */
-        for (auto& it_nhg : m_bulkNhgReducedRefCnt)
-        {
-            if (m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
-            {
-                removeNextHopGroup(it_nhg.first);
-            }
-        }
+        removeBulkNhgReducedRefCnt();
     }
 }
 
@@ -583,7 +578,7 @@ bool RouteOrch::addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey
             }
         }
 
-        next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
+        next_hop_id = getNextHopGroupEntry(getNhgKeyId(nextHops, NHG_KEY_ID_INVALID))->next_hop_group_id;
     }
 
     /* Sync the inseg entry */
@@ -803,9 +798,9 @@ bool RouteOrch::addLabelRoutePost(const LabelRouteBulkContext& ctx, const NextHo
         {
             decreaseNextHopRefCount(it_route->second.nhg_key);
             if (it_route->second.nhg_key.getSize() > 1
-                && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
+                && isRefCounterZero(it_route->second.nhg_key))
             {
-                m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
+                addBulkNhgReducedRefCnt(it_route->second.nhg_key, NHG_KEY_ID_INVALID, 0);
             }
         }
         /* The next hop group is owned by (Cbf)NhgOrch. */
@@ -923,9 +918,9 @@ bool RouteOrch::removeLabelRoutePost(const LabelRouteBulkContext& ctx)
          */
         decreaseNextHopRefCount(it_route->second.nhg_key);
         if (it_route->second.nhg_key.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
+            && isRefCounterZero(it_route->second.nhg_key))
         {
-            m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
+            addBulkNhgReducedRefCnt(it_route->second.nhg_key, NHG_KEY_ID_INVALID, 0);
         }
         /*
          * Additionally check if the NH has label and its ref count == 0, then
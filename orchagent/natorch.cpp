@@ -15,6 +15,8 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <unordered_map>
@@ -89,7 +91,8 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
     auto cleanupNotifier = new Notifier(m_cleanupNotificationConsumer, this, "NAT_DB_CLEANUP_NOTIFICATION");
     Orch::addExecutor(cleanupNotifier);
 
-    /* Start the timer to query NAT entry statistics every 5 secs and hitbits every 30 secs */
+    /* Start the timer to query a slice of the NAT entry hitbits and statistics every 5 secs,
+     * each entry is queried every 30 secs */
     SWSS_LOG_INFO("Start the HITBIT Timer ");
     auto interval      = timespec { .tv_sec = NAT_HITBIT_N_CNTRS_QUERY_PERIOD, .tv_nsec = 0 };
     m_natQueryTimer = new SelectableTimer(interval);
@@ -3097,11 +3100,11 @@ void NatOrch::doTask(SelectableTimer &timer)
 
     if (timer.getFd() == m_natQueryTimer->getFd())
     {
-        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0)
-        {
-            queryHitBits();
-        }
-        queryCounters();
+        /* Each tick queries the hit bits and the counters of a slice of the entries,
+         * so that all the entries are queried once per NAT_HITBIT_QUERY_MULTIPLE ticks */
+        uint32_t tick = natTimerTickCntr++;
+        queryHitBits(tick);
+        queryCounters(tick);
     }
     else if (timer.getFd() == m_natTimeoutTimer->getFd())
     {
@@ -3114,212 +3117,274 @@ void NatOrch::doTask(SelectableTimer &timer)
     }
 }
 
-void NatOrch::queryCounters(void)
+size_t NatEntryBulkQuery::add(const sai_nat_entry_t &entry)
+{
+    m_entries.push_back(entry);
+    m_values.insert(m_values.end(), m_attrs.begin(), m_attrs.end());
+    m_statuses.push_back(SAI_STATUS_NOT_EXECUTED);
+
+    return m_entries.size() - 1;
+}
+
+void NatEntryBulkQuery::query()
 {
     SWSS_LOG_ENTER();
 
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
+    uint32_t attr_count = static_cast<uint32_t>(m_attrs.size());
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    for (size_t first = 0; first < m_entries.size(); first += NAT_BULK_QUERY_SIZE)
     {
-        return;
-    }
+        uint32_t object_count = static_cast<uint32_t>(min(m_entries.size() - first, (size_t)NAT_BULK_QUERY_SIZE));
 
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
-    {
-        getNatCounters(natIter);
+        if (m_useBulk && sai_nat_api->get_nat_entries_attribute)
+        {
+            vector<uint32_t> attr_counts(object_count, attr_count);
+            vector<sai_attribute_t *> attr_lists(object_count);
+            for (uint32_t i = 0; i < object_count; i++)
+            {
+                attr_lists[i] = &m_values[(first + i) * attr_count];
+            }
 
-        queried_entries++;
-        natIter++;
+            sai_status_t status = sai_nat_api->get_nat_entries_attribute(object_count, &m_entries[first],
+                                                                         attr_counts.data(), attr_lists.data(),
+                                                                         SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                                                         &m_statuses[first]);
+            if ((status != SAI_STATUS_NOT_IMPLEMENTED) && (status != SAI_STATUS_NOT_SUPPORTED))
+            {
+                continue;
+            }
+
+            SWSS_LOG_NOTICE("Bulk get of NAT entries is not supported, querying the entries one at a time");
+            m_useBulk = false;
+        }
+
+        for (size_t i = first; i < first + object_count; i++)
+        {
+            m_statuses[i] = sai_nat_api->get_nat_entry_attribute(&m_entries[i], attr_count, &m_values[i * attr_count]);
+        }
     }
+}
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
-    {
-        getNaptCounters(naptIter);
+static sai_nat_entry_t getSaiNatEntry(const IpAddress &ipAddr, const string &nat_type)
+{
+    sai_nat_entry_t nat_entry = {};
 
-        queried_entries++;
-        naptIter++;
+    nat_entry.vr_id       = gVirtualRouterId;
+    nat_entry.switch_id   = gSwitchId;
+
+    if (nat_type == "dnat")
+    {
+        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
+        nat_entry.data.key.dst_ip = ipAddr.getV4Addr();
+        nat_entry.data.mask.dst_ip = 0xffffffff;
     }
-    TwiceNatEntry::iterator tnatIter = m_twiceNatEntries.begin();
-    while (tnatIter != m_twiceNatEntries.end())
+    else
     {
-        getTwiceNatCounters(tnatIter);
-
-        queried_entries++;
-        tnatIter++;
+        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
+        nat_entry.data.key.src_ip = ipAddr.getV4Addr();
+        nat_entry.data.mask.src_ip = 0xffffffff;
     }
+    return nat_entry;
+}
 
-    TwiceNaptEntry::iterator tnaptIter = m_twiceNaptEntries.begin();
-    while (tnaptIter != m_twiceNaptEntries.end())
-    {
-        getTwiceNaptCounters(tnaptIter);
+static sai_nat_entry_t getSaiNaptEntry(const IpAddress &ipAddr, int l4_port, const string &prototype, const string &nat_type)
+{
+    sai_nat_entry_t nat_entry = {};
 
-        queried_entries++;
-        tnaptIter++;
-    }
+    nat_entry.vr_id       = gVirtualRouterId;
+    nat_entry.switch_id   = gSwitchId;
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
+    if (nat_type == "dnat")
     {
-        return;
+        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
+        nat_entry.data.key.dst_ip       = ipAddr.getV4Addr();
+        nat_entry.data.key.l4_dst_port  = (uint16_t)(l4_port);
+        nat_entry.data.mask.dst_ip      = 0xffffffff;
+        nat_entry.data.mask.l4_dst_port = 0xffff;
     }
-    time_spent = getTimeDiff(time_now, time_end);
-
-    if (queried_entries)
+    else
     {
-        SWSS_LOG_DEBUG("Time spent in querying counters for %u NAT/NAPT entries = %lu secs, %lu msecs",
-                       queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
+        nat_entry.data.key.src_ip       = ipAddr.getV4Addr();
+        nat_entry.data.key.l4_src_port  = (uint16_t)(l4_port);
+        nat_entry.data.mask.src_ip      = 0xffffffff;
+        nat_entry.data.mask.l4_src_port = 0xffff;
     }
+
+    nat_entry.data.key.proto        = (uint8_t)((prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    nat_entry.data.mask.proto       = 0xff;
+    return nat_entry;
 }
 
-void NatOrch::addAllNatEntries(void)
+static sai_nat_entry_t getSaiTwiceNatEntry(const TwiceNatEntryKey &key)
+{
+    sai_nat_entry_t dbl_nat_entry = {};
+
+    dbl_nat_entry.vr_id = gVirtualRouterId;
+    dbl_nat_entry.switch_id = gSwitchId;
+    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
+    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
+    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
+    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
+    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
+    return dbl_nat_entry;
+}
+
+static sai_nat_entry_t getSaiTwiceNaptEntry(const TwiceNaptEntryKey &key)
+{
+    sai_nat_entry_t dbl_nat_entry = {};
+
+    dbl_nat_entry.vr_id = gVirtualRouterId;
+    dbl_nat_entry.switch_id = gSwitchId;
+    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
+    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
+    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
+    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
+    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
+    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
+    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
+    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
+    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
+    dbl_nat_entry.data.key.proto = (uint8_t)((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    dbl_nat_entry.data.mask.proto = 0xff;
+    return dbl_nat_entry;
+}
+
+#define NAT_NOT_QUERIED   SIZE_MAX
+
+static vector<sai_attribute_t> getHitBitAttrs()
+{
+    vector<sai_attribute_t> attrs(2);
+
+    attrs[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
+    attrs[0].value.booldata = 0;
+    attrs[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
+    attrs[1].value.booldata = 1;
+    return attrs;
+}
+
+static bool isHitBitSet(const NatEntryBulkQuery &query, size_t index)
+{
+    return (index != NAT_NOT_QUERIED) && query.isOk(index) && query.getValue(index, 0).booldata;
+}
+
+void NatOrch::queryHitBits(uint32_t tick)
 {
     SWSS_LOG_ENTER();
 
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    struct timespec  time_now;
+
+    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
     {
-        if ((*natIter).second.addedToHw == false)
-        {
-            if ((*natIter).second.nat_type == "snat")
-            {
-                /* Add SNAT entry to the hardware */
-                addHwSnatEntry((*natIter).first);
-            }
-            else if ((*natIter).second.nat_type == "dnat")
-            {
-                if (gNhTrackingSupported == true)
-                {
-                    addDnatToNhCache((*natIter).second.translated_ip, (*natIter).first);
-                }
-                else
-                {
-                    addHwDnatEntry((*natIter).first);
-                }
-            }
-        }
-        natIter++;
+        return;
     }
+    auto start = chrono::steady_clock::now();
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    auto natSlice       = getSweepSlice(m_natEntries, m_natSweepCursor, tick);
+    auto naptSlice      = getSweepSlice(m_naptEntries, m_naptSweepCursor, tick);
+    auto twiceNatSlice  = getSweepSlice(m_twiceNatEntries, m_twiceNatSweepCursor, tick);
+    auto twiceNaptSlice = getSweepSlice(m_twiceNaptEntries, m_twiceNaptSweepCursor, tick);
+
+    /* The hit bits of the dynamic SNAT/SNAPT and Twice NAT/NAPT entries in hardware are
+     * queried first. For the SNAT/SNAPT entries without the hit bit, the hit bit of the
+     * reverse DNAT/DNAPT entry is queried next. Hitbits are queried for both directions
+     * when SNAT entry is checked, so the DNAT/DNAPT entries are not queried on their own. */
+    NatEntryBulkQuery query(getHitBitAttrs(), m_bulkGetSupported);
+    vector<size_t> natIndex(natSlice.size(), NAT_NOT_QUERIED);
+    vector<size_t> naptIndex(naptSlice.size(), NAT_NOT_QUERIED);
+    vector<size_t> twiceNatIndex(twiceNatSlice.size(), NAT_NOT_QUERIED);
+    vector<size_t> twiceNaptIndex(twiceNaptSlice.size(), NAT_NOT_QUERIED);
+
+    for (size_t i = 0; i < natSlice.size(); i++)
     {
-        if ((*naptIter).second.addedToHw == false)
+        const NatEntryValue &entry = natSlice[i]->second;
+        if ((entry.nat_type != "dnat") and (entry.addedToHw == true) and (entry.entry_type != "static"))
         {
-            if ((*naptIter).second.nat_type == "snat")
-            {
-                /* Add SNAPT entry to the hardware */
-                addHwSnaptEntry((*naptIter).first);
-            }
-            else if ((*naptIter).second.nat_type == "dnat")
-            {
-                if (gNhTrackingSupported == true)
-                {
-                    addDnaptToNhCache((*naptIter).second.translated_ip, (*naptIter).first);
-                }
-                else
-                {
-                    addHwDnaptEntry((*naptIter).first);
-                }
-            }
+            natIndex[i] = query.add(getSaiNatEntry(natSlice[i]->first, "snat"));
         }
-        naptIter++;
     }
-
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (size_t i = 0; i < naptSlice.size(); i++)
     {
-        if ((*twiceNatIter).second.addedToHw == false)
+        const NaptEntryValue &entry = naptSlice[i]->second;
+        if ((entry.nat_type != "dnat") and (entry.addedToHw == true) and (entry.entry_type != "static"))
         {
-            if (gNhTrackingSupported == true)
-            {
-                /* Cache the Twice NAT entry in the nexthop resolution cache */
-                addTwiceNatToNhCache((*twiceNatIter).second.translated_dst_ip, (*twiceNatIter).first);
-            }
-            else
-            {
-                /* Add Twice NAT entry to the hardware */
-                addHwTwiceNatEntry((*twiceNatIter).first);
-            }
+            const NaptEntryKey &key = naptSlice[i]->first;
+            naptIndex[i] = query.add(getSaiNaptEntry(key.ip_address, key.l4_port, key.prototype, "snat"));
         }
-        twiceNatIter++;
     }
-
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    for (size_t i = 0; i < twiceNatSlice.size(); i++)
     {
-        if ((*twiceNaptIter).second.addedToHw == false)
+        const TwiceNatEntryValue &entry = twiceNatSlice[i]->second;
+        if ((entry.addedToHw == true) and (entry.entry_type != "static"))
         {
-            if (gNhTrackingSupported == true)
-            {
-                /* Cache the Twice NAPT entry in the nexthop resolution cache */
-                addTwiceNaptToNhCache((*twiceNaptIter).second.translated_dst_ip, (*twiceNaptIter).first);
-            }
-            else
-            {
-                /* Add Twice NAPT entry to the hardware */
-                addHwTwiceNaptEntry((*twiceNaptIter).first);
-            }
+            twiceNatIndex[i] = query.add(getSaiTwiceNatEntry(twiceNatSlice[i]->first));
         }
-        twiceNaptIter++;
     }
-}
-
-void NatOrch::clearCounters(void)
-{
-    SWSS_LOG_ENTER();
-
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    for (size_t i = 0; i < twiceNaptSlice.size(); i++)
     {
-        setNatCounters(natIter);
-        natIter++;
+        const TwiceNaptEntryValue &entry = twiceNaptSlice[i]->second;
+        if ((entry.addedToHw == true) and (entry.entry_type != "static"))
+        {
+            twiceNaptIndex[i] = query.add(getSaiTwiceNaptEntry(twiceNaptSlice[i]->first));
+        }
     }
+    query.query();
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
-    {
-        setNaptCounters(naptIter);
-        naptIter++;
-    }
+    NatEntryBulkQuery reverseQuery(getHitBitAttrs(), query.isBulkSupported());
+    vector<size_t> natReverseIndex(natSlice.size(), NAT_NOT_QUERIED);
+    vector<size_t> naptReverseIndex(naptSlice.size(), NAT_NOT_QUERIED);
 
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (size_t i = 0; i < natSlice.size(); i++)
     {
-        setTwiceNatCounters(twiceNatIter);
-        twiceNatIter++;
-    }
+        if ((natIndex[i] == NAT_NOT_QUERIED) || !query.isOk(natIndex[i]) || isHitBitSet(query, natIndex[i]))
+        {
+            continue;
+        }
 
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
-    {
-        setTwiceNaptCounters(twiceNaptIter);
-        twiceNaptIter++;
+        const NatEntryValue &entry = natSlice[i]->second;
+        auto dnatIter = m_natEntries.find(entry.translated_ip);
+        if ((dnatIter != m_natEntries.end()) and ((dnatIter->second).addedToHw == true))
+        {
+            natReverseIndex[i] = reverseQuery.add(getSaiNatEntry(entry.translated_ip, "dnat"));
+        }
     }
-}
-
-void NatOrch::queryHitBits(void)
-{
-    SWSS_LOG_ENTER();
+    for (size_t i = 0; i < naptSlice.size(); i++)
+    {
+        if ((naptIndex[i] == NAT_NOT_QUERIED) || !query.isOk(naptIndex[i]) || isHitBitSet(query, naptIndex[i]))
+        {
+            continue;
+        }
 
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
+        const NaptEntryValue &entry = naptSlice[i]->second;
+        NaptEntryKey dnaptKey;
+        dnaptKey.ip_address = entry.translated_ip;
+        dnaptKey.l4_port    = entry.translated_l4_port;
+        dnaptKey.prototype  = naptSlice[i]->first.prototype;
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
-    {
-        return;
+        auto dnaptIter = m_naptEntries.find(dnaptKey);
+        if ((dnaptIter != m_naptEntries.end()) and ((dnaptIter->second).addedToHw == true))
+        {
+            naptReverseIndex[i] = reverseQuery.add(getSaiNaptEntry(dnaptKey.ip_address, dnaptKey.l4_port, dnaptKey.prototype, "dnat"));
+        }
     }
+    reverseQuery.query();
+    m_bulkGetSupported = reverseQuery.isBulkSupported();
 
     /* Remove the NAT entries that are aged out.
-     * Query the NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+     * Update the active timeout of the NAT entries active in the hardware. */
+    for (size_t i = 0; i < natSlice.size(); i++)
     {
-        if (checkIfNatEntryIsActive(natIter, time_now.tv_sec))
+        auto natIter = natSlice[i];
+        bool active  = (natIter->second.nat_type != "dnat") and (natIter->second.addedToHw == true) and
+                       ((natIter->second.entry_type == "static") or
+                        isHitBitSet(query, natIndex[i]) or isHitBitSet(reverseQuery, natReverseIndex[i]));
+
+        if (active)
         {
+            if (natIter->second.entry_type != "static")
+            {
+                natIter->second.ageOutTime = time_now.tv_sec + timeout;
+            }
             /* Since the entry is active in the hardware, reset the active time */
             natIter->second.activeTime = time_now.tv_sec;
         }
@@ -3333,21 +3398,28 @@ void NatOrch::queryHitBits(void)
                     std::vector<FieldValueTuple> fvVector;
                     std::string key = natIter->first.to_string();
                     setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
+                    m_hitBitSweep.agedOut++;
                 }
-            } 
+            }
         }
-        queried_entries++;
-        natIter++;
     }
 
     /* Remove the NAPT entries that are aged out.
-     * Query the NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+     * Update the active timeout of the NAPT entries active in the hardware. */
+    for (size_t i = 0; i < naptSlice.size(); i++)
     {
-        if (checkIfNaptEntryIsActive(naptIter, time_now.tv_sec))
+        auto naptIter = naptSlice[i];
+        int  timeout  = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        bool active   = (naptIter->second.nat_type != "dnat") and (naptIter->second.addedToHw == true) and
+                        ((naptIter->second.entry_type == "static") or
+                         isHitBitSet(query, naptIndex[i]) or isHitBitSet(reverseQuery, naptReverseIndex[i]));
+
+        if (active)
         {
+            if (naptIter->second.entry_type != "static")
+            {
+                naptIter->second.ageOutTime = time_now.tv_sec + timeout;
+            }
             /* Since the entry is active in the hardware, reset the active time */
             naptIter->second.activeTime = time_now.tv_sec;
         }
@@ -3356,27 +3428,30 @@ void NatOrch::queryHitBits(void)
             if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
                 (naptIter->second.entry_type != "static"))
             {
-                int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
                 if (time_now.tv_sec - naptIter->second.activeTime >= timeout)
                 {
                     std::vector<FieldValueTuple> fvVector;
                     std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
                     setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
+                    m_hitBitSweep.agedOut++;
                 }
             }
         }
-        queried_entries++;
-        naptIter++;
     }
 
     /* Remove the Twice NAT entries that are aged out.
-     * Query the Twice NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+     * Update the active timeout of the Twice NAT entries active in the hardware. */
+    for (size_t i = 0; i < twiceNatSlice.size(); i++)
     {
-        if (checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec))
+        auto twiceNatIter = twiceNatSlice[i];
+        bool active       = (twiceNatIter->second.entry_type == "static") or isHitBitSet(query, twiceNatIndex[i]);
+
+        if (active)
         {
+            if (twiceNatIter->second.entry_type != "static")
+            {
+                twiceNatIter->second.ageOutTime = time_now.tv_sec + timeout;
+            }
             /* Since the entry is active in the hardware, reset the active time */
             twiceNatIter->second.activeTime = time_now.tv_sec;
         }
@@ -3390,21 +3465,27 @@ void NatOrch::queryHitBits(void)
                     std::vector<FieldValueTuple> fvVector;
                     std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
                     setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
+                    m_hitBitSweep.agedOut++;
                 }
             }
         }
-        queried_entries++;
-        twiceNatIter++;
     }
 
     /* Remove the Twice NAPT entries that are aged out.
-     * Query the Twice NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+     * Update the active timeout of the Twice NAPT entries active in the hardware. */
+    for (size_t i = 0; i < twiceNaptSlice.size(); i++)
     {
-        if (checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec))
+        auto twiceNaptIter = twiceNaptSlice[i];
+        int  timeout       = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        bool active        = (twiceNaptIter->second.addedToHw == true) and
+                             ((twiceNaptIter->second.entry_type == "static") or isHitBitSet(query, twiceNaptIndex[i]));
+
+        if (active)
         {
+            if (twiceNaptIter->second.entry_type != "static")
+            {
+                twiceNaptIter->second.ageOutTime = time_now.tv_sec + timeout;
+            }
             /* Since the entry is active in the hardware, reset the active time */
             twiceNaptIter->second.activeTime = time_now.tv_sec;
         }
@@ -3413,317 +3494,409 @@ void NatOrch::queryHitBits(void)
             if ((twiceNaptIter->second.addedToHw == true) and
                 (twiceNaptIter->second.entry_type != "static"))
             {
-                int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
                 if (time_now.tv_sec - twiceNaptIter->second.activeTime >= timeout)
                 {
                     std::vector<FieldValueTuple> fvVector;
                     std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) + 
                                        ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
                     setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
+                    m_hitBitSweep.agedOut++;
                 }
             }
         }
-        queried_entries++;
-        twiceNaptIter++;
-    }
-    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
-    {
-        return;
     }
-    time_spent = getTimeDiff(time_now, time_end);
 
-    if (queried_entries)
+    auto elapsed = chrono::steady_clock::now() - start;
+    m_hitBitSweep.entries += query.size() + reverseQuery.size();
+    m_hitBitSweep.elapsed += chrono::duration_cast<chrono::nanoseconds>(elapsed);
+
+    SWSS_LOG_DEBUG("Time spent in querying hardware hit-bits for %zu NAT/NAPT entries = %" PRId64 " msecs",
+                   query.size() + reverseQuery.size(), (int64_t)chrono::duration_cast<chrono::milliseconds>(elapsed).count());
+
+    if ((tick % NAT_HITBIT_QUERY_MULTIPLE) == NAT_HITBIT_QUERY_MULTIPLE - 1)
     {
-        SWSS_LOG_DEBUG("Time spent in querying hardware hit-bits for %u NAT/NAPT entries = %lu secs, %lu msecs",
-                       queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+        updateSweepCounters("HITBIT", m_hitBitSweep);
+        m_hitBitSweep = NatSweepStats();
     }
 }
 
-void NatOrch::updateAllConntrackEntries(void)
+void NatOrch::queryCounters(uint32_t tick)
 {
     SWSS_LOG_ENTER();
 
-    /* Send notifications for the Single NAT entries to set timeout */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
-    {
+    auto start = chrono::steady_clock::now();
 
-        if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
-            (natIter->second.entry_type != "static"))
+    vector<sai_attribute_t> attrs(2);
+    attrs[0].id = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
+    attrs[1].id = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
+
+    NatEntryBulkQuery query(attrs, m_bulkGetSupported);
+    vector<NatEntry::iterator> natIters;
+    vector<NaptEntry::iterator> naptIters;
+    vector<TwiceNatEntry::iterator> twiceNatIters;
+    vector<TwiceNaptEntry::iterator> twiceNaptIters;
+
+    /* The entries of the slice in hardware are added to the query in this order, and read back in the same order */
+    for (const auto &natIter : getSweepSlice(m_natEntries, m_natCounterCursor, tick))
+    {
+        if (natIter->second.addedToHw == true)
         {
-            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = natIter->first.to_string();
-            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
+            natIters.push_back(natIter);
+            query.add(getSaiNatEntry(natIter->first, natIter->second.nat_type));
         }
-        natIter++;
     }
-
-    /* Send notifications for the Single NAPT entries to set timeout */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (const auto &naptIter : getSweepSlice(m_naptEntries, m_naptCounterCursor, tick))
     {
-        if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
-            (naptIter->second.entry_type != "static"))
+        if (naptIter->second.addedToHw == true)
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
+            const NaptEntryKey &key = naptIter->first;
+            naptIters.push_back(naptIter);
+            query.add(getSaiNaptEntry(key.ip_address, key.l4_port, key.prototype, naptIter->second.nat_type));
         }
-        naptIter++;
     }
-
-    /* Send notifications for the Twice NAT entries to set timeout */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (const auto &tnatIter : getSweepSlice(m_twiceNatEntries, m_twiceNatCounterCursor, tick))
     {
-        if ((twiceNatIter->second.addedToHw == true) and
-            (twiceNatIter->second.entry_type != "static"))
+        if (tnatIter->second.addedToHw == true)
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
+            twiceNatIters.push_back(tnatIter);
+            query.add(getSaiTwiceNatEntry(tnatIter->first));
         }
-        twiceNatIter++;
     }
-   
-    /* Send notifications for the Twice NAPT entries to set timeout */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    for (const auto &tnaptIter : getSweepSlice(m_twiceNaptEntries, m_twiceNaptCounterCursor, tick))
     {
-        if ((twiceNaptIter->second.addedToHw == true) and
-            (twiceNaptIter->second.entry_type != "static"))
+        if (tnaptIter->second.addedToHw == true)
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
-                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
+            twiceNaptIters.push_back(tnaptIter);
+            query.add(getSaiTwiceNaptEntry(tnaptIter->first));
         }
-        twiceNaptIter++;
     }
-}
 
-bool NatOrch::getNatCounters(const NatEntry::iterator &iter)
-{
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    sai_attribute_t   nat_entry_attr[4] = {};
-    sai_nat_entry_t   nat_entry = {};
-    sai_status_t      status;
-    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
+    query.query();
+    m_bulkGetSupported = query.isBulkSupported();
 
-    if (entry.addedToHw == false)
+    size_t index = 0;
+    for (const auto &natIter : natIters)
     {
-        SWSS_LOG_DEBUG("Skip get Counters for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
-    }
-
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-
-    nat_entry.vr_id       = gVirtualRouterId;
-    nat_entry.switch_id   = gSwitchId;
+        uint64_t nat_translations_pkts = 0, nat_translations_bytes = 0;
+        if (!query.isOk(index))
+        {
+            SWSS_LOG_ERROR("Failed to get Counters for %s entry [ip %s]", (natIter->second.nat_type == "dnat") ? "DNAT" : "SNAT",
+                           natIter->first.to_string().c_str());
+        }
+        else
+        {
+            nat_translations_bytes = query.getValue(index, 0).u64;
+            nat_translations_pkts  = query.getValue(index, 1).u64;
+        }
+        index++;
 
-    if (entry.nat_type == "dnat")
-    {
-        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-        nat_entry.data.key.dst_ip = ipAddr.getV4Addr();   
-        nat_entry.data.mask.dst_ip = 0xffffffff;
+        /* Update the Counter values in the database */
+        updateNatCounters(natIter->first, nat_translations_pkts, nat_translations_bytes);
     }
-    else
+    for (const auto &naptIter : naptIters)
     {
-        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-        nat_entry.data.key.src_ip = ipAddr.getV4Addr();
-        nat_entry.data.mask.src_ip = 0xffffffff;
-    }
+        const NaptEntryKey &naptKey = naptIter->first;
+        uint64_t nat_translations_pkts = 0, nat_translations_bytes = 0;
+        if (!query.isOk(index))
+        {
+            SWSS_LOG_ERROR("Failed to get Counters for %s entry for [proto %s, ip %s, port %d]",
+                           (naptIter->second.nat_type == "dnat") ? "DNAPT" : "SNAPT",
+                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
+        }
+        else
+        {
+            nat_translations_bytes = query.getValue(index, 0).u64;
+            nat_translations_pkts  = query.getValue(index, 1).u64;
+        }
+        index++;
 
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
-    if (entry.nat_type == "snat")
+        /* Update the Counter values in the database */
+        updateNaptCounters(naptKey.prototype, naptKey.ip_address, naptKey.l4_port,
+                           nat_translations_pkts, nat_translations_bytes);
+    }
+    for (const auto &tnatIter : twiceNatIters)
     {
-        if (status != SAI_STATUS_SUCCESS)
+        const TwiceNatEntryKey &key = tnatIter->first;
+        uint64_t nat_translations_pkts = 0, nat_translations_bytes = 0;
+        if (!query.isOk(index))
         {
-            SWSS_LOG_ERROR("Failed to get Counters for SNAT entry [src-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "", ipAddr.to_string().c_str(),
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
+            SWSS_LOG_ERROR("Failed to get Counters for Twice NAT entry [src-ip %s, dst-ip %s]",
+                           key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
         }
         else
         {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            nat_translations_bytes = query.getValue(index, 0).u64;
+            nat_translations_pkts  = query.getValue(index, 1).u64;
         }
+        index++;
+
+        /* Update the Counter values in the database */
+        updateTwiceNatCounters(key, nat_translations_pkts, nat_translations_bytes);
     }
-    else if (entry.nat_type == "dnat")
+    for (const auto &tnaptIter : twiceNaptIters)
     {
-        if (status != SAI_STATUS_SUCCESS)
+        const TwiceNaptEntryKey &key = tnaptIter->first;
+        uint64_t nat_translations_pkts = 0, nat_translations_bytes = 0;
+        if (!query.isOk(index))
         {
-            SWSS_LOG_ERROR("Failed to get Counters for DNAT entry [dst-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "", ipAddr.to_string().c_str(),
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
+            SWSS_LOG_DEBUG("Failed to get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d]",
+                           key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                           key.dst_l4_port);
         }
         else
         {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            nat_translations_bytes = query.getValue(index, 0).u64;
+            nat_translations_pkts  = query.getValue(index, 1).u64;
         }
+        index++;
+
+        /* Update the Counter values in the database */
+        updateTwiceNaptCounters(key, nat_translations_pkts, nat_translations_bytes);
     }
 
-    /* Update the Counter values in the database */
-    updateNatCounters(ipAddr, nat_translations_pkts, nat_translations_bytes);
+    auto elapsed = chrono::steady_clock::now() - start;
+    m_counterSweep.entries += query.size();
+    m_counterSweep.elapsed += chrono::duration_cast<chrono::nanoseconds>(elapsed);
 
-    return 0;
+    SWSS_LOG_DEBUG("Time spent in querying counters for %zu NAT/NAPT entries = %" PRId64 " msecs",
+                   query.size(), (int64_t)chrono::duration_cast<chrono::milliseconds>(elapsed).count());
+
+    if ((tick % NAT_HITBIT_QUERY_MULTIPLE) == NAT_HITBIT_QUERY_MULTIPLE - 1)
+    {
+        updateSweepCounters("COUNTERS", m_counterSweep);
+        m_counterSweep = NatSweepStats();
+    }
 }
 
-bool NatOrch::getTwiceNatCounters(const TwiceNatEntry::iterator &iter)
+/* Exports the entries, duration and rate of the last sweep, and the entries aged out by the hit bit sweep,
+ * as <sweep>_SWEEP_* fields of the global NAT counters */
+void NatOrch::updateSweepCounters(const string &sweep, const NatSweepStats &stats)
 {
-    const TwiceNatEntryKey   &key = iter->first;
-    TwiceNatEntryValue       &entry  = iter->second;
-    uint32_t          attr_count;
-    sai_attribute_t   nat_entry_attr[4] = {};
-    sai_nat_entry_t   dbl_nat_entry = {};
-    sai_status_t      status;
-    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
+    std::vector<swss::FieldValueTuple> values;
+    std::string key = "Values";
 
-    if (entry.addedToHw == false)
+    double secs = chrono::duration<double>(stats.elapsed).count();
+    uint64_t rate = (secs > 0) ? (uint64_t)((double)stats.entries / secs) : 0;
+
+    values.emplace_back(sweep + "_SWEEP_ENTRIES", to_string(stats.entries));
+    values.emplace_back(sweep + "_SWEEP_DURATION_MS", to_string(chrono::duration_cast<chrono::milliseconds>(stats.elapsed).count()));
+    values.emplace_back(sweep + "_SWEEP_ENTRIES_PER_SEC", to_string(rate));
+    if (sweep == "HITBIT")
     {
-        SWSS_LOG_DEBUG("Skip get Counters for Twice NAT entry [src ip %s, dst ip %s], as not yet added to HW",
-                        key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
-        return 0;
+        values.emplace_back(sweep + "_SWEEP_AGED_OUT", to_string(stats.agedOut));
     }
 
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
+    m_countersGlobalNatTable.set(key, values);
+}
 
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
+void NatOrch::addAllNatEntries(void)
+{
+    SWSS_LOG_ENTER();
 
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    NatEntry::iterator natIter = m_natEntries.begin();
+    while (natIter != m_natEntries.end())
     {
-        SWSS_LOG_ERROR("Failed to get Counters for Twice NAT entry [src-ip %s, dst-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                        key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
-                        nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
+        if ((*natIter).second.addedToHw == false)
+        {
+            if ((*natIter).second.nat_type == "snat")
+            {
+                /* Add SNAT entry to the hardware */
+                addHwSnatEntry((*natIter).first);
+            }
+            else if ((*natIter).second.nat_type == "dnat")
+            {
+                if (gNhTrackingSupported == true)
+                {
+                    addDnatToNhCache((*natIter).second.translated_ip, (*natIter).first);
+                }
+                else
+                {
+                    addHwDnatEntry((*natIter).first);
+                }
+            }
+        }
+        natIter++;
     }
-    else
+
+    NaptEntry::iterator naptIter = m_naptEntries.begin();
+    while (naptIter != m_naptEntries.end())
     {
-        nat_translations_bytes = nat_entry_attr[0].value.u64;
-        nat_translations_pkts  = nat_entry_attr[1].value.u64;
+        if ((*naptIter).second.addedToHw == false)
+        {
+            if ((*naptIter).second.nat_type == "snat")
+            {
+                /* Add SNAPT entry to the hardware */
+                addHwSnaptEntry((*naptIter).first);
+            }
+            else if ((*naptIter).second.nat_type == "dnat")
+            {
+                if (gNhTrackingSupported == true)
+                {
+                    addDnaptToNhCache((*naptIter).second.translated_ip, (*naptIter).first);
+                }
+                else
+                {
+                    addHwDnaptEntry((*naptIter).first);
+                }
+            }
+        }
+        naptIter++;
     }
 
-    /* Update the Counter values in the database */
-    updateTwiceNatCounters(key, nat_translations_pkts, nat_translations_bytes);
+    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
+    while (twiceNatIter != m_twiceNatEntries.end())
+    {
+        if ((*twiceNatIter).second.addedToHw == false)
+        {
+            if (gNhTrackingSupported == true)
+            {
+                /* Cache the Twice NAT entry in the nexthop resolution cache */
+                addTwiceNatToNhCache((*twiceNatIter).second.translated_dst_ip, (*twiceNatIter).first);
+            }
+            else
+            {
+                /* Add Twice NAT entry to the hardware */
+                addHwTwiceNatEntry((*twiceNatIter).first);
+            }
+        }
+        twiceNatIter++;
+    }
 
-    return 0;
+    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
+    while (twiceNaptIter != m_twiceNaptEntries.end())
+    {
+        if ((*twiceNaptIter).second.addedToHw == false)
+        {
+            if (gNhTrackingSupported == true)
+            {
+                /* Cache the Twice NAPT entry in the nexthop resolution cache */
+                addTwiceNaptToNhCache((*twiceNaptIter).second.translated_dst_ip, (*twiceNaptIter).first);
+            }
+            else
+            {
+                /* Add Twice NAPT entry to the hardware */
+                addHwTwiceNaptEntry((*twiceNaptIter).first);
+            }
+        }
+        twiceNaptIter++;
+    }
 }
 
-bool NatOrch::setNatCounters(const NatEntry::iterator &iter)
+void NatOrch::clearCounters(void)
 {
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    sai_attribute_t   nat_entry_attr_packet = {};
-    sai_attribute_t   nat_entry_attr_byte = {};
-    sai_nat_entry_t   nat_entry = {};
-    sai_status_t      status;
-    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
+    SWSS_LOG_ENTER();
 
-    if (entry.addedToHw == false)
+    NatEntry::iterator natIter = m_natEntries.begin();
+    while (natIter != m_natEntries.end())
     {
-        SWSS_LOG_DEBUG("Skip set Counters for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
+        setNatCounters(natIter);
+        natIter++;
     }
 
-    nat_entry_attr_byte.id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr_packet.id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    nat_entry.vr_id       = gVirtualRouterId;
-    nat_entry.switch_id   = gSwitchId;
+    NaptEntry::iterator naptIter = m_naptEntries.begin();
+    while (naptIter != m_naptEntries.end())
+    {
+        setNaptCounters(naptIter);
+        naptIter++;
+    }
 
-    if (entry.nat_type == "dnat")
+    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
+    while (twiceNatIter != m_twiceNatEntries.end())
     {
-        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-        nat_entry.data.key.dst_ip = ipAddr.getV4Addr();
-        nat_entry.data.mask.dst_ip = 0xffffffff;
+        setTwiceNatCounters(twiceNatIter);
+        twiceNatIter++;
     }
-    else
+
+    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
+    while (twiceNaptIter != m_twiceNaptEntries.end())
     {
-        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-        nat_entry.data.key.src_ip = ipAddr.getV4Addr();
-        nat_entry.data.mask.src_ip = 0xffffffff;
+        setTwiceNaptCounters(twiceNaptIter);
+        twiceNaptIter++;
     }
+}
 
-    status = sai_nat_api->set_nat_entry_attribute(&nat_entry, &nat_entry_attr_packet);
-    
-    if (entry.nat_type == "snat")
+void NatOrch::updateAllConntrackEntries(void)
+{
+    SWSS_LOG_ENTER();
+
+    /* Send notifications for the Single NAT entries to set timeout */
+    NatEntry::iterator natIter = m_natEntries.begin();
+    while (natIter != m_natEntries.end())
     {
-        if (status != SAI_STATUS_SUCCESS)
+
+        if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
+            (natIter->second.entry_type != "static"))
         {
-            SWSS_LOG_ERROR("Failed to clear packet counter for SNAT entry [src-ip %s]", ipAddr.to_string().c_str());
-            handleSaiSetStatus(SAI_API_NAT, status);
+            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = natIter->first.to_string();
+            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
         }
+        natIter++;
     }
-    else if (entry.nat_type == "dnat")
+
+    /* Send notifications for the Single NAPT entries to set timeout */
+    NaptEntry::iterator naptIter = m_naptEntries.begin();
+    while (naptIter != m_naptEntries.end())
     {
-        if (status != SAI_STATUS_SUCCESS)
+        if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
+            (naptIter->second.entry_type != "static"))
         {
-            SWSS_LOG_ERROR("Failed to clear packet counter for DNAT entry [dst-ip %s]", ipAddr.to_string().c_str());
-            handleSaiSetStatus(SAI_API_NAT, status);
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
+            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
         }
+        naptIter++;
     }
 
-    status = sai_nat_api->set_nat_entry_attribute(&nat_entry, &nat_entry_attr_byte);
-
-    if (entry.nat_type == "snat")
+    /* Send notifications for the Twice NAT entries to set timeout */
+    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
+    while (twiceNatIter != m_twiceNatEntries.end())
     {
-        if (status != SAI_STATUS_SUCCESS)
+        if ((twiceNatIter->second.addedToHw == true) and
+            (twiceNatIter->second.entry_type != "static"))
         {
-            SWSS_LOG_ERROR("Failed to clear byte counter for SNAT entry [src-ip %s]", ipAddr.to_string().c_str());
-            handleSaiSetStatus(SAI_API_NAT, status);
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
+            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
         }
+        twiceNatIter++;
     }
-    else if (entry.nat_type == "dnat")
+   
+    /* Send notifications for the Twice NAPT entries to set timeout */
+    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
+    while (twiceNaptIter != m_twiceNaptEntries.end())
     {
-        if (status != SAI_STATUS_SUCCESS)
+        if ((twiceNaptIter->second.addedToHw == true) and
+            (twiceNaptIter->second.entry_type != "static"))
         {
-            SWSS_LOG_ERROR("Failed to clear byte counter for DNAT entry [dst-ip %s]", ipAddr.to_string().c_str());
-            handleSaiSetStatus(SAI_API_NAT, status);
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
+                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
+            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
         }
+        twiceNaptIter++;
     }
-    /* Update the Counter values in the database */
-    updateNatCounters(ipAddr, nat_translations_pkts, nat_translations_bytes);
-
-    return 0;
 }
 
-bool NatOrch::getNaptCounters(const NaptEntry::iterator &iter)
+bool NatOrch::setNatCounters(const NatEntry::iterator &iter)
 {
-    const NaptEntryKey &naptKey    = iter->first;
-    NaptEntryValue     &entry      = iter->second;
-    uint8_t            protoType   = ((naptKey.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    nat_entry = {};
-    sai_status_t       status;
-    uint64_t           nat_translations_pkts = 0, nat_translations_bytes = 0;
+    const IpAddress   &ipAddr = iter->first;
+    NatEntryValue     &entry  = iter->second;
+    sai_attribute_t   nat_entry_attr_packet = {};
+    sai_attribute_t   nat_entry_attr_byte = {};
+    sai_nat_entry_t   nat_entry = {};
+    sai_status_t      status;
+    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
 
     if (entry.addedToHw == false)
     {
-        SWSS_LOG_DEBUG("Skip get Counters for %s NAPT entry for [proto %s, ip %s, port %d], as not yet added to HW",
-                       entry.nat_type.c_str(), naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
+        SWSS_LOG_DEBUG("Skip set Counters for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
         return 0;
     }
 
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
+    nat_entry_attr_byte.id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
+    nat_entry_attr_packet.id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
 
     nat_entry.vr_id       = gVirtualRouterId;
     nat_entry.switch_id   = gSwitchId;
@@ -3731,114 +3904,56 @@ bool NatOrch::getNaptCounters(const NaptEntry::iterator &iter)
     if (entry.nat_type == "dnat")
     {
         nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-        nat_entry.data.key.dst_ip      = naptKey.ip_address.getV4Addr();
-        nat_entry.data.key.l4_dst_port = (uint16_t)(naptKey.l4_port);
-        nat_entry.data.mask.dst_ip      = 0xffffffff;
-        nat_entry.data.mask.l4_dst_port = 0xffff;
+        nat_entry.data.key.dst_ip = ipAddr.getV4Addr();
+        nat_entry.data.mask.dst_ip = 0xffffffff;
     }
-    else if (entry.nat_type == "snat")
+    else
     {
         nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-        nat_entry.data.key.src_ip      = naptKey.ip_address.getV4Addr();
-        nat_entry.data.key.l4_src_port = (uint16_t)(naptKey.l4_port);
-        nat_entry.data.mask.src_ip      = 0xffffffff;
-        nat_entry.data.mask.l4_src_port = 0xffff;
+        nat_entry.data.key.src_ip = ipAddr.getV4Addr();
+        nat_entry.data.mask.src_ip = 0xffffffff;
     }
 
-    nat_entry.data.key.proto        = protoType;
-    nat_entry.data.mask.proto       = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
-
+    status = sai_nat_api->set_nat_entry_attribute(&nat_entry, &nat_entry_attr_packet);
+    
     if (entry.nat_type == "snat")
-    { 
+    {
         if (status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to get Counters for SNAPT entry for [proto %s, src-ip %s, src-port %d], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port,
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
-        {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            SWSS_LOG_ERROR("Failed to clear packet counter for SNAT entry [src-ip %s]", ipAddr.to_string().c_str());
+            handleSaiSetStatus(SAI_API_NAT, status);
         }
     }
     else if (entry.nat_type == "dnat")
     {
         if (status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to get Counters for DNAPT entry for [proto %s, dst-ip %s, dst-port %d], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port,
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
-        {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            SWSS_LOG_ERROR("Failed to clear packet counter for DNAT entry [dst-ip %s]", ipAddr.to_string().c_str());
+            handleSaiSetStatus(SAI_API_NAT, status);
         }
     }
 
-    /* Update the Counter values in the database */
-    updateNaptCounters(naptKey.prototype, naptKey.ip_address, naptKey.l4_port,
-                       nat_translations_pkts, nat_translations_bytes);
-    return 0;
-}
-
-bool NatOrch::getTwiceNaptCounters(const TwiceNaptEntry::iterator &iter)
-{
-    const TwiceNaptEntryKey &key    = iter->first;
-    TwiceNaptEntryValue     &entry      = iter->second;
-    uint8_t            protoType   = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    dbl_nat_entry = {};
-    sai_status_t       status;
-    uint64_t           nat_translations_pkts = 0, nat_translations_bytes = 0;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port);
-        return 0;
-    }
-
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
+    status = sai_nat_api->set_nat_entry_attribute(&nat_entry, &nat_entry_attr_byte);
 
-    if (status != SAI_STATUS_SUCCESS)
+    if (entry.nat_type == "snat")
     {
-        SWSS_LOG_DEBUG("Failed to get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to clear byte counter for SNAT entry [src-ip %s]", ipAddr.to_string().c_str());
+            handleSaiSetStatus(SAI_API_NAT, status);
+        }
     }
-    else
+    else if (entry.nat_type == "dnat")
     {
-        nat_translations_bytes = nat_entry_attr[0].value.u64;
-        nat_translations_pkts  = nat_entry_attr[1].value.u64;
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to clear byte counter for DNAT entry [dst-ip %s]", ipAddr.to_string().c_str());
+            handleSaiSetStatus(SAI_API_NAT, status);
+        }
     }
-
     /* Update the Counter values in the database */
-    updateTwiceNaptCounters(key, nat_translations_pkts, nat_translations_bytes);
+    updateNatCounters(ipAddr, nat_translations_pkts, nat_translations_bytes);
+
     return 0;
 }
 
@@ -4133,319 +4248,6 @@ void NatOrch::updateTwiceNaptCounters(const TwiceNaptEntryKey &key,
     m_countersTwiceNaptTable.set(naptKey, values);
 }
 
-bool NatOrch::checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now)
-{
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    IpAddress         srcIp;
-    sai_attribute_t   nat_entry_attr[4] = {};
-    sai_nat_entry_t   snat_entry = {};
-    sai_nat_entry_t   dnat_entry;
-    sai_status_t      status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAT entries are always treated active */ 
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-    srcIp     = ipAddr;
-    snat_entry.data.key.src_ip   = srcIp.getV4Addr();
-    snat_entry.data.mask.src_ip  = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAT HIT BIT for src-ip %s = %d", srcIp.to_string().c_str(),
-                      nat_entry_attr[0].value.booldata);
-
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-        else
-        {
-            auto dnatIter = m_natEntries.find(entry.translated_ip);
-            if (dnatIter == m_natEntries.end())
-            {
-                return 0;
-            }
-            if ((dnatIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-            /* If SNAT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id             = gVirtualRouterId;
-            dnat_entry.switch_id         = gSwitchId;
-            dnat_entry.nat_type          = SAI_NAT_TYPE_DESTINATION_NAT;
-            dnat_entry.data.key.dst_ip   = entry.translated_ip.getV4Addr();
-            dnat_entry.data.mask.dst_ip  = 0xffffffff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAT HIT BIT for dst-ip %s = %d", entry.translated_ip.to_string().c_str(),
-                                nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + timeout;
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now)
-{
-    const NaptEntryKey &naptKey    = iter->first;
-    NaptEntryValue     &entry      = iter->second;
-    int                protoType   = ((naptKey.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    IpAddress          srcIp;
-    uint16_t           srcPort;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    snat_entry = {};
-    sai_nat_entry_t    dnat_entry;
-    sai_status_t       status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAPT entry for [proto %s, ip %s, port %d], as not yet added to HW",
-                       entry.nat_type.c_str(), naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-
-    srcIp     = naptKey.ip_address;
-    srcPort   = (uint16_t)(naptKey.l4_port);
-    snat_entry.data.key.src_ip       = srcIp.getV4Addr();
-    snat_entry.data.key.l4_src_port  = srcPort;
-
-    snat_entry.data.mask.src_ip      = 0xffffffff;
-    snat_entry.data.mask.l4_src_port = 0xffff;
-    snat_entry.data.key.proto        = (uint8_t)protoType;
-    snat_entry.data.mask.proto       = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAPT HIT BIT for proto %s, src-ip %s, src-port %d = %d", naptKey.prototype.c_str(),
-                      srcIp.to_string().c_str(), srcPort, nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-        else
-        {
-            NaptEntryKey dnaptKey;
-            dnaptKey.ip_address = entry.translated_ip;
-            dnaptKey.l4_port    = entry.translated_l4_port;
-            dnaptKey.prototype  = naptKey.prototype;
-
-            auto dnaptIter = m_naptEntries.find(dnaptKey);
-            if (dnaptIter == m_naptEntries.end())
-            {
-                return 0;
-            }
-            if ((dnaptIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-
-            /* If SNAPT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id                 = gVirtualRouterId;
-            dnat_entry.switch_id             = gSwitchId;
-            dnat_entry.nat_type              = SAI_NAT_TYPE_DESTINATION_NAT;
-
-            dnat_entry.data.key.dst_ip       = entry.translated_ip.getV4Addr();
-            dnat_entry.data.key.l4_dst_port  = (uint16_t)(entry.translated_l4_port);
-
-            dnat_entry.data.mask.dst_ip      = 0xffffffff;
-            dnat_entry.data.mask.l4_dst_port = 0xffff;
-            dnat_entry.data.key.proto        = (uint8_t)protoType;
-            dnat_entry.data.mask.proto       = 0xff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAPT HIT BIT for proto %s, dst-ip %s, dst-port %d = %d", naptKey.prototype.c_str(),
-                              entry.translated_ip.to_string().c_str(), entry.translated_l4_port, nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now)
-{
-    const TwiceNatEntryKey &key    = iter->first;
-    TwiceNatEntryValue     &entry  = iter->second;
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    dbl_nat_entry = {};
-    sai_status_t       status;
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [src ip %s, dst-ip %s], as not yet added to HW",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
-        return 0;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAT HIT BIT for src-ip %s, dst-ip %s = %d",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(), nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now)
-{
-    const TwiceNaptEntryKey &key   = iter->first;
-    TwiceNaptEntryValue     &entry = iter->second;
-    uint8_t            protoType   = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    dbl_nat_entry = {};
-    sai_status_t       status;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAPT HIT BIT for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d] = %d",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port,
-                        nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-    }
-    return 0;
-}
-
 void NatOrch::doTask(NotificationConsumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -29,6 +29,7 @@
 #include "routeorch.h"
 #include "nexthopgroupkey.h"
 #include "notificationproducer.h"
+#include <chrono>
 #ifdef DEBUG_FRAMEWORK
 #include "debugdumporch.h"
 #endif
@@ -36,7 +37,8 @@
 #define VALUES                            "Values" // Global Values Key
 #define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // 5 secs
 #define NAT_CONNTRACK_TIMEOUT_PERIOD      86400    // 1 day
-#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits are queried every 30 secs
+#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits and counters of an entry are queried every 30 secs
+#define NAT_BULK_QUERY_SIZE               1024     // NAT entries read per SAI bulk get
 
 struct NatEntryValue
 {
@@ -176,6 +178,91 @@ struct DnatEntries
 
 typedef std::map<IpAddress, DnatEntries> DnatNhResolvCache;
 
+/*
+ * Reads the same attributes of a list of NAT entries, with one SAI bulk get per
+ * NAT_BULK_QUERY_SIZE entries, or one get per entry if the SAI doesn't implement the
+ * bulk get.
+ */
+class NatEntryBulkQuery
+{
+public:
+    NatEntryBulkQuery(const vector<sai_attribute_t> &attrs, bool useBulk = true) :
+        m_attrs(attrs), m_useBulk(useBulk)
+    {
+    }
+
+    /* Returns the index of the entry in the query */
+    size_t add(const sai_nat_entry_t &entry);
+    void query();
+
+    size_t size() const { return m_entries.size(); }
+    bool isOk(size_t index) const { return m_statuses[index] == SAI_STATUS_SUCCESS; }
+    const sai_attribute_value_t &getValue(size_t index, size_t attr) const
+    {
+        return m_values[index * m_attrs.size() + attr].value;
+    }
+
+    /* False once the SAI reported the bulk get as not implemented */
+    bool isBulkSupported() const { return m_useBulk; }
+
+private:
+    vector<sai_attribute_t>  m_attrs;
+    bool                     m_useBulk;
+    vector<sai_nat_entry_t>  m_entries;
+    vector<sai_attribute_t>  m_values;
+    vector<sai_status_t>     m_statuses;
+};
+
+/* Position of a hit bit or counter sweep in a NAT entry map, the sweep is spread over NAT_HITBIT_QUERY_MULTIPLE ticks */
+template<typename Key>
+struct NatSweepCursor
+{
+    Key            lastKey;            // Last key queried in the current sweep
+    bool           started = false;    // Boolean to represent lastKey is valid
+};
+
+/* Entries of the sweep for the tick: the next 1/NAT_HITBIT_QUERY_MULTIPLE of
+ * the map after the cursor, and all the remaining ones on the last tick of the sweep */
+template<typename MapType>
+vector<typename MapType::iterator> getSweepSlice(MapType &entries, NatSweepCursor<typename MapType::key_type> &cursor,
+                                                 uint32_t tick)
+{
+    uint32_t phase = tick % NAT_HITBIT_QUERY_MULTIPLE;
+    size_t   count = entries.size();
+
+    if (phase == 0)
+    {
+        cursor.started = false;
+    }
+    if (phase != NAT_HITBIT_QUERY_MULTIPLE - 1)
+    {
+        count = (count + NAT_HITBIT_QUERY_MULTIPLE - 1) / NAT_HITBIT_QUERY_MULTIPLE;
+    }
+
+    vector<typename MapType::iterator> slice;
+    auto iter = cursor.started ? entries.upper_bound(cursor.lastKey) : entries.begin();
+    while ((iter != entries.end()) && (slice.size() < count))
+    {
+        slice.push_back(iter);
+        iter++;
+    }
+
+    if (!slice.empty())
+    {
+        cursor.lastKey = slice.back()->first;
+        cursor.started = true;
+    }
+    return slice;
+}
+
+/* Entries queried and time spent by a hit bit or counter sweep */
+struct NatSweepStats
+{
+    uint64_t                 entries = 0;
+    uint64_t                 agedOut = 0;   // Entries notified as aged out, hit bit sweep only
+    std::chrono::nanoseconds elapsed{0};
+};
+
 class NatOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -221,6 +308,18 @@ private:
 
     std::shared_ptr<NotificationProducer> setTimeoutNotifier;
 
+    NatSweepCursor<IpAddress>          m_natSweepCursor;
+    NatSweepCursor<NaptEntryKey>       m_naptSweepCursor;
+    NatSweepCursor<TwiceNatEntryKey>   m_twiceNatSweepCursor;
+    NatSweepCursor<TwiceNaptEntryKey>  m_twiceNaptSweepCursor;
+    NatSweepStats                      m_hitBitSweep;
+    NatSweepCursor<IpAddress>          m_natCounterCursor;
+    NatSweepCursor<NaptEntryKey>       m_naptCounterCursor;
+    NatSweepCursor<TwiceNatEntryKey>   m_twiceNatCounterCursor;
+    NatSweepCursor<TwiceNaptEntryKey>  m_twiceNaptCounterCursor;
+    NatSweepStats                      m_counterSweep;
+    bool                               m_bulkGetSupported = true;
+
     /* DNAT/DNAPT entry is cached, to delete and re-add it whenever the direct NextHop (connected neighbor)
      * or indirect NextHop (via route) to reach the DNAT IP is changed. */
     DnatNhResolvCache       m_nhResolvCache;
@@ -289,11 +388,6 @@ private:
     bool addHwDnatPoolEntry(const IpAddress &dstIp);
     bool removeHwDnatPoolEntry(const IpAddress &dstIp);
 
-    bool checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now);
-    bool checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now);
-
     void enableNatFeature(void);
     void disableNatFeature(void);
     void addAllNatEntries(void);
@@ -301,13 +395,10 @@ private:
     void clearAllDnatEntries(void);
     void cleanupAppDbEntries(void);
     void clearCounters(void);
-    void queryCounters(void);
-    void queryHitBits(void);
+    void queryCounters(uint32_t tick);
+    void queryHitBits(uint32_t tick);
+    void updateSweepCounters(const string &sweep, const NatSweepStats &stats);
     bool isNatEnabled(void);
-    bool getNatCounters(const NatEntry::iterator &iter);
-    bool getTwiceNatCounters(const TwiceNatEntry::iterator &iter);
-    bool getNaptCounters(const NaptEntry::iterator &iter);
-    bool getTwiceNaptCounters(const TwiceNaptEntry::iterator &iter);
     bool setNatCounters(const NatEntry::iterator &iter);
     bool setTwiceNatCounters(const TwiceNatEntry::iterator &iter);
     bool setNaptCounters(const NaptEntry::iterator &iter);
@@ -124,22 +124,22 @@ void NeighOrch::processFDBFlushUpdate(const FdbFlushUpdate& update)
     for (auto entry : update.entries)
     {
         // Get Vlan object
-        Port vlan;
-        if (!m_portsOrch->getPort(entry.bv_id, vlan))
+        const Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port \
                              from bv_id 0x%" PRIx64 ".", entry.bv_id);
             continue;
         }
         SWSS_LOG_INFO("Flushing ARP for port: %s, VLAN: %s",
-                      vlan.m_alias.c_str(), update.port.m_alias.c_str());
+                      vlan->m_alias.c_str(), update.port.m_alias.c_str());
 
         // If the FDB entry MAC matches with neighbor/ARP entry MAC,
         // and ARP entry incoming interface matches with VLAN name,
         // flush neighbor/arp entry.
         for (const auto &neighborEntry : m_syncdNeighbors)
         {
-            if (neighborEntry.first.alias == vlan.m_alias &&
+            if (neighborEntry.first.alias == vlan->m_alias &&
                 neighborEntry.second.mac == entry.mac)
             {
                 resolveNeighborEntry(neighborEntry.first, neighborEntry.second.mac);
@@ -342,6 +342,11 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
                 nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
         }
     }
+
+    /* Wake up the routes waiting for this neighbor */
+    Constraint cst = { RETRY_CST_NEIGH, NextHopKey(nexthop.ip_address, nexthop.alias).to_string() };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
     return true;
 }
 
@@ -434,6 +439,11 @@ bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
                 nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
         }
     }
+
+    /* Wake up the routes waiting for this neighbor */
+    Constraint cst = { RETRY_CST_NEIGH, NextHopKey(nexthop.ip_address, nexthop.alias).to_string() };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
     return true;
 }
 
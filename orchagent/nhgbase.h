@@ -7,6 +7,7 @@
 #include "dbconnector.h"
 #include "set"
 #include "orch.h"
+#include "observer.h"
 #include "crmorch.h"
 #include "routeorch.h"
 #include "nexthopgroupkey.h"
@@ -195,12 +196,15 @@ public:
     NhgCommon(NhgCommon &&nhg) : NhgBase(move(nhg)),
                                 m_key(move(nhg.m_key)),
                                 m_members(move(nhg.m_members))
-    { SWSS_LOG_ENTER(); }
+    { SWSS_LOG_ENTER(); assert(nhg.m_pending_members.empty()); }
 
     NhgCommon& operator=(NhgCommon &&nhg)
     {
         SWSS_LOG_ENTER();
 
+        /* The queued member operations refer to the groups being moved. */
+        assert(m_pending_members.empty() && nhg.m_pending_members.empty());
+
         swap(m_key, nhg.m_key);
         swap(m_members, nhg.m_members);
 
@@ -222,6 +226,13 @@ public:
     inline size_t getSize() const
                                 { SWSS_LOG_ENTER(); return m_members.size(); }
 
+    /*
+     * Check if a member failed to be synced or removed by the last update of
+     * the group.  The group is kept with the members which succeeded, and the
+     * failed ones are retried by the next update.
+     */
+    inline bool hasFailedMembers() const { return m_failed_members; }
+
     /*
      * Sync the group, generating a SAI ID.
      */
@@ -234,6 +245,11 @@ public:
     {
         SWSS_LOG_ENTER();
 
+        /*
+         * Complete the member operations still queued for this group.
+         */
+        flushPendingMembers();
+
         /*
          * If the group is already removed, there is nothing to be done.
          */
@@ -301,66 +317,118 @@ protected:
      */
     map<MbrKey, Mbr> m_members;
 
+    /*
+     * The members with an operation queued on the shared member bulker.
+     */
+    set<MbrKey> m_pending_members;
+
+    /*
+     * Whether a member operation failed since the last update.
+     */
+    bool m_failed_members = false;
+
+    /*
+     * Program the operations queued on the shared member bulker if any of
+     * them is for this group.  The bulker callbacks refer to the group, so
+     * this must be done before the members are changed in another way.
+     */
+    void flushPendingMembers()
+    {
+        if (!m_pending_members.empty())
+        {
+            gRouteOrch->getNhgMemberBulker().flush();
+        }
+    }
+
     /*
      * Sync the given members in the group.
      */
     virtual bool syncMembers(const set<MbrKey> &member_keys) = 0;
 
     /*
-     * Remove the given members from the group.
+     * Queue the removal of the given members on the shared member bulker.
+     * Once removed, a member is reset, and erased from the group if erase is
+     * set.  A member which fails to be removed is kept as it is.
      */
-    virtual bool removeMembers(const set<MbrKey> &member_keys)
+    void queueRemoveMembers(const set<MbrKey> &member_keys, bool erase)
     {
         SWSS_LOG_ENTER();
 
-        /*
-         * Remove all the given members from the group.
-         */
-        ObjectBulker<sai_next_hop_group_api_t> bulker(sai_next_hop_group_api,
-                                                      gSwitchId,
-                                                      gMaxBulkSize);
-        map<MbrKey, sai_status_t> statuses;
+        auto &bulker = gRouteOrch->getNhgMemberBulker();
 
         for (const auto &key : member_keys)
         {
+            /*
+             * A member can't have two operations queued.
+             */
+            if (m_pending_members.find(key) != m_pending_members.end())
+            {
+                bulker.flush();
+            }
+
             const auto &nhgm = m_members.at(key);
 
-            if (nhgm.isSynced())
+            if (!nhgm.isSynced())
             {
-                bulker.remove_entry(&statuses[key], nhgm.getId());
+                if (erase)
+                {
+                    m_members.erase(key);
+                }
+                continue;
             }
+
+            m_pending_members.insert(key);
+            bulker.removeMember(nhgm.getId(), [this, key, erase](sai_status_t status)
+            {
+                m_pending_members.erase(key);
+                auto &member = m_members.at(key);
+
+                if (status == SAI_STATUS_SUCCESS)
+                {
+                    member.remove();
+
+                    if (erase)
+                    {
+                        m_members.erase(key);
+                    }
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Failed to remove next hop group member %s, rv: %d",
+                                    member.to_string().c_str(),
+                                    status);
+                    m_failed_members = true;
+                }
+            });
         }
+    }
+
+    /*
+     * Remove the given members from the group.
+     */
+    virtual bool removeMembers(const set<MbrKey> &member_keys)
+    {
+        SWSS_LOG_ENTER();
 
         /*
-         * Flush the bulker to remove the members.
+         * Remove all the given members from the group, the result is needed
+         * now so don't wait for the end of the task pass.
          */
-        bulker.flush();
+        queueRemoveMembers(member_keys, false);
+        gRouteOrch->getNhgMemberBulker().flush();
 
         /*
-         * Iterate over the returned statuses and check if the removal was
-         * successful.  If it was, remove the member, otherwise log an error
-         * message.
+         * The members which failed to be removed are still synced.
          */
-        bool success = true;
-
-        for (const auto &status : statuses)
+        for (const auto &key : member_keys)
         {
-            auto &member = m_members.at(status.first);
-
-            if (status.second == SAI_STATUS_SUCCESS)
+            if (m_members.at(key).isSynced())
             {
-                member.remove();
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Failed to remove next hop group member %s, rv: %d",
-                                member.to_string().c_str(),
-                                status.second);
-                success = false;
+                return false;
             }
         }
 
-        return success;
+        return true;
     }
 
     /*
@@ -395,7 +463,7 @@ struct NhgEntry
  * Class providing the common functionality shared by all NhgOrch classes.
  */
 template <typename NhgClass>
-class NhgOrchCommon : public Orch
+class NhgOrchCommon : public Orch, public Subject
 {
 public:
     /*
@@ -456,4 +524,11 @@ protected:
      * Map of synced next hop groups.
      */
     unordered_map<string, NhgEntry<NhgClass>> m_syncdNextHopGroups;
+
+    /* Wake up the tasks waiting for the given next hop group index. */
+    void notifyNhgAdded(const string &index)
+    {
+        Constraint cst = { RETRY_CST_NHG, index };
+        notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+    }
 };
@@ -0,0 +1,73 @@
+#include <cassert>
+
+#include "nhgkeyindex.h"
+
+using namespace std;
+
+NhgKeyId NextHopGroupKeyIndex::intern(const NextHopGroupKey &key)
+{
+    auto it = m_ids.find(key);
+    if (it != m_ids.end())
+    {
+        m_slots[it->second].refs++;
+        return it->second;
+    }
+
+    NhgKeyId id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = (NhgKeyId)m_slots.size();
+        m_slots.emplace_back();
+    }
+
+    it = m_ids.emplace(key, id).first;
+    m_slots[id].key = &it->first;
+    m_slots[id].refs = 1;
+
+    return id;
+}
+
+NhgKeyId NextHopGroupKeyIndex::find(const NextHopGroupKey &key) const
+{
+    auto it = m_ids.find(key);
+    return it == m_ids.end() ? NHG_KEY_ID_INVALID : it->second;
+}
+
+void NextHopGroupKeyIndex::ref(NhgKeyId id)
+{
+    assert(getRefCount(id) > 0);
+
+    m_slots[id].refs++;
+}
+
+void NextHopGroupKeyIndex::release(NhgKeyId id)
+{
+    assert(getRefCount(id) > 0);
+
+    Slot &slot = m_slots[id];
+    if (--slot.refs > 0)
+    {
+        return;
+    }
+
+    m_ids.erase(*slot.key);
+    slot.key = nullptr;
+    m_freeIds.push_back(id);
+}
+
+const NextHopGroupKey &NextHopGroupKeyIndex::getKey(NhgKeyId id) const
+{
+    assert(getRefCount(id) > 0);
+
+    return *m_slots[id].key;
+}
+
+uint32_t NextHopGroupKeyIndex::getRefCount(NhgKeyId id) const
+{
+    return id < m_slots.size() ? m_slots[id].refs : 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "nexthopgroupkey.h"
+
+/* ID of an interned next hop set, NHG_KEY_ID_INVALID is never assigned */
+typedef uint32_t NhgKeyId;
+#define NHG_KEY_ID_INVALID 0
+
+/*
+ * Index interning the next hop sets of the next hop groups.
+ *
+ * Each distinct NextHopGroupKey, weights included, gets a small integer ID.
+ * Routes using the same next hop set in any VRF or from any protocol get the
+ * same ID. Once a route has the ID of its next hops, looking up its group or
+ * comparing its next hops doesn't build, hash or compare keys again.
+ *
+ * IDs are reference counted. An ID and its key stay valid while referenced,
+ * and the ID is reused for another set once the last reference is released.
+ */
+class NextHopGroupKeyIndex
+{
+public:
+    NextHopGroupKeyIndex() = default;
+
+    NextHopGroupKeyIndex(const NextHopGroupKeyIndex&) = delete;
+    NextHopGroupKeyIndex& operator=(const NextHopGroupKeyIndex&) = delete;
+
+    /* Get the ID of the next hop set, interning it if needed, and take a reference */
+    NhgKeyId intern(const NextHopGroupKey &key);
+
+    /* Get the ID of the next hop set if interned, without taking a reference */
+    NhgKeyId find(const NextHopGroupKey &key) const;
+
+    void ref(NhgKeyId id);
+    void release(NhgKeyId id);
+
+    const NextHopGroupKey &getKey(NhgKeyId id) const;
+    uint32_t getRefCount(NhgKeyId id) const;
+
+    /* Number of interned next hop sets */
+    size_t size() const { return m_ids.size(); }
+
+private:
+    struct Slot
+    {
+        /* Key of the m_ids node, which doesn't move when m_ids grows */
+        const NextHopGroupKey *key = nullptr;
+        uint32_t refs = 0;
+    };
+
+    std::unordered_map<NextHopGroupKey, NhgKeyId> m_ids;
+
+    /* Indexed by ID, slot 0 is unused */
+    std::vector<Slot> m_slots = std::vector<Slot>(1);
+    std::vector<NhgKeyId> m_freeIds;
+};
+
+/*
+ * Reference on an interned next hop set, released when going out of scope.
+ */
+class NextHopGroupKeyRef
+{
+public:
+    NextHopGroupKeyRef() = default;
+    NextHopGroupKeyRef(NextHopGroupKeyIndex &index, const NextHopGroupKey &key) :
+        m_index(&index), m_id(index.intern(key)) {}
+
+    ~NextHopGroupKeyRef() { reset(); }
+
+    NextHopGroupKeyRef(NextHopGroupKeyRef &&ref) : m_index(ref.m_index), m_id(ref.m_id)
+        { ref.m_id = NHG_KEY_ID_INVALID; }
+
+    NextHopGroupKeyRef& operator=(NextHopGroupKeyRef &&ref)
+    {
+        if (this != &ref)
+        {
+            reset();
+            m_index = ref.m_index;
+            m_id = ref.m_id;
+            ref.m_id = NHG_KEY_ID_INVALID;
+        }
+        return *this;
+    }
+
+    NextHopGroupKeyRef(const NextHopGroupKeyRef&) = delete;
+    NextHopGroupKeyRef& operator=(const NextHopGroupKeyRef&) = delete;
+
+    void reset()
+    {
+        if (m_id != NHG_KEY_ID_INVALID)
+        {
+            m_index->release(m_id);
+            m_id = NHG_KEY_ID_INVALID;
+        }
+    }
+
+    NhgKeyId id() const { return m_id; }
+
+private:
+    NextHopGroupKeyIndex *m_index = nullptr;
+    NhgKeyId m_id = NHG_KEY_ID_INVALID;
+};
@@ -0,0 +1,72 @@
+#include "nhgmemberbulker.h"
+
+using namespace std;
+
+NhgMemberBulker::NhgMemberBulker(sai_next_hop_group_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    m_bulker(api, switch_id, max_bulk_size)
+{
+    /* Members are independent of each other, keep going after a failed one */
+    m_bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+}
+
+void NhgMemberBulker::createMember(const vector<sai_attribute_t> &attrs, const CreateCallback &done)
+{
+    m_creating.push_back({ SAI_NULL_OBJECT_ID, done });
+    m_bulker.create_entry(&m_creating.back().nhgm_id, (uint32_t)attrs.size(), attrs.data());
+}
+
+void NhgMemberBulker::removeMember(sai_object_id_t nhgm_id, const RemoveCallback &done)
+{
+    m_removing.push_back({ SAI_STATUS_NOT_EXECUTED, done });
+    m_bulker.remove_entry(&m_removing.back().status, nhgm_id);
+}
+
+void NhgMemberBulker::commit()
+{
+    if (m_batchDepth == 0)
+    {
+        flush();
+    }
+}
+
+void NhgMemberBulker::endBatch()
+{
+    assert(m_batchDepth > 0);
+
+    if (--m_batchDepth == 0)
+    {
+        flush();
+    }
+}
+
+void NhgMemberBulker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * The callbacks may queue new operations, e.g. to replace a removed
+     * member, so keep flushing until nothing is left.
+     */
+    while (pendingCount() > 0)
+    {
+        SWSS_LOG_INFO("Flush %zu next hop group member removals, %zu creations",
+                      m_removing.size(), m_creating.size());
+
+        m_bulker.flush();
+
+        deque<RemoveOp> removed;
+        deque<CreateOp> created;
+        removed.swap(m_removing);
+        created.swap(m_creating);
+
+        /* The removals are programmed before the creations, report them in the same order */
+        for (const auto &op : removed)
+        {
+            op.done(op.status);
+        }
+        for (const auto &op : created)
+        {
+            op.done(op.nhgm_id);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "bulker.h"
+
+/*
+ * Next hop group member operations shared by all the next hop groups of
+ * RouteOrch and NhgOrch.
+ *
+ * Member creations and removals are queued together with a callback, which is
+ * run once the member is programmed with the member's own result. A failed
+ * member doesn't fail the other members of its group, or the other groups
+ * programmed in the same bulk call.
+ *
+ * While a batch is open (see NhgMemberBatch), the operations of every group
+ * touched are kept and programmed with one flush when the batch is closed.
+ * Otherwise commit() flushes them right away.
+ */
+class NhgMemberBulker
+{
+public:
+    /* Called with the member's SAI ID, or SAI_NULL_OBJECT_ID if it couldn't be created */
+    using CreateCallback = std::function<void(sai_object_id_t nhgm_id)>;
+    using RemoveCallback = std::function<void(sai_status_t status)>;
+
+    NhgMemberBulker(sai_next_hop_group_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size);
+
+    NhgMemberBulker(const NhgMemberBulker&) = delete;
+    NhgMemberBulker& operator=(const NhgMemberBulker&) = delete;
+
+    void createMember(const std::vector<sai_attribute_t> &attrs, const CreateCallback &done);
+    void removeMember(sai_object_id_t nhgm_id, const RemoveCallback &done);
+
+    /* Flush the queued operations, unless a batch is open */
+    void commit();
+
+    /* Program the queued operations now, then run their callbacks */
+    void flush();
+
+    void beginBatch() { ++m_batchDepth; }
+    void endBatch();
+
+    size_t pendingCount() const { return m_creating.size() + m_removing.size(); }
+
+private:
+    struct CreateOp
+    {
+        sai_object_id_t nhgm_id;
+        CreateCallback done;
+    };
+
+    struct RemoveOp
+    {
+        sai_status_t status;
+        RemoveCallback done;
+    };
+
+    ObjectBulker<sai_next_hop_group_api_t> m_bulker;
+
+    /* The bulker writes the results in place, so the operations must not move */
+    std::deque<CreateOp> m_creating;
+    std::deque<RemoveOp> m_removing;
+
+    unsigned m_batchDepth = 0;
+};
+
+/*
+ * Keeps the member operations of a task pass on the bulker, and programs them
+ * with one flush when closed or going out of scope, so an early return or an
+ * exception can't leave the batch open.
+ */
+class NhgMemberBatch
+{
+public:
+    explicit NhgMemberBatch(NhgMemberBulker &bulker) : m_bulker(bulker) { m_bulker.beginBatch(); }
+    ~NhgMemberBatch() { close(); }
+
+    NhgMemberBatch(const NhgMemberBatch&) = delete;
+    NhgMemberBatch& operator=(const NhgMemberBatch&) = delete;
+
+    /* Close the batch before the end of the scope, the results are needed */
+    void close()
+    {
+        if (m_open)
+        {
+            m_open = false;
+            m_bulker.endBatch();
+        }
+    }
+
+private:
+    NhgMemberBulker &m_bulker;
+    bool m_open = true;
+};
@@ -43,6 +43,16 @@ void NhgOrch::doTask(Consumer& consumer)
         return;
     }
 
+    /*
+     * Program the members of all the groups updated in this pass with a
+     * single bulk call.  The SET operations are consumed only after that, as
+     * a group with failed members keeps its operation to retry them.
+     */
+    auto& bulker = gRouteOrch->getNhgMemberBulker();
+    vector<decltype(consumer.m_toSync.begin())> synced_tasks;
+
+    NhgMemberBatch batch(bulker);
+
     auto it = consumer.m_toSync.begin();
 
     while (it != consumer.m_toSync.end())
@@ -266,6 +276,7 @@ void NhgOrch::doTask(Consumer& consumer)
                         if (nhg->sync())
                         {
                             m_syncdNextHopGroups.emplace(index, NhgEntry<NextHopGroup>(std::move(nhg)));
+                            notifyNhgAdded(index);
                         }
                         else
                         {
@@ -300,6 +311,7 @@ void NhgOrch::doTask(Consumer& consumer)
                             success = false;
                         }
                         m_syncdNextHopGroups.emplace(index, NhgEntry<NextHopGroup>(std::move(nhg)));
+                        notifyNhgAdded(index);
                     }
                 }
             }
@@ -436,7 +448,11 @@ void NhgOrch::doTask(Consumer& consumer)
         }
 
         /* Depending on the operation success, consume it or skip it. */
-        if (success)
+        if (success && (op == SET_COMMAND))
+        {
+            synced_tasks.push_back(it++);
+        }
+        else if (success)
         {
             it = consumer.m_toSync.erase(it);
         }
@@ -445,6 +461,25 @@ void NhgOrch::doTask(Consumer& consumer)
             ++it;
         }
     }
+
+    batch.close();
+
+    /*
+     * Consume the SET operations, unless some members of their group failed
+     * to be programmed.
+     */
+    for (const auto& task_it : synced_tasks)
+    {
+        const auto& nhg_it = m_syncdNextHopGroups.find(task_it->first);
+
+        if ((nhg_it != m_syncdNextHopGroups.end()) && nhg_it->second.nhg->hasFailedMembers())
+        {
+            SWSS_LOG_INFO("Retry failed members of next hop group %s", task_it->first.c_str());
+            continue;
+        }
+
+        consumer.m_toSync.erase(task_it);
+    }
 }
 
 /*
@@ -462,29 +497,36 @@ bool NhgOrch::validateNextHop(const NextHopKey& nh_key)
 
     /*
      * Iterate through all groups and validate the next hop in those who
-     * contain it.
+     * contain it.  The members are programmed with a single bulk call.
      */
-    for (auto& it : m_syncdNextHopGroups)
     {
-        auto& nhg = it.second.nhg;
+        NhgMemberBatch batch(gRouteOrch->getNhgMemberBulker());
 
-        if (nhg->hasMember(nh_key))
+        for (auto& it : m_syncdNextHopGroups)
         {
-            /*
-             * If sync fails, exit right away, as we expect it to be due to a
-             * raeson for which any other future validations will fail too.
-             */
-            if (!nhg->validateNextHop(nh_key))
+            auto& nhg = it.second.nhg;
+
+            if (nhg->hasMember(nh_key))
             {
-                SWSS_LOG_ERROR("Failed to validate next hop %s in group %s",
-                                nh_key.to_string().c_str(),
-                                it.first.c_str());
-                return false;
+                /*
+                 * If sync fails, exit right away, as we expect it to be due to a
+                 * raeson for which any other future validations will fail too.
+                 */
+                if (!nhg->validateNextHop(nh_key))
+                {
+                    SWSS_LOG_ERROR("Failed to validate next hop %s in group %s",
+                                    nh_key.to_string().c_str(),
+                                    it.first.c_str());
+                    return false;
+                }
             }
         }
     }
 
-    return true;
+    /* A batch of the caller may still be open, the results are needed now */
+    gRouteOrch->getNhgMemberBulker().flush();
+
+    return checkFailedMembers(nh_key);
 }
 
 /*
@@ -502,26 +544,63 @@ bool NhgOrch::invalidateNextHop(const NextHopKey& nh_key)
 
     /*
      * Iterate through all groups and invalidate the next hop from those who
-     * contain it.
+     * contain it.  The members are removed with a single bulk call.
      */
-    for (auto& it : m_syncdNextHopGroups)
     {
-        auto& nhg = it.second.nhg;
+        NhgMemberBatch batch(gRouteOrch->getNhgMemberBulker());
 
-        if (nhg->hasMember(nh_key))
+        for (auto& it : m_syncdNextHopGroups)
         {
-            /* If the remove fails, exit right away. */
-            if (!nhg->invalidateNextHop(nh_key))
+            auto& nhg = it.second.nhg;
+
+            if (nhg->hasMember(nh_key))
             {
-                SWSS_LOG_WARN("Failed to invalidate next hop %s from group %s",
-                                nh_key.to_string().c_str(),
-                                it.first.c_str());
-                return false;
+                /* If the remove fails, exit right away. */
+                if (!nhg->invalidateNextHop(nh_key))
+                {
+                    SWSS_LOG_WARN("Failed to invalidate next hop %s from group %s",
+                                    nh_key.to_string().c_str(),
+                                    it.first.c_str());
+                    return false;
+                }
             }
         }
     }
 
-    return true;
+    /* A batch of the caller may still be open, the results are needed now */
+    gRouteOrch->getNhgMemberBulker().flush();
+
+    return checkFailedMembers(nh_key);
+}
+
+/*
+ * Purpose:     Check the result of a next hop (in)validation.
+ * Description: Look for the groups containing the next hop whose member
+ *              failed to be programmed by the bulk call.
+ * Params:      IN  nh_key - The (in)validated next hop.
+ * Returns:     true, if the member was programmed in all containing groups;
+ *              false, otherwise.
+ */
+bool NhgOrch::checkFailedMembers(const NextHopKey& nh_key) const
+{
+    SWSS_LOG_ENTER();
+
+    bool success = true;
+
+    for (const auto& it : m_syncdNextHopGroups)
+    {
+        const auto& nhg = it.second.nhg;
+
+        if (nhg->hasMember(nh_key) && nhg->hasFailedMembers())
+        {
+            SWSS_LOG_WARN("Failed to update next hop %s in group %s",
+                            nh_key.to_string().c_str(),
+                            it.first.c_str());
+            success = false;
+        }
+    }
+
+    return success;
 }
 
 /*
@@ -895,12 +974,15 @@ bool NextHopGroup::remove()
 
 /*
  * Purpose:     Sync the given next hop group's members over the SAI API.
- * Description: Iterate over the given members and sync them.  If the member
- *              is already synced, we skip it.  If any of the next hops isn't
- *              already synced by the neighOrch, this will fail.  Any next hop
- *              which has the neighbor interface down will be skipped.
+ * Description: Iterate over the given members and queue them on the shared
+ *              member bulker.  If the member is already synced or queued, we
+ *              skip it.  If any of the next hops isn't already synced by the
+ *              neighOrch, this will fail.  Any next hop which has the neighbor
+ *              interface down will be skipped.  A member which fails to be
+ *              created is left unsynced and marks the group as having failed
+ *              members, so the next update retries it.
  * Params:      IN  nh_keys - The next hop keys of the members to sync.
- * Returns:     true, if the members were added succesfully;
+ * Returns:     true, if the members were queued succesfully;
  *              false, otherwise.
  */
 bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
@@ -910,24 +992,22 @@ bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
     /* This method should not be called for single-membered non-recursive nexthop groups */
     assert(isRecursive() || (m_members.size() > 1));
 
-    ObjectBulker<sai_next_hop_group_api_t> nextHopGroupMemberBulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize);
+    auto& bulker = gRouteOrch->getNhgMemberBulker();
 
     /*
      * Iterate over the given next hops.
-     * If the group member is already synced, skip it.
+     * If the group member is already synced or queued, skip it.
      * If any next hop is not synced, thus neighOrch doesn't have it, stop
      * immediately.
      * If a next hop's interface is down, skip it from being synced.
      */
-    std::map<NextHopKey, sai_object_id_t> syncingMembers;
-
     bool success = true;
     for (const auto& nh_key : nh_keys)
     {
         NextHopGroupMember& nhgm = m_members.at(nh_key);
 
         /* If the member is already synced, continue. */
-        if (nhgm.isSynced())
+        if (nhgm.isSynced() || (m_pending_members.find(nh_key) != m_pending_members.end()))
         {
             continue;
         }
@@ -954,33 +1034,31 @@ bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
         /* Create the next hop group member's attributes and fill them. */
         vector<sai_attribute_t> nhgm_attrs = createNhgmAttrs(nhgm);
 
-        /* Add a bulker entry for this member. */
-        nextHopGroupMemberBulker.create_entry(&syncingMembers[nh_key],
-                                               (uint32_t)nhgm_attrs.size(),
-                                               nhgm_attrs.data());
-    }
+        /* Queue this member on the shared bulker. */
+        m_pending_members.insert(nh_key);
+        bulker.createMember(nhgm_attrs, [this, nh_key](sai_object_id_t nhgm_id)
+        {
+            m_pending_members.erase(nh_key);
 
-    /* Flush the bulker to perform the sync. */
-    nextHopGroupMemberBulker.flush();
+            /* Check that the returned member ID is valid. */
+            if (nhgm_id == SAI_NULL_OBJECT_ID)
+            {
+                SWSS_LOG_ERROR("Failed to create next hop group %s's member %s",
+                                m_key.to_string().c_str(), nh_key.to_string().c_str());
+                m_failed_members = true;
+            }
+            else
+            {
+                m_members.at(nh_key).sync(nhgm_id);
+            }
+        });
+    }
 
     /*
-     * Go through the synced members and increment the Crm ref count for the
-     * successful ones.
+     * Program the members, unless NhgOrch is batching the members of several
+     * groups.
      */
-    for (const auto& mbr : syncingMembers)
-    {
-        /* Check that the returned member ID is valid. */
-        if (mbr.second == SAI_NULL_OBJECT_ID)
-        {
-            SWSS_LOG_ERROR("Failed to create next hop group %s's member %s",
-                            m_key.to_string().c_str(), mbr.first.to_string().c_str());
-            success = false;
-        }
-        else
-        {
-            m_members.at(mbr.first).sync(mbr.second);
-        }
-    }
+    bulker.commit();
 
     return success;
 }
@@ -1000,6 +1078,10 @@ bool NextHopGroup::update(const NextHopGroupKey& nhg_key)
 {
     SWSS_LOG_ENTER();
 
+    /* Complete the member operations still queued for this group. */
+    flushPendingMembers();
+    m_failed_members = false;
+
     if (!isSynced() ||
         (!isRecursive() && (m_members.size() == 1 || nhg_key.getSize() == 1)))
     {
@@ -1053,18 +1135,12 @@ bool NextHopGroup::update(const NextHopGroupKey& nhg_key)
         }
     }
 
-    /* Remove the removed members. */
-    if (!removeMembers(removed_nh_keys))
-    {
-        SWSS_LOG_WARN("Failed to remove members from group %s", to_string().c_str());
-        return false;
-    }
-
-    /* Remove the removed members. */
-    for (const auto& nh_key : removed_nh_keys)
-    {
-        m_members.erase(nh_key);
-    }
+    /*
+     * Remove the removed members.  They are queued ahead of the new members,
+     * so the ASIC group members limit is not reached.  A member which fails
+     * to be removed is kept and retried by the next update.
+     */
+    queueRemoveMembers(removed_nh_keys, true);
 
     /* Add any new members to the group. */
     for (const auto& it : new_nh_keys)
@@ -1134,6 +1210,7 @@ bool NextHopGroup::validateNextHop(const NextHopKey& nh_key)
 
     if (isRecursive() || (m_members.size() > 1))
     {
+        m_failed_members = false;
         return syncMembers({nh_key});
     }
 
@@ -1142,7 +1219,9 @@ bool NextHopGroup::validateNextHop(const NextHopKey& nh_key)
 
 /*
  * Purpose:     Invalidate a next hop in the group.
- * Description: Sync the invalidated next hop group member.
+ * Description: Queue the removal of the invalidated next hop group member.
+ *              A failure to remove it is reported by hasFailedMembers() once
+ *              the shared member bulker is flushed.
  * Params:      IN  nh_key - The next hop to invalidate.
  * Returns:     true, if the operation was successful;
  *              false, otherwise.
@@ -1153,7 +1232,9 @@ bool NextHopGroup::invalidateNextHop(const NextHopKey& nh_key)
 
     if (isRecursive() || (m_members.size() > 1))
     {
-        return removeMembers({nh_key});
+        m_failed_members = false;
+        queueRemoveMembers({nh_key}, false);
+        gRouteOrch->getNhgMemberBulker().commit();
     }
 
     return true;
@@ -131,4 +131,7 @@ public:
 
 private:
     void doTask(Consumer& consumer) override;
+
+    /* Check that a next hop was (in)validated in all the groups. */
+    bool checkFailedMembers(const NextHopKey& nh_key) const;
 };
@@ -24,7 +24,8 @@ enum SubjectType
     SUBJECT_TYPE_MLAG_INTF_CHANGE,
     SUBJECT_TYPE_MLAG_ISL_CHANGE,
     SUBJECT_TYPE_FDB_FLUSH_CHANGE,
-    SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE
+    SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE,
+    SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED
 };
 
 class Observer
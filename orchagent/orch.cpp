@@ -20,11 +20,112 @@ int gBatchSize = 0;
 std::shared_ptr<RingBuffer> Orch::gRingBuffer = nullptr;
 std::shared_ptr<RingBuffer> Executor::gRingBuffer = nullptr;
 
-RingBuffer::RingBuffer(int size): buffer(size)
+std::atomic<bool> ConsumerBase::m_retryPass{false};
+std::atomic<uint64_t> ConsumerBase::m_progressEpoch{0};
+
+RingLane::RingLane(const string &name, size_t depth):
+    m_name(name)
+{
+    size_t capacity = 2;
+    while (capacity < depth)
+    {
+        capacity <<= 1;
+    }
+
+    m_cells = vector<Cell>(capacity);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_mask = capacity - 1;
+}
+
+size_t RingLane::size() const
+{
+    size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+    size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+
+    return enqueuePos >= dequeuePos ? enqueuePos - dequeuePos : 0;
+}
+
+bool RingLane::push(AnyTask &&task)
+{
+    Cell *cell;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        cell = &m_cells[pos & m_mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            m_stalls++;
+            return false;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->task = std::move(task);
+    cell->enqueued = std::chrono::steady_clock::now();
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    m_pushed++;
+
+    size_t depth = size();
+    size_t watermark = m_highWatermark.load(std::memory_order_relaxed);
+    while (depth > watermark && !m_highWatermark.compare_exchange_weak(watermark, depth, std::memory_order_relaxed));
+
+    return true;
+}
+
+bool RingLane::pop(AnyTask &task)
+{
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell = &m_cells[pos & m_mask];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+    {
+        return false;
+    }
+
+    task = std::move(cell->task);
+    uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - cell->enqueued).count();
+
+    m_dequeuePos.store(pos + 1, std::memory_order_release);
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    m_executed++;
+    m_totalLatencyUs += latency;
+    if (latency > m_maxLatencyUs.load(std::memory_order_relaxed))
+    {
+        m_maxLatencyUs.store(latency, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+RingBuffer::RingBuffer(int size)
 {
     if (size <= 1) {
         throw std::invalid_argument("Buffer size must be greater than 1");
     }
+
+    m_depth = static_cast<size_t>(size);
+    m_lanes.emplace_back(new RingLane("default", m_depth));
 }
 
 void RingBuffer::pauseThread()
@@ -42,9 +143,25 @@ void RingBuffer::notify()
         cv.notify_all();
 }
 
+void RingBuffer::waitUntilDrained()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!IsEmpty() || !IsIdle())
+    {
+        cv.notify_all();
+        idle_cv.wait_for(lock, std::chrono::milliseconds(SLEEP_MSECONDS));
+    }
+}
+
 void RingBuffer::setIdle(bool idle)
 {
     idle_status = idle;
+
+    if (idle)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        idle_cv.notify_all();
+    }
 }
 
 bool RingBuffer::IsIdle() const
@@ -54,40 +171,91 @@ bool RingBuffer::IsIdle() const
 
 bool RingBuffer::IsFull() const
 {
-    return (tail + 1) % static_cast<int>(buffer.size()) == head;
+    for (const auto &lane : m_lanes)
+    {
+        if (lane->size() < lane->capacity())
+            return false;
+    }
+    return true;
 }
 
 bool RingBuffer::IsEmpty() const
 {
-    return tail == head;
+    for (const auto &lane : m_lanes)
+    {
+        if (!lane->empty())
+            return false;
+    }
+    return true;
+}
+
+RingLane *RingBuffer::getLane(const std::string &tableName) const
+{
+    auto it = m_consumerSet.find(tableName);
+    if (it == m_consumerSet.end())
+    {
+        return m_lanes.front().get();
+    }
+    return it->second;
 }
 
 bool RingBuffer::push(AnyTask ringEntry)
 {
-    if (IsFull())
-        return false;
-    buffer[tail] = std::move(ringEntry);
-    tail = (tail + 1) % static_cast<int>(buffer.size());
-    return true;
+    return m_lanes.front()->push(std::move(ringEntry));
+}
+
+bool RingBuffer::push(const std::string &tableName, AnyTask ringEntry)
+{
+    return getLane(tableName)->push(std::move(ringEntry));
 }
 
 bool RingBuffer::pop(AnyTask& ringEntry)
 {
-    if (IsEmpty())
-        return false;
-    ringEntry = std::move(buffer[head]);
-    head = (head + 1) % static_cast<int>(buffer.size());
-    return true;
+    // Round robin over the lanes, one task at a time
+    for (size_t i = 0; i < m_lanes.size(); i++)
+    {
+        auto &lane = m_lanes[m_nextLane];
+        m_nextLane = (m_nextLane + 1) % m_lanes.size();
+
+        if (lane->pop(ringEntry))
+            return true;
+    }
+    return false;
 }
 
 void RingBuffer::addExecutor(Executor* executor)
 {
-    m_consumerSet.insert(executor->getName());
+    const auto &name = executor->getName();
+    if (m_consumerSet.find(name) != m_consumerSet.end())
+        return;
+
+    m_lanes.emplace_back(new RingLane(name, m_depth));
+    m_consumerSet[name] = m_lanes.back().get();
 }
 
 bool RingBuffer::serves(const std::string& tableName)
 {
-    return m_consumerSet.find(tableName) != m_consumerSet.end();  
+    return m_consumerSet.find(tableName) != m_consumerSet.end();
+}
+
+std::vector<ring_lane_stats_t> RingBuffer::getStats() const
+{
+    std::vector<ring_lane_stats_t> stats;
+    for (const auto &lane : m_lanes)
+    {
+        ring_lane_stats_t s;
+        s.name = lane->getName();
+        s.depth = lane->size();
+        s.capacity = lane->capacity();
+        s.highWatermark = lane->m_highWatermark;
+        s.pushed = lane->m_pushed;
+        s.stalls = lane->m_stalls;
+        s.executed = lane->m_executed;
+        s.avgLatencyUs = s.executed ? lane->m_totalLatencyUs / s.executed : 0;
+        s.maxLatencyUs = lane->m_maxLatencyUs;
+        stats.push_back(s);
+    }
+    return stats;
 }
 
 Orch::Orch(DBConnector *db, const string tableName, int pri)
@@ -157,77 +325,81 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry)
     /* Record incoming tasks */
     Recorder::Instance().swss.record(dumpTuple(entry));
 
+    /* A newer update supersedes the wait, merge it with the parked task */
+    if (!m_retryCache.empty())
+    {
+        KeyOpFieldsValuesTuple parked;
+        if (m_retryCache.take(key, parked))
+        {
+            m_toSync.emplace(key, std::move(parked));
+        }
+    }
+
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
-    * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * m_toSync allows one key with multiple values, the values of a key are
+    * adjacent and kept in insertion order.
+    * We maintain maximum two values per key.
+    * In case there is one key-value, it should be DEL or SET
+    * In case there are two key-value pairs, it should be DEL then SET
     */
+    auto iter = m_toSync.find(key);
 
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    if (iter == m_toSync.end())
     {
         m_toSync.emplace(key, entry);
+        return;
     }
 
     /* if a DEL task comes, we overwrite the old key */
-    else if (op == DEL_COMMAND)
-    {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
-    }
-    else
+    if (op == DEL_COMMAND)
     {
-        /*
-        * Now we are trying to add the key-value with SET.
-        * We maintain maximum two values per key.
-        * In case there is one key-value, it should be DEL or SET
-        * In case there are two key-value pairs, it should be DEL then SET
-        * The code logic is following:
-        * We iterate the values with the key, we skip the value with DEL and then
-        * check if that was the only one (I,E, the iter pointer now points to end or next key),
-        * in such case, we insert the key-value with SET.
-        * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
-        */
-        auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
+        iter->second = entry;
+        m_toSync.touch(iter);
+
+        auto next = std::next(iter);
+        while (next != m_toSync.end() && next->first == key)
         {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
-                break;
+            next = m_toSync.erase(next);
         }
-        if (iter == ret.second)
+        return;
+    }
+
+    /*
+    * Now we are trying to add the key-value with SET.
+    * We skip the value with DEL and, if there was a SET already, we combine
+    * the fields in place. Otherwise the SET is inserted after the DEL.
+    */
+    for (; iter != m_toSync.end() && iter->first == key; ++iter)
+    {
+        if (kfvOp(iter->second) == SET_COMMAND)
         {
-            m_toSync.emplace(key, entry);
+            break;
         }
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+    }
 
+    if (iter == m_toSync.end() || iter->first != key)
+    {
+        m_toSync.emplace(key, entry);
+        return;
+    }
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+    auto &existing_values = kfvFieldsValues(iter->second);
+    for (const auto &it : kfvFieldsValues(entry))
+    {
+        const string &field = fvField(it);
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
+        auto iu = existing_values.begin();
+        while (iu != existing_values.end())
+        {
+            if (fvField(*iu) == field)
+                iu = existing_values.erase(iu);
+            else
+                iu++;
         }
+        existing_values.push_back(it);
     }
-
+    m_toSync.touch(iter);
 }
 
 size_t ConsumerBase::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
@@ -304,6 +476,78 @@ size_t ConsumerBase::refillToSync()
     return 0;
 }
 
+SyncMap::iterator ConsumerBase::addToRetry(SyncMap::iterator it, const Constraint &cst)
+{
+    SWSS_LOG_ENTER();
+
+    /* Only the last task of a key can be parked, e.g. the SET after a DEL */
+    auto next = std::next(it);
+    if (next != m_toSync.end() && next->first == it->first)
+    {
+        return next;
+    }
+
+    m_retryCache.insert(it->first, std::move(it->second), cst);
+    return m_toSync.erase(it);
+}
+
+size_t ConsumerBase::retryToSync(const Constraint &cst)
+{
+    SWSS_LOG_ENTER();
+
+    auto tasks = m_retryCache.resolve(cst);
+    for (auto &task : tasks)
+    {
+        m_toSync.emplace(task.first, std::move(task.second));
+    }
+
+    if (!tasks.empty())
+    {
+        SWSS_LOG_INFO("Woke up %zu tasks of %s waiting for %s", tasks.size(), getName().c_str(), cst.second.c_str());
+    }
+
+    return tasks.size();
+}
+
+void ConsumerBase::setRetryPass(bool retryPass)
+{
+    m_retryPass = retryPass;
+}
+
+void ConsumerBase::notifyProgress()
+{
+    m_progressEpoch++;
+}
+
+bool ConsumerBase::shouldDrain()
+{
+    if (m_toSync.empty())
+    {
+        return false;
+    }
+
+    if (!m_retryPass || m_toSync.newSize() > 0 || m_lastEpoch != m_progressEpoch)
+    {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    return now - m_lastAttempt >= std::chrono::milliseconds(RETRY_INTERVAL_MSECONDS);
+}
+
+void ConsumerBase::parkTasks(size_t pending)
+{
+    /* Tasks done by this pass may unblock the ones parked in other consumers */
+    if (pendingSize() < pending)
+    {
+        notifyProgress();
+    }
+
+    m_toSync.park();
+    m_lastEpoch = m_progressEpoch;
+    m_lastAttempt = std::chrono::steady_clock::now();
+}
+
 string ConsumerBase::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
 {
     string s = getTableName() + getConsumerTable()->getTableNameSeparator() + kfvKey(tuple)
@@ -326,6 +570,10 @@ void ConsumerBase::dumpPendingTasks(vector<string> &ts)
 
         ts.push_back(s);
     }
+
+    m_retryCache.forEach([&](const KeyOpFieldsValuesTuple &tuple) {
+        ts.push_back(dumpTuple(tuple));
+    });
 }
 
 void Consumer::execute()
@@ -361,21 +609,24 @@ void Executor::processAnyTask(AnyTask&& task)
     {
         // this executor should execute the input task in the main thread
         // but to avoid thread issue, it should wait when the ring buffer is actively working
-        while (!gRingBuffer->IsEmpty() || !gRingBuffer->IsIdle()) {
-            gRingBuffer->notify();
-            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MSECONDS));
-        }
+        gRingBuffer->waitUntilDrained();
         // execute task()
         task();
     }
     else
     {
         // if this executor is served by ring buffer, 
-        // push the task to gRingBuffer
+        // push the task to its lane of gRingBuffer
         // this task would be executed in the ring thread, not here
-        while (!gRingBuffer->push(task)) {
+        bool warned = false;
+        while (!gRingBuffer->push(getName(), task)) {
             gRingBuffer->notify();
-            SWSS_LOG_WARN("ring is full...push again");
+            if (!warned)
+            {
+                SWSS_LOG_WARN("ring lane %s is full...push again", getName().c_str());
+                warned = true;
+            }
+            std::this_thread::yield();
         }
         gRingBuffer->notify();
     }
@@ -383,8 +634,12 @@ void Executor::processAnyTask(AnyTask&& task)
 
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
+    if (shouldDrain())
+    {
+        size_t pending = pendingSize();
         ((Orch *)m_orch)->doTask((Consumer&)*this);
+        parkTasks(pending);
+    }
 }
 
 size_t Orch::addExistingData(const string& tableName)
@@ -684,6 +939,18 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
+void Orch::retryToSync(const Constraint &cst)
+{
+    for (auto &it : m_consumerMap)
+    {
+        ConsumerBase* consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer != NULL)
+        {
+            consumer->retryToSync(cst);
+        }
+    }
+}
+
 void Orch::flushResponses()
 {
     m_publisher.flush();
@@ -908,6 +1175,13 @@ bool Orch::isItemIdsMapContinuous(unsigned long idsMap, sai_uint32_t maxId)
     return true;
 }
 
+void Orch::declareResources(const set<string> &reads, const set<string> &writes)
+{
+    m_readResources = reads;
+    m_writeResources = writes;
+    m_resourcesDeclared = true;
+}
+
 void Orch::addConsumer(DBConnector *db, string tableName, int pri)
 {
     if (db->getDbId() == CONFIG_DB || db->getDbId() == STATE_DB || db->getDbId() == CHASSIS_APP_DB)
@@ -932,7 +1206,8 @@ void Orch::addExecutor(Executor* executor)
         SWSS_LOG_THROW("Duplicated executorName in m_consumerMap: %s", executor->getName().c_str());
     }
 
-    if (gRingBuffer && executor->getName() == APP_ROUTE_TABLE_NAME) {
+    if (gRingBuffer && (executor->getName() == APP_ROUTE_TABLE_NAME ||
+                        executor->getName() == APP_NEIGH_TABLE_NAME)) {
         gRingBuffer->addExecutor(executor);
     }
 }
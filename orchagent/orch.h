@@ -7,7 +7,10 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <type_traits>
 
 extern "C" {
 #include <sai.h>
@@ -26,6 +29,8 @@ extern "C" {
 #include "response_publisher.h"
 #include "recorder.h"
 #include "schema.h"
+#include "syncmap.h"
+#include "retrycache.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -51,8 +56,36 @@ const char state_db_key_delimiter  = '|';
 #define DEFAULT_KEY_SEPARATOR  ":"
 #define VLAN_SUB_INTERFACE_SEPARATOR "."
 
+/*
+ * Names of shared state, used by orchs to declare what doTask() reads and
+ * writes (see Orch::declareResources).
+ */
+#define ORCH_RESOURCE_PORT          "PORT"
+#define ORCH_RESOURCE_NEIGH         "NEIGH"
+#define ORCH_RESOURCE_FDB           "FDB"
+#define ORCH_RESOURCE_MIRROR        "MIRROR"
+#define ORCH_RESOURCE_VXLAN         "VXLAN"
+#define ORCH_RESOURCE_MLAG          "MLAG"
+#define ORCH_RESOURCE_ACL           "ACL"
+#define ORCH_RESOURCE_BUFFER        "BUFFER"
+#define ORCH_RESOURCE_SWITCH        "SWITCH"
+#define ORCH_RESOURCE_CRM           "CRM"
+#define ORCH_RESOURCE_WATERMARK     "WATERMARK"
+#define ORCH_RESOURCE_PFCWD         "PFCWD"
+#define ORCH_RESOURCE_DASH_ENI      "DASH_ENI"
+#define ORCH_RESOURCE_DASH_VNET     "DASH_VNET"
+#define ORCH_RESOURCE_DASH_ROUTE    "DASH_ROUTE"
+#define ORCH_RESOURCE_DASH_ACL      "DASH_ACL"
+#define ORCH_RESOURCE_DASH_TUNNEL   "DASH_TUNNEL"
+#define ORCH_RESOURCE_DASH_METER    "DASH_METER"
+#define ORCH_RESOURCE_DASH_HA       "DASH_HA"
+#define ORCH_RESOURCE_DASH_PORT_MAP "DASH_PORT_MAP"
+
 #define RING_SIZE 30
+#define RING_TASK_SIZE 48
+#define COUNTERS_RING_BUFFER_TABLE "RING_BUFFER_STATS"
 #define SLEEP_MSECONDS 500
+#define RETRY_INTERVAL_MSECONDS 1000
 
 const int default_orch_pri = 0;
 
@@ -84,16 +117,120 @@ typedef std::map<std::string, std::shared_ptr<object_reference_map>> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
-
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
 class Orch;
 
-using AnyTask = std::function<void()>; // represents a function with no argument and returns void
+/*
+ * AnyTask represents a function with no argument that returns void.
+ *
+ * Unlike std::function, the callable is always stored inline in a fixed
+ * RING_TASK_SIZE bytes buffer, so queuing a task on the ring buffer never
+ * allocates. Callables that do not fit are rejected at compile time.
+ */
+class AnyTask
+{
+public:
+    AnyTask() = default;
+
+    template <typename F,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, AnyTask>::value>::type>
+    AnyTask(F &&func)
+    {
+        typedef typename std::decay<F>::type Fn;
+        static_assert(sizeof(Fn) <= RING_TASK_SIZE, "task capture exceeds RING_TASK_SIZE");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "task capture is over-aligned");
+
+        new (&m_storage) Fn(std::forward<F>(func));
+        m_ops = &opsFor<Fn>;
+    }
+
+    AnyTask(const AnyTask &other)
+    {
+        if (other.m_ops)
+        {
+            other.m_ops->copy(&m_storage, &other.m_storage);
+            m_ops = other.m_ops;
+        }
+    }
+
+    AnyTask(AnyTask &&other) noexcept
+    {
+        if (other.m_ops)
+        {
+            other.m_ops->move(&m_storage, &other.m_storage);
+            m_ops = other.m_ops;
+            other.reset();
+        }
+    }
+
+    AnyTask& operator=(const AnyTask &other)
+    {
+        if (this != &other)
+        {
+            AnyTask tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    AnyTask& operator=(AnyTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.m_ops)
+            {
+                other.m_ops->move(&m_storage, &other.m_storage);
+                m_ops = other.m_ops;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    ~AnyTask() { reset(); }
+
+    void operator()() { m_ops->invoke(&m_storage); }
+
+    explicit operator bool() const { return m_ops != nullptr; }
+
+    void reset()
+    {
+        if (m_ops)
+        {
+            m_ops->destroy(&m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops
+    {
+        void (*invoke)(void *);
+        void (*copy)(void *, const void *);
+        void (*move)(void *, void *);
+        void (*destroy)(void *);
+    };
+
+    template <typename Fn>
+    static void invokeFn(void *p) { (*static_cast<Fn *>(p))(); }
+    template <typename Fn>
+    static void copyFn(void *dst, const void *src) { new (dst) Fn(*static_cast<const Fn *>(src)); }
+    template <typename Fn>
+    static void moveFn(void *dst, void *src) { new (dst) Fn(std::move(*static_cast<Fn *>(src))); }
+    template <typename Fn>
+    static void destroyFn(void *p) { static_cast<Fn *>(p)->~Fn(); }
+
+    template <typename Fn>
+    static const Ops opsFor;
+
+    typename std::aligned_storage<RING_TASK_SIZE, alignof(std::max_align_t)>::type m_storage;
+    const Ops *m_ops = nullptr;
+};
+
+template <typename Fn>
+const AnyTask::Ops AnyTask::opsFor = { &AnyTask::invokeFn<Fn>, &AnyTask::copyFn<Fn>, &AnyTask::moveFn<Fn>, &AnyTask::destroyFn<Fn> };
 
 class RingBuffer;
 
@@ -182,19 +319,126 @@ public:
 
     size_t refillToSync();
     size_t refillToSync(swss::Table* table);
+
+    /*
+     * Park the task at 'it' until 'cst' is resolved, instead of leaving it
+     * in m_toSync to be retried by every doTask() pass. Returns the next
+     * task, like m_toSync.erase(). A newer update of the key takes the task
+     * back to m_toSync.
+     */
+    SyncMap::iterator addToRetry(SyncMap::iterator it, const Constraint &cst);
+
+    // Move the tasks waiting for 'cst' back to m_toSync, returns their number
+    size_t retryToSync(const Constraint &cst);
+
+    size_t getRetrySize() const { return m_retryCache.size(); }
+
+    /*
+     * The periodic pass of OrchDaemon retries the tasks left in m_toSync.
+     * During that pass, a consumer with only parked tasks is skipped unless
+     * some consumer made progress since its last attempt, or
+     * RETRY_INTERVAL_MSECONDS elapsed.
+     */
+    static void setRetryPass(bool retryPass);
+    static void notifyProgress();
+
+protected:
+    // Whether drain() should run doTask() now
+    bool shouldDrain();
+    // Park the remaining tasks after a doTask() pass which started with 'pending' tasks
+    void parkTasks(size_t pending);
+    size_t pendingSize() const { return m_toSync.size() + m_retryCache.size(); }
+
+private:
+    RetryCache m_retryCache;
+
+    static std::atomic<bool> m_retryPass;
+    static std::atomic<uint64_t> m_progressEpoch;
+
+    uint64_t m_lastEpoch = 0;
+    std::chrono::steady_clock::time_point m_lastAttempt;
 };
 
+/*
+ * RingLane is a bounded lock-free multi-producer single-consumer queue.
+ *
+ * Each cell carries a sequence number (D. Vyukov's bounded queue), so
+ * producers only contend on one atomic increment and the ring thread pops
+ * without taking any lock. Tasks are stored inline in the cells.
+ */
+class RingLane
+{
+public:
+    RingLane(const std::string &name, size_t depth);
+
+    const std::string& getName() const { return m_name; }
+    size_t capacity() const { return m_mask + 1; }
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    bool push(AnyTask &&task);
+    bool pop(AnyTask &task);
+
+    // Statistics, updated by producers and the ring thread respectively
+    std::atomic<uint64_t> m_pushed{0};
+    std::atomic<uint64_t> m_stalls{0};
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_totalLatencyUs{0};
+    std::atomic<uint64_t> m_maxLatencyUs{0};
+    std::atomic<size_t> m_highWatermark{0};
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        AnyTask task;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    std::string m_name;
+    std::vector<Cell> m_cells;
+    size_t m_mask;
+
+    // Keep producer and consumer positions on separate cache lines
+    std::atomic<size_t> m_enqueuePos{0};
+    char m_padding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_dequeuePos{0};
+};
+
+typedef struct
+{
+    std::string name;
+    size_t depth;
+    size_t capacity;
+    size_t highWatermark;
+    uint64_t pushed;
+    uint64_t stalls;
+    uint64_t executed;
+    uint64_t avgLatencyUs;
+    uint64_t maxLatencyUs;
+} ring_lane_stats_t;
+
+/*
+ * RingBuffer hands consumer tasks over from the select thread to the ring
+ * thread. Every table served by the ring gets its own lane, and pop() walks
+ * the lanes round robin, so a burst on one table (e.g. ROUTE_TABLE) cannot
+ * starve the others (e.g. NEIGH_TABLE). Tasks pushed without a table name go
+ * to the default lane.
+ */
 class RingBuffer
 {
 private:
-    std::vector<AnyTask> buffer;
-    int head = 0;
-    int tail = 0;
-    std::set<std::string> m_consumerSet;
+    size_t m_depth;
+    std::vector<std::unique_ptr<RingLane>> m_lanes;
+    std::map<std::string, RingLane *> m_consumerSet;
+    size_t m_nextLane = 0;
 
     std::condition_variable cv;
+    std::condition_variable idle_cv;
     std::mutex mtx;
-    bool idle_status = true;
+    std::atomic<bool> idle_status{true};
+
+    RingLane *getLane(const std::string &tableName) const;
 
 public:
     RingBuffer(int size=RING_SIZE);
@@ -205,17 +449,24 @@ public:
     void pauseThread();
     // wake up the ring thread in case it's locked but not empty
     void notify();
+    // block the caller until every lane is drained and the ring thread is idle
+    void waitUntilDrained();
 
     bool IsFull() const;
     bool IsEmpty() const;
     bool IsIdle() const;
 
     bool push(AnyTask entry);
+    bool push(const std::string &tableName, AnyTask entry);
     bool pop(AnyTask& entry);
 
+    // Lanes must be added before the ring thread is started
     void addExecutor(Executor* executor);
     bool serves(const std::string& tableName);
     void setIdle(bool idle);
+
+    size_t getDepth() const { return m_depth; }
+    std::vector<ring_lane_stats_t> getStats() const;
 };
 
 class Consumer : public ConsumerBase {
@@ -307,10 +558,23 @@ public:
 
     void dumpPendingTasks(std::vector<std::string> &ts);
 
+    /* Wake up the tasks of all consumers parked on 'cst' */
+    void retryToSync(const Constraint &cst);
+
     /**
      * @brief Flush pending responses
      */
     void flushResponses();
+
+    /*
+     * Declare the shared state doTask() reads and writes, so that OrchScheduler
+     * can run this orch concurrently with orchs it doesn't conflict with.
+     * An orch without a declaration is never run concurrently with another one.
+     */
+    void declareResources(const std::set<std::string> &reads, const std::set<std::string> &writes);
+    bool hasDeclaredResources() const { return m_resourcesDeclared; }
+    const std::set<std::string>& getReadResources() const { return m_readResources; }
+    const std::set<std::string>& getWriteResources() const { return m_writeResources; }
 protected:
     ConsumerMap m_consumerMap;
 
@@ -335,6 +599,10 @@ protected:
 
     ResponsePublisher m_publisher{"APPL_STATE_DB"};
 private:
+    bool m_resourcesDeclared = false;
+    std::set<std::string> m_readResources;
+    std::set<std::string> m_writeResources;
+
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
 };
 
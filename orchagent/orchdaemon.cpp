@@ -74,12 +74,15 @@ event_handle_t g_events_handle;
 #define DEFAULT_MAX_BULK_SIZE 1000
 size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
 
+size_t gOrchWorkers = 1;
+
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb, DBConnector *chassisAppDb, ZmqServer *zmqServer) :
         m_applDb(applDb),
         m_configDb(configDb),
         m_stateDb(stateDb),
         m_chassisAppDb(chassisAppDb),
-        m_zmqServer(zmqServer)
+        m_zmqServer(zmqServer),
+        m_scheduler(gOrchWorkers)
 {
     SWSS_LOG_ENTER();
     m_select = new Select();
@@ -147,11 +150,11 @@ void OrchDaemon::popRingBuffer()
 /**
  * This function initializes gRingBuffer, otherwise it's nullptr.
  */
-void OrchDaemon::enableRingBuffer() {
-    gRingBuffer = std::make_shared<RingBuffer>();
+void OrchDaemon::enableRingBuffer(int size) {
+    gRingBuffer = std::make_shared<RingBuffer>(size);
     Executor::gRingBuffer = gRingBuffer;
     Orch::gRingBuffer = gRingBuffer;
-    SWSS_LOG_NOTICE("RingBuffer created at %p!", (void *)gRingBuffer.get());
+    SWSS_LOG_NOTICE("RingBuffer created at %p with lane depth %d!", (void *)gRingBuffer.get(), size);
 }
 
 void OrchDaemon::disableRingBuffer() {
@@ -160,6 +163,59 @@ void OrchDaemon::disableRingBuffer() {
     Orch::gRingBuffer = nullptr;
 }
 
+/*
+ * Publish per-lane ring buffer statistics to COUNTERS_DB so that queue depth,
+ * producer stalls and enqueue-to-execute latency can be monitored.
+ */
+void OrchDaemon::publishRingBufferStats()
+{
+    if (!gRingBuffer)
+    {
+        return;
+    }
+
+    if (!m_ringStatsTable)
+    {
+        m_countersDb = std::make_shared<DBConnector>("COUNTERS_DB", 0);
+        m_ringStatsTable = std::make_unique<Table>(m_countersDb.get(), COUNTERS_RING_BUFFER_TABLE);
+    }
+
+    for (const auto &lane : gRingBuffer->getStats())
+    {
+        vector<FieldValueTuple> fvs = {
+            {"depth", to_string(lane.depth)},
+            {"capacity", to_string(lane.capacity)},
+            {"high_watermark", to_string(lane.highWatermark)},
+            {"pushed", to_string(lane.pushed)},
+            {"stalls", to_string(lane.stalls)},
+            {"executed", to_string(lane.executed)},
+            {"avg_latency_us", to_string(lane.avgLatencyUs)},
+            {"max_latency_us", to_string(lane.maxLatencyUs)}
+        };
+        m_ringStatsTable->set(lane.name, fvs);
+    }
+}
+
+/*
+ * Run the periodic doTask() pass over all orchs. Consumers whose m_toSync
+ * only holds tasks that already failed are skipped until something made
+ * progress (see ConsumerBase::shouldDrain).
+ */
+void OrchDaemon::retryPendingTasks()
+{
+    ConsumerBase::setRetryPass(true);
+    try
+    {
+        m_scheduler.run();
+    }
+    catch (...)
+    {
+        ConsumerBase::setRetryPass(false);
+        throw;
+    }
+    ConsumerBase::setRetryPass(false);
+}
+
 bool OrchDaemon::init()
 {
     SWSS_LOG_ENTER();
@@ -310,6 +366,10 @@ bool OrchDaemon::init()
     gNhgOrch = new NhgOrch(m_applDb, APP_NEXTHOP_GROUP_TABLE_NAME);
     gCbfNhgOrch = new CbfNhgOrch(m_applDb, APP_CLASS_BASED_NEXT_HOP_GROUP_TABLE_NAME);
 
+    /* Routes referencing a next hop group index are parked until it is created */
+    gNhgOrch->attach(gRouteOrch);
+    gCbfNhgOrch->attach(gRouteOrch);
+
     gCoppOrch = new CoppOrch(m_applDb, APP_COPP_TABLE_NAME);
 
     vector<string> tunnel_tables = {
@@ -821,6 +881,11 @@ bool OrchDaemon::init()
     TwampOrch *twamp_orch = new TwampOrch(confDbTwampTable, stateDbTwampTable, gSwitchOrch, gPortsOrch, vrf_orch);
     m_orchList.push_back(twamp_orch);
 
+    /* Orderings to keep when the periodic doTask() pass runs orchs concurrently */
+    m_scheduler.addOrder(gPortsOrch, gIntfsOrch);
+    m_scheduler.addOrder(gIntfsOrch, gNeighOrch);
+    m_scheduler.addOrder(gNeighOrch, gRouteOrch);
+
     if (WarmStart::isWarmStart())
     {
         bool suc = warmRestoreAndSyncUp();
@@ -880,6 +945,8 @@ void OrchDaemon::start(long heartBeatInterval)
         m_select->addSelectables(o->getSelectables());
     }
 
+    m_scheduler.setOrchList(m_orchList);
+
     auto tstart = std::chrono::high_resolution_clock::now();
 
     while (true)
@@ -899,6 +966,7 @@ void OrchDaemon::start(long heartBeatInterval)
             tstart = std::chrono::high_resolution_clock::now();
 
             flush();
+            publishRingBufferStats();
         }
 
         if (ret == Select::ERROR)
@@ -924,8 +992,7 @@ void OrchDaemon::start(long heartBeatInterval)
                 }
                 else
                 {
-                    for (Orch *o : m_orchList)
-                        o->doTask();
+                    retryPendingTasks();
                 }
             }
 
@@ -943,13 +1010,18 @@ void OrchDaemon::start(long heartBeatInterval)
         auto *c = (Executor *)s;
         c->execute();
 
+        /* Notifications and timers may unblock tasks parked in m_toSync */
+        if (dynamic_cast<ConsumerBase *>(c) == nullptr)
+        {
+            ConsumerBase::notifyProgress();
+        }
+
         /* After each iteration, periodically check all m_toSync map to
          * execute all the remaining tasks that need to be retried. */
 
         if (!gRingBuffer || (gRingBuffer->IsEmpty() && gRingBuffer->IsIdle()))
         {
-            for (Orch *o : m_orchList)
-                o->doTask();
+            retryPendingTasks();
         }
         /*
          * Asked to check warm restart readiness.
@@ -965,11 +1037,7 @@ void OrchDaemon::start(long heartBeatInterval)
                 // but should finish data that already in the ring
                 if (gRingBuffer)
                 {
-                    while (!gRingBuffer->IsEmpty() || !gRingBuffer->IsIdle())
-                    {
-                        gRingBuffer->notify();
-                        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MSECONDS));
-                    }
+                    gRingBuffer->waitUntilDrained();
                 }
 
                 // Should sleep here or continue handling timers and etc.??
@@ -58,6 +58,7 @@
 #include "dash/dashhaorch.h"
 #include "dash/dashmeterorch.h"
 #include "dash/dashportmaporch.h"
+#include "orchscheduler.h"
 #include <sairedis.h>
 
 using namespace swss;
@@ -97,12 +98,14 @@ public:
      * and populate this ring's pointer to the producers [Orch, Consumer], to make sure that
      * they are connected to the same ring.
      */
-    void enableRingBuffer();
+    void enableRingBuffer(int size = RING_SIZE);
     void disableRingBuffer();
     /**
      * This method describes how the ring consumer consumes this ring.
      */
     void popRingBuffer();
+    void publishRingBufferStats();
+    void retryPendingTasks();
 
     std::shared_ptr<RingBuffer> gRingBuffer = nullptr;
 
@@ -120,9 +123,13 @@ protected:
     bool m_fabricQueueStatEnabled = true;
 
     std::vector<Orch *> m_orchList;
+    OrchScheduler m_scheduler;
     Select *m_select;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_lastHeartBeat;
 
+    std::shared_ptr<DBConnector> m_countersDb = nullptr;
+    std::unique_ptr<Table> m_ringStatsTable = nullptr;
+
     void flush();
 
     void heartBeat(std::chrono::time_point<std::chrono::high_resolution_clock> tcurrent, long interval);
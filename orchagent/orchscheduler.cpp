@@ -0,0 +1,289 @@
+#include <algorithm>
+
+#include "logger.h"
+#include "orchscheduler.h"
+
+using namespace std;
+
+OrchScheduler::OrchScheduler(size_t workers)
+{
+    SWSS_LOG_ENTER();
+
+    // The calling thread runs tasks too, so start one thread less
+    for (size_t i = 1; i < workers; i++)
+    {
+        m_workers.emplace_back(&OrchScheduler::workerLoop, this);
+    }
+
+    if (workers > 1)
+    {
+        SWSS_LOG_NOTICE("Orch scheduler started with %zu workers", workers);
+    }
+}
+
+OrchScheduler::~OrchScheduler()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_workCv.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void OrchScheduler::setOrchList(const vector<Orch *> &orchs)
+{
+    m_orchList = orchs;
+    m_stagesValid = false;
+}
+
+void OrchScheduler::addOrder(Orch *before, Orch *after)
+{
+    if (before == nullptr || after == nullptr || before == after)
+    {
+        return;
+    }
+
+    m_order[before].insert(after);
+    m_stagesValid = false;
+}
+
+bool OrchScheduler::conflicts(const Orch *a, const Orch *b)
+{
+    if (!a->hasDeclaredResources() || !b->hasDeclaredResources())
+    {
+        return true;
+    }
+
+    auto intersects = [](const set<string> &x, const set<string> &y)
+    {
+        for (const auto &r : x)
+        {
+            if (y.find(r) != y.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    return intersects(a->getWriteResources(), b->getWriteResources())
+        || intersects(a->getWriteResources(), b->getReadResources())
+        || intersects(b->getWriteResources(), a->getReadResources());
+}
+
+const vector<vector<Orch *>>& OrchScheduler::getStages()
+{
+    if (!m_stagesValid)
+    {
+        buildStages();
+    }
+    return m_stages;
+}
+
+/*
+ * Every conflicting pair keeps its m_orchList order, and every explicit
+ * order is added on top. The stage of an orch is the length of the longest
+ * chain of predecessors, so each stage only depends on earlier stages.
+ */
+void OrchScheduler::buildStages()
+{
+    SWSS_LOG_ENTER();
+
+    size_t n = m_orchList.size();
+    map<Orch *, size_t> index;
+    for (size_t i = 0; i < n; i++)
+    {
+        index[m_orchList[i]] = i;
+    }
+
+    vector<set<size_t>> successors(n);
+    vector<size_t> inDegree(n, 0);
+
+    auto addEdge = [&](size_t from, size_t to)
+    {
+        if (successors[from].insert(to).second)
+        {
+            inDegree[to]++;
+        }
+    };
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = i + 1; j < n; j++)
+        {
+            if (conflicts(m_orchList[i], m_orchList[j]))
+            {
+                addEdge(i, j);
+            }
+        }
+    }
+
+    for (const auto &it : m_order)
+    {
+        auto from = index.find(it.first);
+        if (from == index.end())
+        {
+            continue;
+        }
+        for (auto *after : it.second)
+        {
+            auto to = index.find(after);
+            if (to != index.end())
+            {
+                addEdge(from->second, to->second);
+            }
+        }
+    }
+
+    vector<size_t> level(n, 0);
+    deque<size_t> ready;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (inDegree[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    size_t visited = 0;
+    size_t maxLevel = 0;
+    while (!ready.empty())
+    {
+        size_t i = ready.front();
+        ready.pop_front();
+        visited++;
+        maxLevel = max(maxLevel, level[i]);
+
+        for (auto j : successors[i])
+        {
+            level[j] = max(level[j], level[i] + 1);
+            if (--inDegree[j] == 0)
+            {
+                ready.push_back(j);
+            }
+        }
+    }
+
+    m_stages.clear();
+    if (visited != n)
+    {
+        SWSS_LOG_ERROR("Orch ordering constraints contain a cycle, running all orchs serially");
+        for (auto *orch : m_orchList)
+        {
+            m_stages.push_back({orch});
+        }
+    }
+    else if (n > 0)
+    {
+        m_stages.resize(maxLevel + 1);
+        for (size_t i = 0; i < n; i++)
+        {
+            m_stages[level[i]].push_back(m_orchList[i]);
+        }
+    }
+
+    m_stagesValid = true;
+    SWSS_LOG_NOTICE("Orch scheduler planned %zu orchs into %zu stages", n, m_stages.size());
+}
+
+void OrchScheduler::run()
+{
+    if (m_workers.empty())
+    {
+        for (Orch *o : m_orchList)
+        {
+            o->doTask();
+        }
+        return;
+    }
+
+    for (const auto &stage : getStages())
+    {
+        runStage(stage);
+    }
+}
+
+void OrchScheduler::runStage(const vector<Orch *> &stage)
+{
+    if (stage.size() == 1)
+    {
+        stage.front()->doTask();
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_queue.insert(m_queue.end(), stage.begin() + 1, stage.end());
+        m_pending = stage.size() - 1;
+        m_error = nullptr;
+    }
+    m_workCv.notify_all();
+
+    runOrch(stage.front());
+
+    // Help the workers with whatever is still queued
+    unique_lock<mutex> lock(m_mutex);
+    while (!m_queue.empty())
+    {
+        Orch *orch = m_queue.front();
+        m_queue.pop_front();
+        lock.unlock();
+
+        runOrch(orch);
+
+        lock.lock();
+        m_pending--;
+    }
+    m_doneCv.wait(lock, [&](){ return m_pending == 0; });
+
+    if (m_error)
+    {
+        rethrow_exception(m_error);
+    }
+}
+
+void OrchScheduler::runOrch(Orch *orch)
+{
+    try
+    {
+        orch->doTask();
+    }
+    catch (...)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!m_error)
+        {
+            m_error = current_exception();
+        }
+    }
+}
+
+void OrchScheduler::workerLoop()
+{
+    unique_lock<mutex> lock(m_mutex);
+    while (true)
+    {
+        m_workCv.wait(lock, [&](){ return m_exit || !m_queue.empty(); });
+        if (m_exit)
+        {
+            return;
+        }
+
+        Orch *orch = m_queue.front();
+        m_queue.pop_front();
+        lock.unlock();
+
+        runOrch(orch);
+
+        lock.lock();
+        if (--m_pending == 0)
+        {
+            m_doneCv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "orch.h"
+
+/*
+ * OrchScheduler runs the periodic Orch::doTask() pass of OrchDaemon.
+ *
+ * The orch list is split into stages. Orchs in the same stage don't conflict
+ * with each other (see Orch::declareResources) and have no ordering
+ * constraint between them, so they are run concurrently on a worker pool.
+ * Stages are run one after another in m_orchList order. An orch which has
+ * not declared its resources conflicts with every other orch, so it always
+ * gets a stage of its own, which keeps today's serial behavior by default.
+ *
+ * With fewer than two workers, run() is exactly the serial loop over the
+ * orch list.
+ */
+class OrchScheduler
+{
+public:
+    OrchScheduler(size_t workers = 0);
+    ~OrchScheduler();
+
+    OrchScheduler(const OrchScheduler&) = delete;
+    OrchScheduler& operator=(const OrchScheduler&) = delete;
+
+    void setOrchList(const std::vector<Orch *> &orchs);
+
+    // Require 'before' to be done before 'after' in every pass
+    void addOrder(Orch *before, Orch *after);
+
+    // Run doTask() of all orchs
+    void run();
+
+    size_t getWorkerCount() const { return m_workers.size(); }
+    const std::vector<std::vector<Orch *>>& getStages();
+
+    static bool conflicts(const Orch *a, const Orch *b);
+
+private:
+    std::vector<Orch *> m_orchList;
+    std::map<Orch *, std::set<Orch *>> m_order;
+    std::vector<std::vector<Orch *>> m_stages;
+    bool m_stagesValid = false;
+
+    std::vector<std::thread> m_workers;
+    std::deque<Orch *> m_queue;
+    size_t m_pending = 0;
+    bool m_exit = false;
+    std::exception_ptr m_error;
+    std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_doneCv;
+
+    void buildStages();
+    void runStage(const std::vector<Orch *> &stage);
+    void runOrch(Orch *orch);
+    void workerLoop();
+};
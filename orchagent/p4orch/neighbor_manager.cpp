@@ -3,9 +3,11 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "crmorch.h"
 #include "dbconnector.h"
 #include "logger.h"
@@ -26,6 +28,7 @@ extern sai_object_id_t gSwitchId;
 extern sai_neighbor_api_t *sai_neighbor_api;
 
 extern CrmOrch *gCrmOrch;
+extern size_t gMaxBulkSize;
 
 namespace
 {
@@ -168,7 +171,7 @@ P4NeighborEntry *NeighborManager::getNeighborEntry(const std::string &neighbor_k
     return &m_neighborTable[neighbor_key];
 }
 
-ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
+ReturnCode NeighborManager::validateNeighborCreation(const P4NeighborEntry &neighbor_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -185,34 +188,80 @@ ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
                                                                             << " already exists in centralized map");
     }
 
-    ASSIGN_OR_RETURN(neighbor_entry.neigh_entry, getSaiEntry(neighbor_entry));
-    auto attrs = getSaiAttrs(neighbor_entry);
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> NeighborManager::createNeighbors(std::vector<P4NeighborEntry> &neighbor_entries)
+{
+    SWSS_LOG_ENTER();
 
-    CHECK_ERROR_AND_LOG_AND_RETURN(sai_neighbor_api->create_neighbor_entry(
-                                       &neighbor_entry.neigh_entry, static_cast<uint32_t>(attrs.size()), attrs.data()),
-                                   "Failed to create neighbor with key " << QuotedVar(neighbor_key));
+    std::vector<ReturnCode> statuses(neighbor_entries.size());
+    std::vector<sai_status_t> object_statuses(neighbor_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<bool> queued(neighbor_entries.size(), false);
+    EntityBulker<sai_neighbor_api_t> neighbor_bulker(sai_neighbor_api, gMaxBulkSize);
 
-    m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry.router_intf_key);
-    if (neighbor_entry.neighbor_id.isV4())
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        auto &neighbor_entry = neighbor_entries[i];
+        statuses[i] = validateNeighborCreation(neighbor_entry);
+        if (!statuses[i].ok())
+        {
+            continue;
+        }
+
+        auto sai_entry_or = getSaiEntry(neighbor_entry);
+        if (!sai_entry_or.ok())
+        {
+            statuses[i] = sai_entry_or.status();
+            continue;
+        }
+        neighbor_entry.neigh_entry = *sai_entry_or;
+        auto attrs = getSaiAttrs(neighbor_entry);
+        neighbor_bulker.create_entry(&object_statuses[i], &neighbor_entry.neigh_entry,
+                                     static_cast<uint32_t>(attrs.size()), attrs.data());
+        queued[i] = true;
     }
-    else
+
+    neighbor_bulker.flush();
+
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        if (!queued[i])
+        {
+            continue;
+        }
+        const auto &neighbor_entry = neighbor_entries[i];
+        const std::string &neighbor_key = neighbor_entry.neighbor_key;
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to create neighbor with key " << QuotedVar(neighbor_key));
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to create neighbor with key " << QuotedVar(neighbor_key);
+            continue;
+        }
+
+        m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry.router_intf_key);
+        if (neighbor_entry.neighbor_id.isV4())
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        m_neighborTable[neighbor_key] = neighbor_entry;
+        m_p4OidMapper->setDummyOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
     }
 
-    m_neighborTable[neighbor_key] = neighbor_entry;
-    m_p4OidMapper->setDummyOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
-    return ReturnCode();
+    return statuses;
 }
 
-ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
+ReturnCode NeighborManager::validateNeighborRemoval(const std::string &neighbor_key)
 {
     SWSS_LOG_ENTER();
 
-    auto *neighbor_entry = getNeighborEntry(neighbor_key);
-    if (neighbor_entry == nullptr)
+    if (getNeighborEntry(neighbor_key) == nullptr)
     {
         LOG_ERROR_AND_RETURN(ReturnCode(StatusCode::SWSS_RC_NOT_FOUND)
                              << "Neighbor with key " << QuotedVar(neighbor_key) << " does not exist");
@@ -231,22 +280,64 @@ ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
                              << " referenced by other objects (ref_count = " << ref_count << ")");
     }
 
-    CHECK_ERROR_AND_LOG_AND_RETURN(sai_neighbor_api->remove_neighbor_entry(&neighbor_entry->neigh_entry),
-                                   "Failed to remove neighbor with key " << QuotedVar(neighbor_key));
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> NeighborManager::removeNeighbors(const std::vector<std::string> &neighbor_keys)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(neighbor_keys.size());
+    std::vector<sai_status_t> object_statuses(neighbor_keys.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<bool> queued(neighbor_keys.size(), false);
+    EntityBulker<sai_neighbor_api_t> neighbor_bulker(sai_neighbor_api, gMaxBulkSize);
 
-    m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry->router_intf_key);
-    if (neighbor_entry->neighbor_id.isV4())
+    for (size_t i = 0; i < neighbor_keys.size(); ++i)
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        statuses[i] = validateNeighborRemoval(neighbor_keys[i]);
+        if (!statuses[i].ok())
+        {
+            continue;
+        }
+
+        auto *neighbor_entry = getNeighborEntry(neighbor_keys[i]);
+        neighbor_bulker.remove_entry(&object_statuses[i], &neighbor_entry->neigh_entry);
+        queued[i] = true;
     }
-    else
+
+    neighbor_bulker.flush();
+
+    for (size_t i = 0; i < neighbor_keys.size(); ++i)
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        if (!queued[i])
+        {
+            continue;
+        }
+        const std::string &neighbor_key = neighbor_keys[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to remove neighbor with key " << QuotedVar(neighbor_key));
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to remove neighbor with key " << QuotedVar(neighbor_key);
+            continue;
+        }
+
+        auto *neighbor_entry = getNeighborEntry(neighbor_key);
+        m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry->router_intf_key);
+        if (neighbor_entry->neighbor_id.isV4())
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
+        m_neighborTable.erase(neighbor_key);
     }
 
-    m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
-    m_neighborTable.erase(neighbor_key);
-    return ReturnCode();
+    return statuses;
 }
 
 ReturnCode NeighborManager::setDstMacAddress(P4NeighborEntry *neighbor_entry, const swss::MacAddress &mac_address)
@@ -268,28 +359,45 @@ ReturnCode NeighborManager::setDstMacAddress(P4NeighborEntry *neighbor_entry, co
     return ReturnCode();
 }
 
-ReturnCode NeighborManager::processAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key)
+std::vector<ReturnCode> NeighborManager::processAddRequests(const std::vector<P4NeighborAppDbEntry> &app_db_entries)
 {
     SWSS_LOG_ENTER();
 
-    // Perform operation specific validations.
-    if (!app_db_entry.is_set_dst_mac)
+    std::vector<ReturnCode> statuses(app_db_entries.size());
+    std::vector<P4NeighborEntry> neighbor_entries;
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < app_db_entries.size(); ++i)
     {
-        LOG_ERROR_AND_RETURN(ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM)
-                             << p4orch::kDstMac
-                             << " is mandatory to create neighbor entry. Failed to create "
-                                "neighbor with key "
-                             << QuotedVar(neighbor_key));
+        const auto &app_db_entry = app_db_entries[i];
+        // Perform operation specific validations.
+        if (!app_db_entry.is_set_dst_mac)
+        {
+            statuses[i] = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM)
+                          << p4orch::kDstMac
+                          << " is mandatory to create neighbor entry. Failed to create "
+                             "neighbor with key "
+                          << QuotedVar(KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id,
+                                                                         app_db_entry.neighbor_id));
+            SWSS_LOG_ERROR("%s", statuses[i].message().c_str());
+            continue;
+        }
+        neighbor_entries.emplace_back(app_db_entry.router_intf_id, app_db_entry.neighbor_id,
+                                      app_db_entry.dst_mac_address);
+        indices.push_back(i);
     }
 
-    P4NeighborEntry neighbor_entry(app_db_entry.router_intf_id, app_db_entry.neighbor_id, app_db_entry.dst_mac_address);
-    auto status = createNeighbor(neighbor_entry);
-    if (!status.ok())
+    auto create_statuses = createNeighbors(neighbor_entries);
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
     {
-        SWSS_LOG_ERROR("Failed to create neighbor with key %s", QuotedVar(neighbor_key).c_str());
+        if (!create_statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to create neighbor with key %s",
+                           QuotedVar(neighbor_entries[i].neighbor_key).c_str());
+        }
+        statuses[indices[i]] = create_statuses[i];
     }
 
-    return status;
+    return statuses;
 }
 
 ReturnCode NeighborManager::processUpdateRequest(const P4NeighborAppDbEntry &app_db_entry,
@@ -311,17 +419,20 @@ ReturnCode NeighborManager::processUpdateRequest(const P4NeighborAppDbEntry &app
     return ReturnCode();
 }
 
-ReturnCode NeighborManager::processDeleteRequest(const std::string &neighbor_key)
+std::vector<ReturnCode> NeighborManager::processDeleteRequests(const std::vector<std::string> &neighbor_keys)
 {
     SWSS_LOG_ENTER();
 
-    auto status = removeNeighbor(neighbor_key);
-    if (!status.ok())
+    auto statuses = removeNeighbors(neighbor_keys);
+    for (size_t i = 0; i < neighbor_keys.size(); ++i)
     {
-        SWSS_LOG_ERROR("Failed to remove neighbor with key %s", QuotedVar(neighbor_key).c_str());
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to remove neighbor with key %s", QuotedVar(neighbor_keys[i]).c_str());
+        }
     }
 
-    return status;
+    return statuses;
 }
 
 ReturnCode NeighborManager::getSaiObject(const std::string &json_key, sai_object_type_t &object_type,
@@ -372,40 +483,73 @@ void NeighborManager::drain()
 {
     SWSS_LOG_ENTER();
 
-    for (const auto &key_op_fvs_tuple : m_entries)
+    // Adds and deletes are queued and programmed with bulk SAI calls. An entry
+    // for a neighbor which is already queued flushes the queue first, so that
+    // the entries still take effect in order.
+    std::vector<ReturnCode> statuses(m_entries.size());
+    std::vector<P4NeighborAppDbEntry> add_entries;
+    std::vector<size_t> add_indices;
+    std::vector<std::string> delete_keys;
+    std::vector<size_t> delete_indices;
+    std::unordered_set<std::string> queued_keys;
+
+    auto flush = [&]() {
+        if (!add_entries.empty())
+        {
+            auto add_statuses = processAddRequests(add_entries);
+            for (size_t i = 0; i < add_entries.size(); ++i)
+            {
+                statuses[add_indices[i]] = add_statuses[i];
+            }
+        }
+        if (!delete_keys.empty())
+        {
+            auto delete_statuses = processDeleteRequests(delete_keys);
+            for (size_t i = 0; i < delete_keys.size(); ++i)
+            {
+                statuses[delete_indices[i]] = delete_statuses[i];
+            }
+        }
+        add_entries.clear();
+        add_indices.clear();
+        delete_keys.clear();
+        delete_indices.clear();
+        queued_keys.clear();
+    };
+
+    for (size_t idx = 0; idx < m_entries.size(); ++idx)
     {
+        const auto &key_op_fvs_tuple = m_entries[idx];
         std::string table_name;
         std::string db_key;
         parseP4RTKey(kfvKey(key_op_fvs_tuple), &table_name, &db_key);
         const std::vector<swss::FieldValueTuple> &attributes = kfvFieldsValues(key_op_fvs_tuple);
 
-        ReturnCode status;
         auto app_db_entry_or = deserializeNeighborEntry(db_key, attributes);
         if (!app_db_entry_or.ok())
         {
-            status = app_db_entry_or.status();
+            statuses[idx] = app_db_entry_or.status();
             SWSS_LOG_ERROR("Unable to deserialize APP DB entry with key %s: %s",
-                           QuotedVar(table_name + ":" + db_key).c_str(), status.message().c_str());
-            m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple),
-                                 status,
-                                 /*replace=*/true);
+                           QuotedVar(table_name + ":" + db_key).c_str(), statuses[idx].message().c_str());
             continue;
         }
         auto &app_db_entry = *app_db_entry_or;
 
-        status = validateNeighborAppDbEntry(app_db_entry);
+        auto status = validateNeighborAppDbEntry(app_db_entry);
         if (!status.ok())
         {
             SWSS_LOG_ERROR("Validation failed for Neighbor APP DB entry with key %s: %s",
                            QuotedVar(table_name + ":" + db_key).c_str(), status.message().c_str());
-            m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple),
-                                 status,
-                                 /*replace=*/true);
+            statuses[idx] = status;
             continue;
         }
 
         const std::string neighbor_key =
             KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id, app_db_entry.neighbor_id);
+        if (queued_keys.count(neighbor_key) != 0)
+        {
+            flush();
+        }
 
         const std::string &operation = kfvOp(key_op_fvs_tuple);
         if (operation == SET_COMMAND)
@@ -414,25 +558,36 @@ void NeighborManager::drain()
             if (neighbor_entry == nullptr)
             {
                 // Create neighbor
-                status = processAddRequest(app_db_entry, neighbor_key);
+                add_entries.push_back(app_db_entry);
+                add_indices.push_back(idx);
+                queued_keys.insert(neighbor_key);
             }
             else
             {
                 // Modify existing neighbor
-                status = processUpdateRequest(app_db_entry, neighbor_entry);
+                statuses[idx] = processUpdateRequest(app_db_entry, neighbor_entry);
             }
         }
         else if (operation == DEL_COMMAND)
         {
             // Delete neighbor
-            status = processDeleteRequest(neighbor_key);
+            delete_keys.push_back(neighbor_key);
+            delete_indices.push_back(idx);
+            queued_keys.insert(neighbor_key);
         }
         else
         {
-            status = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM) << "Unknown operation type " << QuotedVar(operation);
-            SWSS_LOG_ERROR("%s", status.message().c_str());
+            statuses[idx] = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM)
+                            << "Unknown operation type " << QuotedVar(operation);
+            SWSS_LOG_ERROR("%s", statuses[idx].message().c_str());
         }
-        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
+    }
+    flush();
+
+    for (size_t idx = 0; idx < m_entries.size(); ++idx)
+    {
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(m_entries[idx]), kfvFieldsValues(m_entries[idx]),
+                             statuses[idx],
                              /*replace=*/true);
     }
     m_entries.clear();
@@ -60,12 +60,16 @@ class NeighborManager : public ObjectManagerInterface
                                                                 const std::vector<swss::FieldValueTuple> &attributes);
     ReturnCode validateNeighborAppDbEntry(const P4NeighborAppDbEntry &app_db_entry);
     P4NeighborEntry *getNeighborEntry(const std::string &neighbor_key);
-    ReturnCode createNeighbor(P4NeighborEntry &neighbor_entry);
-    ReturnCode removeNeighbor(const std::string &neighbor_key);
+    // Creates and removes a list of neighbors with one bulk SAI call. The
+    // neighbor keys must be unique in the list.
+    std::vector<ReturnCode> createNeighbors(std::vector<P4NeighborEntry> &neighbor_entries);
+    std::vector<ReturnCode> removeNeighbors(const std::vector<std::string> &neighbor_keys);
+    ReturnCode validateNeighborCreation(const P4NeighborEntry &neighbor_entry);
+    ReturnCode validateNeighborRemoval(const std::string &neighbor_key);
     ReturnCode setDstMacAddress(P4NeighborEntry *neighbor_entry, const swss::MacAddress &mac_address);
-    ReturnCode processAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key);
+    std::vector<ReturnCode> processAddRequests(const std::vector<P4NeighborAppDbEntry> &app_db_entries);
     ReturnCode processUpdateRequest(const P4NeighborAppDbEntry &app_db_entry, P4NeighborEntry *neighbor_entry);
-    ReturnCode processDeleteRequest(const std::string &neighbor_key);
+    std::vector<ReturnCode> processDeleteRequests(const std::vector<std::string> &neighbor_keys);
     std::string verifyStateCache(const P4NeighborAppDbEntry &app_db_entry, const P4NeighborEntry *neighbor_entry);
     std::string verifyStateAsicDb(const P4NeighborEntry *neighbor_entry);
     ReturnCodeOr<sai_neighbor_entry_t> getSaiEntry(const P4NeighborEntry &neighbor_entry);
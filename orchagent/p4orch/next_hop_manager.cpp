@@ -3,9 +3,11 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "crmorch.h"
 #include "dbconnector.h"
 #include "ipaddress.h"
@@ -25,6 +27,7 @@ using ::p4orch::kTableKeyDelimiter;
 extern sai_object_id_t gSwitchId;
 extern sai_next_hop_api_t *sai_next_hop_api;
 extern CrmOrch *gCrmOrch;
+extern size_t gMaxBulkSize;
 extern P4Orch *gP4Orch;
 
 P4NextHopEntry::P4NextHopEntry(const std::string &next_hop_id, const std::string &router_interface_id,
@@ -184,66 +187,110 @@ void NextHopManager::drain()
 {
     SWSS_LOG_ENTER();
 
-    for (const auto &key_op_fvs_tuple : m_entries)
+    // Adds and deletes are queued and programmed with bulk SAI calls. An entry
+    // for a next hop which is already queued flushes the queue first, so that
+    // the entries still take effect in order.
+    std::vector<ReturnCode> statuses(m_entries.size());
+    std::vector<P4NextHopAppDbEntry> add_entries;
+    std::vector<size_t> add_indices;
+    std::vector<std::string> delete_keys;
+    std::vector<size_t> delete_indices;
+    std::unordered_set<std::string> queued_keys;
+
+    auto flush = [&]() {
+        if (!add_entries.empty())
+        {
+            auto add_statuses = processAddRequests(add_entries);
+            for (size_t i = 0; i < add_entries.size(); ++i)
+            {
+                statuses[add_indices[i]] = add_statuses[i];
+            }
+        }
+        if (!delete_keys.empty())
+        {
+            auto delete_statuses = processDeleteRequests(delete_keys);
+            for (size_t i = 0; i < delete_keys.size(); ++i)
+            {
+                statuses[delete_indices[i]] = delete_statuses[i];
+            }
+        }
+        add_entries.clear();
+        add_indices.clear();
+        delete_keys.clear();
+        delete_indices.clear();
+        queued_keys.clear();
+    };
+
+    for (size_t idx = 0; idx < m_entries.size(); ++idx)
     {
+        const auto &key_op_fvs_tuple = m_entries[idx];
         std::string table_name;
         std::string key;
         parseP4RTKey(kfvKey(key_op_fvs_tuple), &table_name, &key);
         const std::vector<swss::FieldValueTuple> &attributes = kfvFieldsValues(key_op_fvs_tuple);
 
-        ReturnCode status;
         auto app_db_entry_or = deserializeP4NextHopAppDbEntry(key, attributes);
         if (!app_db_entry_or.ok())
         {
-            status = app_db_entry_or.status();
+            statuses[idx] = app_db_entry_or.status();
             SWSS_LOG_ERROR("Unable to deserialize APP DB entry with key %s: %s",
-                           QuotedVar(table_name + ":" + key).c_str(), status.message().c_str());
-            m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple),
-                                 status,
-                                 /*replace=*/true);
+                           QuotedVar(table_name + ":" + key).c_str(), statuses[idx].message().c_str());
             continue;
         }
         auto &app_db_entry = *app_db_entry_or;
 
         const std::string next_hop_key = KeyGenerator::generateNextHopKey(app_db_entry.next_hop_id);
+        if (queued_keys.count(next_hop_key) != 0)
+        {
+            flush();
+        }
 
         // Fulfill the operation.
         const std::string &operation = kfvOp(key_op_fvs_tuple);
         if (operation == SET_COMMAND)
         {
-            status = validateAppDbEntry(app_db_entry);
+            auto status = validateAppDbEntry(app_db_entry);
             if (!status.ok())
             {
                 SWSS_LOG_ERROR("Validation failed for Nexthop APP DB entry with key %s: %s",
                                QuotedVar(kfvKey(key_op_fvs_tuple)).c_str(), status.message().c_str());
-                m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple),
-                                     status,
-                                     /*replace=*/true);
+                statuses[idx] = status;
                 continue;
             }
             auto *next_hop_entry = getNextHopEntry(next_hop_key);
             if (next_hop_entry == nullptr)
             {
                 // Create new next hop.
-                status = processAddRequest(app_db_entry);
+                add_entries.push_back(app_db_entry);
+                add_indices.push_back(idx);
+                queued_keys.insert(next_hop_key);
             }
             else
             {
                 // Modify existing next hop.
-                status = processUpdateRequest(app_db_entry, next_hop_entry);
+                statuses[idx] = processUpdateRequest(app_db_entry, next_hop_entry);
             }
         }
         else if (operation == DEL_COMMAND)
         {
             // Delete next hop.
-            status = processDeleteRequest(next_hop_key);
+            delete_keys.push_back(next_hop_key);
+            delete_indices.push_back(idx);
+            queued_keys.insert(next_hop_key);
         }
         else
         {
-            status = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM) << "Unknown operation type " << QuotedVar(operation);
-            SWSS_LOG_ERROR("%s", status.message().c_str());
+            statuses[idx] = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM)
+                            << "Unknown operation type " << QuotedVar(operation);
+            SWSS_LOG_ERROR("%s", statuses[idx].message().c_str());
         }
-        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
+    }
+    flush();
+
+    for (size_t idx = 0; idx < m_entries.size(); ++idx)
+    {
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(m_entries[idx]), kfvFieldsValues(m_entries[idx]),
+                             statuses[idx],
                              /*replace=*/true);
     }
     m_entries.clear();
@@ -321,21 +368,29 @@ ReturnCodeOr<P4NextHopAppDbEntry> NextHopManager::deserializeP4NextHopAppDbEntry
     return app_db_entry;
 }
 
-ReturnCode NextHopManager::processAddRequest(const P4NextHopAppDbEntry &app_db_entry)
+std::vector<ReturnCode> NextHopManager::processAddRequests(const std::vector<P4NextHopAppDbEntry> &app_db_entries)
 {
     SWSS_LOG_ENTER();
 
-    P4NextHopEntry next_hop_entry(app_db_entry.next_hop_id, app_db_entry.router_interface_id,
-                                  app_db_entry.gre_tunnel_id, app_db_entry.neighbor_id);
-    auto status = createNextHop(next_hop_entry);
-    if (!status.ok())
+    std::vector<P4NextHopEntry> next_hop_entries;
+    for (const auto &app_db_entry : app_db_entries)
     {
-        SWSS_LOG_ERROR("Failed to create next hop with key %s", QuotedVar(next_hop_entry.next_hop_key).c_str());
+        next_hop_entries.emplace_back(app_db_entry.next_hop_id, app_db_entry.router_interface_id,
+                                      app_db_entry.gre_tunnel_id, app_db_entry.neighbor_id);
     }
-    return status;
+    auto statuses = createNextHops(next_hop_entries);
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
+    {
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to create next hop with key %s",
+                           QuotedVar(next_hop_entries[i].next_hop_key).c_str());
+        }
+    }
+    return statuses;
 }
 
-ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
+ReturnCode NextHopManager::validateNextHopCreation(P4NextHopEntry &next_hop_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -381,43 +436,96 @@ ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
                              << " does not exist in centralized mapper");
     }
 
-    ASSIGN_OR_RETURN(std::vector<sai_attribute_t> attrs, getSaiAttrs(next_hop_entry));
+    return ReturnCode();
+}
 
-    // Call SAI API.
-    CHECK_ERROR_AND_LOG_AND_RETURN(sai_next_hop_api->create_next_hop(&next_hop_entry.next_hop_oid, gSwitchId,
-                                                                     (uint32_t)attrs.size(), attrs.data()),
-                                   "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key));
+std::vector<ReturnCode> NextHopManager::createNextHops(std::vector<P4NextHopEntry> &next_hop_entries)
+{
+    SWSS_LOG_ENTER();
 
-    if (!next_hop_entry.gre_tunnel_id.empty())
-    {
-        // On successful creation, increment ref count for tunnel object
-        m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_TUNNEL,
-                                        KeyGenerator::generateTunnelKey(next_hop_entry.gre_tunnel_id));
-    }
-    else
-    {
-        // On successful creation, increment ref count for router intf object
-        m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
-                                        KeyGenerator::generateRouterInterfaceKey(next_hop_entry.router_interface_id));
-    }
+    std::vector<ReturnCode> statuses(next_hop_entries.size());
+    std::vector<std::vector<sai_attribute_t>> sai_attrs(next_hop_entries.size());
+    std::vector<sai_object_id_t> next_hop_oids(next_hop_entries.size(), SAI_NULL_OBJECT_ID);
+    std::vector<sai_status_t> object_statuses(next_hop_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<bool> queued(next_hop_entries.size(), false);
+    ObjectBulker<sai_next_hop_api_t> next_hop_bulker(sai_next_hop_api, gSwitchId, gMaxBulkSize);
+    // Next hops in a batch are independent of each other.
+    next_hop_bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
 
-    m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
-    if (next_hop_entry.neighbor_id.isV4())
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        auto &next_hop_entry = next_hop_entries[i];
+        statuses[i] = validateNextHopCreation(next_hop_entry);
+        if (!statuses[i].ok())
+        {
+            continue;
+        }
+
+        auto attrs_or = getSaiAttrs(next_hop_entry);
+        if (!attrs_or.ok())
+        {
+            statuses[i] = attrs_or.status();
+            continue;
+        }
+        sai_attrs[i] = *attrs_or;
+        next_hop_bulker.create_entry(&next_hop_oids[i], &object_statuses[i], (uint32_t)sai_attrs[i].size(),
+                                     sai_attrs[i].data());
+        queued[i] = true;
     }
-    else
+
+    // Call SAI API.
+    next_hop_bulker.flush();
+
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
-    }
+        if (!queued[i])
+        {
+            continue;
+        }
+        auto &next_hop_entry = next_hop_entries[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key));
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key);
+            continue;
+        }
+        next_hop_entry.next_hop_oid = next_hop_oids[i];
 
-    // Add created entry to internal table.
-    m_nextHopTable.emplace(next_hop_entry.next_hop_key, next_hop_entry);
+        if (!next_hop_entry.gre_tunnel_id.empty())
+        {
+            // On successful creation, increment ref count for tunnel object
+            m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_TUNNEL,
+                                            KeyGenerator::generateTunnelKey(next_hop_entry.gre_tunnel_id));
+        }
+        else
+        {
+            // On successful creation, increment ref count for router intf object
+            m_p4OidMapper->increaseRefCount(
+                SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                KeyGenerator::generateRouterInterfaceKey(next_hop_entry.router_interface_id));
+        }
 
-    // Add the key to OID map to centralized mapper.
-    m_p4OidMapper->setOID(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_entry.next_hop_key, next_hop_entry.next_hop_oid);
+        m_p4OidMapper->increaseRefCount(
+            SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+            KeyGenerator::generateNeighborKey(next_hop_entry.router_interface_id, next_hop_entry.neighbor_id));
+        if (next_hop_entry.neighbor_id.isV4())
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+        }
 
-    return ReturnCode();
+        // Add created entry to internal table.
+        m_nextHopTable.emplace(next_hop_entry.next_hop_key, next_hop_entry);
+
+        // Add the key to OID map to centralized mapper.
+        m_p4OidMapper->setOID(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_entry.next_hop_key, next_hop_entry.next_hop_oid);
+    }
+
+    return statuses;
 }
 
 ReturnCode NextHopManager::processUpdateRequest(const P4NextHopAppDbEntry &app_db_entry, P4NextHopEntry *next_hop_entry)
@@ -431,20 +539,23 @@ ReturnCode NextHopManager::processUpdateRequest(const P4NextHopAppDbEntry &app_d
     return status;
 }
 
-ReturnCode NextHopManager::processDeleteRequest(const std::string &next_hop_key)
+std::vector<ReturnCode> NextHopManager::processDeleteRequests(const std::vector<std::string> &next_hop_keys)
 {
     SWSS_LOG_ENTER();
 
-    auto status = removeNextHop(next_hop_key);
-    if (!status.ok())
+    auto statuses = removeNextHops(next_hop_keys);
+    for (size_t i = 0; i < next_hop_keys.size(); ++i)
     {
-        SWSS_LOG_ERROR("Failed to remove next hop with key %s", QuotedVar(next_hop_key).c_str());
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop with key %s", QuotedVar(next_hop_keys[i]).c_str());
+        }
     }
 
-    return status;
+    return statuses;
 }
 
-ReturnCode NextHopManager::removeNextHop(const std::string &next_hop_key)
+ReturnCode NextHopManager::validateNextHopRemoval(const std::string &next_hop_key)
 {
     SWSS_LOG_ENTER();
 
@@ -472,55 +583,100 @@ ReturnCode NextHopManager::removeNextHop(const std::string &next_hop_key)
                              << " referenced by other objects (ref_count = " << ref_count);
     }
 
-    // Call SAI API.
-    CHECK_ERROR_AND_LOG_AND_RETURN(sai_next_hop_api->remove_next_hop(next_hop_entry->next_hop_oid),
-                                   "Failed to remove next hop " << QuotedVar(next_hop_entry->next_hop_key));
+    return ReturnCode();
+}
 
-    if (!next_hop_entry->gre_tunnel_id.empty())
-    {
-        // On successful deletion, decrement ref count for tunnel object
-        m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_TUNNEL,
-                                        KeyGenerator::generateTunnelKey(next_hop_entry->gre_tunnel_id));
-    }
-    else
-    {
-        // On successful deletion, decrement ref count for router intf object
-        m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
-                                        KeyGenerator::generateRouterInterfaceKey(next_hop_entry->router_interface_id));
-    }
+std::vector<ReturnCode> NextHopManager::removeNextHops(const std::vector<std::string> &next_hop_keys)
+{
+    SWSS_LOG_ENTER();
 
-    std::string router_interface_id = next_hop_entry->router_interface_id;
-    if (!next_hop_entry->gre_tunnel_id.empty())
+    std::vector<ReturnCode> statuses(next_hop_keys.size());
+    std::vector<sai_status_t> object_statuses(next_hop_keys.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<bool> queued(next_hop_keys.size(), false);
+    ObjectBulker<sai_next_hop_api_t> next_hop_bulker(sai_next_hop_api, gSwitchId, gMaxBulkSize);
+    // Next hops in a batch are independent of each other.
+    next_hop_bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+
+    for (size_t i = 0; i < next_hop_keys.size(); ++i)
     {
-        auto gre_tunnel_or = gP4Orch->getGreTunnelManager()->getConstGreTunnelEntry(
-            KeyGenerator::generateTunnelKey(next_hop_entry->gre_tunnel_id));
-        if (!gre_tunnel_or.ok())
+        statuses[i] = validateNextHopRemoval(next_hop_keys[i]);
+        if (!statuses[i].ok())
         {
-            LOG_ERROR_AND_RETURN(ReturnCode(StatusCode::SWSS_RC_NOT_FOUND)
-                                 << "GRE Tunnel " << QuotedVar(next_hop_entry->gre_tunnel_id)
-                                 << " does not exist in GRE Tunnel Manager");
+            continue;
         }
-        router_interface_id = (*gre_tunnel_or).router_interface_id;
-    }
-    m_p4OidMapper->decreaseRefCount(
-        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
-        KeyGenerator::generateNeighborKey(router_interface_id, next_hop_entry->neighbor_id));
-    if (next_hop_entry->neighbor_id.isV4())
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+
+        auto *next_hop_entry = getNextHopEntry(next_hop_keys[i]);
+        next_hop_bulker.remove_entry(&object_statuses[i], next_hop_entry->next_hop_oid);
+        queued[i] = true;
     }
-    else
+
+    // Call SAI API.
+    next_hop_bulker.flush();
+
+    for (size_t i = 0; i < next_hop_keys.size(); ++i)
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
-    }
+        if (!queued[i])
+        {
+            continue;
+        }
+        const auto &next_hop_key = next_hop_keys[i];
+        auto *next_hop_entry = getNextHopEntry(next_hop_key);
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to remove next hop " << QuotedVar(next_hop_key));
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            statuses[i] = ReturnCode(object_statuses[i]) << "Failed to remove next hop " << QuotedVar(next_hop_key);
+            continue;
+        }
 
-    // Remove the key to OID map to centralized mapper.
-    m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_key);
+        if (!next_hop_entry->gre_tunnel_id.empty())
+        {
+            // On successful deletion, decrement ref count for tunnel object
+            m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_TUNNEL,
+                                            KeyGenerator::generateTunnelKey(next_hop_entry->gre_tunnel_id));
+        }
+        else
+        {
+            // On successful deletion, decrement ref count for router intf object
+            m_p4OidMapper->decreaseRefCount(
+                SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                KeyGenerator::generateRouterInterfaceKey(next_hop_entry->router_interface_id));
+        }
 
-    // Remove the entry from internal table.
-    m_nextHopTable.erase(next_hop_key);
+        std::string router_interface_id = next_hop_entry->router_interface_id;
+        if (!next_hop_entry->gre_tunnel_id.empty())
+        {
+            auto gre_tunnel_or = gP4Orch->getGreTunnelManager()->getConstGreTunnelEntry(
+                KeyGenerator::generateTunnelKey(next_hop_entry->gre_tunnel_id));
+            if (!gre_tunnel_or.ok())
+            {
+                statuses[i] = ReturnCode(StatusCode::SWSS_RC_NOT_FOUND)
+                              << "GRE Tunnel " << QuotedVar(next_hop_entry->gre_tunnel_id)
+                              << " does not exist in GRE Tunnel Manager";
+                SWSS_LOG_ERROR("%s", statuses[i].message().c_str());
+                continue;
+            }
+            router_interface_id = (*gre_tunnel_or).router_interface_id;
+        }
+        m_p4OidMapper->decreaseRefCount(
+            SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+            KeyGenerator::generateNeighborKey(router_interface_id, next_hop_entry->neighbor_id));
+        if (next_hop_entry->neighbor_id.isV4())
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+        }
 
-    return ReturnCode();
+        // Remove the key to OID map to centralized mapper.
+        m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_key);
+
+        // Remove the entry from internal table.
+        m_nextHopTable.erase(next_hop_key);
+    }
+
+    return statuses;
 }
 
 std::string NextHopManager::verifyState(const std::string &key, const std::vector<swss::FieldValueTuple> &tuple)
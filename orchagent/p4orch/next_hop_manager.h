@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "ipaddress.h"
 #include "orch.h"
@@ -72,20 +73,30 @@ class NextHopManager : public ObjectManagerInterface
     ReturnCodeOr<P4NextHopAppDbEntry> deserializeP4NextHopAppDbEntry(
         const std::string &key, const std::vector<swss::FieldValueTuple> &attributes);
 
-    // Processes add operation for an entry.
-    ReturnCode processAddRequest(const P4NextHopAppDbEntry &app_db_entry);
+    // Processes add operation for a list of entries.
+    std::vector<ReturnCode> processAddRequests(const std::vector<P4NextHopAppDbEntry> &app_db_entries);
 
-    // Creates an next hop in the next hop table. Return true on success.
-    ReturnCode createNextHop(P4NextHopEntry &next_hop_entry);
+    // Creates a list of next hops in the next hop table with one bulk SAI call.
+    // The next hop keys must be unique in the list.
+    std::vector<ReturnCode> createNextHops(std::vector<P4NextHopEntry> &next_hop_entries);
+
+    // Checks the existence of a next hop to be created and its dependencies, and
+    // resolves the router interface and neighbor of a tunnel next hop.
+    ReturnCode validateNextHopCreation(P4NextHopEntry &next_hop_entry);
 
     // Processes update operation for an entry.
     ReturnCode processUpdateRequest(const P4NextHopAppDbEntry &app_db_entry, P4NextHopEntry *next_hop_entry);
 
-    // Processes delete operation for an entry.
-    ReturnCode processDeleteRequest(const std::string &next_hop_key);
+    // Processes delete operation for a list of entries.
+    std::vector<ReturnCode> processDeleteRequests(const std::vector<std::string> &next_hop_keys);
+
+    // Deletes a list of next hops in the next hop table with one bulk SAI call.
+    // The next hop keys must be unique in the list.
+    std::vector<ReturnCode> removeNextHops(const std::vector<std::string> &next_hop_keys);
 
-    // Deletes an next hop in the next hop table. Return true on success.
-    ReturnCode removeNextHop(const std::string &next_hop_key);
+    // Checks the existence of a next hop to be removed and that it is no longer
+    // referenced.
+    ReturnCode validateNextHopRemoval(const std::string &next_hop_key);
 
     // Verifies internal cache for an entry.
     std::string verifyStateCache(const P4NextHopAppDbEntry &app_db_entry, const P4NextHopEntry *next_hop_entry);
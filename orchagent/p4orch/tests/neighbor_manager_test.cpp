@@ -17,8 +17,12 @@
 using ::p4orch::kTableKeyDelimiter;
 
 using ::testing::_;
+using ::testing::DoAll;
 using ::testing::Eq;
+using ::testing::InSequence;
+using ::testing::Pointee;
 using ::testing::Return;
+using ::testing::SetArrayArgument;
 using ::testing::StrictMock;
 using ::testing::Truly;
 
@@ -101,6 +105,15 @@ bool MatchNeighborCreateAttributeList(const sai_attribute_t *attr_list, const sw
     return true;
 }
 
+// Matches the attribute list of the first neighbor of a bulk create.
+bool MatchNeighborCreateAttributeLists(const sai_attribute_t **attr_lists, const swss::MacAddress &dst_mac_address)
+{
+    if (attr_lists == nullptr)
+        return false;
+
+    return MatchNeighborCreateAttributeList(attr_lists[0], dst_mac_address);
+}
+
 bool MatchNeighborSetAttributeList(const sai_attribute_t *attr_list, const swss::MacAddress &dst_mac_address)
 {
     if (attr_list == nullptr)
@@ -158,12 +171,15 @@ class NeighborManagerTest : public ::testing::Test
 
     ReturnCode CreateNeighbor(P4NeighborEntry &neighbor_entry)
     {
-        return neighbor_manager_.createNeighbor(neighbor_entry);
+        std::vector<P4NeighborEntry> neighbor_entries{neighbor_entry};
+        auto statuses = neighbor_manager_.createNeighbors(neighbor_entries);
+        neighbor_entry = neighbor_entries[0];
+        return statuses[0];
     }
 
     ReturnCode RemoveNeighbor(const std::string &neighbor_key)
     {
-        return neighbor_manager_.removeNeighbor(neighbor_key);
+        return neighbor_manager_.removeNeighbors(std::vector<std::string>{neighbor_key})[0];
     }
 
     ReturnCode SetDstMacAddress(P4NeighborEntry *neighbor_entry, const swss::MacAddress &mac_address)
@@ -171,9 +187,9 @@ class NeighborManagerTest : public ::testing::Test
         return neighbor_manager_.setDstMacAddress(neighbor_entry, mac_address);
     }
 
-    ReturnCode ProcessAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key)
+    ReturnCode ProcessAddRequest(const P4NeighborAppDbEntry &app_db_entry)
     {
-        return neighbor_manager_.processAddRequest(app_db_entry, neighbor_key);
+        return neighbor_manager_.processAddRequests(std::vector<P4NeighborAppDbEntry>{app_db_entry})[0];
     }
 
     ReturnCode ProcessUpdateRequest(const P4NeighborAppDbEntry &app_db_entry, P4NeighborEntry *neighbor_entry)
@@ -183,7 +199,7 @@ class NeighborManagerTest : public ::testing::Test
 
     ReturnCode ProcessDeleteRequest(const std::string &neighbor_key)
     {
-        return neighbor_manager_.processDeleteRequest(neighbor_key);
+        return neighbor_manager_.processDeleteRequests(std::vector<std::string>{neighbor_key})[0];
     }
 
     P4NeighborEntry *GetNeighborEntry(const std::string &neighbor_key)
@@ -235,12 +251,15 @@ class NeighborManagerTest : public ::testing::Test
         copy(neigh_entry.ip_address, neighbor_entry.neighbor_id);
         neigh_entry.rif_id = router_intf_oid;
 
+        std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
         EXPECT_CALL(mock_sai_neighbor_,
-                    create_neighbor_entry(Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neigh_entry)),
-                                          Eq(2),
-                                          Truly(std::bind(MatchNeighborCreateAttributeList, std::placeholders::_1,
-                                                          neighbor_entry.dst_mac_address))))
-            .WillOnce(Return(SAI_STATUS_SUCCESS));
+                    create_neighbor_entries(Eq(1),
+                                            Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neigh_entry)),
+                                            Pointee(Eq(2)),
+                                            Truly(std::bind(MatchNeighborCreateAttributeLists, std::placeholders::_1,
+                                                            neighbor_entry.dst_mac_address)),
+                                            Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+            .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
         ASSERT_TRUE(
             p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry.router_intf_key, router_intf_oid));
@@ -311,7 +330,9 @@ TEST_F(NeighborManagerTest, CreateNeighborSaiApiFails)
 
     ASSERT_TRUE(
         p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry.router_intf_key, kRouterInterfaceOid1));
-    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entry(_, _, _)).WillOnce(Return(SAI_STATUS_FAILURE));
+    std::vector<sai_status_t> exp_status{SAI_STATUS_FAILURE};
+    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entries(_, _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_UNKNOWN, CreateNeighbor(neighbor_entry));
 
@@ -328,9 +349,11 @@ TEST_F(NeighborManagerTest, RemoveNeighborExistingNeighborEntry)
     copy(neigh_entry.ip_address, neighbor_entry.neighbor_id);
     neigh_entry.rif_id = kRouterInterfaceOid2;
 
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
     EXPECT_CALL(mock_sai_neighbor_,
-                remove_neighbor_entry(Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neigh_entry))))
-        .WillOnce(Return(SAI_STATUS_SUCCESS));
+                remove_neighbor_entries(Eq(1), Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neigh_entry)),
+                                        Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, RemoveNeighbor(neighbor_entry.neighbor_key));
 
@@ -369,7 +392,9 @@ TEST_F(NeighborManagerTest, RemoveNeighborSaiApiFails)
     P4NeighborEntry neighbor_entry(kRouterInterfaceId2, kNeighborId2, kMacAddress2);
     AddNeighborEntry(neighbor_entry, kRouterInterfaceOid2);
 
-    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entry(_)).WillOnce(Return(SAI_STATUS_FAILURE));
+    std::vector<sai_status_t> exp_status{SAI_STATUS_FAILURE};
+    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entries(_, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_UNKNOWN, RemoveNeighbor(neighbor_entry.neighbor_key));
 
@@ -427,20 +452,21 @@ TEST_F(NeighborManagerTest, ProcessAddRequestValidAppDbParams)
     copy(neighbor_entry.neigh_entry.ip_address, app_db_entry.neighbor_id);
     neighbor_entry.neigh_entry.rif_id = kRouterInterfaceOid1;
 
-    EXPECT_CALL(
-        mock_sai_neighbor_,
-        create_neighbor_entry(
-            Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neighbor_entry.neigh_entry)), Eq(2),
-            Truly(std::bind(MatchNeighborCreateAttributeList, std::placeholders::_1, app_db_entry.dst_mac_address))))
-        .WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_neighbor_,
+                create_neighbor_entries(
+                    Eq(1), Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neighbor_entry.neigh_entry)),
+                    Pointee(Eq(2)),
+                    Truly(std::bind(MatchNeighborCreateAttributeLists, std::placeholders::_1,
+                                    app_db_entry.dst_mac_address)),
+                    Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
                                       KeyGenerator::generateRouterInterfaceKey(app_db_entry.router_intf_id),
                                       neighbor_entry.neigh_entry.rif_id));
 
-    const std::string neighbor_key =
-        KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id, app_db_entry.neighbor_id);
-    EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(app_db_entry, neighbor_key));
+    EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(app_db_entry));
 
     ValidateNeighborEntry(neighbor_entry, /*router_intf_ref_count=*/1);
 }
@@ -452,9 +478,7 @@ TEST_F(NeighborManagerTest, ProcessAddRequesDstMacAddressNotSet)
                                                .dst_mac_address = swss::MacAddress(),
                                                .is_set_dst_mac = false};
 
-    const std::string neighbor_key =
-        KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id, app_db_entry.neighbor_id);
-    EXPECT_EQ(StatusCode::SWSS_RC_INVALID_PARAM, ProcessAddRequest(app_db_entry, neighbor_key));
+    EXPECT_EQ(StatusCode::SWSS_RC_INVALID_PARAM, ProcessAddRequest(app_db_entry));
 
     P4NeighborEntry neighbor_entry(app_db_entry.router_intf_id, app_db_entry.neighbor_id, app_db_entry.dst_mac_address);
     ValidateNeighborEntryNotPresent(neighbor_entry, /*check_ref_count=*/false);
@@ -467,9 +491,7 @@ TEST_F(NeighborManagerTest, ProcessAddRequestInvalidRouterInterface)
                                                .dst_mac_address = kMacAddress1,
                                                .is_set_dst_mac = true};
 
-    const std::string neighbor_key =
-        KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id, app_db_entry.neighbor_id);
-    EXPECT_EQ(StatusCode::SWSS_RC_NOT_FOUND, ProcessAddRequest(app_db_entry, neighbor_key));
+    EXPECT_EQ(StatusCode::SWSS_RC_NOT_FOUND, ProcessAddRequest(app_db_entry));
 
     P4NeighborEntry neighbor_entry(app_db_entry.router_intf_id, app_db_entry.neighbor_id, app_db_entry.dst_mac_address);
     ValidateNeighborEntryNotPresent(neighbor_entry, /*check_ref_count=*/false);
@@ -536,9 +558,12 @@ TEST_F(NeighborManagerTest, ProcessDeleteRequestExistingNeighborEntry)
     copy(neighbor_entry.neigh_entry.ip_address, neighbor_entry.neighbor_id);
     neighbor_entry.neigh_entry.rif_id = kRouterInterfaceOid1;
 
-    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entry(Truly(std::bind(MatchNeighborEntry, std::placeholders::_1,
-                                                                          neighbor_entry.neigh_entry))))
-        .WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_neighbor_,
+                remove_neighbor_entries(
+                    Eq(1), Truly(std::bind(MatchNeighborEntry, std::placeholders::_1, neighbor_entry.neigh_entry)),
+                    Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessDeleteRequest(neighbor_entry.neighbor_key));
 
@@ -729,7 +754,9 @@ TEST_F(NeighborManagerTest, DrainValidAttributes)
     attributes.push_back(swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress1.to_string()});
     Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key, SET_COMMAND, attributes));
 
-    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entry(_, _, _)).WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entries(Eq(1), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
     Drain();
 
     P4NeighborEntry neighbor_entry(kRouterInterfaceId1, kNeighborId1, kMacAddress1);
@@ -753,12 +780,69 @@ TEST_F(NeighborManagerTest, DrainValidAttributes)
     attributes.clear();
     Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key, DEL_COMMAND, attributes));
 
-    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entry(_)).WillOnce(Return(SAI_STATUS_SUCCESS));
+    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entries(Eq(1), _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
     Drain();
 
     ValidateNeighborEntryNotPresent(neighbor_entry, /*check_ref_count=*/true);
 }
 
+TEST_F(NeighborManagerTest, DrainProgramsBatchWithBulkCalls)
+{
+    ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                                      KeyGenerator::generateRouterInterfaceKey(kRouterInterfaceId1),
+                                      kRouterInterfaceOid1));
+    ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                                      KeyGenerator::generateRouterInterfaceKey(kRouterInterfaceId2),
+                                      kRouterInterfaceOid2));
+
+    const std::string appl_db_key_1 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                      CreateNeighborAppDbKey(kRouterInterfaceId1, kNeighborId1);
+    const std::string appl_db_key_2 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                      CreateNeighborAppDbKey(kRouterInterfaceId2, kNeighborId2);
+    const std::vector<swss::FieldValueTuple> attributes_1{
+        swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress1.to_string()}};
+    const std::vector<swss::FieldValueTuple> attributes_2{
+        swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress2.to_string()}};
+
+    // Both neighbors are created in one bulk call. Deleting the first one in the
+    // same batch needs the creation to be done first.
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key_1, SET_COMMAND, attributes_1));
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key_2, SET_COMMAND, attributes_2));
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key_1, DEL_COMMAND, std::vector<swss::FieldValueTuple>{}));
+
+    std::vector<sai_status_t> exp_create_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+    std::vector<sai_status_t> exp_remove_status{SAI_STATUS_SUCCESS};
+    {
+        InSequence s;
+        EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entries(Eq(2), _, _, _, _, _))
+            .WillOnce(DoAll(SetArrayArgument<5>(exp_create_status.begin(), exp_create_status.end()),
+                            Return(SAI_STATUS_SUCCESS)));
+        EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entries(Eq(1), _, _, _))
+            .WillOnce(DoAll(SetArrayArgument<3>(exp_remove_status.begin(), exp_remove_status.end()),
+                            Return(SAI_STATUS_SUCCESS)));
+    }
+    {
+        // Statuses are published in the order of the entries.
+        InSequence s;
+        EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key_1), _,
+                                        Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+        EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key_2), _,
+                                        Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+        EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key_1), _,
+                                        Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    }
+    Drain();
+
+    P4NeighborEntry neighbor_entry_1(kRouterInterfaceId1, kNeighborId1, kMacAddress1);
+    ValidateNeighborEntryNotPresent(neighbor_entry_1, /*check_ref_count=*/true);
+    P4NeighborEntry neighbor_entry_2(kRouterInterfaceId2, kNeighborId2, kMacAddress2);
+    neighbor_entry_2.neigh_entry.switch_id = gSwitchId;
+    copy(neighbor_entry_2.neigh_entry.ip_address, neighbor_entry_2.neighbor_id);
+    neighbor_entry_2.neigh_entry.rif_id = kRouterInterfaceOid2;
+    ValidateNeighborEntry(neighbor_entry_2, /*router_intf_ref_count=*/1);
+}
+
 TEST_F(NeighborManagerTest, DrainInvalidAppDbEntryKey)
 {
     ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
@@ -28,8 +28,11 @@ using ::p4orch::kTableKeyDelimiter;
 using ::testing::_;
 using ::testing::DoAll;
 using ::testing::Eq;
+using ::testing::InSequence;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::SetArgPointee;
+using ::testing::SetArrayArgument;
 using ::testing::StrictMock;
 using ::testing::Truly;
 
@@ -224,6 +227,19 @@ bool MatchCreateNextHopArgAttrList(const sai_attribute_t *attr_list,
     return true;
 }
 
+// Verifies the attribute list of the first next hop of SAI next hop's
+// create_next_hops().
+bool MatchCreateNextHopsArgAttrLists(const sai_attribute_t **attr_lists,
+                                     const std::unordered_map<sai_attr_id_t, sai_attribute_value_t> &expected_attr_list)
+{
+    if (attr_lists == nullptr)
+    {
+        return false;
+    }
+
+    return MatchCreateNextHopArgAttrList(attr_lists[0], expected_attr_list);
+}
+
 } // namespace
 
 class NextHopManagerTest : public ::testing::Test
@@ -284,7 +300,7 @@ class NextHopManagerTest : public ::testing::Test
 
     ReturnCode ProcessAddRequest(const P4NextHopAppDbEntry &app_db_entry)
     {
-        return next_hop_manager_.processAddRequest(app_db_entry);
+        return next_hop_manager_.processAddRequests(std::vector<P4NextHopAppDbEntry>{app_db_entry})[0];
     }
 
     ReturnCode ProcessUpdateRequest(const P4NextHopAppDbEntry &app_db_entry, P4NextHopEntry *next_hop_entry)
@@ -294,7 +310,7 @@ class NextHopManagerTest : public ::testing::Test
 
     ReturnCode ProcessDeleteRequest(const std::string &next_hop_key)
     {
-        return next_hop_manager_.processDeleteRequest(next_hop_key);
+        return next_hop_manager_.processDeleteRequests(std::vector<std::string>{next_hop_key})[0];
     }
 
     P4NextHopEntry *GetNextHopEntry(const std::string &next_hop_key)
@@ -398,12 +414,15 @@ P4NextHopEntry *NextHopManagerTest::AddNextHopEntry1()
     }
 
     // Set up mock call.
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
     EXPECT_CALL(mock_sai_next_hop_,
-                create_next_hop(
-                    ::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                    Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                    CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1)))))
-        .WillOnce(DoAll(SetArgPointee<0>(kNextHopOid), Return(SAI_STATUS_SUCCESS)));
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4NextHopAppDbEntry1));
 
@@ -418,13 +437,15 @@ P4NextHopEntry *NextHopManagerTest::AddTunnelNextHopEntry1()
     }
 
     // Set up mock call.
-    EXPECT_CALL(
-        mock_sai_next_hop_,
-        create_next_hop(::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                        Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                        CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1,
-                                                                            swss::IpAddress(kNeighborId1))))))
-        .WillOnce(DoAll(SetArgPointee<0>(kTunnelNextHopOid), Return(SAI_STATUS_SUCCESS)));
+    std::vector<sai_object_id_t> exp_oids{kTunnelNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_,
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1, swss::IpAddress(kNeighborId1)))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4TunnelNextHopAppDbEntry1));
 
@@ -477,12 +498,15 @@ TEST_F(NextHopManagerTest, ProcessAddRequestShouldSucceedAddingNewNextHop)
     ASSERT_TRUE(p4_oid_mapper_.getRefCount(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, &original_neighbor_ref_count));
 
     // Set up mock call.
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
     EXPECT_CALL(mock_sai_next_hop_,
-                create_next_hop(
-                    ::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                    Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                    CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1)))))
-        .WillOnce(DoAll(SetArgPointee<0>(kNextHopOid), Return(SAI_STATUS_SUCCESS)));
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4NextHopAppDbEntry1));
 
@@ -537,12 +561,13 @@ TEST_F(NextHopManagerTest, ProcessAddRequestShouldFailWhenSaiCallFails)
     ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry1, kRouterInterfaceOid1));
 
     // Set up mock call.
+    std::vector<sai_status_t> exp_status{SAI_STATUS_FAILURE};
     EXPECT_CALL(mock_sai_next_hop_,
-                create_next_hop(
-                    ::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                    Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                    CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1)))))
-        .WillOnce(Return(SAI_STATUS_FAILURE));
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_UNKNOWN, ProcessAddRequest(kP4NextHopAppDbEntry1));
 
@@ -572,13 +597,15 @@ TEST_F(NextHopManagerTest, ProcessAddRequestShouldSuccessForTunnelNexthop)
     ASSERT_TRUE(ResolveNextHopEntryDependency(kP4TunnelNextHopAppDbEntry1, kTunnelOid1));
 
     // Set up mock call.
-    EXPECT_CALL(
-        mock_sai_next_hop_,
-        create_next_hop(::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                        Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                        CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1,
-                                                                            swss::IpAddress(kNeighborId1))))))
-        .WillOnce(DoAll(SetArgPointee<0>(kTunnelNextHopOid), Return(SAI_STATUS_SUCCESS)));
+    std::vector<sai_object_id_t> exp_oids{kTunnelNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_,
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1, swss::IpAddress(kNeighborId1)))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4TunnelNextHopAppDbEntry1));
 
@@ -622,8 +649,11 @@ TEST_F(NextHopManagerTest, ProcessDeleteRequestShouldSucceedForExistingNextHop)
     ASSERT_NE(p4_next_hop_entry, nullptr);
 
     // Set up mock call.
-    EXPECT_CALL(mock_sai_next_hop_, remove_next_hop(Eq(p4_next_hop_entry->next_hop_oid)))
-        .WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_remove_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(Eq(1), Pointee(Eq(p4_next_hop_entry->next_hop_oid)),
+                                                     Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_remove_status.begin(), exp_remove_status.end()),
+                        Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessDeleteRequest(p4_next_hop_entry->next_hop_key));
 
@@ -699,8 +729,11 @@ TEST_F(NextHopManagerTest, ProcessDeleteRequestShouldFailIfSaiCallFails)
     ASSERT_NE(p4_next_hop_entry, nullptr);
 
     // Set up mock call.
-    EXPECT_CALL(mock_sai_next_hop_, remove_next_hop(Eq(p4_next_hop_entry->next_hop_oid)))
-        .WillOnce(Return(SAI_STATUS_FAILURE));
+    std::vector<sai_status_t> exp_remove_status{SAI_STATUS_FAILURE};
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(Eq(1), Pointee(Eq(p4_next_hop_entry->next_hop_oid)),
+                                                     Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_remove_status.begin(), exp_remove_status.end()),
+                        Return(SAI_STATUS_FAILURE)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_UNKNOWN, ProcessDeleteRequest(p4_next_hop_entry->next_hop_key));
 
@@ -724,12 +757,15 @@ TEST_F(NextHopManagerTest, GetNextHopEntryShouldReturnValidPointerForAddedNextHo
     ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry1, kRouterInterfaceOid1));
 
     // Set up mock call.
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
     EXPECT_CALL(mock_sai_next_hop_,
-                create_next_hop(
-                    ::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                    Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                    CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1)))))
-        .WillOnce(DoAll(SetArgPointee<0>(kNextHopOid), Return(SAI_STATUS_SUCCESS)));
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4NextHopAppDbEntry1, kRouterInterfaceOid1))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4NextHopAppDbEntry1));
 
@@ -812,8 +848,11 @@ TEST_F(NextHopManagerTest, DrainValidAppEntryShouldSucceed)
     Enqueue(app_db_entry);
 
     EXPECT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry2, kRouterInterfaceOid2));
-    EXPECT_CALL(mock_sai_next_hop_, create_next_hop(_, _, _, _))
-        .WillOnce(DoAll(SetArgPointee<0>(kNextHopOid), Return(SAI_STATUS_SUCCESS)));
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, create_next_hops(_, Eq(1), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     Drain();
 
@@ -834,8 +873,11 @@ TEST_F(NextHopManagerTest, DrainValidTunnelNexthopAppEntryShouldSucceed)
     Enqueue(tunnel_app_db_entry);
 
     EXPECT_TRUE(ResolveNextHopEntryDependency(kP4TunnelNextHopAppDbEntry2, kTunnelOid2));
-    EXPECT_CALL(mock_sai_next_hop_, create_next_hop(_, _, _, _))
-        .WillOnce(DoAll(SetArgPointee<0>(kTunnelNextHopOid), Return(SAI_STATUS_SUCCESS)));
+    std::vector<sai_object_id_t> exp_oids{kTunnelNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, create_next_hops(_, Eq(1), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     Drain();
 
@@ -846,7 +888,11 @@ TEST_F(NextHopManagerTest, DrainValidTunnelNexthopAppEntryShouldSucceed)
     std::vector<swss::FieldValueTuple> fvs;
     swss::KeyOpFieldsValuesTuple app_db_entry(std::string(APP_P4RT_NEXTHOP_TABLE_NAME) + kTableKeyDelimiter + j.dump(),
                                               DEL_COMMAND, fvs);
-    EXPECT_CALL(mock_sai_next_hop_, remove_next_hop(Eq(kTunnelNextHopOid))).WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_remove_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(Eq(1), Pointee(Eq(kTunnelNextHopOid)),
+                                                     Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_remove_status.begin(), exp_remove_status.end()),
+                        Return(SAI_STATUS_SUCCESS)));
 
     Enqueue(app_db_entry);
     Drain();
@@ -866,6 +912,58 @@ TEST_F(NextHopManagerTest, DrainValidTunnelNexthopAppEntryShouldSucceed)
     EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, 0));
 }
 
+TEST_F(NextHopManagerTest, DrainBatchShouldPublishPerEntrySaiStatus)
+{
+    nlohmann::json j;
+    j[prependMatchField(p4orch::kNexthopId)] = kNextHopId;
+    std::vector<swss::FieldValueTuple> fvs{{p4orch::kAction, p4orch::kSetIpNexthop},
+                                           {prependParamField(p4orch::kNeighborId), kNeighborId1},
+                                           {prependParamField(p4orch::kRouterInterfaceId), kRouterInterfaceId1}};
+    const std::string appl_db_key = std::string(APP_P4RT_NEXTHOP_TABLE_NAME) + kTableKeyDelimiter + j.dump();
+
+    nlohmann::json tunnel_j;
+    tunnel_j[prependMatchField(p4orch::kNexthopId)] = kTunnelNextHopId;
+    std::vector<swss::FieldValueTuple> tunnel_fvs{{p4orch::kAction, p4orch::kSetTunnelNexthop},
+                                                  {prependParamField(p4orch::kNeighborId), kNeighborId2},
+                                                  {prependParamField(p4orch::kTunnelId), kTunnelId2}};
+    const std::string tunnel_appl_db_key =
+        std::string(APP_P4RT_NEXTHOP_TABLE_NAME) + kTableKeyDelimiter + tunnel_j.dump();
+
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key, SET_COMMAND, fvs));
+    Enqueue(swss::KeyOpFieldsValuesTuple(tunnel_appl_db_key, SET_COMMAND, tunnel_fvs));
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry1, kRouterInterfaceOid1));
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4TunnelNextHopAppDbEntry2, kTunnelOid2));
+
+    // Both next hops are created in one bulk call, only the second one fails.
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid, SAI_NULL_OBJECT_ID};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_TABLE_FULL};
+    EXPECT_CALL(mock_sai_next_hop_,
+                create_next_hops(Eq(gSwitchId), Eq(2), _, _, Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)));
+    {
+        // The SAI status of each entry is published, in the order of the entries.
+        InSequence s;
+        EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key), _,
+                                        Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+        EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(tunnel_appl_db_key), _,
+                                        Eq(StatusCode::SWSS_RC_FULL), Eq(true)));
+    }
+    Drain();
+
+    EXPECT_TRUE(ValidateNextHopEntryAdd(kP4NextHopAppDbEntry1, kNextHopOid));
+    EXPECT_EQ(GetNextHopEntry(KeyGenerator::generateNextHopKey(kP4TunnelNextHopAppDbEntry2.next_hop_id)), nullptr);
+    EXPECT_FALSE(p4_oid_mapper_.existsOID(SAI_OBJECT_TYPE_NEXT_HOP,
+                                          KeyGenerator::generateNextHopKey(kP4TunnelNextHopAppDbEntry2.next_hop_id)));
+
+    // The failed next hop does not hold references.
+    const std::string tunnel_key = KeyGenerator::generateTunnelKey(kP4TunnelNextHopAppDbEntry2.gre_tunnel_id);
+    const std::string neighbor_key =
+        KeyGenerator::generateNeighborKey(kP4TunnelEntry2.router_interface_id, kP4TunnelEntry2.neighbor_id);
+    EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_TUNNEL, tunnel_key, 0));
+    EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, 0));
+}
+
 TEST_F(NextHopManagerTest, DrainAppEntryWithInvalidOpShouldBeNoOp)
 {
     nlohmann::json j;
@@ -1002,8 +1100,11 @@ TEST_F(NextHopManagerTest, DrainDeleteRequestShouldSucceedForExistingNextHop)
     std::vector<swss::FieldValueTuple> fvs;
     swss::KeyOpFieldsValuesTuple app_db_entry(std::string(APP_P4RT_NEXTHOP_TABLE_NAME) + kTableKeyDelimiter + j.dump(),
                                               DEL_COMMAND, fvs);
-    EXPECT_CALL(mock_sai_next_hop_, remove_next_hop(Eq(p4_next_hop_entry->next_hop_oid)))
-        .WillOnce(Return(SAI_STATUS_SUCCESS));
+    std::vector<sai_status_t> exp_remove_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(Eq(1), Pointee(Eq(p4_next_hop_entry->next_hop_oid)),
+                                                     Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_remove_status.begin(), exp_remove_status.end()),
+                        Return(SAI_STATUS_SUCCESS)));
 
     Enqueue(app_db_entry);
     Drain();
@@ -1097,13 +1198,15 @@ TEST_F(NextHopManagerTest, VerifyTunnelNextHopStateTest)
     ASSERT_TRUE(ResolveNextHopEntryDependency(kP4TunnelNextHopAppDbEntry1, kTunnelOid1));
 
     // Set up mock call.
-    EXPECT_CALL(
-        mock_sai_next_hop_,
-        create_next_hop(::testing::NotNull(), Eq(gSwitchId), Eq(3),
-                        Truly(std::bind(MatchCreateNextHopArgAttrList, std::placeholders::_1,
-                                        CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1,
-                                                                            swss::IpAddress(kNeighborId1))))))
-        .WillOnce(DoAll(SetArgPointee<0>(kTunnelNextHopOid), Return(SAI_STATUS_SUCCESS)));
+    std::vector<sai_object_id_t> exp_oids{kTunnelNextHopOid};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_,
+                create_next_hops(Eq(gSwitchId), Eq(1), Pointee(Eq(3)),
+                                 Truly(std::bind(MatchCreateNextHopsArgAttrLists, std::placeholders::_1,
+                                                 CreateAttributeListForNextHopObject(kP4TunnelNextHopAppDbEntry1, kTunnelOid1, swss::IpAddress(kNeighborId1)))),
+                                 Eq(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
 
     EXPECT_EQ(StatusCode::SWSS_RC_SUCCESS, ProcessAddRequest(kP4TunnelNextHopAppDbEntry1));
 
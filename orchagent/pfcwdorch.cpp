@@ -45,6 +45,9 @@ PfcWdOrch<DropHandler, ForwardHandler>::PfcWdOrch(DBConnector *db, vector<string
     m_platform(getenv("platform") ? getenv("platform") : "")
 {
     SWSS_LOG_ENTER();
+
+    // Storm actions update port state and install ACL rules
+    declareResources({ ORCH_RESOURCE_SWITCH }, { ORCH_RESOURCE_PFCWD, ORCH_RESOURCE_PORT, ORCH_RESOURCE_ACL });
     if (m_platform == "")
     {
         SWSS_LOG_ERROR("Platform environment variable is not defined");
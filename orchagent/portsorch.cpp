@@ -1475,13 +1475,14 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
     {
         return false;
     }
     else
     {
-        p = m_portList[alias];
+        p = itr->second;
         return true;
     }
 }
@@ -1490,21 +1491,106 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
+    const Port *p = lookupPortOid(id);
+    if (p == nullptr)
+    {
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+const Port *PortsOrch::getPortPtr(const string &alias) const
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &itr->second;
+}
+
+const Port *PortsOrch::getPortPtr(sai_object_id_t id)
+{
+    return lookupPortOid(id);
+}
+
+bool PortsOrch::updatePort(const string &alias, const std::function<void(Port &)> &update)
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return false;
+    }
+
+    update(itr->second);
+    return true;
+}
+
+Port *PortsOrch::lookupPortOid(sai_object_id_t id)
+{
+    auto idx = m_portOidIndex.find(id);
+    if (idx != m_portOidIndex.end())
+    {
+        return idx->second;
+    }
+
     auto itr = saiOidToAlias.find(id);
     if (itr == saiOidToAlias.end())
     {
-        return false;
+        return nullptr;
     }
-    else
+
+    auto port = m_portList.find(itr->second);
+    if (port == m_portList.end())
     {
-        if (!getPort(itr->second, port))
+        SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
+    }
+
+    m_portOidIndex[id] = &port->second;
+    return &port->second;
+}
+
+void PortsOrch::addPortOid(sai_object_id_t id, const string &alias)
+{
+    saiOidToAlias[id] = alias;
+    m_portOidIndex.erase(id);
+}
+
+void PortsOrch::removePortOid(sai_object_id_t id)
+{
+    saiOidToAlias.erase(id);
+    m_portOidIndex.erase(id);
+}
+
+/*
+ * Remove a port from the port list. Other OIDs may still resolve to the port,
+ * e.g. the gearbox system and line side ports, so drop every index entry
+ * referring to it before the entry goes away.
+ */
+void PortsOrch::erasePort(const string &alias)
+{
+    auto port = m_portList.find(alias);
+    if (port == m_portList.end())
+    {
+        return;
+    }
+
+    for (auto idx = m_portOidIndex.begin(); idx != m_portOidIndex.end();)
+    {
+        if (idx->second == &port->second)
         {
-            SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
+            idx = m_portOidIndex.erase(idx);
+        }
+        else
+        {
+            ++idx;
         }
-        return true;
     }
 
-    return false;
+    m_portList.erase(port);
 }
 
 void PortsOrch::increasePortRefCount(const string &alias)
@@ -1675,18 +1761,14 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
 {
     SWSS_LOG_ENTER();
 
-    auto itr = saiOidToAlias.find(bridge_port_id);
-    if (itr == saiOidToAlias.end())
+    const Port *p = lookupPortOid(bridge_port_id);
+    if (p == nullptr)
     {
         return false;
     }
-    else
-    {
-        getPort(itr->second, port);
-        return true;
-    }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 bool PortsOrch::addSubPort(Port &port, const string &alias, const string &vlan, const bool &adminUp, const uint32_t &mtu)
@@ -1776,6 +1858,10 @@ bool PortsOrch::addSubPort(Port &port, const string &alias, const string &vlan,
     m_portList[alias] = p;
     m_port_ref_count[alias] = 0;
     port = p;
+
+    Constraint cst = { RETRY_CST_PORT, alias };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
     return true;
 }
 
@@ -1819,7 +1905,7 @@ bool PortsOrch::removeSubPort(const string &alias)
     }
     m_portList[parentPort.m_alias] = parentPort;
 
-    m_portList.erase(it);
+    erasePort(alias);
 
     // Restore hostif vlan tag for the parent port when the last subport is removed
     if (parentPort.m_child_ports.empty())
@@ -1867,7 +1953,15 @@ void PortsOrch::updateChildPortsMtu(const Port &p, const uint32_t mtu)
 
 void PortsOrch::setPort(string alias, Port p)
 {
+    bool created = m_portList.find(alias) == m_portList.end();
+
     m_portList[alias] = p;
+
+    if (created)
+    {
+        Constraint cst = { RETRY_CST_PORT, alias };
+        notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+    }
 }
 
 void PortsOrch::getCpuPort(Port &port)
@@ -3758,7 +3852,7 @@ bool PortsOrch::initPort(const PortConfig &port)
 
                 /* Add port to port list */
                 m_portList[alias] = p;
-                saiOidToAlias[id] = alias;
+                addPortOid(id, alias);
                 m_port_ref_count[alias] = 0;
                 m_portOidToIndex[id] = index;
 
@@ -3802,6 +3896,9 @@ bool PortsOrch::initPort(const PortConfig &port)
 
                 m_portList[alias].m_init = true;
 
+                Constraint cst = { RETRY_CST_PORT, alias };
+                notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
                 if (role == Port::Role::Rec || role == Port::Role::Inb)
                 {
                     m_recircPortRole[alias] = role;
@@ -5167,8 +5264,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
             /* Delete port from port list */
             m_portConfigMap.erase(alias);
-            m_portList.erase(alias);
-            saiOidToAlias.erase(port_id);
+            removePortOid(port_id);
+            erasePort(alias);
 
             SWSS_LOG_NOTICE("Removed port %s", alias.c_str());
         }
@@ -6513,7 +6610,7 @@ bool PortsOrch::addBridgePort(Port &port)
         return false;
     }
     m_portList[port.m_alias] = port;
-    saiOidToAlias[port.m_bridge_port_id] = port.m_alias;
+    addPortOid(port.m_bridge_port_id, port.m_alias);
     SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
 
     PortUpdate update = { port, true };
@@ -6573,7 +6670,7 @@ bool PortsOrch::removeBridgePort(Port &port)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
-    saiOidToAlias.erase(port.m_bridge_port_id);
+    removePortOid(port.m_bridge_port_id);
     port.m_bridge_port_id = SAI_NULL_OBJECT_ID;
 
     /* Remove bridge port */
@@ -6650,9 +6747,12 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_members = set<string>();
     m_portList[vlan_alias] = vlan;
     m_port_ref_count[vlan_alias] = 0;
-    saiOidToAlias[vlan_oid] =  vlan_alias;
+    addPortOid(vlan_oid, vlan_alias);
     m_vlanPorts.emplace(vlan_alias);
 
+    Constraint cst = { RETRY_CST_PORT, vlan_alias };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
     return true;
 }
 
@@ -6721,8 +6821,8 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
-    saiOidToAlias.erase(vlan.m_vlan_info.vlan_oid);
-    m_portList.erase(vlan.m_alias);
+    removePortOid(vlan.m_vlan_info.vlan_oid);
+    erasePort(vlan.m_alias);
     m_port_ref_count.erase(vlan.m_alias);
     m_vlanPorts.erase(vlan.m_alias);
 
@@ -7242,11 +7342,14 @@ bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
     lag.m_members = set<string>();
     m_portList[lag_alias] = lag;
     m_port_ref_count[lag_alias] = 0;
-    saiOidToAlias[lag_id] = lag_alias;
+    addPortOid(lag_id, lag_alias);
 
     PortUpdate update = { lag, true };
     notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
 
+    Constraint cst = { RETRY_CST_PORT, lag_alias };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
     FieldValueTuple tuple(lag_alias, sai_serialize_object_id(lag_id));
     vector<FieldValueTuple> fields;
     fields.push_back(tuple);
@@ -7315,8 +7418,8 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%" PRIx64, lag.m_alias.c_str(), lag.m_lag_id);
 
-    saiOidToAlias.erase(lag.m_lag_id);
-    m_portList.erase(lag.m_alias);
+    removePortOid(lag.m_lag_id);
+    erasePort(lag.m_alias);
     m_port_ref_count.erase(lag.m_alias);
 
     PortUpdate update = { lag, false };
@@ -7601,7 +7704,10 @@ bool PortsOrch::addTunnel(string tunnel_alias, sai_object_id_t tunnel_id, bool h
     }
     tunnel.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
     m_portList[tunnel_alias] = tunnel;
-    saiOidToAlias[tunnel_id] = tunnel_alias;
+    addPortOid(tunnel_id, tunnel_alias);
+
+    Constraint cst = { RETRY_CST_PORT, tunnel_alias };
+    notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
 
     SWSS_LOG_INFO("addTunnel:: %" PRIx64, tunnel_id);
 
@@ -7612,8 +7718,8 @@ bool PortsOrch::removeTunnel(Port tunnel)
 {
     SWSS_LOG_ENTER();
 
-    saiOidToAlias.erase(tunnel.m_tunnel_id);
-    m_portList.erase(tunnel.m_alias);
+    removePortOid(tunnel.m_tunnel_id);
+    erasePort(tunnel.m_alias);
 
     return true;
 }
@@ -9448,8 +9554,8 @@ bool PortsOrch::initGearboxPort(Port &port)
             SWSS_LOG_NOTICE("BOX: Connected Gearbox ports; system-side:0x%" PRIx64 " to line-side:0x%" PRIx64, systemPort, linePort);
             m_gearboxPortListLaneMap[port.m_port_id] = make_tuple(systemPort, linePort);
             port.m_line_side_id = linePort;
-            saiOidToAlias[systemPort] = port.m_alias;
-            saiOidToAlias[linePort] = port.m_alias;
+            addPortOid(systemPort, port.m_alias);
+            addPortOid(linePort, port.m_alias);
 
             /* Add gearbox system/line port name map to counter table */
             FieldValueTuple tuple(port.m_alias + "_system", sai_serialize_object_id(systemPort));
@@ -9986,6 +10092,20 @@ void PortsOrch::updateGearboxPortOperStatus(const Port& port)
     }
 }
 
+bool PortsOrch::incrFdbCount(const std::string& alias, int count)
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return false;
+    }
+    else
+    {
+        itr->second.m_fdb_count += count;
+    }
+    return true;
+}
+
 bool PortsOrch::decrFdbCount(const std::string& alias, int count)
 {
     auto itr = m_portList.find(alias);
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <unordered_set>
+#include <functional>
 
 #include "acltable.h"
 #include "orch.h"
@@ -142,6 +143,14 @@ public:
     bool setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode);
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
+    /*
+     * Lookups without copying the Port object. The pointer refers to the
+     * entry in the port list and stays valid until the port is removed.
+     * Modifications go through updatePort() or the dedicated setters.
+     */
+    const Port *getPortPtr(const string &alias) const;
+    const Port *getPortPtr(sai_object_id_t id);
+    bool updatePort(const string &alias, const std::function<void(Port &)> &update);
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
@@ -247,6 +256,7 @@ public:
 
     void updateGearboxPortOperStatus(const Port& port);
 
+    bool incrFdbCount(const string& alias, int count);
     bool decrFdbCount(const string& alias, int count);
 
     void setMACsecEnabledState(sai_object_id_t port_id, bool enabled);
@@ -347,6 +357,8 @@ private:
      * coming from SAI
      */
     unordered_map<sai_object_id_t, string> saiOidToAlias;
+    /* saiOidToAlias resolved to the entries of m_portList, filled on lookup */
+    unordered_map<sai_object_id_t, Port *> m_portOidIndex;
     unordered_map<sai_object_id_t, uint16_t> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -385,6 +397,10 @@ private:
 
     void removePortFromLanesMap(string alias);
     void removePortFromPortListMap(sai_object_id_t port_id);
+    Port *lookupPortOid(sai_object_id_t id);
+    void addPortOid(sai_object_id_t id, const string &alias);
+    void removePortOid(sai_object_id_t id);
+    void erasePort(const string &alias);
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
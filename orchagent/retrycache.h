@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "table.h"
+
+/*
+ * A constraint names the resource a task waits for, e.g. an unresolved
+ * neighbor. The owner of the resource wakes up the tasks waiting for it once
+ * it is created, by notifying SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED with the
+ * constraint as context (see Orch::retryToSync).
+ */
+enum ConstraintType
+{
+    RETRY_CST_NEIGH,    // next hop key (ip@alias) of a neighbor, owned by NeighOrch
+    RETRY_CST_PORT,     // alias of a port, LAG or VLAN, owned by PortsOrch
+    RETRY_CST_VRF,      // VRF name, owned by VRFOrch
+    RETRY_CST_NHG       // next hop group index, owned by NhgOrch and CbfNhgOrch
+};
+
+typedef std::pair<ConstraintType, std::string> Constraint;
+
+struct ConstraintHash
+{
+    size_t operator()(const Constraint &cst) const
+    {
+        return std::hash<std::string>()(cst.second) ^ (static_cast<size_t>(cst.first) << 1);
+    }
+};
+
+/*
+ * RetryCache holds the tasks of a consumer which are parked until their
+ * constraint is resolved, so they are not parsed again by every doTask()
+ * pass in the meantime. There is at most one parked task per key.
+ */
+class RetryCache
+{
+public:
+    bool empty() const { return m_tasks.empty(); }
+    size_t size() const { return m_tasks.size(); }
+
+    void insert(const std::string &key, swss::KeyOpFieldsValuesTuple &&task, const Constraint &cst)
+    {
+        auto it = m_tasks.find(key);
+        if (it != m_tasks.end())
+        {
+            removeWaiter(it->second.first, key);
+            m_tasks.erase(it);
+        }
+
+        m_tasks.emplace(key, std::make_pair(cst, std::move(task)));
+        m_waiters[cst].insert(key);
+    }
+
+    // Remove the task parked for key, returns false if there is none
+    bool take(const std::string &key, swss::KeyOpFieldsValuesTuple &task)
+    {
+        auto it = m_tasks.find(key);
+        if (it == m_tasks.end())
+        {
+            return false;
+        }
+
+        task = std::move(it->second.second);
+        removeWaiter(it->second.first, key);
+        m_tasks.erase(it);
+        return true;
+    }
+
+    // Remove and return the tasks waiting for cst
+    std::vector<std::pair<std::string, swss::KeyOpFieldsValuesTuple>> resolve(const Constraint &cst)
+    {
+        std::vector<std::pair<std::string, swss::KeyOpFieldsValuesTuple>> tasks;
+
+        auto waiters = m_waiters.find(cst);
+        if (waiters == m_waiters.end())
+        {
+            return tasks;
+        }
+
+        tasks.reserve(waiters->second.size());
+        for (const auto &key : waiters->second)
+        {
+            auto it = m_tasks.find(key);
+            tasks.emplace_back(key, std::move(it->second.second));
+            m_tasks.erase(it);
+        }
+        m_waiters.erase(waiters);
+
+        return tasks;
+    }
+
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (const auto &it : m_tasks)
+        {
+            f(it.second.second);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::pair<Constraint, swss::KeyOpFieldsValuesTuple>> m_tasks;
+    std::unordered_map<Constraint, std::unordered_set<std::string>, ConstraintHash> m_waiters;
+
+    void removeWaiter(const Constraint &cst, const std::string &key)
+    {
+        auto waiters = m_waiters.find(cst);
+        if (waiters == m_waiters.end())
+        {
+            return;
+        }
+
+        waiters->second.erase(key);
+        if (waiters->second.empty())
+        {
+            m_waiters.erase(waiters);
+        }
+    }
+};
@@ -37,6 +37,15 @@ extern string gMySwitchType;
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
+/* Route bulker flush policy, see BulkerPolicy */
+#define ROUTE_BULK_MAX_AGE_MS           100
+#define ROUTE_BULK_LATENCY_TARGET_MS    50
+#define ROUTE_BULK_MIN_SIZE             64
+
+/* Route bulker statistics are written to COUNTERS_DB at most once per interval */
+#define ROUTE_BULKER_STATS_INTERVAL_SEC 1
+#define BULKER_STATS_TABLE              "BULKER_STATS"
+
 RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames, SwitchOrch *switchOrch, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch, FgNhgOrch *fgNhgOrch, Srv6Orch *srv6Orch, swss::ZmqServer *zmqServer) :
         gRouteBulker(sai_route_api, gMaxBulkSize),
         gLabelRouteBulker(sai_mpls_api, gMaxBulkSize),
@@ -56,6 +65,16 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     m_publisher.setBuffered(true);
 
+    BulkerPolicy policy;
+    policy.max_age = std::chrono::milliseconds(ROUTE_BULK_MAX_AGE_MS);
+    policy.latency_target = std::chrono::milliseconds(ROUTE_BULK_LATENCY_TARGET_MS);
+    policy.min_bulk_size = ROUTE_BULK_MIN_SIZE;
+    gRouteBulker.set_policy(policy);
+
+    /* Routes waiting for a neighbor or a VRF are parked until it is created */
+    m_neighOrch->attach(this);
+    m_vrfOrch->attach(this);
+
     sai_attribute_t attr;
     attr.id = SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS;
 
@@ -383,6 +402,18 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr, sai_object_
     }
 }
 
+void RouteOrch::update(SubjectType type, void *cntx)
+{
+    SWSS_LOG_ENTER();
+
+    if (type != SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED)
+    {
+        return;
+    }
+
+    retryToSync(*static_cast<Constraint *>(cntx));
+}
+
 void RouteOrch::updateDefaultRouteSwapSet(const NextHopGroupKey default_nhg_key, std::set<NextHopKey>& active_default_route_nhops)
 {
     std::set<NextHopKey> current_default_route_nhops;
@@ -452,10 +483,9 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
     count = 0;
 
+    /* The members of all the groups are created with one bulk call */
     for (auto nhopgroup = m_syncdNextHopGroups.begin();
          nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
     {
@@ -471,58 +501,28 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
         {
            continue;
         }
-        
-        vector<sai_attribute_t> nhgm_attrs;
-        sai_attribute_t nhgm_attr;
 
-        /* get updated nhkey with possible weight */
-        auto nhkey = nhopgroup->first.getNextHops().find(nexthop);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = nhopgroup->second.next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nexthop);
-        nhgm_attrs.push_back(nhgm_attr);
-
-        if (nhkey->weight)
-        {
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
-            nhgm_attr.value.s32 = nhkey->weight;
-            nhgm_attrs.push_back(nhgm_attr);
-        }
-
-        if (m_switchOrch->checkOrderedEcmpEnable())
+        /* The member is already being retried */
+        if (nhopgroup->second.pending_members.count(nexthop))
         {
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_SEQUENCE_ID;
-            nhgm_attr.value.u32 = nhopgroup->second.nhopgroup_members[nexthop].seq_id;
-            nhgm_attrs.push_back(nhgm_attr);
+            continue;
         }
 
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
-
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to add next hop member to group %" PRIx64 ": %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
-            if (handle_status != task_success)
-            {
-                return parseHandleSaiStatusFailure(handle_status);
-            }
-        }
+        /* get updated nhkey with possible weight */
+        auto nhkey = nhopgroup->first.getNextHops().find(nexthop);
 
-        ++count;
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[nexthop].next_hop_id = nexthop_id;
         /* Keep the count of number of nexthop members are present in Nexthop Group
          * when the links became active again*/
-        nhopgroup->second.nh_member_install_count++;
+        NextHopGroupPendingMember member = { m_neighOrch->getNextHopId(nexthop),
+                                             nhopgroup->second.nhopgroup_members[nexthop].seq_id, true };
+
+        queueNextHopGroupMember(nhopgroup->first, nhopgroup->second.next_hop_group_id, *nhkey, member);
+        ++count;
     }
 
+    /* The caller acts on the result, so don't wait for the end of the pass */
+    gNextHopGroupMemberBulker.flush();
+
     if (!m_fgNhgOrch->validNextHopInNextHopGroup(nexthop))
     {
         return false;
@@ -535,10 +535,10 @@ bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    bool success = true;
     count = 0;
 
+    /* The members of all the groups are removed with one bulk call */
     for (auto nhopgroup = m_syncdNextHopGroups.begin();
          nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
     {
@@ -554,41 +554,62 @@ bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t
         {
            continue;
         }
- 
 
-        nexthop_id = nhopgroup->second.nhopgroup_members[nexthop].next_hop_id;
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
-
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to remove next hop member %" PRIx64 " from group %" PRIx64 ": %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
-            if (handle_status != task_success)
-            {
-                return parseHandleSaiStatusFailure(handle_status);
-            }
-        }
-        // Reduce the member install count when links down
-        if (nhopgroup->second.nh_member_install_count)
+        /* The member was never created, stop retrying it */
+        if (nhopgroup->second.pending_members.erase(nexthop) ||
+            nhopgroup->second.nhopgroup_members[nexthop].next_hop_id == SAI_NULL_OBJECT_ID)
         {
-            nhopgroup->second.nh_member_install_count--;
+            continue;
         }
-        // Nexthop Group member count has become zero so swap it's memebers with default route
-        // nexthop's if this route is eligible for such a swap
-        if (nhopgroup->second.nh_member_install_count == 0 && nhopgroup->second.eligible_for_default_route_nh_swap && !nhopgroup->second.is_default_route_nh_swap)
-        {
-            if(nexthop.ip_address.isV4())
-            { 
-                addDefaultRouteNexthopsInNextHopGroup(nhopgroup->second, v4_active_default_route_nhops);
-            }
-            else
+
+        NextHopGroupKey nexthops = nhopgroup->first;
+        sai_object_id_t nexthop_id = nhopgroup->second.nhopgroup_members[nexthop].next_hop_id;
+
+        gNextHopGroupMemberBulker.removeMember(nexthop_id,
+            [this, nexthops, nexthop, nexthop_id, &count, &success](sai_status_t status)
             {
-                addDefaultRouteNexthopsInNextHopGroup(nhopgroup->second, v6_active_default_route_nhops);
-            }
-        }
-        ++count;
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+                auto &entry = m_syncdNextHopGroups.at(nexthops);
+
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to remove next hop member %" PRIx64 " from group %" PRIx64 ": %d\n",
+                                   nexthop_id, entry.next_hop_group_id, status);
+                    task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+                    if (handle_status != task_success)
+                    {
+                        success &= parseHandleSaiStatusFailure(handle_status);
+                        return;
+                    }
+                }
+                // Reduce the member install count when links down
+                if (entry.nh_member_install_count)
+                {
+                    entry.nh_member_install_count--;
+                }
+                // Nexthop Group member count has become zero so swap it's memebers with default route
+                // nexthop's if this route is eligible for such a swap
+                if (entry.nh_member_install_count == 0 && entry.eligible_for_default_route_nh_swap && !entry.is_default_route_nh_swap)
+                {
+                    if(nexthop.ip_address.isV4())
+                    { 
+                        addDefaultRouteNexthopsInNextHopGroup(entry, v4_active_default_route_nhops);
+                    }
+                    else
+                    {
+                        addDefaultRouteNexthopsInNextHopGroup(entry, v6_active_default_route_nhops);
+                    }
+                }
+                ++count;
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+            });
+    }
+
+    /* The caller acts on the result, so don't wait for the end of the pass */
+    gNextHopGroupMemberBulker.flush();
+
+    if (!success)
+    {
+        return false;
     }
 
     if (!m_fgNhgOrch->invalidNextHopInNextHopGroup(nexthop))
@@ -613,6 +634,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
     if (table_name == APP_LABEL_ROUTE_TABLE_NAME)
     {
         doLabelTask(consumer);
+        exportBulkerStats();
         return;
     }
 
@@ -629,9 +651,20 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 RouteBulkContext
         >                                       toBulk;
 
+        // Next hop group members of the groups created for these routes are
+        // kept on the member bulker, and created together before the routes
+        NhgMemberBatch nhgMemberBatch(gNextHopGroupMemberBulker);
+
         // Add or remove routes with a route bulker
         while (it != consumer.m_toSync.end())
         {
+            // Program what is queued once it fills a bulk call or got old, rather
+            // than holding the first routes of a large burst until all are parsed
+            if (gRouteBulker.flush_due())
+            {
+                break;
+            }
+
             KeyOpFieldsValuesTuple t = it->second;
 
             string key = kfvKey(t);
@@ -707,7 +740,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
 
                 if (!m_vrfOrch->isVRFexists(vrf_name))
                 {
-                    it++;
+                    it = consumer.addToRetry(it, Constraint(RETRY_CST_VRF, vrf_name));
                     continue;
                 }
                 vrf_id = m_vrfOrch->getVRFid(vrf_name);
@@ -1007,11 +1040,20 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                     catch (const std::out_of_range& e)
                     {
                         SWSS_LOG_ERROR("Next hop group %s does not exist", nhg_index.c_str());
-                        ++it;
+                        it = consumer.addToRetry(it, Constraint(RETRY_CST_NHG, nhg_index));
                         continue;
                     }
                 }
 
+                /*
+                 * Intern the ECMP next hops once, the next hop group of the
+                 * route is looked up and compared by id from here on.
+                 */
+                if (ctx.nhg_index.empty() && nhg.getSize() > 1)
+                {
+                    ctx.nhg_ref = NextHopGroupKeyRef(m_nhgKeyIndex, nhg);
+                }
+
                 sai_route_entry_t route_entry;
                 route_entry.vr_id = vrf_id;
                 route_entry.switch_id = gSwitchId;
@@ -1052,6 +1094,8 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                     {
                         if (addRoute(ctx, nhg))
                             it = consumer.m_toSync.erase(it);
+                        else if (ctx.has_retry_constraint)
+                            it = consumer.addToRetry(it, ctx.retry_constraint);
                         else
                             it++;
                     }
@@ -1063,12 +1107,14 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                  */
                 else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
                     m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
-                    m_syncdRoutes.at(vrf_id).at(ip_prefix) != RouteNhg(nhg, ctx.nhg_index, ctx.context_index) ||
+                    m_syncdRoutes.at(vrf_id).at(ip_prefix) != RouteNhg(nhg, ctx.nhg_index, ctx.context_index, ctx.nhg_ref.id()) ||
                     gRouteBulker.bulk_entry_pending_removal(route_entry) ||
                     ctx.using_temp_nhg)
                 {
                     if (addRoute(ctx, nhg))
                         it = consumer.m_toSync.erase(it);
+                    else if (ctx.has_retry_constraint)
+                        it = consumer.addToRetry(it, ctx.retry_constraint);
                     else
                         it++;
                 }
@@ -1102,12 +1148,15 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             }
         }
 
+        nhgMemberBatch.close();
+
         // Flush the route bulker, so routes will be written to syncd and ASIC
         gRouteBulker.flush();
 
         // Go through the bulker results
         auto it_prev = consumer.m_toSync.begin();
-        m_bulkNhgReducedRefCnt.clear();
+        /* Emptied by removeBulkNhgReducedRefCnt(), each entry holds a reference on its id */
+        assert(m_bulkNhgReducedRefCnt.empty());
         NextHopGroupKey v4_default_nhg_key;
         NextHopGroupKey v6_default_nhg_key;
         m_bulkSrv6NhgReducedVec.clear();
@@ -1167,7 +1216,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 }
                 else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
                          m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
-                         m_syncdRoutes.at(vrf_id).at(ip_prefix) != RouteNhg(nhg, ctx.nhg_index, ctx.context_index) ||
+                         m_syncdRoutes.at(vrf_id).at(ip_prefix) != RouteNhg(nhg, ctx.nhg_index, ctx.context_index, ctx.nhg_ref.id()) ||
                          gRouteBulker.bulk_entry_pending_removal(route_entry) ||
                          ctx.using_temp_nhg)
                 {
@@ -1202,28 +1251,17 @@ void RouteOrch::doTask(ConsumerBase& consumer)
         }
 
         /* Remove next hop group if the reference count decreases to zero */
-        for (auto& it_nhg : m_bulkNhgReducedRefCnt)
-        {
-            if (it_nhg.first.is_overlay_nexthop() && it_nhg.second != 0)
-            {
-                removeOverlayNextHops(it_nhg.second, it_nhg.first);
-            }
-            else if (m_syncdNextHopGroups[it_nhg.first].ref_count == 0)
-            {
-                // Pass the flag to indicate if the NextHop Group as Default Route NH Members as swapped.
-                removeNextHopGroup(it_nhg.first, m_syncdNextHopGroups[it_nhg.first].is_default_route_nh_swap);
-            }
-        }
+        removeBulkNhgReducedRefCnt();
         /* Reduce reference for srv6 next hop group */
         /* Later delete for increase refcnt early */
         if (!m_bulkSrv6NhgReducedVec.empty())
         {
             m_srv6Orch->removeSrv6Nexthops(m_bulkSrv6NhgReducedVec);
         }
-        /* No Update to Default Route so we can return */
+        /* No Update to Default Route, go on with the routes left after a flush_due() break */
         if (!(v4_default_nhg_key.getSize()) && !(v6_default_nhg_key.getSize()))
         {
-            return;
+            continue;
         }
 	/* Update to v4 Default Route so update the data structure */
         if (v4_default_nhg_key.getSize())
@@ -1236,6 +1274,28 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             updateDefaultRouteSwapSet(v6_default_nhg_key, v6_active_default_route_nhops);
         }
     }
+
+    exportBulkerStats();
+}
+
+/* Write the statistics of the route bulkers to COUNTERS_DB, at most once per interval */
+void RouteOrch::exportBulkerStats()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_lastBulkerStatsExport < std::chrono::seconds(ROUTE_BULKER_STATS_INTERVAL_SEC))
+    {
+        return;
+    }
+    m_lastBulkerStatsExport = now;
+
+    if (!m_bulkerStatsTable)
+    {
+        m_countersDb = std::make_shared<DBConnector>("COUNTERS_DB", 0);
+        m_bulkerStatsTable = std::make_unique<Table>(m_countersDb.get(), BULKER_STATS_TABLE);
+    }
+
+    m_bulkerStatsTable->set("ROUTE", gRouteBulker.stats().getFieldValues());
+    m_bulkerStatsTable->set("LABEL_ROUTE", gLabelRouteBulker.stats().getFieldValues());
 }
 
 void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPrefix &prefix, const NextHopGroupKey &nexthops, bool add)
@@ -1319,7 +1379,7 @@ void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPre
     }
 }
 
-void RouteOrch::increaseNextHopRefCount(const NextHopGroupKey &nexthops)
+void RouteOrch::increaseNextHopRefCount(const NextHopGroupKey &nexthops, NhgKeyId nhg_id)
 {
     /* Return when there is no next hop (dropped) */
     if (nexthops.getSize() == 0)
@@ -1336,12 +1396,18 @@ void RouteOrch::increaseNextHopRefCount(const NextHopGroupKey &nexthops)
     }
     else
     {
-        m_syncdNextHopGroups[nexthops].ref_count ++;
-        SWSS_LOG_INFO("Routeorch inc Ref count %u for next_hops: %s", m_syncdNextHopGroups[nexthops].ref_count, nexthops.to_string().c_str());
+        NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(getNhgKeyId(nexthops, nhg_id));
+        if (nhg_entry == nullptr)
+        {
+            SWSS_LOG_ERROR("Failed to increase the ref count of next hop group %s, not found", nexthops.to_string().c_str());
+            return;
+        }
+        nhg_entry->ref_count ++;
+        SWSS_LOG_INFO("Routeorch inc Ref count %u for next_hops: %s", nhg_entry->ref_count, nexthops.to_string().c_str());
     }
 }
 
-void RouteOrch::decreaseNextHopRefCount(const NextHopGroupKey &nexthops)
+void RouteOrch::decreaseNextHopRefCount(const NextHopGroupKey &nexthops, NhgKeyId nhg_id)
 {
     /* Return when there is no next hop (dropped) */
     if (nexthops.getSize() == 0)
@@ -1358,19 +1424,99 @@ void RouteOrch::decreaseNextHopRefCount(const NextHopGroupKey &nexthops)
     }
     else
     {
-        m_syncdNextHopGroups[nexthops].ref_count --;
-        SWSS_LOG_INFO("Routeorch dec Ref count %u for next_hops: %s", m_syncdNextHopGroups[nexthops].ref_count, nexthops.to_string().c_str());
+        NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(getNhgKeyId(nexthops, nhg_id));
+        if (nhg_entry == nullptr)
+        {
+            SWSS_LOG_ERROR("Failed to decrease the ref count of next hop group %s, not found", nexthops.to_string().c_str());
+            return;
+        }
+        nhg_entry->ref_count --;
+        SWSS_LOG_INFO("Routeorch dec Ref count %u for next_hops: %s", nhg_entry->ref_count, nexthops.to_string().c_str());
     }
 }
 
 bool RouteOrch::isRefCounterZero(const NextHopGroupKey &nexthops) const
 {
-    if (!hasNextHopGroup(nexthops))
+    NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(getNhgKeyId(nexthops, NHG_KEY_ID_INVALID));
+
+    return nhg_entry == nullptr || nhg_entry->ref_count == 0;
+}
+
+/*
+ * Interned id of the next hops of a route. The id taken when the route was
+ * parsed is used if they are the route's own next hops.
+ */
+NhgKeyId RouteOrch::getNhgKeyId(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops) const
+{
+    if (&nextHops == &ctx.nhg && ctx.nhg_ref.id() != NHG_KEY_ID_INVALID)
     {
-        return true;
+        return ctx.nhg_ref.id();
+    }
+
+    return m_nhgKeyIndex.find(nextHops);
+}
+
+/*
+ * Interned id of next hops whose id was kept by the route, or looked up if
+ * not, for the callers outside of the route path.
+ */
+NhgKeyId RouteOrch::getNhgKeyId(const NextHopGroupKey &nextHops, NhgKeyId nhg_id) const
+{
+    return nhg_id != NHG_KEY_ID_INVALID ? nhg_id : m_nhgKeyIndex.find(nextHops);
+}
+
+NextHopGroupEntry *RouteOrch::getNextHopGroupEntry(NhgKeyId nhg_id) const
+{
+    return nhg_id < m_nhgEntries.size() ? m_nhgEntries[nhg_id] : nullptr;
+}
+
+/*
+ * Queue a next hop group for the check at the end of the bulk pass, holding
+ * its interned id until then.
+ */
+void RouteOrch::addBulkNhgReducedRefCnt(const NextHopGroupKey &nextHops, NhgKeyId nhg_id, sai_object_id_t vrf_id)
+{
+    if (nhg_id == NHG_KEY_ID_INVALID)
+    {
+        nhg_id = m_nhgKeyIndex.intern(nextHops);
+    }
+    else
+    {
+        m_nhgKeyIndex.ref(nhg_id);
     }
 
-    return m_syncdNextHopGroups.at(nexthops).ref_count == 0;
+    if (!m_bulkNhgReducedRefCnt.emplace(nhg_id, vrf_id).second)
+    {
+        m_nhgKeyIndex.release(nhg_id);
+    }
+}
+
+/* Remove the next hop groups whose reference count decreased to zero in the bulk pass */
+void RouteOrch::removeBulkNhgReducedRefCnt()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& it_nhg : m_bulkNhgReducedRefCnt)
+    {
+        const NextHopGroupKey &nexthops = m_nhgKeyIndex.getKey(it_nhg.first);
+        NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(it_nhg.first);
+
+        if (nexthops.is_overlay_nexthop() && it_nhg.second != 0)
+        {
+            removeOverlayNextHops(it_nhg.second, nexthops);
+        }
+        else if (nhg_entry && nhg_entry->ref_count == 0)
+        {
+            // Pass the flag to indicate if the NextHop Group as Default Route NH Members as swapped.
+            removeNextHopGroup(nexthops, nhg_entry->is_default_route_nh_swap);
+        }
+    }
+
+    for (auto& it_nhg : m_bulkNhgReducedRefCnt)
+    {
+        m_nhgKeyIndex.release(it_nhg.first);
+    }
+    m_bulkNhgReducedRefCnt.clear();
 }
 
 const NextHopGroupKey RouteOrch::getSyncdRouteNhgKey(sai_object_id_t vrf_id, const IpPrefix& ipPrefix)
@@ -1441,7 +1587,7 @@ bool RouteOrch::removeFineGrainedNextHopGroup(sai_object_id_t &next_hop_group_id
     return true;
 }
 
-bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
+bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops, NhgKeyId nhg_id)
 {
     SWSS_LOG_ENTER();
 
@@ -1548,65 +1694,54 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
     next_hop_group_entry.next_hop_group_id = next_hop_group_id;
     next_hop_group_entry.nh_member_install_count = 0;
 
-    size_t npid_count = next_hop_ids.size();
-    vector<sai_object_id_t> nhgm_ids(npid_count);
-    for (size_t i = 0; i < npid_count; i++)
-    {
-        auto nhid = next_hop_ids[i];
-        auto weight = nhopgroup_members_set[nhid].weight;
-
-        // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
-
-        sai_attribute_t nhgm_attr;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhid;
-        nhgm_attrs.push_back(nhgm_attr);
+    /*
+     * Initialize the next hop group structure with ref_count as 0. This
+     * count will increase once the route is successfully syncd.
+     */
+    next_hop_group_entry.ref_count = 0;
 
-        if (weight)
-        {
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
-            nhgm_attr.value.s32 = weight;
-            nhgm_attrs.push_back(nhgm_attr);
-        }
+    /* The group holds a reference on the interned id of its next hops */
+    if (nhg_id == NHG_KEY_ID_INVALID)
+    {
+        nhg_id = m_nhgKeyIndex.intern(nexthops);
+    }
+    else
+    {
+        m_nhgKeyIndex.ref(nhg_id);
+    }
+    next_hop_group_entry.key_id = nhg_id;
 
-        if (m_switchOrch->checkOrderedEcmpEnable())
-        {
-            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_SEQUENCE_ID;
-            nhgm_attr.value.u32 = ((uint32_t)i) + 1; // To make non-zero sequence id
-            nhgm_attrs.push_back(nhgm_attr);
-        }
+    auto &nhg_entry = m_syncdNextHopGroups[nexthops];
+    nhg_entry = next_hop_group_entry;
+    if (m_nhgEntries.size() <= nhg_id)
+    {
+        m_nhgEntries.resize(nhg_id + 1, nullptr);
+    }
+    m_nhgEntries[nhg_id] = &nhg_entry;
 
-        gNextHopGroupMemberBulker.create_entry(&nhgm_ids[i],
-                                                 (uint32_t)nhgm_attrs.size(),
-                                                 nhgm_attrs.data());
+    /* Increment the ref_count for the valid next hops used by the next hop group. */
+    for (auto it : valid_next_hops_for_refcount)
+    {
+        m_neighOrch->increaseNextHopRefCount(it);
     }
 
-    gNextHopGroupMemberBulker.flush();
-    for (size_t i = 0; i < npid_count; i++)
+    /*
+     * Queue the members on the shared member bulker. In a route task pass
+     * they are created together with the members of the other groups, before
+     * the routes are programmed. A member which fails is retried on its own,
+     * without removing the group or its other members.
+     */
+    for (size_t i = 0; i < next_hop_ids.size(); i++)
     {
         auto nhid = next_hop_ids[i];
-        auto nhgm_id = nhgm_ids[i];
-        if (nhgm_id == SAI_NULL_OBJECT_ID)
-        {
-            // TODO: do we need to clean up?
-            SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member %" PRIx64 ": %d\n",
-                           next_hop_group_id, nhgm_ids[i], status);
-            return false;
-        }
-
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        NextHopGroupPendingMember member = { nhid, ((uint32_t)i) + 1, false };
+        NextHopKey nexthop;
 
         // Save the membership into next hop structure
         if (nhopgroup_shared_set.find(nhid) != nhopgroup_shared_set.end())
         {
             auto it = nhopgroup_shared_set[nhid].begin();
-            next_hop_group_entry.nhopgroup_members[*it].next_hop_id = nhgm_id;
-            next_hop_group_entry.nhopgroup_members[*it].seq_id = (uint32_t)i + 1;
+            nexthop = *it;
             nhopgroup_shared_set[nhid].erase(it);
             if (nhopgroup_shared_set[nhid].empty())
             {
@@ -1615,27 +1750,143 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
         }
         else
         {
-            next_hop_group_entry.nhopgroup_members[nhopgroup_members_set.find(nhid)->second].next_hop_id = nhgm_id;
-            next_hop_group_entry.nhopgroup_members[nhopgroup_members_set.find(nhid)->second].seq_id = ((uint32_t)i) + 1;
+            nexthop = nhopgroup_members_set.find(nhid)->second;
             /* Keep the count of number of nexthop members are present in Nexthop Group*/
-            next_hop_group_entry.nh_member_install_count++;
+            member.counted = true;
         }
+
+        queueNextHopGroupMember(nexthops, next_hop_group_id, nexthop, member);
     }
 
-    /* Increment the ref_count for the valid next hops used by the next hop group. */
-    for (auto it : valid_next_hops_for_refcount)
+    gNextHopGroupMemberBulker.commit();
+
+    return true;
+}
+
+void RouteOrch::queueNextHopGroupMember(const NextHopGroupKey &nexthops, sai_object_id_t next_hop_group_id,
+                                        const NextHopKey &nexthop, const NextHopGroupPendingMember &member)
+{
+    SWSS_LOG_ENTER();
+
+    // Create a next hop group member
+    vector<sai_attribute_t> nhgm_attrs;
+
+    sai_attribute_t nhgm_attr;
+    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+    nhgm_attr.value.oid = next_hop_group_id;
+    nhgm_attrs.push_back(nhgm_attr);
+
+    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+    nhgm_attr.value.oid = member.next_hop_id;
+    nhgm_attrs.push_back(nhgm_attr);
+
+    if (nexthop.weight)
     {
-        m_neighOrch->increaseNextHopRefCount(it);
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+        nhgm_attr.value.s32 = nexthop.weight;
+        nhgm_attrs.push_back(nhgm_attr);
     }
 
-    /*
-     * Initialize the next hop group structure with ref_count as 0. This
-     * count will increase once the route is successfully syncd.
-     */
-    next_hop_group_entry.ref_count = 0;
-    m_syncdNextHopGroups[nexthops] = next_hop_group_entry;
+    if (m_switchOrch->checkOrderedEcmpEnable())
+    {
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_SEQUENCE_ID;
+        nhgm_attr.value.u32 = member.seq_id; // To make non-zero sequence id
+        nhgm_attrs.push_back(nhgm_attr);
+    }
 
-    return true;
+    gNextHopGroupMemberBulker.createMember(nhgm_attrs,
+        [this, nexthops, next_hop_group_id, nexthop, member](sai_object_id_t nhgm_id)
+        {
+            /* The group was removed while its member was queued */
+            auto nhg_it = m_syncdNextHopGroups.find(nexthops);
+            if (nhg_it == m_syncdNextHopGroups.end() || nhg_it->second.next_hop_group_id != next_hop_group_id)
+            {
+                if (nhgm_id != SAI_NULL_OBJECT_ID)
+                {
+                    sai_next_hop_group_api->remove_next_hop_group_member(nhgm_id);
+                }
+                return;
+            }
+
+            auto &entry = nhg_it->second;
+            if (nhgm_id == SAI_NULL_OBJECT_ID)
+            {
+                SWSS_LOG_ERROR("Failed to create next hop group %s member %s, retrying it",
+                               nexthops.to_string().c_str(), nexthop.to_string().c_str());
+                /* Not created, there is nothing to remove */
+                entry.nhopgroup_members[nexthop].next_hop_id = SAI_NULL_OBJECT_ID;
+                entry.nhopgroup_members[nexthop].seq_id = member.seq_id;
+                entry.pending_members[nexthop] = member;
+                m_nhgPendingMembers.insert(nexthops);
+                return;
+            }
+
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+            entry.pending_members.erase(nexthop);
+            entry.nhopgroup_members[nexthop].next_hop_id = nhgm_id;
+            entry.nhopgroup_members[nexthop].seq_id = member.seq_id;
+            if (member.counted)
+            {
+                entry.nh_member_install_count++;
+            }
+        });
+}
+
+/*
+ * Create again the members which failed to be created. The members whose
+ * next hop went away or down in the meantime are dropped, as they are added
+ * back by validnexthopinNextHopGroup().
+ */
+void RouteOrch::retryNextHopGroupMembers()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_nhgPendingMembers.empty())
+    {
+        return;
+    }
+
+    std::set<NextHopGroupKey> groups;
+    groups.swap(m_nhgPendingMembers);
+
+    for (const auto &nexthops : groups)
+    {
+        auto nhg_it = m_syncdNextHopGroups.find(nexthops);
+        if (nhg_it == m_syncdNextHopGroups.end())
+        {
+            continue;
+        }
+
+        NextHopGroupPendingMembers pending;
+        pending.swap(nhg_it->second.pending_members);
+
+        for (const auto &it : pending)
+        {
+            if (!m_neighOrch->hasNextHop(it.first) || m_neighOrch->isNextHopFlagSet(it.first, NHFLAGS_IFDOWN))
+            {
+                continue;
+            }
+
+            /* The neighbor may have been created again in the meantime */
+            NextHopGroupPendingMember member = it.second;
+            member.next_hop_id = m_neighOrch->getNextHopId(it.first);
+
+            /* Until the member is created, it's still pending */
+            nhg_it->second.pending_members[it.first] = member;
+            queueNextHopGroupMember(nexthops, nhg_it->second.next_hop_group_id, it.first, member);
+        }
+    }
+
+    gNextHopGroupMemberBulker.commit();
+}
+
+void RouteOrch::doTask()
+{
+    SWSS_LOG_ENTER();
+
+    retryNextHopGroupMembers();
+
+    Orch::doTask();
 }
 
 bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool is_default_route_nh_swap)
@@ -1655,6 +1906,10 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
         return true;
     }
 
+    /* Complete the members still queued, so all of them are removed */
+    gNextHopGroupMemberBulker.flush();
+    next_hop_group_entry->second.pending_members.clear();
+
     next_hop_group_id = next_hop_group_entry->second.next_hop_group_id;
     SWSS_LOG_NOTICE("Delete next hop group %s", nexthops.to_string().c_str());
 
@@ -1675,6 +1930,13 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
             continue;
         }
 
+        /* The member failed to be created */
+        if (nhop->second.next_hop_id == SAI_NULL_OBJECT_ID)
+        {
+            nhop = nhgm.erase(nhop);
+            continue;
+        }
+
         next_hop_ids.push_back(nhop->second.next_hop_id);
         nhop = nhgm.erase(nhop);
     }
@@ -1683,8 +1945,10 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
     vector<sai_status_t> statuses(nhid_count);
     for (size_t i = 0; i < nhid_count; i++)
     {
-        gNextHopGroupMemberBulker.remove_entry(&statuses[i], next_hop_ids[i]);
+        gNextHopGroupMemberBulker.removeMember(next_hop_ids[i],
+            [&statuses, i](sai_status_t status) { statuses[i] = status; });
     }
+    /* The group is removed right after, its members can't wait for the end of the pass */
     gNextHopGroupMemberBulker.flush();
     for (size_t i = 0; i < nhid_count; i++)
     {
@@ -1769,8 +2033,20 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
             m_neighOrch->decreaseNextHopRefCount(nhop->first);
         }
     }
- 
-    m_syncdNextHopGroups.erase(nexthops);
+
+    NhgKeyId nhg_id = next_hop_group_entry->second.key_id;
+    if (nhg_id != NHG_KEY_ID_INVALID)
+    {
+        m_nhgEntries[nhg_id] = nullptr;
+    }
+
+    m_syncdNextHopGroups.erase(next_hop_group_entry);
+
+    /* Last, nexthops may be the interned key */
+    if (nhg_id != NHG_KEY_ID_INVALID)
+    {
+        m_nhgKeyIndex.release(nhg_id);
+    }
 
     return true;
 }
@@ -2101,6 +2377,10 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                     SWSS_LOG_INFO("Failed to get next hop %s for %s, resolving neighbor",
                             nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
                     m_neighOrch->resolveNeighbor(nexthop);
+
+                    /* Wait for NeighOrch to add the neighbor */
+                    ctx.retry_constraint = Constraint(RETRY_CST_NEIGH, NextHopKey(nexthop.ip_address, nexthop.alias).to_string());
+                    ctx.has_retry_constraint = true;
                     return false;
                 }
             }
@@ -2124,10 +2404,12 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
         }
 
         /* Check if there is already an existing next hop group */
-        if (!hasNextHopGroup(nextHops))
+        NhgKeyId nhg_id = getNhgKeyId(ctx, nextHops);
+        NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(nhg_id);
+        if (nhg_entry == nullptr)
         {
             /* Try to create a new next hop group */
-            if (!addNextHopGroup(nextHops))
+            if (!addNextHopGroup(nextHops, nhg_id))
             {
                 /* If the nexthop is a srv6 nexthop, not create tempRoute
                  * retry to add route */
@@ -2195,12 +2477,13 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             {
                 /* Nexthop Creation Successful. So the save the state if eligible to fallback to default route
                  * based on APP_DB value for the route. Also initialize the present to False as swap did not happen */
-                m_syncdNextHopGroups[nextHops].eligible_for_default_route_nh_swap = ctx.fallback_to_default_route;
-                m_syncdNextHopGroups[nextHops].is_default_route_nh_swap = false;
+                nhg_entry = &m_syncdNextHopGroups.at(nextHops);
+                nhg_entry->eligible_for_default_route_nh_swap = ctx.fallback_to_default_route;
+                nhg_entry->is_default_route_nh_swap = false;
             }
         }
 
-        next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
+        next_hop_id = nhg_entry->next_hop_group_id;
     }
 
     /* Sync the route entry */
@@ -2409,7 +2692,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
     /* The route is pointing to a next hop group */
     else
     {
-        if (!hasNextHopGroup(nextHops))
+        if (getNextHopGroupEntry(getNhgKeyId(ctx, nextHops)) == nullptr)
         {
             // Previous added an temporary route
             auto& tmp_next_hop = ctx.tmp_next_hop;
@@ -2451,16 +2734,15 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         else
         {
             /* Route already exists */
-            auto nh_entry = m_syncdNextHopGroups.find(it_route->second.nhg_key);
-            if (nh_entry != m_syncdNextHopGroups.end())
+            NextHopGroupEntry *nh_entry = getNextHopGroupEntry(it_route->second.nhg_id);
+            if (nh_entry != nullptr)
             {
                 /* Case where route was pointing to non-fine grained nhs in the past,
                  * and transitioned to Fine Grained ECMP */
-                decreaseNextHopRefCount(it_route->second.nhg_key);
-                if (it_route->second.nhg_key.getSize() > 1
-                    && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
+                decreaseNextHopRefCount(it_route->second.nhg_key, it_route->second.nhg_id);
+                if (nh_entry->ref_count == 0)
                 {
-                    m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
+                    addBulkNhgReducedRefCnt(it_route->second.nhg_key, it_route->second.nhg_id, 0);
                 }
             }
             SWSS_LOG_INFO("FG Post set route %s with next hop(s) %s",
@@ -2500,7 +2782,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         /* Increase the ref_count for the next hop group. */
         if (ctx.nhg_index.empty())
         {
-            increaseNextHopRefCount(nextHops);
+            increaseNextHopRefCount(nextHops, getNhgKeyId(ctx, nextHops));
         }
         else
         {
@@ -2558,7 +2840,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         /* Decrease the ref count for the previous next hop group. */
         else if (it_route->second.nhg_index.empty())
         {
-            decreaseNextHopRefCount(it_route->second.nhg_key);
+            decreaseNextHopRefCount(it_route->second.nhg_key, it_route->second.nhg_id);
             auto ol_nextHops = it_route->second.nhg_key;
             if (ol_nextHops.is_srv6_nexthop())
             {
@@ -2566,10 +2848,11 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
             }
             if (ol_nextHops.getSize() > 1)
             {
-                if (m_syncdNextHopGroups[ol_nextHops].ref_count == 0)
+                NextHopGroupEntry *ol_nhg_entry = getNextHopGroupEntry(getNhgKeyId(ol_nextHops, it_route->second.nhg_id));
+                if (ol_nhg_entry == nullptr || ol_nhg_entry->ref_count == 0)
                 {
                     SWSS_LOG_NOTICE("Update Nexthop Group %s", ol_nextHops.to_string().c_str());
-                    m_bulkNhgReducedRefCnt.emplace(ol_nextHops, 0);
+                    addBulkNhgReducedRefCnt(ol_nextHops, it_route->second.nhg_id, 0);
                 }
                 if (mux_orch->isMuxNexthops(ol_nextHops))
                 {
@@ -2591,7 +2874,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
                 if (m_neighOrch->getNextHopRefCount(nexthop) == 0)
                 {
                     SWSS_LOG_NOTICE("Update overlay Nexthop %s", ol_nextHops.to_string().c_str());
-                    m_bulkNhgReducedRefCnt.emplace(ol_nextHops, vrf_id);
+                    addBulkNhgReducedRefCnt(ol_nextHops, NHG_KEY_ID_INVALID, vrf_id);
                 }
             }
             else if (ol_nextHops.getSize() == 1 && !ol_nextHops.is_srv6_nexthop())
@@ -2626,7 +2909,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         if (ctx.nhg_index.empty())
         {
             /* Increase the ref_count for the next hop (group) entry */
-            increaseNextHopRefCount(nextHops);
+            increaseNextHopRefCount(nextHops, getNhgKeyId(ctx, nextHops));
         }
         else
         {
@@ -2669,7 +2952,20 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         gFlowCounterRouteOrch->handleRouteAdd(vrf_id, ipPrefix);
     }
 
-    m_syncdRoutes[vrf_id][ipPrefix] = RouteNhg(nextHops, ctx.nhg_index, ctx.context_index);
+    /*
+     * Keep the interned id only if the route references a RouteOrch's owned
+     * next hop group, the group holds the id as long as the route uses it.
+     */
+    NhgKeyId nhg_id = NHG_KEY_ID_INVALID;
+    if (ctx.nhg_index.empty() && !isFineGrained && nextHops.getSize() > 1)
+    {
+        nhg_id = getNhgKeyId(ctx, nextHops);
+        if (getNextHopGroupEntry(nhg_id) == nullptr)
+        {
+            nhg_id = NHG_KEY_ID_INVALID;
+        }
+    }
+    m_syncdRoutes[vrf_id][ipPrefix] = RouteNhg(nextHops, ctx.nhg_index, ctx.context_index, nhg_id);
 
     /* add subnet decap term for VIP route */
     const SubnetDecapConfig &config = gTunneldecapOrch->getSubnetDecapConfig();
@@ -2866,7 +3162,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         /*
          * Decrease the reference count only when the route is pointing to a next hop.
          */
-        decreaseNextHopRefCount(it_route->second.nhg_key);
+        decreaseNextHopRefCount(it_route->second.nhg_key, it_route->second.nhg_id);
 
         auto ol_nextHops = it_route->second.nhg_key;
 
@@ -2878,10 +3174,11 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
         if (it_route->second.nhg_key.getSize() > 1)
         {
-            if (m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
+            NextHopGroupEntry *nhg_entry = getNextHopGroupEntry(getNhgKeyId(ol_nextHops, it_route->second.nhg_id));
+            if (nhg_entry == nullptr || nhg_entry->ref_count == 0)
             {
                 SWSS_LOG_NOTICE("Remove Nexthop Group %s", ol_nextHops.to_string().c_str());
-                m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
+                addBulkNhgReducedRefCnt(it_route->second.nhg_key, it_route->second.nhg_id, 0);
             }
             if (mux_orch->isMuxNexthops(ol_nextHops))
             {
@@ -2905,7 +3202,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
             if (m_neighOrch->getNextHopRefCount(nexthop) == 0)
             {
                 SWSS_LOG_NOTICE("Remove overlay Nexthop %s", ol_nextHops.to_string().c_str());
-                m_bulkNhgReducedRefCnt.emplace(ol_nextHops, vrf_id);
+                addBulkNhgReducedRefCnt(ol_nextHops, NHG_KEY_ID_INVALID, vrf_id);
             }
         }
         /*
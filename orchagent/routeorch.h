@@ -14,6 +14,8 @@
 #include "ipprefix.h"
 #include "nexthopgroupkey.h"
 #include "bulker.h"
+#include "nhgmemberbulker.h"
+#include "nhgkeyindex.h"
 #include "fgnhgorch.h"
 #include <map>
 #include "zmqorch.h"
@@ -36,12 +38,23 @@ struct NextHopGroupMemberEntry
 
 typedef std::map<NextHopKey, NextHopGroupMemberEntry> NextHopGroupMembers;
 
+/* Member which failed to be created, retried on the next task pass */
+struct NextHopGroupPendingMember
+{
+    sai_object_id_t  next_hop_id;   // next hop sai oid
+    uint32_t         seq_id;        // Sequence Id of nexthop in the group
+    bool             counted;       // Counted in nh_member_install_count once created
+};
+
+typedef std::map<NextHopKey, NextHopGroupPendingMember> NextHopGroupPendingMembers;
+
 struct NhgBase;
 
 struct NextHopGroupEntry
 {
     NextHopGroupEntry() :
         next_hop_group_id(SAI_NULL_OBJECT_ID),
+        key_id(NHG_KEY_ID_INVALID),
         ref_count(0),
         nh_member_install_count(0),
         eligible_for_default_route_nh_swap(false),
@@ -50,9 +63,11 @@ struct NextHopGroupEntry
     }
 
     sai_object_id_t         next_hop_group_id;      // next hop group id
+    NhgKeyId                key_id;                 // interned id of the next hops
     int                     ref_count;              // reference count
     NextHopGroupMembers     nhopgroup_members;      // ids of members indexed by <ip_address, if_alias>
     NextHopGroupMembers     default_route_nhopgroup_members;      // ids of members indexed by <ip_address, if_alias>
+    NextHopGroupPendingMembers pending_members;    // members to be created again, indexed by <ip_address, if_alias>
     uint32_t                nh_member_install_count;
     bool                    eligible_for_default_route_nh_swap;
     bool                    is_default_route_nh_swap;
@@ -83,12 +98,29 @@ struct RouteNhg
 
     std::string context_index;
 
+    /*
+     * Interned ID of nhg_key.  Filled only if the route references a
+     * RouteOrch's owned next hop group, which keeps the ID valid.
+     */
+    NhgKeyId nhg_id = NHG_KEY_ID_INVALID;
+
     RouteNhg() = default;
-    RouteNhg(const NextHopGroupKey& key, const std::string& index, const std::string &context_index = "") :
-        nhg_key(key), nhg_index(index), context_index(context_index) {}
+    RouteNhg(const NextHopGroupKey& key, const std::string& index, const std::string &context_index = "",
+             NhgKeyId id = NHG_KEY_ID_INVALID) :
+        nhg_key(key), nhg_index(index), context_index(context_index), nhg_id(id) {}
+
+    /* Same interned IDs means same next hops, without comparing the keys */
+    bool sameNextHops(const RouteNhg& rnhg) const
+    {
+        if (nhg_id != NHG_KEY_ID_INVALID && rnhg.nhg_id != NHG_KEY_ID_INVALID)
+        {
+            return nhg_id == rnhg.nhg_id;
+        }
+        return nhg_key == rnhg.nhg_key;
+    }
 
     bool operator==(const RouteNhg& rnhg)
-       { return ((nhg_key == rnhg.nhg_key) && (nhg_index == rnhg.nhg_index) && (context_index == rnhg.context_index)); }
+       { return (sameNextHops(rnhg) && (nhg_index == rnhg.nhg_index) && (context_index == rnhg.context_index)); }
     bool operator!=(const RouteNhg& rnhg) { return !(*this == rnhg); }
 };
 
@@ -148,10 +180,17 @@ struct RouteBulkContext
     std::vector<string>                 rmacv;
     bool                                vrf_group_flag;
 
+    // Interned ID of nhg, taken when the route is parsed, for RouteOrch's owned next hop groups
+    NextHopGroupKeyRef                  nhg_ref;
+
     std::string                         key;       // Key in database table
     std::string                         protocol;  // Protocol string
     bool                                is_set;    // True if set operation
 
+    // Resource the route waits for when it can't be added yet
+    bool                                has_retry_constraint = false;
+    Constraint                          retry_constraint;
+
     RouteBulkContext(const std::string& key, bool is_set)
         : key(key), excp_intfs_flag(false), using_temp_nhg(false), is_set(is_set),
           fallback_to_default_route(false)
@@ -167,6 +206,7 @@ struct RouteBulkContext
         object_statuses.clear();
         tmp_next_hop.clear();
         nhg.clear();
+        nhg_ref.reset();
         ipv.clear();
         vrf_id = SAI_NULL_OBJECT_ID;
         excp_intfs_flag = false;
@@ -174,6 +214,7 @@ struct RouteBulkContext
         key.clear();
         protocol.clear();
         fallback_to_default_route = false;
+        has_retry_constraint = false;
     }
 };
 
@@ -209,7 +250,7 @@ struct LabelRouteBulkContext
     }
 };
 
-class RouteOrch : public ZmqOrch, public Subject
+class RouteOrch : public ZmqOrch, public Subject, public Observer
 {
 public:
     RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames, SwitchOrch *switchOrch, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch, FgNhgOrch *fgNhgOrch, Srv6Orch *srv6Orch, swss::ZmqServer *zmqServer = nullptr);
@@ -220,11 +261,13 @@ public:
     void attach(Observer *, const IpAddress&, sai_object_id_t vrf_id = gVirtualRouterId);
     void detach(Observer *, const IpAddress&, sai_object_id_t vrf_id = gVirtualRouterId);
 
-    void increaseNextHopRefCount(const NextHopGroupKey&);
-    void decreaseNextHopRefCount(const NextHopGroupKey&);
+    void update(SubjectType type, void *cntx);
+
+    void increaseNextHopRefCount(const NextHopGroupKey&, NhgKeyId nhg_id = NHG_KEY_ID_INVALID);
+    void decreaseNextHopRefCount(const NextHopGroupKey&, NhgKeyId nhg_id = NHG_KEY_ID_INVALID);
     bool isRefCounterZero(const NextHopGroupKey&) const;
 
-    bool addNextHopGroup(const NextHopGroupKey&);
+    bool addNextHopGroup(const NextHopGroupKey&, NhgKeyId nhg_id = NHG_KEY_ID_INVALID);
     bool removeNextHopGroup(const NextHopGroupKey&, const bool is_default_route_nh_swap=false);
 
     void addNextHopRoute(const NextHopKey&, const RouteKey&);
@@ -259,6 +302,11 @@ public:
     bool checkNextHopGroupCount();
     const RouteTables& getSyncdRoutes() const { return m_syncdRoutes; }
 
+    /* Member bulker shared by the next hop groups of RouteOrch and NhgOrch */
+    NhgMemberBulker& getNhgMemberBulker() { return gNextHopGroupMemberBulker; }
+
+    void doTask() override;
+
 private:
     SwitchOrch *m_switchOrch;
     NeighOrch *m_neighOrch;
@@ -281,8 +329,12 @@ private:
     NextHopGroupTable m_syncdNextHopGroups;
     NextHopRouteTable m_nextHops;
 
-    std::set<std::pair<NextHopGroupKey, sai_object_id_t>> m_bulkNhgReducedRefCnt;
-    /* m_bulkNhgReducedRefCnt: nexthop, vrf_id */
+    std::set<std::pair<NhgKeyId, sai_object_id_t>> m_bulkNhgReducedRefCnt;
+    /* m_bulkNhgReducedRefCnt: interned nexthop id, vrf_id, each holding a reference on the id */
+
+    /* Interned next hop sets of the next hop groups, and the group of each id */
+    NextHopGroupKeyIndex m_nhgKeyIndex;
+    std::vector<NextHopGroupEntry *> m_nhgEntries;
 
     std::set<IpPrefix> m_SubnetDecapTermsCreated;
     ProducerStateTable m_appTunnelDecapTermProducer;
@@ -292,7 +344,14 @@ private:
 
     EntityBulker<sai_route_api_t>           gRouteBulker;
     EntityBulker<sai_mpls_api_t>            gLabelRouteBulker;
-    ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
+
+    std::shared_ptr<DBConnector>            m_countersDb;
+    std::unique_ptr<Table>                  m_bulkerStatsTable;
+    std::chrono::steady_clock::time_point   m_lastBulkerStatsExport;
+    NhgMemberBulker                         gNextHopGroupMemberBulker;
+
+    /* Groups with members in pending_members */
+    std::set<NextHopGroupKey> m_nhgPendingMembers;
 
     void addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
     bool addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
@@ -318,6 +377,15 @@ private:
     bool isVipRoute(const IpPrefix &ipPrefix, const NextHopGroupKey &nextHops);
     void createVipRouteSubnetDecapTerm(const IpPrefix &ipPrefix);
     void removeVipRouteSubnetDecapTerm(const IpPrefix &ipPrefix);
+    NhgKeyId getNhgKeyId(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops) const;
+    NhgKeyId getNhgKeyId(const NextHopGroupKey &nextHops, NhgKeyId nhg_id) const;
+    NextHopGroupEntry *getNextHopGroupEntry(NhgKeyId nhg_id) const;
+    void addBulkNhgReducedRefCnt(const NextHopGroupKey &nextHops, NhgKeyId nhg_id, sai_object_id_t vrf_id);
+    void removeBulkNhgReducedRefCnt();
+    void exportBulkerStats();
+    void queueNextHopGroupMember(const NextHopGroupKey &nexthops, sai_object_id_t next_hop_group_id,
+                                 const NextHopKey &nexthop, const NextHopGroupPendingMember &member);
+    void retryNextHopGroupMembers();
     bool addDefaultRouteNexthopsInNextHopGroup(NextHopGroupEntry& original_next_hop_group, std::set<NextHopKey>& default_route_next_hop_set);
     void updateDefaultRouteSwapSet(const NextHopGroupKey default_nhg_key, std::set<NextHopKey>& active_default_route_nhops);
     void incNhgRefCount(const std::string& nhg_index, const std::string &context_index = "");
@@ -0,0 +1,469 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <iterator>
+#include <functional>
+#include <cstdint>
+
+#include "table.h"
+
+/*
+ * SyncMap holds the pending tasks of a consumer (ConsumerBase::m_toSync).
+ *
+ * It keeps the std::multimap interface orchs use to walk and erase tasks,
+ * with the following layout:
+ *
+ * - Entries are visited in arrival order of their keys, all entries of the
+ *   same key are adjacent and in insertion order (a DEL followed by a SET
+ *   after ConsumerBase::addToSync merging).
+ * - Entries live in a slab (std::deque, so references are stable) linked in
+ *   a doubly linked list. Erased slots are reused, so steady state insertion
+ *   doesn't allocate a node per task.
+ * - Keys are indexed by an open addressing hash table (linear probing)
+ *   pointing to the first entry of each key.
+ *
+ * Entries left in the map after a doTask() pass are parked (see park()).
+ * The entries added or updated since form the "new" set, the parked ones
+ * form the retry set.
+ */
+class SyncMap
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef std::pair<std::string, swss::KeyOpFieldsValuesTuple> value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+private:
+    enum : uint32_t
+    {
+        NIL = UINT32_MAX,
+        SLOT_EMPTY = UINT32_MAX,
+        SLOT_DELETED = UINT32_MAX - 1,
+        INITIAL_INDEX_SIZE = 16
+    };
+
+    struct Node
+    {
+        value_type value;
+        size_t hash = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint64_t generation = 0;
+    };
+
+public:
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef SyncMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const value_type *, value_type *>::type pointer;
+        typedef typename std::conditional<Const, const value_type &, value_type &>::type reference;
+        typedef typename std::conditional<Const, const SyncMap *, SyncMap *>::type map_pointer;
+
+        Iterator() = default;
+        Iterator(map_pointer map, uint32_t idx) : m_map(map), m_idx(idx) {}
+
+        // iterator converts to const_iterator
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false> &other) : m_map(other.m_map), m_idx(other.m_idx) {}
+
+        reference operator*() const { return m_map->m_nodes[m_idx].value; }
+        pointer operator->() const { return &m_map->m_nodes[m_idx].value; }
+
+        Iterator& operator++()
+        {
+            m_idx = m_map->m_nodes[m_idx].next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Iterator& operator--()
+        {
+            m_idx = (m_idx == NIL) ? m_map->m_tail : m_map->m_nodes[m_idx].prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        template <bool C>
+        bool operator==(const Iterator<C> &other) const { return m_idx == other.m_idx; }
+        template <bool C>
+        bool operator!=(const Iterator<C> &other) const { return m_idx != other.m_idx; }
+
+    private:
+        friend class SyncMap;
+        friend class Iterator<!Const>;
+
+        map_pointer m_map = nullptr;
+        uint32_t m_idx = NIL;
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    SyncMap() : m_index(INITIAL_INDEX_SIZE, SLOT_EMPTY) {}
+
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    iterator begin() { return iterator(this, m_head); }
+    iterator end() { return iterator(this, NIL); }
+    const_iterator begin() const { return const_iterator(this, m_head); }
+    const_iterator end() const { return const_iterator(this, NIL); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    iterator find(const std::string &key)
+    {
+        return iterator(this, lookup(key, std::hash<std::string>()(key)));
+    }
+
+    const_iterator find(const std::string &key) const
+    {
+        return const_iterator(this, lookup(key, std::hash<std::string>()(key)));
+    }
+
+    size_t count(const std::string &key) const
+    {
+        size_t n = 0;
+        for (auto it = find(key); it != end() && it->first == key; ++it)
+        {
+            n++;
+        }
+        return n;
+    }
+
+    std::pair<iterator, iterator> equal_range(const std::string &key)
+    {
+        auto first = find(key);
+        auto last = first;
+        while (last != end() && last->first == key)
+        {
+            ++last;
+        }
+        return std::make_pair(first, last);
+    }
+
+    // Insert after the existing entries of the same key, like std::multimap
+    iterator emplace(const std::string &key, const swss::KeyOpFieldsValuesTuple &value)
+    {
+        return insertNode(value_type(key, value));
+    }
+
+    iterator emplace(const std::string &key, swss::KeyOpFieldsValuesTuple &&value)
+    {
+        return insertNode(value_type(key, std::move(value)));
+    }
+
+    iterator insert(const value_type &value)
+    {
+        return insertNode(value_type(value));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        uint32_t idx = pos.m_idx;
+        uint32_t next = m_nodes[idx].next;
+
+        unlinkNode(idx);
+        return iterator(this, next);
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    size_t erase(const std::string &key)
+    {
+        size_t n = 0;
+        auto it = find(key);
+        while (it != end() && it->first == key)
+        {
+            it = erase(it);
+            n++;
+        }
+        return n;
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_index.assign(INITIAL_INDEX_SIZE, SLOT_EMPTY);
+        m_indexUsed = 0;
+        m_head = m_tail = NIL;
+        m_size = 0;
+        m_newCount = 0;
+    }
+
+    // Mark an entry updated in place as new
+    void touch(iterator pos)
+    {
+        auto &node = m_nodes[pos.m_idx];
+        if (node.generation != m_generation)
+        {
+            node.generation = m_generation;
+            m_newCount++;
+        }
+    }
+
+    // Move every entry to the retry set
+    void park()
+    {
+        m_generation++;
+        m_newCount = 0;
+    }
+
+    size_t newSize() const { return m_newCount; }
+    size_t retrySize() const { return m_size - m_newCount; }
+
+private:
+    std::deque<Node> m_nodes;
+    std::vector<uint32_t> m_freeNodes;
+    std::vector<uint32_t> m_index;
+    size_t m_indexUsed = 0;
+
+    uint32_t m_head = NIL;
+    uint32_t m_tail = NIL;
+    size_t m_size = 0;
+
+    uint64_t m_generation = 1;
+    size_t m_newCount = 0;
+
+    size_t probeStart(size_t hash) const { return hash & (m_index.size() - 1); }
+
+    // Returns the first entry of key, or NIL
+    uint32_t lookup(const std::string &key, size_t hash) const
+    {
+        size_t slot = findSlot(key, hash);
+        return slot == m_index.size() ? NIL : m_index[slot];
+    }
+
+    size_t findSlot(const std::string &key, size_t hash) const
+    {
+        size_t mask = m_index.size() - 1;
+        for (size_t slot = probeStart(hash), i = 0; i < m_index.size(); slot = (slot + 1) & mask, i++)
+        {
+            uint32_t idx = m_index[slot];
+            if (idx == SLOT_EMPTY)
+            {
+                break;
+            }
+            if (idx != SLOT_DELETED && m_nodes[idx].hash == hash && m_nodes[idx].value.first == key)
+            {
+                return slot;
+            }
+        }
+        return m_index.size();
+    }
+
+    void addToIndex(uint32_t idx)
+    {
+        if ((m_indexUsed + 1) * 10 > m_index.size() * 7)
+        {
+            rehash();
+        }
+
+        size_t mask = m_index.size() - 1;
+        size_t slot = probeStart(m_nodes[idx].hash);
+        while (m_index[slot] != SLOT_EMPTY && m_index[slot] != SLOT_DELETED)
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (m_index[slot] == SLOT_EMPTY)
+        {
+            m_indexUsed++;
+        }
+        m_index[slot] = idx;
+    }
+
+    void rehash()
+    {
+        size_t keys = 0;
+        for (auto idx : m_index)
+        {
+            if (idx != SLOT_EMPTY && idx != SLOT_DELETED)
+            {
+                keys++;
+            }
+        }
+
+        size_t capacity = INITIAL_INDEX_SIZE;
+        while (capacity < (keys + 1) * 2)
+        {
+            capacity <<= 1;
+        }
+
+        std::vector<uint32_t> old(capacity, SLOT_EMPTY);
+        old.swap(m_index);
+        m_indexUsed = 0;
+
+        size_t mask = capacity - 1;
+        for (auto idx : old)
+        {
+            if (idx == SLOT_EMPTY || idx == SLOT_DELETED)
+            {
+                continue;
+            }
+            size_t slot = probeStart(m_nodes[idx].hash);
+            while (m_index[slot] != SLOT_EMPTY)
+            {
+                slot = (slot + 1) & mask;
+            }
+            m_index[slot] = idx;
+            m_indexUsed++;
+        }
+    }
+
+    uint32_t allocNode(value_type &&value, size_t hash)
+    {
+        uint32_t idx;
+        if (!m_freeNodes.empty())
+        {
+            idx = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            idx = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        auto &node = m_nodes[idx];
+        node.value = std::move(value);
+        node.hash = hash;
+        node.generation = m_generation;
+        m_newCount++;
+        m_size++;
+        return idx;
+    }
+
+    iterator insertNode(value_type &&value)
+    {
+        size_t hash = std::hash<std::string>()(value.first);
+        uint32_t first = lookup(value.first, hash);
+        uint32_t idx = allocNode(std::move(value), hash);
+        auto &node = m_nodes[idx];
+
+        if (first == NIL)
+        {
+            // New key, append at the tail
+            node.prev = m_tail;
+            node.next = NIL;
+            if (m_tail != NIL)
+            {
+                m_nodes[m_tail].next = idx;
+            }
+            else
+            {
+                m_head = idx;
+            }
+            m_tail = idx;
+            addToIndex(idx);
+        }
+        else
+        {
+            // Existing key, insert after its last entry
+            uint32_t last = first;
+            while (m_nodes[last].next != NIL && m_nodes[m_nodes[last].next].hash == hash
+                    && m_nodes[m_nodes[last].next].value.first == node.value.first)
+            {
+                last = m_nodes[last].next;
+            }
+            node.prev = last;
+            node.next = m_nodes[last].next;
+            if (node.next != NIL)
+            {
+                m_nodes[node.next].prev = idx;
+            }
+            else
+            {
+                m_tail = idx;
+            }
+            m_nodes[last].next = idx;
+        }
+
+        return iterator(this, idx);
+    }
+
+    void unlinkNode(uint32_t idx)
+    {
+        auto &node = m_nodes[idx];
+
+        size_t slot = findSlot(node.value.first, node.hash);
+        if (slot != m_index.size() && m_index[slot] == idx)
+        {
+            // The first entry of the key goes away, index the next one if any
+            if (node.next != NIL && m_nodes[node.next].hash == node.hash
+                    && m_nodes[node.next].value.first == node.value.first)
+            {
+                m_index[slot] = node.next;
+            }
+            else
+            {
+                m_index[slot] = SLOT_DELETED;
+            }
+        }
+
+        if (node.prev != NIL)
+        {
+            m_nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            m_head = node.next;
+        }
+        if (node.next != NIL)
+        {
+            m_nodes[node.next].prev = node.prev;
+        }
+        else
+        {
+            m_tail = node.prev;
+        }
+
+        if (node.generation == m_generation)
+        {
+            m_newCount--;
+        }
+        m_size--;
+
+        if (m_size == 0)
+        {
+            clear();
+            return;
+        }
+
+        node.value = value_type();
+        node.prev = node.next = NIL;
+        m_freeNodes.push_back(idx);
+    }
+};
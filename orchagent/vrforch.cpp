@@ -108,6 +108,10 @@ bool VRFOrch::addOperation(const Request& request)
         vrf_table_[vrf_name].ref_count = 0;
         vrf_id_table_[router_id] = vrf_name;
         gFlowCounterRouteOrch->onAddVR(router_id);
+
+        Constraint cst = { RETRY_CST_VRF, vrf_name };
+        notify(SUBJECT_TYPE_RETRY_CONSTRAINT_RESOLVED, static_cast<void *>(&cst));
+
         if (vni != 0)
         {
             SWSS_LOG_INFO("VRF '%s' vni %d add", vrf_name.c_str(), vni);
@@ -2,6 +2,7 @@
 #define __VRFORCH_H
 
 #include "request_parser.h"
+#include "observer.h"
 
 extern sai_object_id_t gVirtualRouterId;
 
@@ -46,7 +47,7 @@ public:
 };
 
 
-class VRFOrch : public Orch2
+class VRFOrch : public Orch2, public Subject
 {
 public:
     VRFOrch(swss::DBConnector *appDb, const std::string& appTableName, swss::DBConnector *stateDb, const std::string& stateTableName) :
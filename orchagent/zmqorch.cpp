@@ -1,32 +1,146 @@
+#include <algorithm>
 #include "zmqorch.h"
+#include "orch_zmq_config.h"
 
 using namespace swss;
 using namespace std;
 
 extern int gBatchSize;
 
+/* Statistics of a table are written to COUNTERS_DB at most once per interval */
+#define ZMQ_STATS_EXPORT_INTERVAL_SEC   1
+#define ZMQ_CONSUMER_STATS_TABLE        "ZMQ_CONSUMER_STATS"
+
+const vector<size_t> ZmqConsumerStats::batchBuckets = { 1, 16, 128, 1024, 8192 };
+
+void ZmqConsumerStats::record(size_t batch, bool limited, size_t queueDepth, chrono::microseconds latency)
+{
+    this->queueDepth = queueDepth;
+    if (batch == 0)
+    {
+        return;
+    }
+
+    executes++;
+    entries += batch;
+    if (limited)
+    {
+        this->limited++;
+    }
+
+    auto bucket = lower_bound(batchBuckets.begin(), batchBuckets.end(), batch);
+    batchHistogram[bucket - batchBuckets.begin()]++;
+
+    latencyTotal += latency;
+    latencyMax = max(latencyMax, latency);
+}
+
+vector<FieldValueTuple> ZmqConsumerStats::getFieldValues() const
+{
+    vector<FieldValueTuple> fvs = {
+        { "executes", to_string(executes) },
+        { "entries", to_string(entries) },
+        { "limited_executes", to_string(limited) },
+        { "queue_depth", to_string(queueDepth) },
+        { "latency_avg_us", to_string(executes ? latencyTotal.count() / static_cast<int64_t>(executes) : 0) },
+        { "latency_max_us", to_string(latencyMax.count()) },
+    };
+
+    for (size_t i = 0; i < batchBuckets.size(); i++)
+    {
+        fvs.emplace_back("batch_le_" + to_string(batchBuckets[i]), to_string(batchHistogram[i]));
+    }
+    fvs.emplace_back("batch_gt_" + to_string(batchBuckets.back()), to_string(batchHistogram.back()));
+
+    return fvs;
+}
+
 void ZmqConsumer::execute()
 {
     SWSS_LOG_ENTER();
 
-    size_t update_size = 0;
+    auto start = chrono::steady_clock::now();
+    size_t popped = takePending();
     auto table = static_cast<swss::ZmqConsumerStateTable*>(getSelectable());
-    do
+    while (m_batchLimit == 0 || popped < m_batchLimit)
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
         table->pops(entries);
-        update_size = addToSync(entries);
-    } while (update_size != 0);
+        if (entries.empty())
+        {
+            break;
+        }
+
+        /* A pop is not capped by the batch limit, the entries over it are kept for the next execute() */
+        if (m_batchLimit != 0 && entries.size() > m_batchLimit - popped)
+        {
+            m_pending.insert(m_pending.end(), make_move_iterator(entries.begin() + (m_batchLimit - popped)),
+                             make_move_iterator(entries.end()));
+            entries.resize(m_batchLimit - popped);
+        }
+        popped += addToSync(entries);
+    }
+
+    /*
+     * With a batch limit, the entries left in the table are taken by a later execute(),
+     * once the other selectables with data had their turn
+     */
+    bool limited = m_batchLimit != 0 && popped >= m_batchLimit && (!m_pending.empty() || table->hasData());
+
+    drainToSync();
+
+    auto now = chrono::steady_clock::now();
+    m_stats.record(popped, limited, m_toSync.size(), chrono::duration_cast<chrono::microseconds>(now - start));
+    if (now - m_lastExport >= chrono::seconds(ZMQ_STATS_EXPORT_INTERVAL_SEC))
+    {
+        m_lastExport = now;
+        (static_cast<ZmqOrch*>(m_orch))->exportStats(*this);
+    }
+}
+
+size_t ZmqConsumer::takePending()
+{
+    if (m_pending.empty())
+    {
+        return 0;
+    }
 
-    drain();
+    size_t count = m_pending.size();
+    if (m_batchLimit != 0)
+    {
+        count = min(count, m_batchLimit);
+    }
+
+    std::deque<KeyOpFieldsValuesTuple> entries(make_move_iterator(m_pending.begin()),
+                                               make_move_iterator(m_pending.begin() + count));
+    m_pending.erase(m_pending.begin(), m_pending.begin() + count);
+    return addToSync(entries);
 }
 
 void ZmqConsumer::drain()
 {
-    if (!m_toSync.empty())
-        (static_cast<ZmqOrch*>(m_orch))->doTask(*this);
+    /*
+     * The entries popped over the batch limit are no longer in the ZMQ table, which does not
+     * signal them again. They are taken here, as the orchs are drained on every select loop.
+     */
+    if (!m_pending.empty())
+    {
+        execute();
+        return;
+    }
+
+    drainToSync();
 }
 
+void ZmqConsumer::drainToSync()
+{
+    if (shouldDrain())
+    {
+        size_t pending = pendingSize();
+        (static_cast<ZmqOrch*>(m_orch))->doTask(*this);
+        parkTasks(pending);
+    }
+}
 
 ZmqOrch::ZmqOrch(DBConnector *db, const vector<string> &tableNames, ZmqServer *zmqServer)
 : Orch()
@@ -52,8 +166,25 @@ void ZmqOrch::addConsumer(DBConnector *db, string tableName, int pri, ZmqServer
     {
         if (zmqServer != nullptr)
         {
-            SWSS_LOG_DEBUG("ZmqConsumer initialize for: %s", tableName.c_str());
-            addExecutor(new ZmqConsumer(new ZmqConsumerStateTable(db, tableName, *zmqServer, gBatchSize, pri), this, tableName));
+            static const auto batchSizes = load_zmq_batch_sizes();
+
+            size_t batchLimit = 0;
+            int popBatchSize = gBatchSize;
+            auto found = batchSizes.find(tableName);
+            if (found != batchSizes.end())
+            {
+                batchLimit = found->second;
+                popBatchSize = static_cast<int>(min(batchLimit, static_cast<size_t>(gBatchSize)));
+            }
+
+            if (!m_statsTable)
+            {
+                m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
+                m_statsTable = make_unique<Table>(m_countersDb.get(), ZMQ_CONSUMER_STATS_TABLE);
+            }
+
+            SWSS_LOG_DEBUG("ZmqConsumer initialize for: %s, batch limit: %zu", tableName.c_str(), batchLimit);
+            addExecutor(new ZmqConsumer(new ZmqConsumerStateTable(db, tableName, *zmqServer, popBatchSize, pri), this, tableName, batchLimit));
         }
         else
         {
@@ -71,4 +202,12 @@ void ZmqOrch::doTask(Consumer &consumer)
 {
     // When ZMQ disabled, forward data from Consumer
     doTask((ConsumerBase &)consumer);
-}
\ No newline at end of file
+}
+
+void ZmqOrch::exportStats(const ZmqConsumer &consumer)
+{
+    if (m_statsTable)
+    {
+        m_statsTable->set(consumer.getName(), consumer.getStats().getFieldValues());
+    }
+}
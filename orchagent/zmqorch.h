@@ -1,14 +1,42 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
 #include <orch.h>
+#include "table.h"
 #include "zmqserver.h"
 
+/*
+ * Statistics of a ZmqConsumer, exported to COUNTERS_DB ZMQ_CONSUMER_STATS:<table>
+ */
+struct ZmqConsumerStats
+{
+    // Upper bounds of the batch size histogram buckets, the last bucket counts the larger batches
+    static const std::vector<size_t> batchBuckets;
+
+    uint64_t executes = 0;
+    uint64_t entries = 0;
+    // Executes which stopped taking entries at the batch limit
+    uint64_t limited = 0;
+    std::vector<uint64_t> batchHistogram = std::vector<uint64_t>(batchBuckets.size() + 1, 0);
+    // Time from taking a batch from the ZMQ table to the end of its doTask
+    std::chrono::microseconds latencyTotal{0};
+    std::chrono::microseconds latencyMax{0};
+    // Entries left in m_toSync after the last doTask
+    size_t queueDepth = 0;
+
+    void record(size_t batch, bool limited, size_t queueDepth, std::chrono::microseconds latency);
+    std::vector<swss::FieldValueTuple> getFieldValues() const;
+};
+
 class ZmqConsumer : public ConsumerBase {
 public:
-    ZmqConsumer(swss::ZmqConsumerStateTable *select, Orch *orch, const std::string &name)
-        : ConsumerBase(select, orch, name)
+    ZmqConsumer(swss::ZmqConsumerStateTable *select, Orch *orch, const std::string &name, size_t batchLimit = 0)
+        : ConsumerBase(select, orch, name),
+          m_batchLimit(batchLimit)
     {
     }
 
@@ -20,6 +48,21 @@ public:
 
     void execute() override;
     void drain() override;
+
+    size_t getBatchLimit() const { return m_batchLimit; }
+    const ZmqConsumerStats &getStats() const { return m_stats; }
+
+private:
+    // Maximum number of entries taken by one execute(), 0 for no limit
+    size_t m_batchLimit;
+    // Entries popped from the ZMQ table over the batch limit, taken first by the next execute()
+    std::deque<swss::KeyOpFieldsValuesTuple> m_pending;
+    ZmqConsumerStats m_stats;
+    std::chrono::steady_clock::time_point m_lastExport;
+
+    // Moves pending entries to m_toSync, up to the batch limit
+    size_t takePending();
+    void drainToSync();
 };
 
 class ZmqOrch : public Orch
@@ -31,6 +74,12 @@ public:
     virtual void doTask(ConsumerBase &consumer) { };
     void doTask(Consumer &consumer) override;
 
+    // Writes the statistics of a consumer to COUNTERS_DB
+    void exportStats(const ZmqConsumer &consumer);
+
 private:
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::unique_ptr<swss::Table> m_statsTable;
+
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri, swss::ZmqServer *zmqServer);
-};
\ No newline at end of file
+};
@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "recordparser.h"
+
+using namespace std;
+
+namespace swss {
+
+/* Next tuple of the record, reusing the one of a previous line when there is one */
+static FieldValueTuple &nextTuple(Record &record)
+{
+	if (record.spare.empty())
+	{
+		record.fvs.emplace_back();
+	}
+	else
+	{
+		record.fvs.push_back(move(record.spare.back()));
+		record.spare.pop_back();
+	}
+
+	return record.fvs.back();
+}
+
+bool parseRecord(const string &line, Record &record)
+{
+	const char *p = line.c_str();
+	const char *end = p + line.size();
+
+	/* Park the tuples of the previous line */
+	while (!record.fvs.empty())
+	{
+		record.spare.push_back(move(record.fvs.back()));
+		record.fvs.pop_back();
+	}
+
+	const char *sep = static_cast<const char *>(memchr(p, '|', end - p));
+	if (!sep)
+	{
+		return false;
+	}
+	record.timestamp = p;
+	record.timestampLen = sep - p;
+	p = sep + 1;
+
+	/* Key, the table name is up to the first ':' */
+	sep = static_cast<const char *>(memchr(p, '|', end - p));
+	if (!sep)
+	{
+		/* e.g. "recording started" */
+		return false;
+	}
+	const char *colon = static_cast<const char *>(memchr(p, ':', sep - p));
+	if (!colon)
+	{
+		return false;
+	}
+	record.table.assign(p, colon - p);
+	record.key.assign(colon + 1, sep - colon - 1);
+	p = sep + 1;
+
+	sep = static_cast<const char *>(memchr(p, '|', end - p));
+	record.op.assign(p, sep ? sep - p : end - p);
+
+	while (sep)
+	{
+		p = sep + 1;
+		sep = static_cast<const char *>(memchr(p, '|', end - p));
+		const char *tupleEnd = sep ? sep : end;
+
+		FieldValueTuple &fv = nextTuple(record);
+
+		colon = static_cast<const char *>(memchr(p, ':', tupleEnd - p));
+		if (colon)
+		{
+			fv.first.assign(p, colon - p);
+			fv.second.assign(colon + 1, tupleEnd - colon - 1);
+		}
+		else
+		{
+			fv.first.assign(p, tupleEnd - p);
+			fv.second.clear();
+		}
+	}
+
+	return true;
+}
+
+int64_t parseTimestamp(const char *ts, size_t len)
+{
+	/* mktime() is only needed when the minute changes */
+	static char lastMinute[16];
+	static int64_t lastMinuteUs = -1;
+
+	struct tm tm = {};
+	int sec;
+	long usec;
+
+	if (len < 26 || sscanf(ts, "%4d-%2d-%2d.%2d:%2d:%2d.%6ld", &tm.tm_year, &tm.tm_mon,
+				&tm.tm_mday, &tm.tm_hour, &tm.tm_min, &sec, &usec) != 7)
+	{
+		return -1;
+	}
+
+	if (lastMinuteUs < 0 || memcmp(lastMinute, ts, sizeof(lastMinute)))
+	{
+		tm.tm_year -= 1900;
+		tm.tm_mon -= 1;
+		tm.tm_isdst = -1;
+		lastMinuteUs = static_cast<int64_t>(mktime(&tm)) * 1000000;
+		memcpy(lastMinute, ts, sizeof(lastMinute));
+	}
+
+	return lastMinuteUs + static_cast<int64_t>(sec) * 1000000 + usec;
+}
+
+}
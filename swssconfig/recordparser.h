@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <table.h>
+
+namespace swss {
+
+/*
+ * A swss.rec line split in place: "timestamp|table:key|op|field:value|..."
+ * The strings are reused from one line to the next to avoid allocations:
+ * the tuples past the fields of the current line are parked in spare,
+ * keeping their buffers, so that fvs only holds the fields of the line.
+ */
+struct Record
+{
+	std::string table;
+	std::string key;
+	std::string op;
+	std::vector<FieldValueTuple> fvs;
+	std::vector<FieldValueTuple> spare;
+	const char *timestamp;
+	size_t timestampLen;
+};
+
+/* Split a recorded line, false if it is not a table record, e.g. "recording started" */
+bool parseRecord(const std::string &line, Record &record);
+
+/* Recorder timestamp "YYYY-MM-DD.HH:MM:SS.uuuuuu" in microseconds, -1 if malformed */
+int64_t parseTimestamp(const char *ts, size_t len);
+
+}
@@ -1,98 +1,180 @@
 #include <fstream>
 #include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <ctime>
+#include <getopt.h>
+#include <limits>
 
 #include <dbconnector.h>
 #include <producerstatetable.h>
+#include <redispipeline.h>
+#include <pubsub.h>
 #include "zmqclient.h"
 #include "zmqproducerstatetable.h"
 #include "orch_zmq_config.h"
+#include "recordparser.h"
 #include <schema.h>
-#include <tokenize.h>
 
 using namespace std;
 using namespace swss;
+using namespace std::chrono;
 
-static int line_index = 0;
+#define DEFAULT_BATCH_SIZE 1000
+#define SETTLE_POLL_INTERVAL 0.1  // 100 milliseconds
+
+static size_t line_index = 0;
+static size_t record_count = 0;
 static DBConnector db("APPL_DB", 0, true);
 
 void usage()
 {
-	cout << "Usage: swssplayer <file>" << endl;
+	cout << "Usage: swssplayer [-b batch_size] [-s speed] [-w settle_ms] <file>" << endl;
+	cout << "       -b batch_size: number of records written per Redis pipeline flush (default " << DEFAULT_BATCH_SIZE << ")" << endl;
+	cout << "       -s speed: replay at the recorded pace scaled by speed, e.g. 2 is twice as fast" << endl;
+	cout << "                 (default 0, replay as fast as possible)" << endl;
+	cout << "       -w settle_ms: after the replay, wait until APPL_STATE_DB has not changed for" << endl;
+	cout << "                     settle_ms and report when the orchagent responses settled" << endl;
 	/* TODO: Add sample input file */
 }
 
-vector<FieldValueTuple> processFieldsValuesTuple(string s)
+shared_ptr<ProducerStateTable> get_table(unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, RedisPipeline &pipeline, const string &table_name, const set<string> &zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
 {
-	vector<FieldValueTuple> result;
+    auto findResult = table_map.find(table_name);
+    if (findResult != table_map.end())
+    {
+        return findResult->second;
+    }
 
-	auto tuples = tokenize(s, '|');
-	for (auto tuple : tuples)
-	{
-		auto v_tuple = tokenize(tuple, ':', 1);
-		auto field = v_tuple[0];
-		auto value = v_tuple.size() == 1 ? "" : v_tuple[1];
-		result.push_back(FieldValueTuple(field, value));
-	}
+    auto client = zmq_tables.find(table_name) != zmq_tables.end() ? zmq_client : nullptr;
+    auto p_table = createProducerStateTable(&pipeline, table_name, true, client);
+    table_map.emplace(table_name, p_table);
 
-	return result;
+    return p_table;
 }
 
-shared_ptr<ProducerStateTable> get_table(unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, string table_name, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
+/* Write a record to its table, false if it is neither a SET nor a DEL */
+bool processRecord(Record &record, RedisPipeline &pipeline, unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, const set<string> &zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
 {
-    shared_ptr<ProducerStateTable> p_table= nullptr;
-    auto findResult = table_map.find(table_name);
-    if (findResult == table_map.end())
-    {
-        if ((zmq_tables.find(table_name) != zmq_tables.end()) && (zmq_client != nullptr)) {
-            p_table = make_shared<ZmqProducerStateTable>(&db, table_name, *zmq_client, true);
-        }
-        else {
-            p_table = make_shared<ProducerStateTable>(&db, table_name);
-        }
+	auto p_producer = get_table(table_map, pipeline, record.table, zmq_tables, zmq_client);
 
-        table_map.emplace(table_name, p_table);
-    }
-    else
-    {
-        p_table = findResult->second;
-    }
+	/* Process the operation */
+	if (record.op == SET_COMMAND)
+	{
+		p_producer->set(record.key, record.fvs, SET_COMMAND);
+	}
+	else if (record.op == DEL_COMMAND)
+	{
+		p_producer->del(record.key, DEL_COMMAND);
+	}
+	else
+	{
+		return false;
+	}
 
-    return p_table;
+	record_count++;
+	return true;
 }
 
-void processTokens(vector<string> tokens, unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
+/*
+ * Track APPL_STATE_DB keyspace events, which orchagent generates when it
+ * publishes the responses to the replayed records.
+ */
+class ResponseWatcher
 {
-	auto key = tokens[1];
+public:
+	void start()
+	{
+		m_thread = thread(&ResponseWatcher::run, this);
+	}
 
-	/* Process the key */
-	auto v_key = tokenize(key, ':', 1);
-	auto table_name = v_key[0];
-	auto key_name = v_key[1];
+	/* Wait until no response has been seen for settle, returns the number of responses */
+	uint64_t settle(milliseconds settle)
+	{
+		while (steady_clock::now() - lastEvent() < settle)
+		{
+			this_thread::sleep_for(milliseconds(10));
+		}
 
-	auto p_producer= get_table(table_map, table_name, zmq_tables, zmq_client);
+		m_stop = true;
+		m_thread.join();
+		return m_events;
+	}
 
-	/* Process the operation */
-	auto op = tokens[2];
-	if (op == SET_COMMAND)
+	steady_clock::time_point lastEvent()
 	{
-		auto tuples = processFieldsValuesTuple(tokens[3]);
-		p_producer->set(key_name, tuples, SET_COMMAND);
+		return steady_clock::time_point(steady_clock::duration(m_lastEvent.load()));
 	}
-	else if (op == DEL_COMMAND)
+
+private:
+	thread m_thread;
+	atomic<bool> m_stop{false};
+	atomic<uint64_t> m_events{0};
+	atomic<steady_clock::rep> m_lastEvent{steady_clock::now().time_since_epoch().count()};
+
+	void run()
 	{
-		p_producer->del(key_name, DEL_COMMAND);
+		DBConnector stateDb("APPL_STATE_DB", 0);
+		PubSub pubsub(&stateDb);
+		pubsub.psubscribe("__keyspace@" + to_string(stateDb.getDbId()) + "__:*");
+
+		while (!m_stop)
+		{
+			auto message = pubsub.get_message(SETTLE_POLL_INTERVAL);
+			if (message.empty() || message["type"] != "pmessage")
+			{
+				continue;
+			}
+
+			m_events++;
+			m_lastEvent = steady_clock::now().time_since_epoch().count();
+		}
 	}
-}
+};
 
 int main(int argc, char **argv)
 {
-	if (argc != 2)
+	int opt;
+	long batch_size = DEFAULT_BATCH_SIZE;
+	double speed = 0;
+	long settle_ms = -1;
+
+	while ((opt = getopt(argc, argv, "b:s:w:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'b':
+			batch_size = atol(optarg);
+			break;
+		case 's':
+			speed = atof(optarg);
+			break;
+		case 'w':
+			settle_ms = atol(optarg);
+			break;
+		case 'h':
+			usage();
+			exit(EXIT_SUCCESS);
+		default: /* '?' */
+			usage();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc - 1 || batch_size <= 0 || speed < 0)
 	{
 		usage();
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
+	ifstream file(argv[optind]);
+	if (!file.is_open())
+	{
+		cerr << "Failed to open " << argv[optind] << endl;
+		exit(EXIT_FAILURE);
+	}
 	string line;
 
     auto zmq_tables = load_zmq_tables();
@@ -102,12 +184,76 @@ int main(int argc, char **argv)
         zmq_client = create_zmq_client(ZMQ_LOCAL_ADDRESS);
     }
 
+    /* Flushed every batch_size records below, not after a number of Redis commands */
+    RedisPipeline pipeline(&db, numeric_limits<size_t>::max());
     unordered_map<string, shared_ptr<ProducerStateTable>> table_map;
+    Record record;
+
+    ResponseWatcher watcher;
+    if (settle_ms >= 0)
+    {
+        watcher.start();
+    }
+
+    auto start = steady_clock::now();
+    int64_t first_ts = -1;
+
 	while (getline(file, line))
 	{
-		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens, table_map, zmq_tables, zmq_client);
-
 		line_index++;
+
+		if (!parseRecord(line, record))
+		{
+			continue;
+		}
+
+		/* Hold the record back until its scaled offset from the first one */
+		if (speed > 0)
+		{
+			int64_t ts = parseTimestamp(record.timestamp, record.timestampLen);
+			if (ts >= 0)
+			{
+				if (first_ts < 0)
+				{
+					first_ts = ts;
+				}
+
+				auto due = start + microseconds(static_cast<int64_t>(static_cast<double>(ts - first_ts) / speed));
+				if (due > steady_clock::now())
+				{
+					pipeline.flush();
+					this_thread::sleep_until(due);
+				}
+			}
+		}
+
+		if (processRecord(record, pipeline, table_map, zmq_tables, zmq_client) &&
+		    record_count % batch_size == 0)
+		{
+			pipeline.flush();
+		}
 	}
+
+    pipeline.flush();
+
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    cout << "Replayed " << record_count << " records from " << line_index << " lines in "
+         << elapsed << " s, " << (elapsed > 0 ? static_cast<double>(record_count) / elapsed : 0)
+         << " records/s" << endl;
+
+    if (settle_ms >= 0)
+    {
+        auto responses = watcher.settle(milliseconds(settle_ms));
+        if (responses == 0)
+        {
+            cout << "No APPL_STATE_DB update seen" << endl;
+        }
+        else
+        {
+            cout << "APPL_STATE_DB settled " << duration<double>(watcher.lastEvent() - start).count()
+                 << " s after replay start, " << responses << " updates" << endl;
+        }
+    }
+
+    return 0;
 }
@@ -0,0 +1,50 @@
+#include <fstream>
+#include <iostream>
+
+#include "recorder.h"
+
+using namespace std;
+using namespace swss;
+
+void usage()
+{
+    cout << "Usage: swssrecconv <binary_file> [text_file]" << endl;
+    cout << "       Convert a binary swss.rec or responsepublisher.rec recording to the" << endl;
+    cout << "       text format, written to text_file or to the standard output." << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    ifstream in(argv[1], ifstream::binary);
+    if (!in.is_open())
+    {
+        cerr << "Failed to open " << argv[1] << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    ofstream file;
+    if (argc == 3)
+    {
+        file.open(argv[2], ofstream::out | ofstream::trunc);
+        if (!file.is_open())
+        {
+            cerr << "Failed to open " << argv[2] << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    ostream &out = argc == 3 ? file : cout;
+    if (!Recorder::toText(in, out))
+    {
+        cerr << argv[1] << " is not a binary recording or is truncated" << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
@@ -1,4 +1,7 @@
 #include "ut_helper.h"
+#define private public
+#include "aclorch.h"
+#undef private
 #include "mock_orchagent_main.h"
 #include "mock_sai_api.h"
 #include "mock_orch_test.h"
@@ -48,6 +51,43 @@ namespace aclorch_rule_test
         } 
     };
 
+    /* Sizes of the ACL bulk calls, which go to the mocked per-object calls */
+    vector<uint32_t> acl_bulk_create_calls;
+    vector<uint32_t> acl_bulk_remove_calls;
+
+    template <sai_status_t (*sai_acl_api_t::*create)(sai_object_id_t *, sai_object_id_t, uint32_t, const sai_attribute_t *)>
+    sai_status_t createAclObjects(GENERIC_BULK_CREATE_PARAMS(acl))
+    {
+        acl_bulk_create_calls.push_back(object_count);
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = (sai_acl_api->*create)(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                object_id[i] = SAI_NULL_OBJECT_ID;
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    template <sai_status_t (*sai_acl_api_t::*remove)(sai_object_id_t)>
+    sai_status_t removeAclObjects(GENERIC_BULK_REMOVE_PARAMS(acl))
+    {
+        acl_bulk_remove_calls.push_back(object_count);
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = (sai_acl_api->*remove)(object_id[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
     struct AclOrchRuleTest : public MockOrchTest
     {   
         unique_ptr<SaiMockState> aclMockState;
@@ -58,6 +98,13 @@ namespace aclorch_rule_test
             INIT_SAI_API_MOCK(next_hop);
             MockSaiApis();
 
+            gAclOrch->gAclCounterBulker.create_entries = createAclObjects<&sai_acl_api_t::create_acl_counter>;
+            gAclOrch->gAclCounterBulker.remove_entries = removeAclObjects<&sai_acl_api_t::remove_acl_counter>;
+            gAclOrch->gAclEntryBulker.create_entries = createAclObjects<&sai_acl_api_t::create_acl_entry>;
+            gAclOrch->gAclEntryBulker.remove_entries = removeAclObjects<&sai_acl_api_t::remove_acl_entry>;
+            acl_bulk_create_calls.clear();
+            acl_bulk_remove_calls.clear();
+
             aclMockState = make_unique<SaiMockState>();
             /* Port init done is a pre-req for Aclorch */
             auto consumer = unique_ptr<Consumer>(new Consumer(
@@ -293,4 +340,120 @@ namespace aclorch_rule_test
         addTunnelNhRule(mock_invalid_nh_ip_str, mock_tunnel_name);
         ASSERT_FALSE(gAclOrch->getAclRule(acl_table, acl_rule));
     }
+
+    struct AclBulkRuleTest : public AclOrchRuleTest
+    {
+        string acl_table_type = "TEST_ACL_BULK_TABLE_TYPE";
+        string acl_table = "TEST_ACL_BULK_TABLE";
+        sai_object_id_t next_entry_oid = 0x8000000000001;
+        string failed_priority;
+
+        void PostSetUp() override
+        {
+            AclOrchRuleTest::PostSetUp();
+
+            doAclTableTypeTask({
+                {
+                    acl_table_type,
+                    SET_COMMAND,
+                    {
+                        { ACL_TABLE_TYPE_MATCHES, MATCH_DST_IP },
+                        { ACL_TABLE_TYPE_ACTIONS, ACTION_PACKET_ACTION }
+                    }
+                }
+            });
+            doAclTableTask({
+                {
+                    acl_table,
+                    SET_COMMAND,
+                    {
+                        { ACL_TABLE_TYPE, acl_table_type },
+                        { ACL_TABLE_STAGE, STAGE_INGRESS },
+                    }
+                }
+            });
+        }
+
+        sai_status_t handleCreate(sai_object_id_t *oid, sai_object_id_t switch_id, uint32_t attr_count, const sai_attribute_t *attr_list)
+        {
+            for (uint32_t i = 0; i < attr_count; ++i)
+            {
+                if (attr_list[i].id == SAI_ACL_ENTRY_ATTR_PRIORITY &&
+                    to_string(attr_list[i].value.u32) == failed_priority)
+                {
+                    return SAI_STATUS_FAILURE;
+                }
+            }
+            *oid = next_entry_oid++;
+            return SAI_STATUS_SUCCESS;
+        }
+
+        KeyOpFieldsValuesTuple rule(const string &name, const string &priority, const string &op = SET_COMMAND)
+        {
+            if (op == DEL_COMMAND)
+            {
+                return { acl_table + "|" + name, DEL_COMMAND, { } };
+            }
+            return {
+                acl_table + "|" + name,
+                SET_COMMAND,
+                {
+                    { RULE_PRIORITY, priority },
+                    { MATCH_DST_IP, "10.0.0." + priority + "/32" },
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP }
+                }
+            };
+        }
+    };
+
+    TEST_F(AclBulkRuleTest, CreateRemoveInOnePass)
+    {
+        EXPECT_CALL(*mock_sai_acl_api, create_acl_entry).Times(3).WillRepeatedly(testing::Invoke(this, &AclBulkRuleTest::handleCreate));
+        doAclRuleTask({ rule("RULE_1", "11"), rule("RULE_2", "12"), rule("RULE_3", "13") });
+
+        /* One bulk call for the counters, then one for the entries */
+        ASSERT_EQ(acl_bulk_create_calls, vector<uint32_t>({ 3, 3 }));
+
+        for (const auto &name : { "RULE_1", "RULE_2", "RULE_3" })
+        {
+            auto aclRule = gAclOrch->getAclRule(acl_table, name);
+            ASSERT_NE(aclRule, nullptr);
+            ASSERT_NE(aclRule->getOid(), SAI_NULL_OBJECT_ID);
+            ASSERT_NE(aclRule->getCounterOid(), SAI_NULL_OBJECT_ID);
+        }
+
+        EXPECT_CALL(*mock_sai_acl_api, remove_acl_entry).Times(3).WillRepeatedly(Return(SAI_STATUS_SUCCESS));
+        doAclRuleTask({ rule("RULE_1", "", DEL_COMMAND), rule("RULE_2", "", DEL_COMMAND), rule("RULE_3", "", DEL_COMMAND) });
+        ASSERT_EQ(acl_bulk_remove_calls, vector<uint32_t>({ 3, 3 }));
+
+        ASSERT_EQ(gAclOrch->getAclRule(acl_table, "RULE_1"), nullptr);
+        ASSERT_EQ(gAclOrch->getAclRule(acl_table, "RULE_2"), nullptr);
+        ASSERT_EQ(gAclOrch->getAclRule(acl_table, "RULE_3"), nullptr);
+    }
+
+    TEST_F(AclBulkRuleTest, PartialFailure)
+    {
+        Table ruleStateTable(m_state_db.get(), STATE_ACL_RULE_TABLE_NAME);
+        string status;
+
+        /* The second rule fails, the rules around it are still installed */
+        failed_priority = "12";
+        EXPECT_CALL(*mock_sai_acl_api, create_acl_entry).Times(3).WillRepeatedly(testing::Invoke(this, &AclBulkRuleTest::handleCreate));
+        doAclRuleTask({ rule("RULE_1", "11"), rule("RULE_2", "12"), rule("RULE_3", "13") });
+
+        ASSERT_NE(gAclOrch->getAclRule(acl_table, "RULE_1"), nullptr);
+        ASSERT_EQ(gAclOrch->getAclRule(acl_table, "RULE_2"), nullptr);
+        ASSERT_NE(gAclOrch->getAclRule(acl_table, "RULE_3"), nullptr);
+
+        ASSERT_TRUE(ruleStateTable.hget(acl_table + "|RULE_1", "status", status));
+        ASSERT_EQ(status, "Active");
+        ASSERT_TRUE(ruleStateTable.hget(acl_table + "|RULE_2", "status", status));
+        ASSERT_EQ(status, "Pending creation");
+
+        EXPECT_CALL(*mock_sai_acl_api, remove_acl_entry).Times(2).WillRepeatedly(Return(SAI_STATUS_SUCCESS));
+        doAclRuleTask({ rule("RULE_1", "", DEL_COMMAND), rule("RULE_3", "", DEL_COMMAND) });
+
+        ASSERT_EQ(gAclOrch->getAclRule(acl_table, "RULE_1"), nullptr);
+        ASSERT_FALSE(ruleStateTable.hget(acl_table + "|RULE_1", "status", status));
+    }
 }
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <hiredis/hiredis.h>
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "schema.h"
+#include "buffercalculator.h"
+
+/*
+ * The expected values are what buffer_headroom_mellanox.lua, buffer_check_headroom_mellanox.lua
+ * and buffer_pool_mellanox.lua return for the same database content
+ */
+extern redisReply *mockReply;
+
+namespace buffercalculator_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct BufferCalculatorTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<DBConnector> m_config_db;
+        shared_ptr<DBConnector> m_state_db;
+        unique_ptr<BufferCalculator> m_calculator;
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<DBConnector>("STATE_DB", 0);
+
+            Table asicTable(m_state_db.get(), "ASIC_TABLE");
+            asicTable.set("MELLANOX-SPECTRUM-3", {
+                {"cell_size", "144"},
+                {"pipeline_latency", "19"},
+                {"mac_phy_delay", "0.8"},
+                {"peer_response_time", "3.8"},
+                {"port_reserved_shp", "2"},
+                {"port_max_shp", "5"}
+            });
+            Table losslessTrafficPatternTable(m_config_db.get(), "LOSSLESS_TRAFFIC_PATTERN");
+            losslessTrafficPatternTable.set("AZURE", {
+                {"mtu", "1024"},
+                {"small_packet_percentage", "100"}
+            });
+
+            m_calculator = BufferCalculator::create("mellanox", m_config_db.get(), m_state_db.get(), m_app_db.get());
+            ASSERT_NE(m_calculator, nullptr);
+
+            SetUpInputTables();
+        }
+
+        // The CONFIG_DB and STATE_DB tables fed by buffermgrd
+        void SetUpInputTables()
+        {
+            m_calculator->setEntry(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, "AZURE", {{"default_dynamic_th", "0"}});
+            m_calculator->setEntry(STATE_BUFFER_MAXIMUM_VALUE_TABLE, "global", {{"mmu_size", "14024640"}});
+            m_calculator->setEntry(STATE_BUFFER_MAXIMUM_VALUE_TABLE, "Ethernet0", {{"max_headroom_size", "500000"}});
+
+            m_calculator->setEntry(CFG_PORT_TABLE_NAME, "Ethernet0", {{"lanes", "0,1,2,3"}, {"admin_status", "up"}});
+            m_calculator->setEntry(CFG_PORT_TABLE_NAME, "Ethernet8", {{"lanes", "8,9,10,11,12,13,14,15"}, {"admin_status", "up"}});
+            m_calculator->setEntry(CFG_PORT_TABLE_NAME, "Ethernet16", {{"lanes", "16,17,18,19"}, {"admin_status", "down"}});
+
+            m_calculator->setEntry(CFG_BUFFER_POOL_TABLE_NAME, "ingress_lossless_pool", {{"type", "ingress"}, {"mode", "dynamic"}});
+            m_calculator->setEntry(CFG_BUFFER_POOL_TABLE_NAME, "egress_lossless_pool", {{"type", "egress"}, {"mode", "dynamic"}, {"size", "14024640"}});
+            m_calculator->setEntry(CFG_BUFFER_POOL_TABLE_NAME, "egress_lossy_pool", {{"type", "egress"}, {"mode", "dynamic"}});
+        }
+
+        void SetUpBufferTables(const string &losslessSize)
+        {
+            // APPL_DB tables are mirrored as buffermgrd writes them
+            BufferApplTable profileTable(m_app_db.get(), APP_BUFFER_PROFILE_TABLE_NAME);
+            BufferApplTable pgTable(m_app_db.get(), APP_BUFFER_PG_TABLE_NAME);
+            BufferApplTable queueTable(m_app_db.get(), APP_BUFFER_QUEUE_TABLE_NAME);
+            BufferApplTable ingressListTable(m_app_db.get(), APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME);
+            BufferApplTable egressListTable(m_app_db.get(), APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME);
+            for (auto table : {&profileTable, &pgTable, &queueTable, &ingressListTable, &egressListTable})
+            {
+                table->setCalculator(m_calculator.get());
+            }
+
+            profileTable.set("ingress_lossy_profile", {{"pool", "ingress_lossless_pool"}, {"size", "0"}, {"dynamic_th", "3"}});
+            profileTable.set("pg_lossless_100000_5m_profile", {{"pool", "ingress_lossless_pool"}, {"xon", "19456"}, {"xoff", "108544"}, {"size", "0"}, {"dynamic_th", "0"}});
+            profileTable.set("pg_lossless_100000_5m_profile", {{"size", losslessSize}});
+            profileTable.set("egress_lossless_profile", {{"pool", "egress_lossless_pool"}, {"size", "0"}, {"dynamic_th", "7"}});
+            profileTable.set("egress_lossy_profile", {{"pool", "egress_lossy_pool"}, {"size", "9216"}, {"dynamic_th", "7"}});
+
+            pgTable.set("Ethernet0:0", {{"profile", "ingress_lossy_profile"}});
+            pgTable.set("Ethernet0:3-4", {{"profile", "pg_lossless_100000_5m_profile"}});
+            pgTable.set("Ethernet8:0", {{"profile", "ingress_lossy_profile"}});
+            pgTable.set("Ethernet16:0", {{"profile", "ingress_lossy_profile"}});
+            pgTable.del("Ethernet16:0");
+
+            queueTable.set("Ethernet0:0-2", {{"profile", "egress_lossy_profile"}});
+            queueTable.set("Ethernet0:3-4", {{"profile", "egress_lossless_profile"}});
+            queueTable.set("Ethernet0:5-6", {{"profile", "egress_lossy_profile"}});
+
+            ingressListTable.set("Ethernet0", {{"profile_list", "ingress_lossy_profile"}});
+            egressListTable.set("Ethernet0", {{"profile_list", "egress_lossless_profile,egress_lossy_profile"}});
+        }
+    };
+
+    TEST_F(BufferCalculatorTest, LuaPluginsAreUsedForOtherVendors)
+    {
+        ASSERT_EQ(BufferCalculator::create("barefoot", m_config_db.get(), m_state_db.get(), m_app_db.get()), nullptr);
+        ASSERT_EQ(BufferCalculator::create("mock_test", m_config_db.get(), m_state_db.get(), m_app_db.get()), nullptr);
+        ASSERT_NE(BufferCalculator::create("vs", m_config_db.get(), m_state_db.get(), m_app_db.get()), nullptr);
+    }
+
+    TEST_F(BufferCalculatorTest, Headroom)
+    {
+        ASSERT_EQ(m_calculator->calculateHeadroom("100000", "5m", "9100", "0", "4"),
+                  vector<string>({"xon:19456", "xoff:108544", "size:128000"}));
+        ASSERT_EQ(m_calculator->calculateHeadroom("400000", "40m", "9100", "0", "8"),
+                  vector<string>({"xon:38912", "xoff:265216", "size:313344"}));
+        // Speed without pause quanta, the peer response time is taken from ASIC_TABLE
+        ASSERT_EQ(m_calculator->calculateHeadroom("30000", "5m", "9100", "0", "4"),
+                  vector<string>({"xon:19456", "xoff:44032", "size:63488"}));
+
+        // Only xon is reserved once the shared headroom pool is enabled
+        m_calculator->setEntry(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, "AZURE", {{"default_dynamic_th", "0"}, {"over_subscribe_ratio", "2"}});
+        ASSERT_EQ(m_calculator->calculateHeadroom("100000", "5m", "9100", "0", "4"),
+                  vector<string>({"xon:19456", "xoff:108544", "size:19456"}));
+
+        ASSERT_TRUE(m_calculator->calculateHeadroom("100000", "5m", "", "0", "4").empty());
+    }
+
+    TEST_F(BufferCalculatorTest, CheckHeadroom)
+    {
+        SetUpBufferTables("128000");
+
+        auto ret = m_calculator->checkHeadroom("Ethernet0", "pg_lossless_100000_5m_profile", "128000", "19456", "108544", "Ethernet0:6");
+        ASSERT_EQ(ret[0], "result:true");
+        ASSERT_EQ(ret[1], "debug:Accumulative headroom on port 447488, the maximum available headroom 500000");
+
+        ret = m_calculator->checkHeadroom("Ethernet0", "pg_lossless_100000_5m_profile", "128000", "19456", "108544", "Ethernet0:5-6");
+        ASSERT_EQ(ret[0], "result:false");
+        ASSERT_EQ(ret[1], "debug:Accumulative headroom on port 575488 exceeds the maximum available headroom which is 500000");
+
+        // No maximum headroom size for the port
+        ASSERT_EQ(m_calculator->checkHeadroom("Ethernet8", "pg_lossless_100000_5m_profile", "128000", "19456", "108544", "Ethernet8:3-4"),
+                  vector<string>({"result:true"}));
+    }
+
+    TEST_F(BufferCalculatorTest, BufferPool)
+    {
+        SetUpBufferTables("128000");
+
+        auto ret = m_calculator->calculateBufferPool();
+        ASSERT_EQ(ret[0], "ingress_lossless_pool:13316032");
+        ASSERT_EQ(ret[1], "egress_lossy_pool:13316032");
+        ASSERT_EQ(ret[2], "debug:mmu_size:14024640");
+        ASSERT_EQ(ret[3], "debug:accumulative size:708608");
+        ASSERT_NE(find(ret.begin(), ret.end(), "debug:BUFFER_PROFILE_TABLE:ingress_lossy_profile:19456:2"), ret.end());
+        ASSERT_NE(find(ret.begin(), ret.end(), "debug:BUFFER_PROFILE_TABLE:ingress_lossy_profile_list:-:1"), ret.end());
+        ASSERT_NE(find(ret.begin(), ret.end(), "debug:extra_8lanes:18432:1:1"), ret.end());
+    }
+
+    TEST_F(BufferCalculatorTest, BufferPoolWithSharedHeadroomPool)
+    {
+        m_calculator->setEntry(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, "AZURE", {{"default_dynamic_th", "0"}, {"over_subscribe_ratio", "2"}});
+        SetUpBufferTables("19456");
+
+        auto ret = m_calculator->calculateBufferPool();
+        ASSERT_EQ(ret[0], "ingress_lossless_pool:13419456:103424");
+        ASSERT_EQ(ret[1], "egress_lossy_pool:13419456");
+        ASSERT_NE(find(ret.begin(), ret.end(), "debug:accumulative xoff:206848"), ret.end());
+    }
+
+    TEST_F(BufferCalculatorTest, BufferPoolKeptIfProfileMissing)
+    {
+        SetUpBufferTables("128000");
+
+        BufferApplTable poolTable(m_app_db.get(), APP_BUFFER_POOL_TABLE_NAME);
+        BufferApplTable pgTable(m_app_db.get(), APP_BUFFER_PG_TABLE_NAME);
+        poolTable.setCalculator(m_calculator.get());
+        pgTable.setCalculator(m_calculator.get());
+
+        poolTable.set("ingress_lossless_pool", {{"type", "ingress"}, {"mode", "dynamic"}, {"size", "12000000"}});
+        pgTable.set("Ethernet0:1", {{"profile", "not_yet_created_profile"}});
+
+        ASSERT_EQ(m_calculator->calculateBufferPool(),
+                  vector<string>({"egress_lossy_pool:0", "ingress_lossless_pool:12000000"}));
+    }
+
+    TEST_F(BufferCalculatorTest, BufferPoolKeptWhileOrchagentIsBusy)
+    {
+        SetUpBufferTables("128000");
+
+        BufferApplTable poolTable(m_app_db.get(), APP_BUFFER_POOL_TABLE_NAME);
+        poolTable.setCalculator(m_calculator.get());
+        poolTable.set("ingress_lossless_pool", {{"type", "ingress"}, {"mode", "dynamic"}, {"size", "12000000"}});
+
+        // BUFFER_PROFILE_TABLE_KEY_SET exists
+        mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+        mockReply->type = REDIS_REPLY_INTEGER;
+        mockReply->integer = 1;
+        auto ret = m_calculator->calculateBufferPool();
+        mockReply = nullptr;
+
+        ASSERT_EQ(ret, vector<string>({"egress_lossy_pool:0", "ingress_lossless_pool:12000000"}));
+    }
+
+    TEST_F(BufferCalculatorTest, LoadedFromApplDb)
+    {
+        SetUpBufferTables("128000");
+        auto pool = m_calculator->calculateBufferPool();
+
+        // Warm restart, the buffer tables are in APPL_DB
+        m_calculator = BufferCalculator::create("mellanox", m_config_db.get(), m_state_db.get(), m_app_db.get());
+        SetUpInputTables();
+        ASSERT_EQ(m_calculator->calculateBufferPool(), pool);
+
+        // A PG written before the restart but not yet handled by orchagent
+        Table pendingPgTable(m_app_db.get(), "_" APP_BUFFER_PG_TABLE_NAME);
+        pendingPgTable.set("Ethernet0:6", {{"profile", "pg_lossless_100000_5m_profile"}});
+
+        m_calculator = BufferCalculator::create("mellanox", m_config_db.get(), m_state_db.get(), m_app_db.get());
+        SetUpInputTables();
+        auto ret = m_calculator->checkHeadroom("Ethernet0", "pg_lossless_100000_5m_profile", "128000", "19456", "108544", "Ethernet0:5");
+        ASSERT_EQ(ret[0], "result:false");
+        ASSERT_EQ(ret[1], "debug:Accumulative headroom on port 575488 exceeds the maximum available headroom which is 500000");
+    }
+}
@@ -1,6 +1,8 @@
 #include "ut_helper.h"
 #include "bulker.h"
 
+#include <thread>
+
 extern sai_route_api_t *sai_route_api;
 extern sai_neighbor_api_t *sai_neighbor_api;
 
@@ -8,6 +10,51 @@ namespace bulker_test
 {
     using namespace std;
 
+    vector<uint32_t> bulk_route_calls;
+
+    sai_status_t create_route_entries_failing_second(
+            uint32_t object_count,
+            const sai_route_entry_t *route_entry,
+            const uint32_t *attr_count,
+            const sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_route_calls.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        if (bulk_route_calls.size() == 2)
+        {
+            object_statuses[0] = SAI_STATUS_FAILURE;
+            return SAI_STATUS_FAILURE;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    bool slow_route_calls = false;
+
+    sai_status_t create_route_entries_paced(
+            uint32_t object_count,
+            const sai_route_entry_t *route_entry,
+            const uint32_t *attr_count,
+            const sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_route_calls.push_back(object_count);
+        if (slow_route_calls)
+        {
+            this_thread::sleep_for(chrono::milliseconds(30));
+        }
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
     struct BulkerTest : public ::testing::Test
     {
         BulkerTest()
@@ -173,4 +220,132 @@ namespace bulker_test
         // Confirm neighbor entry is pending removal
         ASSERT_TRUE(gNeighBulker.bulk_entry_pending_removal(neighbor_entry_remove));
     }
+
+    TEST_F(BulkerTest, BulkerPolicyAndStats)
+    {
+        sai_route_api->create_route_entries = create_route_entries_failing_second;
+        bulk_route_calls.clear();
+
+        EntityBulker<sai_route_api_t> gRouteBulker(sai_route_api, 1000);
+
+        BulkerPolicy policy;
+        policy.max_bulk_size = 2;
+        gRouteBulker.set_policy(policy);
+        ASSERT_EQ(gRouteBulker.max_bulk_size, 2u);
+
+        sai_attribute_t route_attr;
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+        deque<sai_status_t> object_statuses;
+        ASSERT_FALSE(gRouteBulker.flush_due());
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            sai_route_entry_t route_entry = {};
+            route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+            route_entry.destination.addr.ip4 = htonl(0x0a000000 + (i << 8));
+            route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+            object_statuses.emplace_back();
+            gRouteBulker.create_entry(&object_statuses.back(), &route_entry, 1, &route_attr);
+        }
+
+        // More than a bulk call is pending
+        ASSERT_TRUE(gRouteBulker.flush_due());
+
+        gRouteBulker.flush();
+        ASSERT_FALSE(gRouteBulker.flush_due());
+
+        // Entries are split into calls of max_bulk_size
+        ASSERT_EQ(bulk_route_calls, vector<uint32_t>({ 2, 2, 1 }));
+
+        const auto &stats = gRouteBulker.stats();
+        ASSERT_EQ(stats.batches, 3u);
+        ASSERT_EQ(stats.items, 5u);
+        ASSERT_EQ(stats.failures, 1u);
+        ASSERT_DOUBLE_EQ(stats.failure_rate(), 0.2);
+        ASSERT_LE(stats.max_flush_latency.count(), stats.flush_latency.count());
+    }
+
+    TEST_F(BulkerTest, BulkerMaxAge)
+    {
+        EntityBulker<sai_route_api_t> gRouteBulker(sai_route_api, 1000);
+
+        BulkerPolicy policy;
+        policy.max_age = chrono::microseconds(1);
+        gRouteBulker.set_policy(policy);
+
+        sai_route_entry_t route_entry = {};
+        route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        route_entry.destination.addr.ip4 = htonl(0x0a00000f);
+        route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+        sai_status_t object_status;
+        gRouteBulker.remove_entry(&object_status, &route_entry);
+
+        // A single entry is due once it is older than max_age
+        this_thread::sleep_for(chrono::milliseconds(1));
+        ASSERT_TRUE(gRouteBulker.flush_due());
+
+        gRouteBulker.clear();
+        ASSERT_FALSE(gRouteBulker.flush_due());
+    }
+
+    TEST_F(BulkerTest, BulkerLatencyTarget)
+    {
+        sai_route_api->create_route_entries = create_route_entries_paced;
+        bulk_route_calls.clear();
+
+        EntityBulker<sai_route_api_t> gRouteBulker(sai_route_api, 8);
+
+        BulkerPolicy policy;
+        policy.latency_target = chrono::milliseconds(20);
+        policy.min_bulk_size = 2;
+        gRouteBulker.set_policy(policy);
+
+        sai_attribute_t route_attr;
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+        uint32_t next_route = 0;
+        deque<sai_status_t> object_statuses;
+        auto flushRoutes = [&](uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                sai_route_entry_t route_entry = {};
+                route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+                route_entry.destination.addr.ip4 = htonl(0x0a000000 + (next_route++ << 8));
+                route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+                object_statuses.emplace_back();
+                gRouteBulker.create_entry(&object_statuses.back(), &route_entry, 1, &route_attr);
+            }
+            gRouteBulker.flush();
+        };
+
+        // Calls over the target halve the size of the next flush, down to min_bulk_size
+        slow_route_calls = true;
+        flushRoutes(8);
+        ASSERT_EQ(gRouteBulker.stats().bulk_size, 4u);
+        flushRoutes(8);
+        ASSERT_EQ(gRouteBulker.stats().bulk_size, 2u);
+        flushRoutes(4);
+        ASSERT_EQ(gRouteBulker.stats().bulk_size, 2u);
+
+        // Full calls well under the target grow it again
+        slow_route_calls = false;
+        flushRoutes(4);
+        ASSERT_EQ(gRouteBulker.stats().bulk_size, 3u);
+
+        ASSERT_EQ(bulk_route_calls, vector<uint32_t>({ 8, 4, 4, 2, 2, 2, 2 }));
+
+        // The statistics are exported as field values
+        auto fvs = gRouteBulker.stats().getFieldValues();
+        map<string, string> values(fvs.begin(), fvs.end());
+        ASSERT_EQ(values["batches"], "7");
+        ASSERT_EQ(values["items"], "24");
+        ASSERT_EQ(values["failures"], "0");
+        ASSERT_EQ(values["bulk_size"], "3");
+    }
 }
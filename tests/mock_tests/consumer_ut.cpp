@@ -29,6 +29,23 @@ namespace consumer_test
         long m_notification_count;
     };
 
+    // Keeps every task in m_toSync, as if they all needed a retry
+    class RetryTestOrch : public Orch
+    {
+    public:
+        RetryTestOrch(swss::DBConnector *db, string tableName)
+            :Orch(db, tableName)
+        {
+        }
+
+        void doTask(Consumer& consumer)
+        {
+            m_passes++;
+        }
+
+        int m_passes = 0;
+    };
+
     struct ConsumerTest : public ::testing::Test
     {
         shared_ptr<swss::DBConnector> m_app_db;
@@ -368,4 +385,104 @@ namespace consumer_test
         test_consumer.execute();
         ASSERT_EQ(test_orch.m_notification_count, consumer_pops_batch_size*2);
     }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_ArrivalOrder)
+    {
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "b", DEL_COMMAND, { } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f2, v2a } } }));
+
+        // keys in arrival order, DEL then SET for the same key
+        vector<pair<string, string>> expected = {
+            { "b", DEL_COMMAND },
+            { "b", SET_COMMAND },
+            { "a", SET_COMMAND },
+            { "c", SET_COMMAND } };
+
+        auto &sync = consumer->m_toSync;
+        ASSERT_EQ(sync.size(), expected.size());
+        size_t i = 0;
+        for (auto it = sync.begin(); it != sync.end(); it++, i++)
+        {
+            ASSERT_EQ(it->first, expected[i].first);
+            ASSERT_EQ(kfvOp(it->second), expected[i].second);
+        }
+        ASSERT_EQ(sync.count("b"), 2u);
+        ASSERT_EQ(sync.find("d"), sync.end());
+
+        sync.erase("b");
+        ASSERT_EQ(sync.size(), 2u);
+        ASSERT_EQ(sync.begin()->first, "a");
+    }
+
+    TEST_F(ConsumerTest, ConsumerRetryPass)
+    {
+        RetryTestOrch test_orch(m_config_db.get(), "CFG_TEST_TABLE");
+        Consumer test_consumer(
+                new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &test_orch, "CFG_TEST_TABLE");
+
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        ASSERT_EQ(test_consumer.m_toSync.newSize(), 1u);
+
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_passes, 1);
+        ASSERT_EQ(test_consumer.m_toSync.retrySize(), 1u);
+
+        // Nothing changed, the parked task is not retried by the periodic pass
+        ConsumerBase::setRetryPass(true);
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_passes, 1);
+
+        // Progress somewhere else wakes it up once
+        ConsumerBase::notifyProgress();
+        test_consumer.drain();
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_passes, 2);
+
+        // An update of the task makes it new again
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f2, v2a } } }));
+        ASSERT_EQ(test_consumer.m_toSync.size(), 1u);
+        ASSERT_EQ(test_consumer.m_toSync.newSize(), 1u);
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_passes, 3);
+        ConsumerBase::setRetryPass(false);
+
+        // Outside of the periodic pass, drain always runs doTask
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_passes, 4);
+    }
+
+    TEST_F(ConsumerTest, ConsumerRetryCache)
+    {
+        Constraint cst(RETRY_CST_NEIGH, "10.0.0.1@Ethernet0");
+
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f1, v1a } } }));
+
+        // Park "a" until the neighbor is created
+        auto it = consumer->addToRetry(consumer->m_toSync.begin(), cst);
+        ASSERT_EQ(it->first, "b");
+        ASSERT_EQ(consumer->m_toSync.size(), 1u);
+        ASSERT_EQ(consumer->getRetrySize(), 1u);
+
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_EQ(ts.size(), 2u);
+
+        // Unrelated constraint doesn't wake it up
+        ASSERT_EQ(consumer->retryToSync(Constraint(RETRY_CST_NEIGH, "10.0.0.2@Ethernet0")), 0u);
+        ASSERT_EQ(consumer->retryToSync(cst), 1u);
+        ASSERT_EQ(consumer->getRetrySize(), 0u);
+        ASSERT_EQ(consumer->m_toSync.count("a"), 1u);
+
+        // A newer update of a parked task merges with it
+        it = consumer->addToRetry(consumer->m_toSync.find("a"), cst);
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f2, v2a } } }));
+        ASSERT_EQ(consumer->getRetrySize(), 0u);
+        exp_kofv = KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a }, { f2, v2a } } });
+        validate_syncmap(consumer->m_toSync, 2, "a", exp_kofv);
+        ASSERT_EQ(consumer->retryToSync(cst), 0u);
+    }
 }
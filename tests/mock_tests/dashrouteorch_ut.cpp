@@ -8,6 +8,7 @@
 #include "mock_orchagent_main.h"
 #include "mock_sai_api.h"
 #include "mock_dash_orch_test.h"
+#include "orchscheduler.h"
 #include "dash_api/appliance.pb.h"
 #include "dash_api/route_type.pb.h"
 #include "dash_api/eni.pb.h"
@@ -54,4 +55,11 @@ namespace dashrouteorch_test
         AddTunnel();
         AddOutboundRoutingEntry();
     }
+
+    TEST_F(DashRouteOrchTest, NotScheduledWithVnetOrch)
+    {
+        // Routes read the VNET OIDs DashVnetOrch writes
+        EXPECT_TRUE(OrchScheduler::conflicts(m_DashRouteOrch, m_dashVnetOrch));
+        EXPECT_TRUE(OrchScheduler::conflicts(m_DashOrch, m_dashVnetOrch));
+    }
 }
\ No newline at end of file
@@ -42,6 +42,39 @@ namespace fdb_syncd_flush_test
     {
         sai_fdb_api = pold_sai_fdb_api;
     }
+
+    uint32_t bulk_create_count;
+    uint32_t bulk_remove_count;
+
+    sai_status_t _ut_stub_sai_create_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        bulk_create_count++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_remove_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        bulk_remove_count++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
     struct FdbOrchTest : public ::testing::Test
     {   
         std::shared_ptr<swss::DBConnector> m_config_db;
@@ -548,4 +581,64 @@ namespace fdb_syncd_flush_test
         ASSERT_EQ(m_portsOrch->m_portList[VXLAN_REMOTE].m_fdb_count, 1);
         _unhook_sai_fdb_api();
     }
+
+    /* Test FDB entries from APPL_DB are programmed in bulk */
+    TEST_F(FdbOrchTest, BulkAddRemoveFromApplDb)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+
+        sai_fdb_api_t ut_bulk_fdb_api = *sai_fdb_api;
+        ut_bulk_fdb_api.create_fdb_entries = _ut_stub_sai_create_fdb_entries;
+        ut_bulk_fdb_api.remove_fdb_entries = _ut_stub_sai_remove_fdb_entries;
+        m_fdborch->gFdbBulker = EntityBulker<sai_fdb_api_t>(&ut_bulk_fdb_api, 1000);
+        bulk_create_count = 0;
+        bulk_remove_count = 0;
+
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        ASSERT_NE(consumer, nullptr);
+
+        std::deque<KeyOpFieldsValuesTuple> entries = {
+            { "Vlan40:52:54:00:ac:3a:01", SET_COMMAND, { { "port", ETH0 }, { "type", "static" } } },
+            { "Vlan40:52:54:00:ac:3a:02", SET_COMMAND, { { "port", ETH0 }, { "type", "static" } } }
+        };
+        consumer->addToSync(entries);
+        m_fdborch->doTask(*consumer);
+
+        /* Both entries are created by a single bulk call */
+        ASSERT_EQ(bulk_create_count, 1u);
+        ASSERT_EQ(consumer->m_toSync.size(), 0u);
+        ASSERT_EQ(m_fdborch->m_entries.size(), 2u);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 2u);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 2u);
+
+        string port;
+        ASSERT_TRUE(m_fdborch->m_fdbStateTable.hget("Vlan40:52:54:00:ac:3a:01", "port", port));
+        ASSERT_EQ(port, ETH0);
+
+        /* A delete and a re-add of the same MAC are applied in order */
+        entries = {
+            { "Vlan40:52:54:00:ac:3a:01", DEL_COMMAND, { } },
+            { "Vlan40:52:54:00:ac:3a:02", DEL_COMMAND, { } }
+        };
+        consumer->addToSync(entries);
+        entries = {
+            { "Vlan40:52:54:00:ac:3a:01", SET_COMMAND, { { "port", ETH0 }, { "type", "static" } } }
+        };
+        consumer->addToSync(entries);
+        m_fdborch->doTask(*consumer);
+
+        /* The re-add flushes the pending delete first */
+        ASSERT_EQ(bulk_remove_count, 2u);
+        ASSERT_EQ(bulk_create_count, 2u);
+        ASSERT_EQ(consumer->m_toSync.size(), 0u);
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1u);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 1u);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1u);
+        ASSERT_TRUE(m_fdborch->m_fdbStateTable.hget("Vlan40:52:54:00:ac:3a:01", "port", port));
+        ASSERT_FALSE(m_fdborch->m_fdbStateTable.hget("Vlan40:52:54:00:ac:3a:02", "port", port));
+    }
 }
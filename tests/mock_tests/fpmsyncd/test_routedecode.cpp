@@ -0,0 +1,368 @@
+#include "ut_helpers_fpmsyncd.h"
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <netlink/route/route.h>
+#include <swss/netdispatcher.h>
+
+#define private public // Need to modify internal cache
+#include "fpmlink.h"
+#include "routesync.h"
+#undef private
+
+using namespace swss;
+
+extern void resetMockWarmStartHelper();
+
+/*
+ * The raw route decoder (RouteSync::onRouteMsgFast) must produce the same
+ * APPL_DB entries as the libnl path (RouteSync::onMsg) for every route it
+ * accepts. Each test builds a netlink message, runs it through both paths and
+ * compares the resulting tables.
+ */
+namespace ut_fpmsyncd
+{
+    typedef std::map<std::string, std::vector<FieldValueTuple>> TableDump;
+
+    struct RouteNextHop
+    {
+        const char *gateway;
+        int ifindex;
+        uint8_t hops;
+    };
+
+    struct FpmSyncdRouteDecodeTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::RedisPipeline> m_pipeline;
+        std::shared_ptr<RouteSync> m_routeSync;
+
+        void SetUp() override
+        {
+            testing_db::reset();
+            resetMockWarmStartHelper();
+            rtnl_route_read_protocol_names(DefaultRtProtoPath);
+
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_pipeline = std::make_shared<swss::RedisPipeline>(m_app_db.get());
+            m_routeSync = std::make_shared<RouteSync>(m_pipeline.get());
+            m_routeSync->setSuppressionEnabled(true);
+        }
+
+        void TearDown() override
+        {
+            testing_db::reset();
+        }
+
+        /* Build a route message, nexthops go to RTA_MULTIPATH when there are more than one */
+        struct nlmsg *createRoute(uint16_t cmd, int family, const char *dst, uint8_t dst_len,
+                                  std::vector<RouteNextHop> nexthops = {}, uint32_t table = 0,
+                                  uint8_t type = RTN_UNICAST, uint32_t nhg_id = 0)
+        {
+            struct nlmsg *msg = (struct nlmsg *)calloc(1, sizeof(struct nlmsg));
+            unsigned char addr[16] = {0};
+
+            msg->n.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+            msg->n.nlmsg_type = cmd;
+            msg->r.rtm_family = (unsigned char)family;
+            msg->r.rtm_dst_len = dst_len;
+            msg->r.rtm_protocol = RTPROT_BGP;
+            msg->r.rtm_scope = RT_SCOPE_UNIVERSE;
+            msg->r.rtm_type = type;
+
+            unsigned int addr_len = family == AF_INET ? 4 : 16;
+
+            if (dst)
+            {
+                inet_pton(family, dst, addr);
+                nl_attr_put(&msg->n, sizeof(*msg), RTA_DST, addr, addr_len);
+            }
+
+            if (table)
+            {
+                nl_attr_put32(&msg->n, sizeof(*msg), RTA_TABLE, table);
+            }
+
+            if (nhg_id)
+            {
+                nl_attr_put32(&msg->n, sizeof(*msg), RTA_NH_ID, nhg_id);
+            }
+
+            if (nexthops.size() == 1)
+            {
+                if (nexthops[0].gateway)
+                {
+                    inet_pton(family, nexthops[0].gateway, addr);
+                    nl_attr_put(&msg->n, sizeof(*msg), RTA_GATEWAY, addr, addr_len);
+                }
+                nl_attr_put32(&msg->n, sizeof(*msg), RTA_OIF, (uint32_t)nexthops[0].ifindex);
+            }
+            else if (nexthops.size() > 1)
+            {
+                alignas(struct rtnexthop) char buf[256] = {0};
+                size_t len = 0;
+
+                for (const auto &nh : nexthops)
+                {
+                    struct rtnexthop *rtnh = reinterpret_cast<struct rtnexthop *>(static_cast<void *>(buf + len));
+                    rtnh->rtnh_len = sizeof(*rtnh);
+                    rtnh->rtnh_hops = nh.hops;
+                    rtnh->rtnh_ifindex = nh.ifindex;
+
+                    if (nh.gateway)
+                    {
+                        struct rtattr *rta = RTNH_DATA(rtnh);
+                        rta->rta_type = RTA_GATEWAY;
+                        rta->rta_len = (unsigned short)RTA_LENGTH(addr_len);
+                        inet_pton(family, nh.gateway, RTA_DATA(rta));
+                        rtnh->rtnh_len = (unsigned short)(rtnh->rtnh_len + RTA_SPACE(addr_len));
+                    }
+
+                    len += RTNH_ALIGN(rtnh->rtnh_len);
+                }
+
+                nl_attr_put(&msg->n, sizeof(*msg), RTA_MULTIPATH, buf, (unsigned int)len);
+            }
+
+            return msg;
+        }
+
+        TableDump dumpTable(const std::string &tableName)
+        {
+            TableDump dump;
+            swss::Table table(m_app_db.get(), tableName);
+            std::vector<std::string> keys;
+
+            table.getKeys(keys);
+            for (const auto &key : keys)
+            {
+                table.get(key, dump[key]);
+            }
+
+            return dump;
+        }
+
+        void decodeLibnl(struct nlmsghdr *h)
+        {
+            struct rtnl_route *route = NULL;
+
+            ASSERT_EQ(rtnl_route_parse(h, &route), 0);
+            m_routeSync->onMsg(h->nlmsg_type, (struct nl_object *)route);
+            rtnl_route_put(route);
+        }
+
+        void resetNextHopGroups()
+        {
+            for (auto &it : m_routeSync->m_nh_groups)
+            {
+                it.second.installed = false;
+            }
+        }
+
+        /* Run h through both decoders and check that they write the same entries */
+        void expectSameResult(struct nlmsghdr *h, const std::string &tableName = APP_ROUTE_TABLE_NAME)
+        {
+            testing_db::reset();
+            resetNextHopGroups();
+            decodeLibnl(h);
+            TableDump libnlResult = dumpTable(tableName);
+
+            testing_db::reset();
+            resetNextHopGroups();
+            ASSERT_TRUE(m_routeSync->onRouteMsgFast(h));
+            TableDump rawResult = dumpTable(tableName);
+
+            ASSERT_FALSE(rawResult.empty());
+            ASSERT_EQ(rawResult, libnlResult);
+        }
+    };
+
+    TEST_F(FpmSyncdRouteDecodeTest, SingleNextHopV4)
+    {
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET, "10.1.1.0", 24, {{"192.168.1.1", 10, 0}});
+        expectSameResult(&msg->n);
+
+        std::string nexthop;
+        swss::Table table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        ASSERT_TRUE(table.hget("10.1.1.0/24", "nexthop", nexthop));
+        ASSERT_EQ(nexthop, "192.168.1.1");
+        free_nlobj(msg);
+    }
+
+    TEST_F(FpmSyncdRouteDecodeTest, HostAndDefaultRoutes)
+    {
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET, "10.1.1.1", 32, {{"192.168.1.1", 10, 0}});
+        expectSameResult(&msg->n);
+        free_nlobj(msg);
+
+        msg = createRoute(RTM_NEWROUTE, AF_INET, "0.0.0.0", 0, {{NULL, 10, 0}});
+        expectSameResult(&msg->n);
+        free_nlobj(msg);
+
+        msg = createRoute(RTM_NEWROUTE, AF_INET6, "::", 0, {{"fc00::1", 10, 0}});
+        expectSameResult(&msg->n);
+        free_nlobj(msg);
+    }
+
+    TEST_F(FpmSyncdRouteDecodeTest, EcmpV6InVrf)
+    {
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET6, "2001:db8::", 64,
+                                        {{"fc00::1", 10, 0}, {"fc00::2", 11, 3}, {NULL, 12, 1}}, 10);
+        expectSameResult(&msg->n);
+
+        std::string weight;
+        swss::Table table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        ASSERT_TRUE(table.hget("Vrf10:2001:db8::/64", "weight", weight));
+        ASSERT_EQ(weight, "1,3,1");
+        free_nlobj(msg);
+    }
+
+    TEST_F(FpmSyncdRouteDecodeTest, BlackholeAndDelete)
+    {
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET, "10.2.0.0", 16, {}, 0, RTN_BLACKHOLE);
+        expectSameResult(&msg->n);
+        free_nlobj(msg);
+
+        msg = createRoute(RTM_DELROUTE, AF_INET, "10.2.0.0", 16);
+        m_routeSync->m_routeTable->set("10.2.0.0/16", {{"nexthop", "1.1.1.1"}});
+        ASSERT_TRUE(m_routeSync->onRouteMsgFast(&msg->n));
+        ASSERT_TRUE(dumpTable(APP_ROUTE_TABLE_NAME).empty());
+        free_nlobj(msg);
+    }
+
+    TEST_F(FpmSyncdRouteDecodeTest, NextHopGroupId)
+    {
+        m_routeSync->m_nh_groups.insert({1, NextHopGroup(1, "192.168.1.1", "Ethernet0")});
+        m_routeSync->m_nh_groups.insert({2, NextHopGroup(2, "192.168.1.2", "Ethernet4")});
+        m_routeSync->m_nh_groups.insert({3, NextHopGroup(3, {{1, 1}, {2, 2}})});
+
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET, "10.3.0.0", 24, {}, 0, RTN_UNICAST, 1);
+        expectSameResult(&msg->n);
+        free_nlobj(msg);
+
+        msg = createRoute(RTM_NEWROUTE, AF_INET, "10.3.1.0", 24, {}, 0, RTN_UNICAST, 3);
+        expectSameResult(&msg->n);
+        expectSameResult(&msg->n, APP_NEXTHOP_GROUP_TABLE_NAME);
+        free_nlobj(msg);
+    }
+
+    TEST_F(FpmSyncdRouteDecodeTest, UnsupportedRoutesFallBack)
+    {
+        // Invalid VRF
+        struct nlmsg *msg = createRoute(RTM_NEWROUTE, AF_INET, "10.4.0.0", 24, {{"192.168.1.1", 10, 0}}, 30);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&msg->n));
+        free_nlobj(msg);
+
+        // Encapsulated next hop
+        msg = createRoute(RTM_NEWROUTE, AF_INET, "10.4.1.0", 24, {{"192.168.1.1", 10, 0}});
+        nl_attr_put16(&msg->n, sizeof(*msg), RTA_ENCAP_TYPE, 1);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&msg->n));
+        free_nlobj(msg);
+
+        // No next hop
+        msg = createRoute(RTM_NEWROUTE, AF_INET, "10.4.2.0", 24);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&msg->n));
+        free_nlobj(msg);
+
+        // No destination
+        msg = createRoute(RTM_NEWROUTE, AF_INET, NULL, 0, {{"192.168.1.1", 10, 0}});
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&msg->n));
+        free_nlobj(msg);
+
+        ASSERT_TRUE(dumpTable(APP_ROUTE_TABLE_NAME).empty());
+    }
+
+    /*
+     * Decode throughput of both paths, run with --gtest_also_run_disabled_tests.
+     * FPMSYNCD_BENCH_CAPTURE may name a file holding a captured FPM stream
+     * (FPM headers followed by netlink messages), otherwise a mix of IPv4 and
+     * IPv6 ECMP routes is generated.
+     */
+    TEST_F(FpmSyncdRouteDecodeTest, DISABLED_DecodeBenchmark)
+    {
+        std::vector<char> stream;
+        const char *capture = getenv("FPMSYNCD_BENCH_CAPTURE");
+
+        if (capture)
+        {
+            std::ifstream file(capture, std::ios::binary);
+            stream.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        else
+        {
+            for (uint32_t i = 0; i < 100000; i++)
+            {
+                char dst[INET6_ADDRSTRLEN];
+                struct nlmsg *msg;
+
+                if (i % 2)
+                {
+                    snprintf(dst, sizeof(dst), "10.%u.%u.0", (i >> 8) & 0xff, i & 0xff);
+                    msg = createRoute(RTM_NEWROUTE, AF_INET, dst, 24, {{"192.168.1.1", 10, 0}});
+                }
+                else
+                {
+                    snprintf(dst, sizeof(dst), "2001:db8:%x::", i);
+                    msg = createRoute(RTM_NEWROUTE, AF_INET6, dst, 64,
+                                      {{"fc00::1", 10, 0}, {"fc00::2", 11, 0}, {"fc00::3", 12, 0}, {"fc00::4", 13, 0}});
+                }
+
+                fpm_msg_hdr_t hdr = {};
+                size_t len = fpm_msg_align(sizeof(hdr) + msg->n.nlmsg_len);
+                hdr.version = FPM_PROTO_VERSION;
+                hdr.msg_type = FPM_MSG_TYPE_NETLINK;
+                hdr.msg_len = htons(static_cast<uint16_t>(len));
+
+                size_t offset = stream.size();
+                stream.resize(offset + len);
+                memcpy(stream.data() + offset, &hdr, sizeof(hdr));
+                memcpy(stream.data() + offset + sizeof(hdr), &msg->n, msg->n.nlmsg_len);
+                free_nlobj(msg);
+            }
+        }
+
+        FpmLink fpm(m_routeSync.get());
+        NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, m_routeSync.get());
+        NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, m_routeSync.get());
+
+        auto replay = [&](bool raw) {
+            m_routeSync->setRawRouteDecodeEnabled(raw);
+            testing_db::reset();
+
+            std::vector<char> copy(stream);
+            size_t messages = 0;
+            auto start = std::chrono::steady_clock::now();
+
+            for (size_t pos = 0; pos + FPM_MSG_HDR_LEN <= copy.size(); messages++)
+            {
+                auto *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(copy.data() + pos));
+                if (!fpm_msg_ok(hdr, copy.size() - pos))
+                {
+                    break;
+                }
+                fpm.processFpmMessage(hdr);
+                pos += fpm_msg_len(hdr);
+            }
+
+            auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            std::cout << (raw ? "raw  " : "libnl") << ": " << messages << " messages in " << usec << " us, "
+                      << (usec ? messages * 1000000 / (size_t)usec : 0) << " msg/s" << std::endl;
+
+            return dumpTable(APP_ROUTE_TABLE_NAME);
+        };
+
+        TableDump libnlResult = replay(false);
+        TableDump rawResult = replay(true);
+
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWROUTE);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_DELROUTE);
+
+        ASSERT_EQ(rawResult, libnlResult);
+    }
+}
@@ -0,0 +1,193 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include "mock_table.h"
+#define private public
+#include "fpmsyncd/routesync.h"
+#include "fpmsyncd/routewriter.h"
+#undef private
+
+using namespace swss;
+
+extern void resetMockWarmStartHelper();
+
+namespace ut_fpmsyncd
+{
+    struct RouteWriterTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::RedisPipeline> m_pipeline;
+        std::shared_ptr<swss::ProducerStateTable> m_routeTable;
+        std::shared_ptr<swss::ProducerStateTable> m_labelRouteTable;
+
+        void SetUp() override
+        {
+            testing_db::reset();
+            resetMockWarmStartHelper();
+
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_pipeline = std::make_shared<swss::RedisPipeline>(m_app_db.get());
+            m_routeTable = std::make_shared<swss::ProducerStateTable>(m_pipeline.get(), APP_ROUTE_TABLE_NAME, true);
+            m_labelRouteTable = std::make_shared<swss::ProducerStateTable>(m_pipeline.get(), APP_LABEL_ROUTE_TABLE_NAME, true);
+        }
+
+        void TearDown() override
+        {
+            testing_db::reset();
+        }
+    };
+
+    TEST_F(RouteWriterTest, QueueCoalescesPerKey)
+    {
+        RouteUpdateQueue queue(16);
+
+        ASSERT_TRUE(queue.push(m_routeTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "1.1.1.1"}}));
+        ASSERT_TRUE(queue.push(m_routeTable.get(), "10.0.1.0/24", DEL_COMMAND, {}));
+        ASSERT_TRUE(queue.push(m_labelRouteTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "3.3.3.3"}}));
+        ASSERT_FALSE(queue.push(m_routeTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "2.2.2.2"}}));
+        ASSERT_FALSE(queue.push(m_routeTable.get(), "10.0.1.0/24", SET_COMMAND, {{"nexthop", "4.4.4.4"}}));
+        ASSERT_EQ(queue.size(), 3u);
+
+        std::vector<RouteUpdate> batch;
+        ASSERT_TRUE(queue.pop(batch, 16, std::chrono::milliseconds(0)));
+        ASSERT_EQ(batch.size(), 3u);
+        ASSERT_EQ(queue.size(), 0u);
+
+        // Keys keep the position of their first update and carry the last one
+        ASSERT_EQ(batch[0].key, "10.0.0.0/24");
+        ASSERT_EQ(batch[0].op, SET_COMMAND);
+        ASSERT_EQ(fvValue(batch[0].fvs[0]), "2.2.2.2");
+        ASSERT_FALSE(batch[0].delFirst);
+
+        // A SET following a DEL still clears the previous entry first
+        ASSERT_EQ(batch[1].key, "10.0.1.0/24");
+        ASSERT_EQ(batch[1].op, SET_COMMAND);
+        ASSERT_TRUE(batch[1].delFirst);
+
+        ASSERT_EQ(batch[2].table, m_labelRouteTable.get());
+        ASSERT_EQ(fvValue(batch[2].fvs[0]), "3.3.3.3");
+    }
+
+    TEST_F(RouteWriterTest, QueuePopIsBounded)
+    {
+        RouteUpdateQueue queue(16);
+
+        for (int i = 0; i < 5; i++)
+        {
+            queue.push(m_routeTable.get(), "10.0." + std::to_string(i) + ".0/24", SET_COMMAND, {{"nexthop", "1.1.1.1"}});
+        }
+
+        std::vector<RouteUpdate> batch;
+        ASSERT_TRUE(queue.pop(batch, 2, std::chrono::milliseconds(0)));
+        ASSERT_EQ(batch.size(), 2u);
+        ASSERT_EQ(queue.size(), 3u);
+
+        // A popped key is not merged anymore
+        ASSERT_TRUE(queue.push(m_routeTable.get(), "10.0.0.0/24", DEL_COMMAND, {}));
+
+        queue.shutdown();
+        batch.clear();
+        ASSERT_TRUE(queue.pop(batch, 16, std::chrono::milliseconds(0)));
+        ASSERT_EQ(batch.size(), 4u);
+        batch.clear();
+        ASSERT_FALSE(queue.pop(batch, 16, std::chrono::milliseconds(0)));
+    }
+
+    TEST_F(RouteWriterTest, QueueHoldsUntilThresholdOrInterval)
+    {
+        RouteUpdateQueue queue(16);
+        std::vector<RouteUpdate> batch;
+
+        queue.push(m_routeTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "1.1.1.1"}});
+        queue.push(m_routeTable.get(), "10.0.1.0/24", SET_COMMAND, {{"nexthop", "1.1.1.1"}});
+
+        // Threshold reached, no hold
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(queue.pop(batch, 16, std::chrono::milliseconds(0), 2, std::chrono::seconds(10)));
+        ASSERT_EQ(batch.size(), 2u);
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+        // Below threshold, held for the interval
+        batch.clear();
+        queue.push(m_routeTable.get(), "10.0.0.0/24", DEL_COMMAND, {});
+        start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(queue.pop(batch, 16, std::chrono::milliseconds(0), 2, std::chrono::milliseconds(50)));
+        ASSERT_EQ(batch.size(), 1u);
+        ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+    }
+
+    TEST_F(RouteWriterTest, WriterSuppressesFlaps)
+    {
+        RouteWriter writer(m_pipeline.get());
+        writer.setFlushPolicy(1000, std::chrono::milliseconds(500));
+        writer.start();
+
+        for (int i = 0; i < 50; i++)
+        {
+            writer.push(m_routeTable.get(), "10.0.0.0/24", i % 2 ? DEL_COMMAND : SET_COMMAND,
+                        {{"nexthop", std::to_string(i)}});
+        }
+        writer.push(m_routeTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "final"}});
+        writer.drain();
+
+        ASSERT_EQ(writer.getReceived(), 51u);
+        ASSERT_EQ(writer.getCoalesced(), 50u);
+        ASSERT_EQ(writer.getWritten(), 1u);
+
+        auto stats = writer.getStats();
+        auto suppressed = std::find_if(stats.begin(), stats.end(),
+                                       [](const FieldValueTuple &fv) { return fvField(fv) == "suppressed"; });
+        ASSERT_NE(suppressed, stats.end());
+        ASSERT_EQ(fvValue(*suppressed), "50");
+
+        swss::Table table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        std::string nexthop;
+        ASSERT_TRUE(table.hget("10.0.0.0/24", "nexthop", nexthop));
+        ASSERT_EQ(nexthop, "final");
+
+        writer.stop();
+    }
+
+    TEST_F(RouteWriterTest, WriterFlushesFinalState)
+    {
+        RouteWriter writer(m_pipeline.get(), 16, 2);
+        writer.start();
+
+        writer.push(m_routeTable.get(), "10.0.0.0/24", SET_COMMAND, {{"nexthop", "1.1.1.1"}, {"ifname", "Ethernet0"}});
+        writer.push(m_routeTable.get(), "10.0.1.0/24", SET_COMMAND, {{"nexthop", "2.2.2.2"}});
+        writer.push(m_routeTable.get(), "10.0.2.0/24", SET_COMMAND, {{"nexthop", "3.3.3.3"}});
+        writer.drain();
+
+        writer.push(m_routeTable.get(), "10.0.0.0/24", DEL_COMMAND, {});
+        writer.push(m_routeTable.get(), "10.0.1.0/24", DEL_COMMAND, {});
+        writer.drain();
+
+        writer.stop();
+
+        swss::Table table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        std::vector<std::string> keys;
+        table.getKeys(keys);
+        ASSERT_EQ(keys.size(), 1u);
+        ASSERT_EQ(keys[0], "10.0.2.0/24");
+
+        ASSERT_EQ(writer.getReceived(), writer.getWritten() + writer.getCoalesced());
+        ASSERT_GE(writer.getBatches(), 2u);
+    }
+
+    TEST_F(RouteWriterTest, RouteSyncQueuesRoutes)
+    {
+        auto routeDb = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+        auto routePipeline = std::make_shared<swss::RedisPipeline>(routeDb.get());
+        RouteSync sync(m_pipeline.get(), routePipeline.get());
+
+        ASSERT_NE(sync.getRouteWriter(), nullptr);
+
+        sync.setRouteWithWarmRestart("10.0.0.0/24", {{"nexthop", "1.1.1.1"}}, sync.m_routeTable, SET_COMMAND);
+        sync.setRouteWithWarmRestart("10.0.0.0/24", {{"nexthop", "2.2.2.2"}}, sync.m_routeTable, SET_COMMAND);
+        sync.getRouteWriter()->drain();
+
+        swss::Table table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        std::string nexthop;
+        ASSERT_TRUE(table.hget("10.0.0.0/24", "nexthop", nexthop));
+        ASSERT_EQ(nexthop, "2.2.2.2");
+    }
+}
@@ -0,0 +1,257 @@
+#include "gtest/gtest.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "../mock_table.h"
+#define private public
+#include "natmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+/* iptables-save output of the nat table, and the inputs of the iptables-restore runs */
+static std::string savedNatRules;
+static std::vector<std::string> restoreInputs;
+static std::string failRestore;
+static std::string failedRule;
+
+static int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    stdout.clear();
+
+    if (cmd == "/sbin/iptables-save -t nat")
+    {
+        stdout = savedNatRules;
+    }
+    else if (cmd.find("/sbin/iptables-restore --noflush < ") == 0)
+    {
+        size_t start = cmd.find("< ") + 2;
+        std::ifstream in(cmd.substr(start, cmd.find(' ', start) - start));
+        std::stringstream ss;
+        ss << in.rdbuf();
+        restoreInputs.push_back(ss.str());
+        return (!failRestore.empty() && restoreInputs.back().find(failRestore) != std::string::npos) ? 1 : 0;
+    }
+    else if (!failedRule.empty() && cmd.find(failedRule) != std::string::npos)
+    {
+        stdout = "iptables: Bad rule (does a matching rule exist in that chain?).";
+        return 1;
+    }
+
+    return 0;
+}
+
+namespace natmgr_ut
+{
+    using namespace std;
+    using namespace swss;
+
+    struct NatMgrTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_config_db;
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<DBConnector> m_state_db;
+        vector<string> cfg_nat_tables;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = make_shared<DBConnector>("CONFIG_DB", 0);
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_state_db = make_shared<DBConnector>("STATE_DB", 0);
+            cfg_nat_tables = { CFG_STATIC_NAT_TABLE_NAME, CFG_STATIC_NAPT_TABLE_NAME };
+
+            savedNatRules.clear();
+            restoreInputs.clear();
+            failRestore.clear();
+            failedRule.clear();
+            mockCallArgs.clear();
+            callback = cb;
+        }
+
+        virtual void TearDown() override
+        {
+            callback = nullptr;
+        }
+
+        shared_ptr<NatMgr> createNatMgr()
+        {
+            auto natmgr = make_shared<NatMgr>(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_nat_tables);
+            natmgr->m_natZoneInterfaceInfo["Ethernet0"] = "1";
+            mockCallArgs.clear();
+            return natmgr;
+        }
+
+        /* The tagged rule line, as written to iptables-restore */
+        static string ruleLine(const natIptablesRule_t &rule)
+        {
+            return "-" + rule.opCmd + " " + rule.chain + " -m comment --comment " + rule.tag + " " + rule.spec;
+        }
+    };
+
+    TEST_F(NatMgrTest, QueueAndRestore)
+    {
+        auto natmgr = createNatMgr();
+
+        // Rules are queued, nothing is run until the end of the pass
+        ASSERT_TRUE(natmgr->setStaticNatIptablesRules(INSERT, "Ethernet0", "65.55.42.1", "10.0.0.1", DNAT_NAT_TYPE));
+        ASSERT_TRUE(natmgr->setMangleIptablesRules(ADD, "Ethernet0", "1"));
+        ASSERT_TRUE(mockCallArgs.empty());
+
+        auto rules = natmgr->m_pendingIptablesRules;
+        ASSERT_EQ(rules.size(), 4u);
+        ASSERT_EQ(rules[0].table, "nat");
+        ASSERT_EQ(rules[0].chain, "PREROUTING");
+        ASSERT_EQ(rules[0].spec, "-m mark --mark 1 -j DNAT -d 65.55.42.1 --to-destination 10.0.0.1");
+        ASSERT_EQ(rules[0].owner, "Static NAT 65.55.42.1");
+        ASSERT_EQ(rules[0].tag.compare(0, strlen(IPTABLES_RULE_TAG), IPTABLES_RULE_TAG), 0);
+        ASSERT_NE(rules[0].tag, rules[1].tag);
+        ASSERT_EQ(rules[2].table, "mangle");
+
+        // One iptables-restore run per table, in the queued order
+        ASSERT_EQ(natmgr->commitIptablesRules(), 0u);
+        ASSERT_EQ(mockCallArgs.size(), 2u);
+        ASSERT_EQ(restoreInputs, vector<string>({
+            "*nat\n" + ruleLine(rules[0]) + "\n" + ruleLine(rules[1]) + "\nCOMMIT\n",
+            "*mangle\n" + ruleLine(rules[2]) + "\n" + ruleLine(rules[3]) + "\nCOMMIT\n",
+        }));
+        ASSERT_TRUE(natmgr->m_pendingIptablesRules.empty());
+
+        // Nothing queued, nothing run
+        mockCallArgs.clear();
+        ASSERT_EQ(natmgr->commitIptablesRules(), 0u);
+        ASSERT_TRUE(mockCallArgs.empty());
+
+        // Not an iptables command
+        ASSERT_FALSE(natmgr->queueIptablesCmds("/sbin/ip link set Ethernet0 up", "test"));
+    }
+
+    TEST_F(NatMgrTest, RestoreFailureAppliesRulesOneByOne)
+    {
+        auto natmgr = createNatMgr();
+
+        ASSERT_TRUE(natmgr->setStaticNatIptablesRules(DELETE, "Ethernet0", "65.55.42.1", "10.0.0.1", DNAT_NAT_TYPE));
+        ASSERT_TRUE(natmgr->setStaticNaptIptablesRules(INSERT, "Ethernet0", "tcp", "65.55.42.2", "1024", "10.0.0.2", "80", DNAT_NAT_TYPE));
+        auto rules = natmgr->m_pendingIptablesRules;
+        ASSERT_EQ(rules.size(), 4u);
+
+        // The transaction is rejected for the delete of a missing rule, only that one fails
+        failRestore = "*nat";
+        failedRule = ruleLine(rules[0]);
+        ASSERT_EQ(natmgr->commitIptablesRules(), 1u);
+
+        ASSERT_EQ(mockCallArgs.size(), 5u);
+        for (size_t i = 0; i < rules.size(); i++)
+        {
+            ASSERT_EQ(mockCallArgs[i + 1], "/sbin/iptables -t nat " + ruleLine(rules[i]));
+        }
+    }
+
+    TEST_F(NatMgrTest, RestoreFailureKeepsOtherTables)
+    {
+        auto natmgr = createNatMgr();
+
+        ASSERT_TRUE(natmgr->setMangleIptablesRules(DELETE, "Ethernet0", "1"));
+        ASSERT_TRUE(natmgr->setStaticNatIptablesRules(INSERT, "Ethernet0", "65.55.42.1", "10.0.0.1", DNAT_NAT_TYPE));
+        auto rules = natmgr->m_pendingIptablesRules;
+        ASSERT_EQ(rules.size(), 4u);
+
+        // The mangle table is rejected, the nat table is committed on its own and not applied again
+        failRestore = "*mangle";
+        failedRule = ruleLine(rules[0]);
+        ASSERT_EQ(natmgr->commitIptablesRules(), 1u);
+
+        ASSERT_EQ(restoreInputs.size(), 2u);
+        ASSERT_EQ(mockCallArgs.size(), 4u);
+        ASSERT_EQ(mockCallArgs[1], "/sbin/iptables -t mangle " + ruleLine(rules[0]));
+        ASSERT_EQ(mockCallArgs[2], "/sbin/iptables -t mangle " + ruleLine(rules[1]));
+        ASSERT_EQ(mockCallArgs[3].find("/sbin/iptables-restore"), 0u);
+    }
+
+    TEST_F(NatMgrTest, ApplyRulesRightAway)
+    {
+        auto natmgr = createNatMgr();
+
+        // Rules queued before are committed first, a failure of theirs is not the result
+        ASSERT_TRUE(natmgr->setMangleIptablesRules(DELETE, "Ethernet0", "1"));
+        failRestore = "*mangle";
+        failedRule = ruleLine(natmgr->m_pendingIptablesRules[0]);
+        ASSERT_TRUE(natmgr->applyIptablesRules([&] {
+            return natmgr->setStaticTwiceNatIptablesRules(INSERT, "Ethernet0", "65.55.42.1", "10.0.0.1", "65.55.42.2", "10.0.0.2");
+        }));
+        ASSERT_TRUE(natmgr->m_pendingIptablesRules.empty());
+        ASSERT_EQ(restoreInputs.size(), 2u);
+        ASSERT_NE(restoreInputs[1].find("65.55.42.1"), string::npos);
+
+        // A rule of their own that fails is
+        failRestore = "*nat";
+        failedRule = "-j DNAT -d 65.55.42.2";
+        ASSERT_FALSE(natmgr->applyIptablesRules([&] {
+            return natmgr->setStaticTwiceNatIptablesRules(DELETE, "Ethernet0", "65.55.42.1", "10.0.0.1", "65.55.42.2", "10.0.0.2");
+        }));
+
+        // Not queued, not applied
+        mockCallArgs.clear();
+        ASSERT_FALSE(natmgr->applyIptablesRules([&] { return natmgr->setMangleIptablesRules(ADD, "Ethernet0", ""); }));
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
+    TEST_F(NatMgrTest, ClaimRulesOfPreviousNatMgr)
+    {
+        // The rules a previous natmgrd added for the config, with their tags
+        auto previous = createNatMgr();
+        ASSERT_TRUE(previous->setStaticNatIptablesRules(INSERT, "Ethernet0", "65.55.42.1", "10.0.0.1", DNAT_NAT_TYPE));
+        ASSERT_TRUE(previous->setStaticNatIptablesRules(INSERT, "Ethernet0", "65.55.42.9", "10.0.0.9", DNAT_NAT_TYPE));
+        auto rules = previous->m_pendingIptablesRules;
+        previous->m_pendingIptablesRules.clear();
+
+        // iptables-save prints the rules of the previous natmgrd with their tags
+        savedNatRules = "# Generated by iptables-save\n"
+                        "*nat\n"
+                        ":PREROUTING ACCEPT [0:0]\n"
+                        "-A PREROUTING -m comment --comment " + rules[0].tag + " " + rules[0].spec + "\n"
+                        "-A POSTROUTING -m comment --comment " + rules[1].tag + " " + rules[1].spec + "\n"
+                        "-A PREROUTING -m comment --comment " + rules[2].tag + " " + rules[2].spec + "\n"
+                        "-A POSTROUTING -m comment --comment " + rules[3].tag + " " + rules[3].spec + "\n"
+                        // Added by a natmgrd older than the tags
+                        "-A PREROUTING -d 65.55.42.5/32 -j DNAT --to-destination 10.0.0.5\n"
+                        // Not a natmgrd rule
+                        "-A POSTROUTING -o eth0 -j MASQUERADE\n"
+                        "COMMIT\n";
+
+        // Warm reboot, the replay has not reconciled yet
+        Table warmRestartEnableTable(m_state_db.get(), STATE_WARM_RESTART_ENABLE_TABLE_NAME);
+        Table warmRestartTable(m_state_db.get(), STATE_WARM_RESTART_TABLE_NAME);
+        warmRestartEnableTable.set("system", { {"enable", "true"} });
+        warmRestartTable.set("natsyncd", { {"state", "restored"} });
+
+        auto natmgr = createNatMgr();
+        ASSERT_EQ(natmgr->m_staleIptablesRules.size(), 5u);
+        ASSERT_EQ(natmgr->m_staleIptablesRules.count(""), 1u);
+
+        // The replay of 65.55.42.1 claims its rules, nothing is added twice
+        ASSERT_TRUE(natmgr->setStaticNatIptablesRules(INSERT, "Ethernet0", "65.55.42.1", "10.0.0.1", DNAT_NAT_TYPE));
+        ASSERT_TRUE(natmgr->m_pendingIptablesRules.empty());
+        ASSERT_EQ(natmgr->m_staleIptablesRules.size(), 3u);
+
+        // Unclaimed rules are kept until the reconciliation
+        ASSERT_EQ(natmgr->commitIptablesRules(), 0u);
+        ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_EQ(natmgr->m_staleIptablesRules.size(), 3u);
+
+        // Then the rules of 65.55.42.9, not in the config any more, and the untagged one are removed
+        warmRestartTable.set("natsyncd", { {"state", "reconciled"} });
+        ASSERT_EQ(natmgr->commitIptablesRules(), 0u);
+        ASSERT_TRUE(natmgr->m_staleIptablesRules.empty());
+
+        ASSERT_EQ(restoreInputs.size(), 1u);
+        const string &restoreInput = restoreInputs[0];
+        ASSERT_NE(restoreInput.find("-D PREROUTING -m comment --comment " + rules[2].tag + " " + rules[2].spec + "\n"), string::npos);
+        ASSERT_NE(restoreInput.find("-D POSTROUTING -m comment --comment " + rules[3].tag + " " + rules[3].spec + "\n"), string::npos);
+        ASSERT_NE(restoreInput.find("-D PREROUTING -d 65.55.42.5/32 -j DNAT --to-destination 10.0.0.5\n"), string::npos);
+        ASSERT_EQ(restoreInput.find(rules[0].tag), string::npos);
+        ASSERT_EQ(restoreInput.find("MASQUERADE"), string::npos);
+    }
+}
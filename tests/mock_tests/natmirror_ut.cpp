@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include <cstring>
+#include <hiredis/hiredis.h>
+#include "mock_table.h"
+#include "schema.h"
+#include "natmirror.h"
+
+extern redisReply *mockReply;
+
+namespace natmirror_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct NatTableMirrorTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+        }
+
+        static redisReply *string_reply(const string &str)
+        {
+            auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+            reply->type = REDIS_REPLY_STRING;
+            reply->str = strdup(str.c_str());
+            reply->len = str.length();
+            return reply;
+        }
+
+        /* A keyspace notification, as read from the subscription */
+        static redisReply *pmessage(const string &pattern, const string &channel, const string &op)
+        {
+            auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+            reply->type = REDIS_REPLY_ARRAY;
+            reply->elements = 4;
+            reply->element = (redisReply **)calloc(sizeof(redisReply *), reply->elements);
+            reply->element[0] = string_reply("pmessage");
+            reply->element[1] = string_reply(pattern);
+            reply->element[2] = string_reply(channel);
+            reply->element[3] = string_reply(op);
+            return reply;
+        }
+    };
+
+    TEST_F(NatTableMirrorTest, LoadsExistingEntries)
+    {
+        Table naptTable(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        naptTable.set("TCP:65.55.42.1:1024", {{"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "20.0.0.1"}});
+        naptTable.set("UDP:20.0.0.1:4000", {{"nat_type", "snat"}, {"entry_type", "dynamic"}, {"translated_ip", "65.55.42.1"}});
+
+        NatTableMirror mirror(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        ASSERT_EQ(mirror.size(), 2u);
+
+        bool isStatic = false;
+        ASSERT_TRUE(mirror.find("TCP:65.55.42.1:1024", isStatic));
+        ASSERT_TRUE(isStatic);
+        ASSERT_TRUE(mirror.find("UDP:20.0.0.1:4000", isStatic));
+        ASSERT_FALSE(isStatic);
+        ASSERT_FALSE(mirror.find("TCP:20.0.0.1:4000", isStatic));
+    }
+
+    TEST_F(NatTableMirrorTest, SkipsOwnWrites)
+    {
+        NatTableMirror mirror(m_app_db.get(), APP_NAT_TABLE_NAME);
+        ASSERT_EQ(mirror.size(), 0u);
+
+        mirror.set("20.0.0.1", {{"nat_type", "snat"}, {"entry_type", "dynamic"}, {"translated_ip", "65.55.42.1"}});
+        mirror.set("65.55.42.1", {{"nat_type", "dnat"}, {"entry_type", "dynamic"}, {"translated_ip", "20.0.0.1"}});
+        ASSERT_TRUE(mirror.exists("20.0.0.1"));
+        mirror.del("20.0.0.1");
+        ASSERT_FALSE(mirror.exists("20.0.0.1"));
+        ASSERT_TRUE(mirror.exists("65.55.42.1"));
+
+        // The notifications of natsyncd's own writes are not looked up
+        Table natTable(m_app_db.get(), APP_NAT_TABLE_NAME);
+        natTable.set("65.55.42.1", {{"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "20.0.0.2"}});
+        mirror.onKeyspaceEvent("65.55.42.1", "hset");
+        mirror.onKeyspaceEvent("20.0.0.1", "del");
+        ASSERT_EQ(mirror.getLookupCount(), 0u);
+
+        bool isStatic = false;
+        ASSERT_TRUE(mirror.find("65.55.42.1", isStatic));
+        ASSERT_FALSE(isStatic);
+        ASSERT_EQ(mirror.getLookupCount(), 0u);
+
+        // Before deleting, the entry is checked: natmgrd replaced it with a static one
+        ASSERT_TRUE(mirror.find("65.55.42.1", isStatic, true));
+        ASSERT_TRUE(isStatic);
+        ASSERT_EQ(mirror.getLookupCount(), 1u);
+
+        // Then it is natmgrd's entry, its notifications are followed
+        natTable.del("65.55.42.1");
+        mirror.onKeyspaceEvent("65.55.42.1", "del");
+        ASSERT_FALSE(mirror.exists("65.55.42.1"));
+        ASSERT_EQ(mirror.size(), 0u);
+    }
+
+    TEST_F(NatTableMirrorTest, AppliesDeletesOfOwnEntries)
+    {
+        NatTableMirror mirror(m_app_db.get(), APP_NAT_TABLE_NAME);
+        Table natTable(m_app_db.get(), APP_NAT_TABLE_NAME);
+        bool isStatic = false;
+
+        // natmgrd writes a static entry over natsyncd's one, the notification is skipped
+        mirror.set("65.55.42.1", {{"nat_type", "dnat"}, {"entry_type", "dynamic"}, {"translated_ip", "20.0.0.1"}});
+        natTable.set("65.55.42.1", {{"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "20.0.0.2"}});
+        mirror.onKeyspaceEvent("65.55.42.1", "hset");
+        ASSERT_TRUE(mirror.exists("65.55.42.1"));
+
+        // Then deletes it, the entry is gone whoever wrote it
+        natTable.del("65.55.42.1");
+        mirror.onKeyspaceEvent("65.55.42.1", "del");
+        ASSERT_FALSE(mirror.find("65.55.42.1", isStatic));
+        ASSERT_EQ(mirror.size(), 0u);
+        ASSERT_EQ(mirror.getLookupCount(), 0u);
+    }
+
+    TEST_F(NatTableMirrorTest, LooksUpEntriesOfOtherWriters)
+    {
+        NatTableMirror mirror(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        Table naptTable(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        bool isStatic = false;
+
+        naptTable.set("TCP:65.55.42.1:1024", {{"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "20.0.0.1"}});
+        mirror.onKeyspaceEvent("TCP:65.55.42.1:1024", "hset");
+        ASSERT_EQ(mirror.getLookupCount(), 1u);
+        ASSERT_TRUE(mirror.find("TCP:65.55.42.1:1024", isStatic, true));
+        ASSERT_TRUE(isStatic);
+
+        // Not natsyncd's entry, nothing to verify
+        ASSERT_EQ(mirror.getLookupCount(), 1u);
+
+        // Removed before the notification was read
+        mirror.onKeyspaceEvent("TCP:65.55.42.2:1024", "hset");
+        ASSERT_FALSE(mirror.exists("TCP:65.55.42.2:1024"));
+
+        naptTable.del("TCP:65.55.42.1:1024");
+        mirror.onKeyspaceEvent("TCP:65.55.42.1:1024", "del");
+        ASSERT_EQ(mirror.size(), 0u);
+        ASSERT_EQ(mirror.getLookupCount(), 2u);
+    }
+
+    TEST_F(NatTableMirrorTest, ReadsKeyspaceNotifications)
+    {
+        NatTableMirror mirror(m_app_db.get(), APP_NAPT_POOL_IP_TABLE_NAME);
+        Table poolTable(m_app_db.get(), APP_NAPT_POOL_IP_TABLE_NAME);
+        poolTable.set("65.55.42.1", {{"NULL", "NULL"}});
+
+        string prefix = "__keyspace@" + to_string(m_app_db->getDbId()) + "__:" + poolTable.getKeyName("");
+        auto subscriber = static_cast<NatKeyspaceSubscriber *>(mirror.getSelectable());
+
+        // The pool IP set by natmgrd, then a notification of another table
+        for (const auto &channel : { prefix + "65.55.42.1", string("__keyspace@0__:NAT_TABLE:65.55.42.1") })
+        {
+            mockReply = pmessage(prefix + "*", channel, "hset");
+            subscriber->readData();
+            mockReply = nullptr;
+        }
+        ASSERT_TRUE(subscriber->hasData());
+
+        mirror.sync();
+        ASSERT_FALSE(subscriber->hasData());
+        ASSERT_TRUE(mirror.exists("65.55.42.1"));
+        ASSERT_EQ(mirror.size(), 1u);
+        ASSERT_EQ(mirror.getLookupCount(), 1u);
+    }
+}
@@ -0,0 +1,414 @@
+#define private public
+#include "natorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_table.h"
+
+extern sai_nat_api_t *sai_nat_api;
+extern sai_switch_api_t *sai_switch_api;
+
+namespace natorch_test
+{
+    using namespace std;
+
+    vector<uint32_t> bulk_get_calls;
+    uint32_t single_get_calls;
+
+    // Returns the source IP of the entry as the byte count and the destination IP as the packet count
+    sai_status_t get_nat_entries_attribute(
+            uint32_t object_count,
+            const sai_nat_entry_t *nat_entry,
+            const uint32_t *attr_count,
+            sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_get_calls.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            EXPECT_EQ(attr_count[i], 2u);
+            attr_list[i][0].value.u64 = nat_entry[i].data.key.src_ip;
+            attr_list[i][1].value.u64 = nat_entry[i].data.key.dst_ip;
+            object_statuses[i] = (nat_entry[i].data.key.src_ip == 7) ? SAI_STATUS_ITEM_NOT_FOUND : SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t get_nat_entries_attribute_not_implemented(
+            uint32_t object_count,
+            const sai_nat_entry_t *nat_entry,
+            const uint32_t *attr_count,
+            sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_get_calls.push_back(object_count);
+        return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+
+    sai_status_t get_nat_entry_attribute(
+            const sai_nat_entry_t *nat_entry,
+            uint32_t attr_count,
+            sai_attribute_t *attr_list)
+    {
+        single_get_calls++;
+        attr_list[0].value.u64 = nat_entry->data.key.src_ip;
+        attr_list[1].value.u64 = nat_entry->data.key.dst_ip;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct NatEntryBulkQueryTest : public ::testing::Test
+    {
+        vector<sai_attribute_t> m_attrs;
+
+        void SetUp() override
+        {
+            ASSERT_EQ(sai_nat_api, nullptr);
+            sai_nat_api = new sai_nat_api_t();
+            sai_nat_api->get_nat_entries_attribute = get_nat_entries_attribute;
+            sai_nat_api->get_nat_entry_attribute = get_nat_entry_attribute;
+
+            bulk_get_calls.clear();
+            single_get_calls = 0;
+
+            m_attrs.resize(2);
+            m_attrs[0].id = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
+            m_attrs[1].id = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
+        }
+
+        void TearDown() override
+        {
+            delete sai_nat_api;
+            sai_nat_api = nullptr;
+        }
+
+        void AddEntries(NatEntryBulkQuery &query, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                sai_nat_entry_t entry = {};
+                entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
+                entry.data.key.src_ip = i;
+                entry.data.key.dst_ip = i * 2;
+                ASSERT_EQ(query.add(entry), i);
+            }
+        }
+    };
+
+    TEST_F(NatEntryBulkQueryTest, QueriesInBulkChunks)
+    {
+        NatEntryBulkQuery query(m_attrs);
+        AddEntries(query, 2500);
+        query.query();
+
+        ASSERT_EQ(bulk_get_calls, vector<uint32_t>({ 1024, 1024, 452 }));
+        ASSERT_EQ(single_get_calls, 0u);
+        ASSERT_TRUE(query.isBulkSupported());
+
+        ASSERT_EQ(query.size(), 2500u);
+        for (uint32_t i = 0; i < 2500; i++)
+        {
+            if (i == 7)
+            {
+                ASSERT_FALSE(query.isOk(i));
+                continue;
+            }
+            ASSERT_TRUE(query.isOk(i));
+            ASSERT_EQ(query.getValue(i, 0).u64, i);
+            ASSERT_EQ(query.getValue(i, 1).u64, i * 2);
+        }
+    }
+
+    TEST_F(NatEntryBulkQueryTest, FallsBackToSingleGets)
+    {
+        sai_nat_api->get_nat_entries_attribute = get_nat_entries_attribute_not_implemented;
+
+        NatEntryBulkQuery query(m_attrs);
+        AddEntries(query, 1500);
+        query.query();
+
+        // Only the first chunk is tried in bulk
+        ASSERT_EQ(bulk_get_calls, vector<uint32_t>({ 1024 }));
+        ASSERT_EQ(single_get_calls, 1500u);
+        ASSERT_FALSE(query.isBulkSupported());
+        for (uint32_t i = 0; i < 1500; i++)
+        {
+            ASSERT_TRUE(query.isOk(i));
+            ASSERT_EQ(query.getValue(i, 1).u64, i * 2);
+        }
+
+        // Later queries of the orch skip the bulk get
+        NatEntryBulkQuery next(m_attrs, query.isBulkSupported());
+        AddEntries(next, 10);
+        next.query();
+        ASSERT_EQ(bulk_get_calls.size(), 1u);
+        ASSERT_EQ(single_get_calls, 1510u);
+    }
+
+    TEST(NatSweepSliceTest, SpreadsSweepOverTicks)
+    {
+        map<int, int> entries;
+        NatSweepCursor<int> cursor;
+        vector<size_t> sizes;
+
+        for (int i = 0; i < 14; i++)
+        {
+            entries[i] = i;
+        }
+
+        // A sixth of the entries, rounded up, per tick
+        vector<int> swept;
+        for (uint32_t tick = 0; tick < NAT_HITBIT_QUERY_MULTIPLE; tick++)
+        {
+            auto slice = getSweepSlice(entries, cursor, tick);
+            sizes.push_back(slice.size());
+            for (const auto &iter : slice)
+            {
+                swept.push_back(iter->first);
+            }
+        }
+        ASSERT_EQ(sizes, vector<size_t>({ 3, 3, 3, 3, 2, 0 }));
+        ASSERT_EQ(swept.size(), 14u);
+        for (int i = 0; i < 14; i++)
+        {
+            ASSERT_EQ(swept[i], i);
+        }
+
+        // The next sweep starts over from the first entry
+        auto slice = getSweepSlice(entries, cursor, NAT_HITBIT_QUERY_MULTIPLE);
+        ASSERT_EQ(slice.size(), 3u);
+        ASSERT_EQ(slice[0]->first, 0);
+    }
+
+    TEST(NatSweepSliceTest, LastTickTakesRemainder)
+    {
+        map<int, int> entries;
+        NatSweepCursor<int> cursor;
+
+        for (int i = 0; i < 6; i++)
+        {
+            entries[i * 10] = i;
+        }
+        for (uint32_t tick = 0; tick < NAT_HITBIT_QUERY_MULTIPLE - 1; tick++)
+        {
+            ASSERT_EQ(getSweepSlice(entries, cursor, tick).size(), 1u);
+        }
+
+        // The cursor entry is removed and entries are added during the sweep, all the remaining ones are taken
+        entries.erase(40);
+        for (int i = 0; i < 10; i++)
+        {
+            entries[41 + i] = i;
+        }
+        auto slice = getSweepSlice(entries, cursor, NAT_HITBIT_QUERY_MULTIPLE - 1);
+        ASSERT_EQ(slice.size(), 10u);
+        ASSERT_EQ(slice.front()->first, 41);
+        ASSERT_EQ(slice.back()->first, 50);
+
+        // Entries added before the cursor are left to the next sweep
+        entries[5] = 0;
+        ASSERT_TRUE(getSweepSlice(entries, cursor, NAT_HITBIT_QUERY_MULTIPLE - 1).empty());
+    }
+
+    /* Source (SNAT) or destination (DNAT) IP and L4 port of the entries with the hit bit set */
+    set<pair<uint32_t, uint16_t>> hit_entries;
+    vector<sai_nat_entry_t> queried_entries;
+
+    sai_status_t get_nat_entries_attribute_hit_bits(
+            uint32_t object_count,
+            const sai_nat_entry_t *nat_entry,
+            const uint32_t *attr_count,
+            sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_get_calls.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            bool dnat = (nat_entry[i].nat_type == SAI_NAT_TYPE_DESTINATION_NAT);
+            uint32_t ip = dnat ? nat_entry[i].data.key.dst_ip : nat_entry[i].data.key.src_ip;
+            uint16_t port = dnat ? nat_entry[i].data.key.l4_dst_port : nat_entry[i].data.key.l4_src_port;
+
+            queried_entries.push_back(nat_entry[i]);
+            if (attr_list[i][0].id == SAI_NAT_ENTRY_ATTR_HIT_BIT)
+            {
+                attr_list[i][0].value.booldata = hit_entries.count({ ip, port }) != 0;
+            }
+            else
+            {
+                attr_list[i][0].value.u64 = port;
+                attr_list[i][1].value.u64 = 1;
+            }
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t get_switch_attribute_not_supported(
+            sai_object_id_t switch_id,
+            uint32_t attr_count,
+            sai_attribute_t *attr_list)
+    {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    struct NatOrchSweepTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<NatOrch> m_natOrch;
+        time_t m_now;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            ASSERT_EQ(sai_nat_api, nullptr);
+            sai_nat_api = new sai_nat_api_t();
+            sai_nat_api->get_nat_entries_attribute = get_nat_entries_attribute_hit_bits;
+
+            sai_switch_api_t *old_sai_switch_api = sai_switch_api;
+            sai_switch_api_t ut_sai_switch_api = {};
+            ut_sai_switch_api.get_switch_attribute = get_switch_attribute_not_supported;
+            sai_switch_api = &ut_sai_switch_api;
+
+            vector<table_name_with_pri_t> tableNames;
+            m_natOrch = make_shared<NatOrch>(m_app_db.get(), m_state_db.get(), tableNames, nullptr, nullptr);
+            sai_switch_api = old_sai_switch_api;
+
+            bulk_get_calls.clear();
+            hit_entries.clear();
+            queried_entries.clear();
+
+            struct timespec time_now;
+            ASSERT_EQ(clock_gettime(CLOCK_MONOTONIC, &time_now), 0);
+            m_now = time_now.tv_sec;
+        }
+
+        void TearDown() override
+        {
+            m_natOrch.reset();
+            delete sai_nat_api;
+            sai_nat_api = nullptr;
+        }
+
+        NaptEntryValue &addNapt(const string &ip, int port, const string &translatedIp, int translatedPort,
+                                const string &natType, const string &entryType = "dynamic", bool addedToHw = true)
+        {
+            NaptEntryKey key;
+            key.ip_address = IpAddress(ip);
+            key.l4_port = port;
+            key.prototype = "TCP";
+
+            NaptEntryValue &value = m_natOrch->m_naptEntries[key];
+            value.translated_ip = IpAddress(translatedIp);
+            value.translated_l4_port = translatedPort;
+            value.nat_type = natType;
+            value.entry_type = entryType;
+            value.activeTime = m_now;
+            value.ageOutTime = 0;
+            value.addedToHw = addedToHw;
+            return value;
+        }
+
+
+        string sweepCounter(const string &field)
+        {
+            string value;
+            m_natOrch->m_countersGlobalNatTable.hget(VALUES, field, value);
+            return value;
+        }
+    };
+
+    TEST_F(NatOrchSweepTest, AgesOutIdleEntries)
+    {
+        time_t idleSince = m_now - m_natOrch->tcp_timeout - 10;
+
+        // Hit in hardware
+        auto &hit = addNapt("10.0.0.1", 1000, "65.55.42.1", 2000, "snat");
+        hit_entries.insert({ IpAddress("10.0.0.1").getV4Addr(), 1000 });
+        hit.activeTime = idleSince;
+
+        // Only the reverse DNAPT entry is hit
+        auto &reverseHit = addNapt("10.0.0.2", 1000, "65.55.42.1", 2001, "snat");
+        auto &dnapt = addNapt("65.55.42.1", 2001, "10.0.0.2", 1000, "dnat");
+        hit_entries.insert({ IpAddress("65.55.42.1").getV4Addr(), 2001 });
+        reverseHit.activeTime = idleSince;
+        dnapt.activeTime = idleSince;
+
+        // Idle for longer than the timeout, and idle since less than the timeout
+        auto &idle = addNapt("10.0.0.3", 1000, "65.55.42.1", 2002, "snat");
+        idle.activeTime = idleSince;
+        auto &recent = addNapt("10.0.0.4", 1000, "65.55.42.1", 2003, "snat");
+        recent.activeTime = m_now - 10;
+
+        // Never queried, a static entry is always active
+        auto &staticEntry = addNapt("10.0.0.5", 1000, "65.55.42.1", 2004, "snat", "static");
+        staticEntry.activeTime = idleSince;
+        auto &notInHw = addNapt("10.0.0.6", 1000, "65.55.42.1", 2005, "snat", "dynamic", false);
+        notInHw.activeTime = idleSince;
+
+        for (uint32_t tick = 0; tick < NAT_HITBIT_QUERY_MULTIPLE; tick++)
+        {
+            m_natOrch->queryHitBits(tick);
+        }
+
+        // The SNAPT entries in hardware once each, the DNAPT entry as the reverse of an idle one
+        ASSERT_EQ(queried_entries.size(), 5u);
+        set<pair<uint32_t, uint16_t>> queried;
+        for (const auto &entry : queried_entries)
+        {
+            queried.insert({ entry.data.key.src_ip | entry.data.key.dst_ip,
+                             entry.data.key.l4_src_port | entry.data.key.l4_dst_port });
+        }
+        ASSERT_EQ(queried.size(), 5u);
+        ASSERT_EQ(queried.count({ IpAddress("10.0.0.5").getV4Addr(), 1000 }), 0u);
+        ASSERT_EQ(queried.count({ IpAddress("10.0.0.6").getV4Addr(), 1000 }), 0u);
+
+        ASSERT_GE(hit.activeTime, m_now);
+        ASSERT_EQ(hit.ageOutTime, hit.activeTime + m_natOrch->tcp_timeout);
+        ASSERT_GE(reverseHit.activeTime, m_now);
+        ASSERT_EQ(reverseHit.ageOutTime, reverseHit.activeTime + m_natOrch->tcp_timeout);
+        ASSERT_EQ(dnapt.activeTime, idleSince);
+        ASSERT_EQ(idle.activeTime, idleSince);
+        ASSERT_EQ(recent.activeTime, m_now - 10);
+        ASSERT_GE(staticEntry.activeTime, m_now);
+        ASSERT_EQ(staticEntry.ageOutTime, 0);
+        ASSERT_EQ(notInHw.activeTime, idleSince);
+
+        // Only the entry idle for longer than the timeout is notified
+        ASSERT_EQ(sweepCounter("HITBIT_SWEEP_ENTRIES"), "5");
+        ASSERT_EQ(sweepCounter("HITBIT_SWEEP_AGED_OUT"), "1");
+    }
+
+    TEST_F(NatOrchSweepTest, QueriesCountersInSlices)
+    {
+        for (int i = 0; i < 14; i++)
+        {
+            addNapt("10.0.0.1", 1000 + i, "65.55.42.1", 2000 + i, "snat");
+        }
+
+        // A slice of the entries per tick, the sweep counters are exported at the end of the sweep
+        for (uint32_t tick = 0; tick < NAT_HITBIT_QUERY_MULTIPLE - 1; tick++)
+        {
+            m_natOrch->queryCounters(tick);
+        }
+        ASSERT_EQ(bulk_get_calls, vector<uint32_t>({ 3, 3, 3, 3, 2 }));
+        ASSERT_EQ(sweepCounter("COUNTERS_SWEEP_ENTRIES"), "");
+
+        m_natOrch->queryCounters(NAT_HITBIT_QUERY_MULTIPLE - 1);
+        ASSERT_EQ(bulk_get_calls.size(), 5u);
+        ASSERT_EQ(sweepCounter("COUNTERS_SWEEP_ENTRIES"), "14");
+
+        string bytes;
+        ASSERT_TRUE(m_natOrch->m_countersNaptTable.hget("TCP:10.0.0.1:1013", "NAT_TRANSLATIONS_BYTES", bytes));
+        ASSERT_EQ(bytes, "1013");
+
+        // The next sweep starts over
+        m_natOrch->queryCounters(NAT_HITBIT_QUERY_MULTIPLE);
+        ASSERT_EQ(bulk_get_calls.back(), 3u);
+        ASSERT_EQ(queried_entries.back().data.key.l4_src_port, 1002);
+    }
+}
@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include <netinet/in.h>
+#include "../mock_table.h"
+#define private public
+#include "natsync.h"
+#undef private
+
+namespace natsyncd_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct NatSyncTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<DBConnector> m_state_db;
+        shared_ptr<RedisPipeline> m_pipeline;
+        shared_ptr<NatSync> m_sync;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_state_db = make_shared<DBConnector>("STATE_DB", 0);
+            m_pipeline = make_shared<RedisPipeline>(m_app_db.get());
+            m_sync = make_shared<NatSync>(m_pipeline.get(), m_app_db.get(), m_state_db.get(), nullptr);
+        }
+
+        virtual void TearDown() override
+        {
+            m_sync.reset();
+        }
+
+        /* A TCP flow source NAT'ted by the kernel */
+        static naptEntry snatFlow(const string &srcIp, uint16_t srcPort, const string &natIp, uint16_t natPort)
+        {
+            naptEntry entry;
+
+            entry.conntrack_id = 1;
+            entry.protocol = IPPROTO_TCP;
+            entry.orig_src_ip = IpAddress(srcIp);
+            entry.orig_src_l4_port = srcPort;
+            entry.orig_dest_ip = IpAddress("20.0.0.100");
+            entry.orig_dst_l4_port = 80;
+            entry.nat_src_ip = IpAddress(natIp);
+            entry.nat_src_l4_port = natPort;
+            entry.nat_dest_ip = entry.orig_dest_ip;
+            entry.nat_dst_l4_port = entry.orig_dst_l4_port;
+            entry.ct_status = 0;
+            return entry;
+        }
+
+        /* An entry natmgrd writes to APP_DB, and its keyspace notification */
+        static void setByNatMgr(Table &table, NatTableMirror &mirror, const string &key,
+                                const vector<FieldValueTuple> &values)
+        {
+            table.set(key, values);
+            mirror.onKeyspaceEvent(key, "hset");
+        }
+
+        uint64_t lookups()
+        {
+            return m_sync->m_natMirror.getLookupCount() + m_sync->m_naptMirror.getLookupCount() +
+                   m_sync->m_naptPoolMirror.getLookupCount() + m_sync->m_twiceNatMirror.getLookupCount() +
+                   m_sync->m_twiceNaptMirror.getLookupCount();
+        }
+
+        string entryType(const string &tableName, const string &key)
+        {
+            Table table(m_app_db.get(), tableName);
+            string value;
+            return table.hget(key, "entry_type", value) ? value : "";
+        }
+    };
+
+    TEST_F(NatSyncTest, OwnFlowsAreNotLookedUp)
+    {
+        auto flow = snatFlow("10.0.0.1", 1000, "65.55.42.1", 2000);
+
+        // The port is translated, SNAPT entry and its implicit DNAPT one
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 0);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:10.0.0.1:1000"), "dynamic");
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:65.55.42.1:2000"), "dynamic");
+        ASSERT_EQ(m_sync->m_flowsInstalled, 1u);
+
+        // Same conntrack notification again
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 1);
+        ASSERT_EQ(m_sync->m_flowsInstalled, 1u);
+
+        // The notifications of the entries orchagent applied come back
+        for (uint16_t port = 1001; port <= 1100; port++)
+        {
+            auto other = snatFlow("10.0.0.1", port, "65.55.42.1", static_cast<uint16_t>(port + 1000));
+            ASSERT_EQ(m_sync->addNatEntry(nullptr, other, true), 0);
+        }
+        Table naptTable(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        vector<string> keys;
+        naptTable.getKeys(keys);
+        ASSERT_EQ(keys.size(), 202u);
+        for (const auto &key : keys)
+        {
+            m_sync->m_naptMirror.onKeyspaceEvent(key, "hset");
+        }
+
+        ASSERT_EQ(m_sync->m_flowsInstalled, 101u);
+        ASSERT_EQ(lookups(), 0u);
+    }
+
+    TEST_F(NatSyncTest, PoolIpMakesNapt)
+    {
+        // Same port and no pool, basic SNAT
+        auto flow = snatFlow("10.0.0.1", 1000, "65.55.42.1", 1000);
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 0);
+        ASSERT_EQ(entryType(APP_NAT_TABLE_NAME, "10.0.0.1"), "dynamic");
+        ASSERT_EQ(entryType(APP_NAT_TABLE_NAME, "65.55.42.1"), "dynamic");
+
+        // A pool IP of natmgrd, the flows translated to it are NAPT ones
+        Table poolTable(m_app_db.get(), APP_NAPT_POOL_IP_TABLE_NAME);
+        setByNatMgr(poolTable, m_sync->m_naptPoolMirror, "65.55.42.2", { {"NULL", "NULL"} });
+
+        flow = snatFlow("10.0.0.2", 1000, "65.55.42.2", 1000);
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 0);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:10.0.0.2:1000"), "dynamic");
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:65.55.42.2:1000"), "dynamic");
+        ASSERT_EQ(entryType(APP_NAT_TABLE_NAME, "10.0.0.2"), "");
+
+        ASSERT_EQ(lookups(), 1u);
+    }
+
+    TEST_F(NatSyncTest, StaticEntryTakesPrecedence)
+    {
+        Table naptTable(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        setByNatMgr(naptTable, m_sync->m_naptMirror, "TCP:65.55.42.1:2000",
+                    { {"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "10.0.0.1"},
+                      {"translated_l4_port", "1000"} });
+
+        // The kernel reports the static DNAPT entry as a SNAPT flow
+        auto flow = snatFlow("10.0.0.1", 1000, "65.55.42.1", 2000);
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 1);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:10.0.0.1:1000"), "");
+
+        // Nor is it removed with the flow
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, false), 1);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:65.55.42.1:2000"), "static");
+        ASSERT_EQ(m_sync->m_flowsInstalled, 0u);
+    }
+
+    TEST_F(NatSyncTest, DeleteVerifiesOwnEntries)
+    {
+        auto flow = snatFlow("10.0.0.1", 1000, "65.55.42.1", 2000);
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 0);
+
+        // Removed with the flow
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, false), 0);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:10.0.0.1:1000"), "");
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:65.55.42.1:2000"), "");
+        ASSERT_EQ(lookups(), 2u);
+
+        // natmgrd replaced the implicit DNAPT entry with a static one, its notification is skipped
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, true), 0);
+        Table naptTable(m_app_db.get(), APP_NAPT_TABLE_NAME);
+        setByNatMgr(naptTable, m_sync->m_naptMirror, "TCP:65.55.42.1:2000",
+                    { {"nat_type", "dnat"}, {"entry_type", "static"}, {"translated_ip", "10.0.0.1"},
+                      {"translated_l4_port", "1000"} });
+        ASSERT_EQ(lookups(), 2u);
+
+        // The dynamic entry is removed, the static one is kept
+        ASSERT_EQ(m_sync->addNatEntry(nullptr, flow, false), 1);
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:10.0.0.1:1000"), "");
+        ASSERT_EQ(entryType(APP_NAPT_TABLE_NAME, "TCP:65.55.42.1:2000"), "static");
+        ASSERT_EQ(lookups(), 4u);
+
+        bool isStatic = false;
+        ASSERT_TRUE(m_sync->m_naptMirror.find("TCP:65.55.42.1:2000", isStatic));
+        ASSERT_TRUE(isStatic);
+    }
+}
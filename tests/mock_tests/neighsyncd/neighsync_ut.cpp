@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include <netinet/in.h>
+#include <linux/neighbour.h>
+#include <netlink/route/neighbour.h>
+#define private public
+#include "neighsync.h"
+#undef private
+#include "mock_table.h"
+
+/*
+ * Mock rtnl_link_i2name() call
+ * Ifindex 1 is Ethernet0 and ifindex 2 is Vlan1000, other ifindexes have no name.
+ */
+extern "C" {
+char *__wrap_rtnl_link_i2name(struct nl_cache *cache, int ifindex, char *dst, size_t len)
+{
+    switch (ifindex)
+    {
+        case 1:
+            strncpy(dst, "Ethernet0", len);
+            return dst;
+        case 2:
+            strncpy(dst, "Vlan1000", len);
+            return dst;
+        default:
+            return NULL;
+    }
+}
+}
+
+namespace neighsyncd_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct NeighSyncTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<DBConnector> m_state_db;
+        shared_ptr<DBConnector> m_config_db;
+        shared_ptr<DBConnector> m_counters_db;
+        shared_ptr<RedisPipeline> m_pipeline;
+        shared_ptr<NeighSync> m_sync;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_state_db = make_shared<DBConnector>("STATE_DB", 0);
+            m_config_db = make_shared<DBConnector>("CONFIG_DB", 0);
+            m_counters_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+            m_pipeline = make_shared<RedisPipeline>(m_app_db.get());
+            m_sync = make_shared<NeighSync>(m_pipeline.get(), m_state_db.get(), m_config_db.get());
+        }
+
+        virtual void TearDown() override
+        {
+            m_sync.reset();
+        }
+
+        void sendNeigh(int nlmsg_type, int family, int ifindex, const string &ip,
+                       const string &mac = "00:11:22:33:44:55", int state = NUD_REACHABLE)
+        {
+            struct rtnl_neigh *neigh = rtnl_neigh_alloc();
+            struct nl_addr *dst = NULL;
+            struct nl_addr *lladdr = NULL;
+
+            nl_addr_parse(ip.c_str(), family, &dst);
+            nl_addr_parse(mac.c_str(), AF_LLC, &lladdr);
+            rtnl_neigh_set_family(neigh, family);
+            rtnl_neigh_set_ifindex(neigh, ifindex);
+            rtnl_neigh_set_dst(neigh, dst);
+            rtnl_neigh_set_lladdr(neigh, lladdr);
+            rtnl_neigh_set_state(neigh, state);
+
+            m_sync->onMsg(nlmsg_type, (struct nl_object *)neigh);
+
+            nl_addr_put(dst);
+            nl_addr_put(lladdr);
+            rtnl_neigh_put(neigh);
+        }
+
+        bool neighExists(const string &key)
+        {
+            Table neighTable(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+            vector<FieldValueTuple> fvs;
+            return neighTable.get(key, fvs);
+        }
+    };
+
+    TEST_F(NeighSyncTest, PeerSwitchCache)
+    {
+        Table peerSwitchTable(m_config_db.get(), CFG_PEER_SWITCH_TABLE_NAME);
+
+        // Not a dual ToR, IPv4 link local neighbors are kept
+        m_sync->loadConfigTables();
+        ASSERT_TRUE(m_sync->m_peerSwitches.empty());
+        sendNeigh(RTM_NEWNEIGH, AF_INET, 1, "169.254.0.1");
+        ASSERT_TRUE(neighExists("Ethernet0:169.254.0.1"));
+
+        // A peer switch added at run time makes it a dual ToR
+        peerSwitchTable.set("peer_switch_hostname", { {"address_ipv4", "10.1.0.33"} });
+        ASSERT_TRUE(m_sync->processConfigTable(&m_sync->m_cfgPeerSwitchTable));
+        ASSERT_EQ(m_sync->m_peerSwitches.count("peer_switch_hostname"), 1u);
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET, 1, "169.254.0.2");
+        ASSERT_FALSE(neighExists("Ethernet0:169.254.0.2"));
+
+        // Unresolved neighbors get a zero MAC on a dual ToR
+        sendNeigh(RTM_NEWNEIGH, AF_INET, 1, "10.0.0.2", "00:11:22:33:44:55", NUD_FAILED);
+        vector<FieldValueTuple> fvs;
+        Table neighTable(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+        ASSERT_TRUE(neighTable.get("Ethernet0:10.0.0.2", fvs));
+        string mac;
+        ASSERT_TRUE(neighTable.hget("Ethernet0:10.0.0.2", "neigh", mac));
+        ASSERT_EQ(mac, "00:00:00:00:00:00");
+    }
+
+    TEST_F(NeighSyncTest, LinkLocalOnlyInterfaceCache)
+    {
+        Table intfTable(m_config_db.get(), CFG_INTF_TABLE_NAME);
+        Table vlanIntfTable(m_config_db.get(), CFG_VLAN_INTF_TABLE_NAME);
+
+        // The interface entry carries the setting, its IP prefixes are skipped
+        intfTable.set("Ethernet0", { {"ipv6_use_link_local_only", "enable"} });
+        intfTable.set("Ethernet0|fe80::1/64", { {"NULL", "NULL"} });
+        vlanIntfTable.set("Vlan1000", { {"ipv6_use_link_local_only", "disable"} });
+        m_sync->loadConfigTables();
+        ASSERT_EQ(m_sync->m_linkLocalIntfs, set<string>({"Ethernet0"}));
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, 1, "fe80::2");
+        ASSERT_TRUE(neighExists("Ethernet0:fe80::2"));
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, 2, "fe80::2");
+        ASSERT_FALSE(neighExists("Vlan1000:fe80::2"));
+
+        // Enabled on the VLAN and disabled on the port at run time
+        vlanIntfTable.set("Vlan1000", { {"ipv6_use_link_local_only", "enable"} });
+        ASSERT_TRUE(m_sync->processConfigTable(&m_sync->m_cfgVlanInterfaceTable));
+        intfTable.set("Ethernet0", { {"ipv6_use_link_local_only", "disable"} });
+        ASSERT_TRUE(m_sync->processConfigTable(&m_sync->m_cfgInterfaceTable));
+        ASSERT_EQ(m_sync->m_linkLocalIntfs, set<string>({"Vlan1000"}));
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, 2, "fe80::2");
+        ASSERT_TRUE(neighExists("Vlan1000:fe80::2"));
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, 1, "fe80::3");
+        ASSERT_FALSE(neighExists("Ethernet0:fe80::3"));
+
+        // Deleting a link local neighbor does not depend on the setting
+        sendNeigh(RTM_DELNEIGH, AF_INET6, 1, "fe80::2");
+        ASSERT_FALSE(neighExists("Ethernet0:fe80::2"));
+
+        // Not a config table
+        ASSERT_FALSE(m_sync->processConfigTable(nullptr));
+    }
+
+    TEST_F(NeighSyncTest, BufferedNeighTable)
+    {
+        // NEIGH_TABLE writes are held in the pipeline until it is flushed once per select iteration
+        ASSERT_TRUE(m_sync->m_neighTable.m_buffered);
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET, 1, "10.0.0.2");
+        sendNeigh(RTM_NEWNEIGH, AF_INET, 2, "192.168.0.2");
+        m_pipeline->flush();
+        ASSERT_TRUE(neighExists("Ethernet0:10.0.0.2"));
+        ASSERT_TRUE(neighExists("Vlan1000:192.168.0.2"));
+    }
+
+    TEST_F(NeighSyncTest, PublishStats)
+    {
+        Table statsTable(m_counters_db.get(), COUNTERS_NEIGHSYNCD_TABLE);
+        string value;
+
+        // Messages other than neighbor ones are not counted
+        m_sync->onMsg(RTM_NEWLINK, nullptr);
+        for (int i = 0; i < 30; i++)
+        {
+            sendNeigh(RTM_NEWNEIGH, AF_INET, 1, "10.0.0." + to_string(i + 1));
+        }
+        ASSERT_EQ(m_sync->getProcessedCount(), 30u);
+
+        m_sync->publishStats(statsTable);
+        ASSERT_TRUE(statsTable.hget(NEIGH_STATS_KEY, "processed", value));
+        ASSERT_EQ(value, "30");
+        ASSERT_TRUE(statsTable.hget(NEIGH_STATS_KEY, "processed_per_sec", value));
+        ASSERT_EQ(value, to_string(30 / NEIGH_STATS_INTERVAL));
+
+        // The rate only covers the messages since the previous interval
+        for (int i = 0; i < 10; i++)
+        {
+            sendNeigh(RTM_DELNEIGH, AF_INET, 1, "10.0.0." + to_string(i + 1));
+        }
+        m_sync->publishStats(statsTable);
+        ASSERT_TRUE(statsTable.hget(NEIGH_STATS_KEY, "processed", value));
+        ASSERT_EQ(value, "40");
+        ASSERT_TRUE(statsTable.hget(NEIGH_STATS_KEY, "processed_per_sec", value));
+        ASSERT_EQ(value, to_string(10 / NEIGH_STATS_INTERVAL));
+    }
+}
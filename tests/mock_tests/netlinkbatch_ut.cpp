@@ -0,0 +1,292 @@
+#define private public
+#include "netlinkbatch.h"
+#undef private
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+namespace netlinkbatch_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    static int failVlanAdd(const string &cmd, string &stdout)
+    {
+        mockCallArgs.push_back(cmd);
+        if (cmd.find("vlan add vid 20 ") != string::npos)
+        {
+            stdout = "RTNETLINK answers: Operation not supported";
+            return 2;
+        }
+        stdout.clear();
+        return 0;
+    }
+
+    /* Runs a shell fallback command for real */
+    static int runCommand(const string &cmd, string &stdout)
+    {
+        stdout.clear();
+        int ret = system((cmd + " > /dev/null 2>&1").c_str());
+        return WIFEXITED(ret) ? WEXITSTATUS(ret) : -1;
+    }
+
+    struct NetlinkBatchTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            mockCallArgs.clear();
+        }
+
+        virtual void TearDown() override
+        {
+            callback = nullptr;
+        }
+    };
+
+    TEST_F(NetlinkBatchTest, ShellFallback)
+    {
+        NetlinkBatch batch(NetlinkBatch::SHELL);
+        ASSERT_EQ(batch.getMode(), NetlinkBatch::SHELL);
+
+        auto master = batch.setLinkMaster("Ethernet0", "Bridge");
+        auto del = batch.delBridgeVlan("Ethernet0", 1);
+        auto untagged = batch.addBridgeVlan("Ethernet0", 10, true);
+        auto tagged = batch.addBridgeVlan("Ethernet0", 20, false);
+        auto nomaster = batch.setLinkMaster("Ethernet4", "");
+        ASSERT_EQ(batch.size(), 5u);
+        ASSERT_TRUE(mockCallArgs.empty());
+
+        callback = failVlanAdd;
+        ASSERT_EQ(batch.commit(), 1u);
+
+        // Each operation runs its own command, in order, and reports its own result
+        ASSERT_EQ(mockCallArgs, vector<string>({
+            "/sbin/ip link set \"Ethernet0\" master \"Bridge\"",
+            "/sbin/bridge vlan del vid 1 dev \"Ethernet0\"",
+            "/sbin/bridge vlan add vid 10 dev \"Ethernet0\" pvid untagged",
+            "/sbin/bridge vlan add vid 20 dev \"Ethernet0\"",
+            "/sbin/ip link set \"Ethernet4\" nomaster",
+        }));
+        ASSERT_TRUE(batch.isOk(master));
+        ASSERT_TRUE(batch.isOk(del));
+        ASSERT_TRUE(batch.isOk(untagged));
+        ASSERT_FALSE(batch.isOk(tagged));
+        ASSERT_EQ(batch.getError(tagged),
+                  "/sbin/bridge vlan add vid 20 dev \"Ethernet0\" : RTNETLINK answers: Operation not supported");
+        ASSERT_TRUE(batch.isOk(nomaster));
+
+        batch.clear();
+        ASSERT_EQ(batch.size(), 0u);
+    }
+
+    TEST_F(NetlinkBatchTest, FdbShellFallback)
+    {
+        NetlinkBatch batch(NetlinkBatch::SHELL);
+
+        batch.replaceFdb("Ethernet0", "00:11:22:33:44:55", 10, NetlinkBatch::FDB_DYNAMIC_EXT_LEARN);
+        batch.replaceFdb("Ethernet0", "00:11:22:33:44:66", 10, NetlinkBatch::FDB_STICKY_STATIC);
+        batch.delFdb("Ethernet4", "00:11:22:33:44:77", 20, NetlinkBatch::FDB_STATIC);
+        ASSERT_EQ(batch.commit(), 0u);
+
+        ASSERT_EQ(mockCallArgs, vector<string>({
+            "/sbin/bridge fdb replace \"00:11:22:33:44:55\" dev \"Ethernet0\" master dynamic extern_learn vlan 10",
+            "/sbin/bridge fdb replace \"00:11:22:33:44:66\" dev \"Ethernet0\" master sticky static vlan 10",
+            "/sbin/bridge fdb del \"00:11:22:33:44:77\" dev \"Ethernet4\" master static vlan 20",
+        }));
+    }
+
+    TEST_F(NetlinkBatchTest, VlanDeviceShellFallback)
+    {
+        NetlinkBatch batch(NetlinkBatch::SHELL);
+
+        batch.addBridgeVlan("Bridge", 10, false, true);
+        batch.addVlanLink("Bridge", "Vlan10", 10, "00:11:22:33:44:55");
+        batch.delLink("Vlan10");
+        batch.delBridgeVlan("Bridge", 10, true);
+        ASSERT_EQ(batch.commit(), 0u);
+
+        ASSERT_EQ(mockCallArgs, vector<string>({
+            "/sbin/bridge vlan add vid 10 dev \"Bridge\" self",
+            "/sbin/ip link add link \"Bridge\" up name \"Vlan10\" address \"00:11:22:33:44:55\" type vlan id 10",
+            "/sbin/ip link del \"Vlan10\"",
+            "/sbin/bridge vlan del vid 10 dev \"Bridge\" self",
+        }));
+
+        // Nothing to dump without the netlink socket, the caller decides on its own
+        set<string> ports;
+        ASSERT_FALSE(batch.getBridgeVlanPorts(ports));
+    }
+
+    TEST_F(NetlinkBatchTest, UnknownDeviceFailsWithoutKernelRequest)
+    {
+        NetlinkBatch batch;
+        if (batch.getMode() != NetlinkBatch::NETLINK)
+        {
+            GTEST_SKIP() << "netlink socket not available";
+        }
+
+        auto index = batch.addBridgeVlan("NoSuchEthernet0", 10, false);
+        ASSERT_EQ(batch.commit(), 1u);
+        ASSERT_FALSE(batch.isOk(index));
+        ASSERT_EQ(batch.getError(index),
+                  "/sbin/bridge vlan add vid 10 dev \"NoSuchEthernet0\" : " + string(strerror(ENODEV)));
+        ASSERT_TRUE(mockCallArgs.empty());
+
+        index = batch.replaceFdb("Ethernet0", "not-a-mac", 10, NetlinkBatch::FDB_STATIC);
+        ASSERT_EQ(batch.getError(index),
+                  "/sbin/bridge fdb replace \"not-a-mac\" dev \"Ethernet0\" master static vlan 10 : " + string(strerror(EINVAL)));
+    }
+
+    TEST_F(NetlinkBatchTest, StrayAckIsIgnored)
+    {
+        NetlinkBatch batch;
+        if (batch.getMode() != NetlinkBatch::NETLINK)
+        {
+            GTEST_SKIP() << "netlink socket not available";
+        }
+
+        // The ack of another request is received before the acks of the batch
+        struct
+        {
+            struct nlmsghdr hdr;
+            struct ifinfomsg ifi;
+        } req = {};
+        req.hdr.nlmsg_len = sizeof(req);
+        req.hdr.nlmsg_type = RTM_GETLINK;
+        req.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+        req.hdr.nlmsg_seq = batch.m_seq - 1;
+        req.ifi.ifi_index = 1;
+        struct sockaddr_nl addr = {};
+        addr.nl_family = AF_NETLINK;
+        ASSERT_EQ(sendto(batch.m_socket, &req, sizeof(req), 0,
+                         reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), static_cast<ssize_t>(sizeof(req)));
+
+        // The kernel answers the operations on the loopback, whatever it answers they don't time out
+        auto add = batch.addBridgeVlan("lo", 10, false);
+        auto del = batch.delBridgeVlan("lo", 10);
+        batch.commit();
+        ASSERT_NE(batch.m_ops[add].error, EAGAIN);
+        ASSERT_NE(batch.m_ops[add].error, ETIMEDOUT);
+        ASSERT_NE(batch.m_ops[del].error, EAGAIN);
+        ASSERT_NE(batch.m_ops[del].error, ETIMEDOUT);
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
+    /*
+     * Programs FDB entries on a port of a dummy bridge in a network namespace of its own
+     * and reports the rate, run with --gtest_also_run_disabled_tests. Skipped without the
+     * privilege to create the namespace or the bridge.
+     */
+    TEST_F(NetlinkBatchTest, DISABLED_FdbBenchmark)
+    {
+        const int macCount = 16384;
+        const int skipped = 77;
+
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0)
+        {
+            if (unshare(CLONE_NEWNET) != 0 ||
+                system("ip link add brfdb type bridge vlan_filtering 1 && ip link add dmfdb type dummy && "
+                       "ip link set dmfdb master brfdb && bridge vlan add vid 10 dev dmfdb && "
+                       "ip link set brfdb up && ip link set dmfdb up") != 0)
+            {
+                _exit(skipped);
+            }
+
+            NetlinkBatch batch;
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < macCount; i++)
+            {
+                char mac[18];
+                snprintf(mac, sizeof(mac), "02:00:00:00:%02x:%02x", (i >> 8) & 0xff, i & 0xff);
+                batch.replaceFdb("dmfdb", mac, 10, NetlinkBatch::FDB_DYNAMIC_EXT_LEARN);
+            }
+            size_t failed = batch.commit();
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            printf("Programmed %d FDB entries in %.3f s, %zu failed (%.0f MACs/s)\n",
+                   macCount, seconds, failed, macCount / seconds);
+            fflush(stdout);
+            _exit(failed == 0 ? 0 : 1);
+        }
+
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        if (WEXITSTATUS(status) == skipped)
+        {
+            GTEST_SKIP() << "cannot create a bridge in a network namespace";
+        }
+        ASSERT_EQ(WEXITSTATUS(status), 0);
+    }
+
+    /*
+     * Adds then removes VLANs of a port of a dummy bridge, over netlink and with one
+     * bridge command per operation, in a network namespace of its own, and reports
+     * both times, run with --gtest_also_run_disabled_tests. Skipped without the privilege
+     * to create the namespace or the bridge.
+     */
+    TEST_F(NetlinkBatchTest, DISABLED_VlanBenchmark)
+    {
+        const int vlanCount = 1000;
+        const int skipped = 77;
+
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0)
+        {
+            if (unshare(CLONE_NEWNET) != 0 ||
+                system("ip link add brvlan type bridge vlan_filtering 1 && ip link add dmvlan type dummy && "
+                       "ip link set dmvlan master brvlan && ip link set brvlan up && ip link set dmvlan up") != 0)
+            {
+                _exit(skipped);
+            }
+
+            callback = runCommand;
+            size_t failed = 0;
+            double seconds[2];
+            NetlinkBatch::Mode modes[2] = { NetlinkBatch::NETLINK, NetlinkBatch::SHELL };
+            for (int m = 0; m < 2; m++)
+            {
+                NetlinkBatch batch(modes[m]);
+                auto start = chrono::steady_clock::now();
+                for (int vid = 2; vid < vlanCount + 2; vid++)
+                {
+                    batch.addBridgeVlan("dmvlan", static_cast<uint16_t>(vid), false);
+                }
+                for (int vid = 2; vid < vlanCount + 2; vid++)
+                {
+                    batch.delBridgeVlan("dmvlan", static_cast<uint16_t>(vid));
+                }
+                failed += batch.commit();
+                seconds[m] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            }
+
+            printf("%d bridge VLAN operations: %.3f s over netlink, %.3f s with bridge commands, %zu failed\n",
+                   2 * vlanCount, seconds[0], seconds[1], failed);
+            fflush(stdout);
+            _exit(failed == 0 ? 0 : 1);
+        }
+
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        if (WEXITSTATUS(status) == skipped)
+        {
+            GTEST_SKIP() << "cannot create a bridge in a network namespace";
+        }
+        ASSERT_EQ(WEXITSTATUS(status), 0);
+    }
+}
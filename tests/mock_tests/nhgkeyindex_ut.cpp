@@ -0,0 +1,73 @@
+#include "ut_helper.h"
+#include "nhgkeyindex.h"
+
+namespace nhgkeyindex_test
+{
+    using namespace std;
+
+    TEST(NhgKeyIndexTest, SameNextHopsGetSameId)
+    {
+        NextHopGroupKeyIndex index;
+
+        // Same next hops, as parsed from routes of different VRFs or protocols
+        NhgKeyId id = index.intern(NextHopGroupKey("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4"));
+        ASSERT_NE(id, NHG_KEY_ID_INVALID);
+        ASSERT_EQ(index.intern(NextHopGroupKey("10.0.0.2@Ethernet4,10.0.0.1@Ethernet0")), id);
+        ASSERT_EQ(index.find(NextHopGroupKey("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4")), id);
+        ASSERT_EQ(index.getRefCount(id), 2u);
+        ASSERT_EQ(index.size(), 1u);
+
+        // Different weights are different next hop sets
+        NhgKeyId weighted = index.intern(NextHopGroupKey("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4", "1,2"));
+        ASSERT_NE(weighted, id);
+        ASSERT_EQ(index.getKey(weighted).to_string(), NextHopGroupKey("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4", "1,2").to_string());
+
+        ASSERT_EQ(index.find(NextHopGroupKey("10.0.0.3@Ethernet8,10.0.0.4@Ethernet12")), NHG_KEY_ID_INVALID);
+    }
+
+    TEST(NhgKeyIndexTest, ReleasedIdIsReused)
+    {
+        NextHopGroupKeyIndex index;
+        NextHopGroupKey nhg1("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4");
+        NextHopGroupKey nhg2("10.0.0.3@Ethernet8,10.0.0.4@Ethernet12");
+
+        NhgKeyId id = index.intern(nhg1);
+        index.ref(id);
+        index.release(id);
+        ASSERT_EQ(index.find(nhg1), id);
+
+        index.release(id);
+        ASSERT_EQ(index.getRefCount(id), 0u);
+        ASSERT_EQ(index.find(nhg1), NHG_KEY_ID_INVALID);
+        ASSERT_EQ(index.size(), 0u);
+
+        ASSERT_EQ(index.intern(nhg2), id);
+        ASSERT_EQ(index.getKey(id), nhg2);
+    }
+
+    TEST(NhgKeyIndexTest, RefIsReleasedOutOfScope)
+    {
+        NextHopGroupKeyIndex index;
+        NextHopGroupKey nhg("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4");
+        NhgKeyId id;
+
+        {
+            NextHopGroupKeyRef ref(index, nhg);
+            id = ref.id();
+            ASSERT_EQ(index.getRefCount(id), 1u);
+
+            NextHopGroupKeyRef moved;
+            moved = std::move(ref);
+            ASSERT_EQ(ref.id(), NHG_KEY_ID_INVALID);
+            ASSERT_EQ(moved.id(), id);
+            ASSERT_EQ(index.getRefCount(id), 1u);
+
+            moved = NextHopGroupKeyRef(index, nhg);
+            ASSERT_EQ(moved.id(), id);
+            ASSERT_EQ(index.getRefCount(id), 1u);
+        }
+
+        ASSERT_EQ(index.getRefCount(id), 0u);
+        ASSERT_EQ(index.find(nhg), NHG_KEY_ID_INVALID);
+    }
+}
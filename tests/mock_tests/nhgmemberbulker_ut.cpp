@@ -0,0 +1,191 @@
+#include "ut_helper.h"
+#include "nhgmemberbulker.h"
+
+namespace nhgmemberbulker_test
+{
+    using namespace std;
+
+    vector<uint32_t> bulk_create_calls;
+    vector<uint32_t> bulk_remove_calls;
+    // The next hop group of each created member
+    vector<sai_object_id_t> created_groups;
+    set<size_t> failing_creates;
+    set<sai_object_id_t> failing_removes;
+
+    sai_status_t create_next_hop_group_members(
+            sai_object_id_t switch_id,
+            uint32_t object_count,
+            const uint32_t *attr_count,
+            const sai_attribute_t **attr_list,
+            sai_bulk_op_error_mode_t mode,
+            sai_object_id_t *object_id,
+            sai_status_t *object_statuses)
+    {
+        bulk_create_calls.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            size_t index = created_groups.size();
+            created_groups.push_back(attr_list[i][0].value.oid);
+            if (failing_creates.count(index))
+            {
+                object_id[i] = SAI_NULL_OBJECT_ID;
+                object_statuses[i] = SAI_STATUS_TABLE_FULL;
+            }
+            else
+            {
+                object_id[i] = 0x1000 + index;
+                object_statuses[i] = SAI_STATUS_SUCCESS;
+            }
+        }
+        return failing_creates.empty() ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+    }
+
+    sai_status_t remove_next_hop_group_members(
+            uint32_t object_count,
+            const sai_object_id_t *object_id,
+            sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses)
+    {
+        bulk_remove_calls.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = failing_removes.count(object_id[i]) ? SAI_STATUS_OBJECT_IN_USE : SAI_STATUS_SUCCESS;
+        }
+        return failing_removes.empty() ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+    }
+
+    struct NhgMemberBulkerTest : public ::testing::Test
+    {
+        sai_next_hop_group_api_t m_api = {};
+
+        void SetUp() override
+        {
+            m_api.create_next_hop_group_members = create_next_hop_group_members;
+            m_api.remove_next_hop_group_members = remove_next_hop_group_members;
+
+            bulk_create_calls.clear();
+            bulk_remove_calls.clear();
+            created_groups.clear();
+            failing_creates.clear();
+            failing_removes.clear();
+        }
+
+        vector<sai_attribute_t> memberAttrs(sai_object_id_t nhg_id, sai_object_id_t nh_id)
+        {
+            vector<sai_attribute_t> attrs(2);
+            attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+            attrs[0].value.oid = nhg_id;
+            attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            attrs[1].value.oid = nh_id;
+            return attrs;
+        }
+    };
+
+    TEST_F(NhgMemberBulkerTest, BatchProgramsAllGroupsOnce)
+    {
+        NhgMemberBulker bulker(&m_api, 0x1, 1000);
+        vector<string> done;
+
+        {
+            NhgMemberBatch batch(bulker);
+
+            for (sai_object_id_t nhg_id : { 0x10, 0x20, 0x30 })
+            {
+                for (sai_object_id_t nh_id : { 0x100, 0x200 })
+                {
+                    bulker.createMember(memberAttrs(nhg_id, nh_id), [&done](sai_object_id_t nhgm_id)
+                    {
+                        done.push_back("create:" + to_string(nhgm_id));
+                    });
+                    bulker.commit();
+                }
+            }
+            bulker.removeMember(0x500, [&done](sai_status_t status)
+            {
+                done.push_back("remove:" + to_string(status));
+            });
+
+            ASSERT_TRUE(bulk_create_calls.empty());
+            ASSERT_EQ(bulker.pendingCount(), 7u);
+        }
+
+        ASSERT_EQ(bulk_create_calls, vector<uint32_t>({ 6 }));
+        ASSERT_EQ(bulk_remove_calls, vector<uint32_t>({ 1 }));
+        ASSERT_EQ(created_groups, vector<sai_object_id_t>({ 0x10, 0x10, 0x20, 0x20, 0x30, 0x30 }));
+        ASSERT_EQ(bulker.pendingCount(), 0u);
+
+        // The removals are reported first, as they are programmed first
+        ASSERT_EQ(done.size(), 7u);
+        ASSERT_EQ(done[0], "remove:0");
+        ASSERT_EQ(done[1], "create:" + to_string(0x1000));
+        ASSERT_EQ(done[6], "create:" + to_string(0x1005));
+    }
+
+    TEST_F(NhgMemberBulkerTest, FailedMembersAreIsolated)
+    {
+        NhgMemberBulker bulker(&m_api, 0x1, 1000);
+        map<sai_object_id_t, vector<sai_object_id_t>> members;
+        map<sai_object_id_t, sai_status_t> removed;
+
+        failing_creates = { 1, 2 };
+        failing_removes = { 0x600 };
+
+        bulker.beginBatch();
+        for (sai_object_id_t nhg_id : { 0x10, 0x20 })
+        {
+            for (sai_object_id_t nh_id : { 0x100, 0x200 })
+            {
+                bulker.createMember(memberAttrs(nhg_id, nh_id), [&members, nhg_id](sai_object_id_t nhgm_id)
+                {
+                    members[nhg_id].push_back(nhgm_id);
+                });
+            }
+        }
+        for (sai_object_id_t nhgm_id : { 0x500, 0x600, 0x700 })
+        {
+            bulker.removeMember(nhgm_id, [&removed, nhgm_id](sai_status_t status)
+            {
+                removed[nhgm_id] = status;
+            });
+        }
+        bulker.endBatch();
+
+        // Every member gets its own result, the others are programmed anyway
+        ASSERT_EQ(members[0x10], vector<sai_object_id_t>({ 0x1000, SAI_NULL_OBJECT_ID }));
+        ASSERT_EQ(members[0x20], vector<sai_object_id_t>({ SAI_NULL_OBJECT_ID, 0x1003 }));
+        ASSERT_EQ(removed[0x500], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(removed[0x600], SAI_STATUS_OBJECT_IN_USE);
+        ASSERT_EQ(removed[0x700], SAI_STATUS_SUCCESS);
+
+        // Only the failed member is programmed again
+        failing_creates.clear();
+        bulker.createMember(memberAttrs(0x10, 0x200), [&members](sai_object_id_t nhgm_id)
+        {
+            members[0x10].push_back(nhgm_id);
+        });
+        bulker.commit();
+
+        ASSERT_EQ(bulk_create_calls, vector<uint32_t>({ 4, 1 }));
+        ASSERT_EQ(members[0x10].back(), 0x1004u);
+    }
+
+    TEST_F(NhgMemberBulkerTest, OperationsQueuedByCallbacksAreFlushed)
+    {
+        NhgMemberBulker bulker(&m_api, 0x1, 1000);
+        sai_object_id_t replaced = SAI_NULL_OBJECT_ID;
+
+        bulker.removeMember(0x500, [&](sai_status_t status)
+        {
+            bulker.createMember(memberAttrs(0x10, 0x100), [&replaced](sai_object_id_t nhgm_id)
+            {
+                replaced = nhgm_id;
+            });
+        });
+        bulker.flush();
+
+        ASSERT_EQ(bulk_remove_calls, vector<uint32_t>({ 1 }));
+        ASSERT_EQ(bulk_create_calls, vector<uint32_t>({ 1 }));
+        ASSERT_EQ(replaced, 0x1000u);
+        ASSERT_EQ(bulker.pendingCount(), 0u);
+    }
+}
@@ -63,14 +63,15 @@ namespace orchdaemon_test
 
         auto ring = new RingBuffer(test_ring_size);
 
-        for (int i = 0; i < test_ring_size - 1; i++)
+        for (int i = 0; i < test_ring_size; i++)
         {
             EXPECT_TRUE(ring->push([](){}));
         }
         EXPECT_FALSE(ring->push([](){}));
+        EXPECT_TRUE(ring->IsFull());
 
         AnyTask task;
-        for (int i = 0; i < test_ring_size - 1; i++)
+        for (int i = 0; i < test_ring_size; i++)
         {
             EXPECT_TRUE(ring->pop(task));
         }
@@ -79,9 +80,50 @@ namespace orchdaemon_test
 
         ring->setIdle(true);
         EXPECT_TRUE(ring->IsIdle());
+
+        auto stats = ring->getStats();
+        ASSERT_EQ(stats.size(), 1);
+        EXPECT_EQ(stats[0].pushed, test_ring_size);
+        EXPECT_EQ(stats[0].executed, test_ring_size);
+        EXPECT_EQ(stats[0].stalls, 1);
+        EXPECT_EQ(stats[0].depth, 0);
         delete ring;
     }
 
+    TEST_F(OrchDaemonTest, ringBufferLanes)
+    {
+        std::vector<std::string> tables = {"ROUTE_TABLE", "NEIGH_TABLE"};
+        auto orch = make_shared<Orch>(&appl_db, tables);
+
+        RingBuffer ring(4);
+        ring.addExecutor(orch->getExecutor("ROUTE_TABLE"));
+        ring.addExecutor(orch->getExecutor("NEIGH_TABLE"));
+
+        EXPECT_TRUE(ring.serves("ROUTE_TABLE"));
+        EXPECT_TRUE(ring.serves("NEIGH_TABLE"));
+
+        std::vector<std::string> order;
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_TRUE(ring.push("ROUTE_TABLE", [&order](){ order.push_back("ROUTE_TABLE"); }));
+        }
+        // a full ROUTE_TABLE lane doesn't block other lanes
+        EXPECT_FALSE(ring.push("ROUTE_TABLE", [](){}));
+        EXPECT_TRUE(ring.push("NEIGH_TABLE", [&order](){ order.push_back("NEIGH_TABLE"); }));
+
+        AnyTask task;
+        while (ring.pop(task))
+        {
+            task();
+        }
+
+        // NEIGH_TABLE task is served right after the first ROUTE_TABLE task
+        ASSERT_EQ(order.size(), 5);
+        EXPECT_EQ(order[0], "ROUTE_TABLE");
+        EXPECT_EQ(order[1], "NEIGH_TABLE");
+        EXPECT_TRUE(ring.IsEmpty());
+    }
+
     TEST_F(OrchDaemonTest, RingThread)
     {
         orchd->enableRingBuffer();
@@ -167,6 +209,78 @@ namespace orchdaemon_test
         orchd->disableRingBuffer();
     }
 
+    class SchedulerTestOrch : public Orch
+    {
+    public:
+        SchedulerTestOrch(const std::string &table, std::atomic<int> &counter)
+            : Orch(&appl_db, table), m_counter(counter)
+        {
+        }
+
+        void doTask() override
+        {
+            m_counter++;
+        }
+
+        std::atomic<int> &m_counter;
+    };
+
+    TEST_F(OrchDaemonTest, OrchSchedulerStages)
+    {
+        std::atomic<int> counter{0};
+        SchedulerTestOrch serial1("SERIAL_1", counter);
+        SchedulerTestOrch fdb("FDB_LIKE", counter);
+        SchedulerTestOrch wm("WM_LIKE", counter);
+        SchedulerTestOrch pfcwd("PFCWD_LIKE", counter);
+        SchedulerTestOrch crm("CRM_LIKE", counter);
+        SchedulerTestOrch serial2("SERIAL_2", counter);
+
+        fdb.declareResources({}, {ORCH_RESOURCE_FDB, ORCH_RESOURCE_PORT});
+        wm.declareResources({ORCH_RESOURCE_PORT}, {ORCH_RESOURCE_WATERMARK});
+        pfcwd.declareResources({}, {ORCH_RESOURCE_PFCWD});
+        crm.declareResources({}, {ORCH_RESOURCE_CRM});
+
+        EXPECT_TRUE(OrchScheduler::conflicts(&serial1, &crm));
+        EXPECT_TRUE(OrchScheduler::conflicts(&fdb, &wm));
+        EXPECT_FALSE(OrchScheduler::conflicts(&wm, &pfcwd));
+
+        OrchScheduler scheduler(4);
+        EXPECT_EQ(scheduler.getWorkerCount(), 3);
+
+        scheduler.setOrchList({&serial1, &fdb, &wm, &pfcwd, &crm, &serial2});
+        scheduler.addOrder(&crm, &pfcwd);
+
+        auto stages = scheduler.getStages();
+        ASSERT_EQ(stages.size(), 4);
+        EXPECT_EQ(stages[0], std::vector<Orch *>({&serial1}));
+        EXPECT_EQ(stages[1], std::vector<Orch *>({&fdb, &crm}));
+        EXPECT_EQ(stages[2], std::vector<Orch *>({&wm, &pfcwd}));
+        EXPECT_EQ(stages[3], std::vector<Orch *>({&serial2}));
+
+        scheduler.run();
+        EXPECT_EQ(counter.load(), 6);
+    }
+
+    TEST_F(OrchDaemonTest, OrchSchedulerCycle)
+    {
+        std::atomic<int> counter{0};
+        SchedulerTestOrch a("A", counter);
+        SchedulerTestOrch b("B", counter);
+        a.declareResources({}, {"A"});
+        b.declareResources({}, {"B"});
+
+        OrchScheduler scheduler(2);
+        scheduler.setOrchList({&a, &b});
+        scheduler.addOrder(&a, &b);
+        scheduler.addOrder(&b, &a);
+
+        // fall back to one stage per orch
+        EXPECT_EQ(scheduler.getStages().size(), 2);
+
+        scheduler.run();
+        EXPECT_EQ(counter.load(), 2);
+    }
+
     TEST_F(OrchDaemonTest, TestRedisFlushFailure)
     {
         InSequence s;
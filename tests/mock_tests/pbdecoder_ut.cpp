@@ -0,0 +1,148 @@
+#include <atomic>
+#include <thread>
+#include "dash/pbdecoder.h"
+#include "dash_api/vnet_mapping.pb.h"
+#include "gtest/gtest.h"
+#include "mock_table.h"
+
+namespace pbdecoder_test
+{
+    using namespace std;
+    using namespace swss;
+
+    struct PbDecoderTest : public ::testing::Test
+    {
+        SyncMap m_toSync;
+
+        void TearDown() override
+        {
+            PbDecodePool::getInstance().setThreadCount(1);
+            PbDecodePool::getInstance().resetStats();
+        }
+
+        // Keys "vnet:<i>", the message of entry i carries i as its underlay IP
+        void AddVnetMaps(size_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                dash::vnet_mapping::VnetMapping vnet_map;
+                vnet_map.mutable_underlay_ip()->set_ipv4(i);
+                string key = "vnet:" + to_string(i);
+                m_toSync.emplace(key, KeyOpFieldsValuesTuple(key, SET_COMMAND, { { "pb", vnet_map.SerializeAsString() } }));
+            }
+        }
+    };
+
+    TEST_F(PbDecoderTest, DecodesBatchOnPool)
+    {
+        PbDecodePool::getInstance().setThreadCount(4);
+        ASSERT_EQ(PbDecodePool::getInstance().getThreadCount(), 4u);
+
+        AddVnetMaps(1000);
+        m_toSync.emplace("vnet:bad", KeyOpFieldsValuesTuple("vnet:bad", SET_COMMAND, { { "pb", "\xff\xff\xff" } }));
+        m_toSync.emplace("vnet:nopb", KeyOpFieldsValuesTuple("vnet:nopb", SET_COMMAND, { { "other", "" } }));
+        m_toSync.emplace("vnet:del", KeyOpFieldsValuesTuple("vnet:del", DEL_COMMAND, {}));
+
+        atomic<size_t> prepared(0);
+        PbBatchDecoder<dash::vnet_mapping::VnetMapping> decoded("VnetMap", m_toSync,
+            [&](const string &key, dash::vnet_mapping::VnetMapping &)
+            {
+                prepared++;
+                return key != "vnet:999";
+            });
+        ASSERT_EQ(prepared.load(), 1000u);
+
+        const auto &stats = PbDecodePool::getInstance().getStats();
+        ASSERT_EQ(stats.batches, 1u);
+        ASSERT_EQ(stats.messages, 1002u);
+        ASSERT_EQ(stats.failures, 3u);
+
+        for (const auto &it : m_toSync)
+        {
+            const string &key = kfvKey(it.second);
+            dash::vnet_mapping::VnetMapping vnet_map;
+            if (key == "vnet:bad" || key == "vnet:nopb" || key == "vnet:999")
+            {
+                ASSERT_FALSE(decoded.take(it.second, vnet_map)) << key;
+            }
+            else if (key != "vnet:del")
+            {
+                ASSERT_TRUE(decoded.take(it.second, vnet_map)) << key;
+                ASSERT_EQ("vnet:" + to_string(vnet_map.underlay_ip().ipv4()), key);
+            }
+        }
+    }
+
+    TEST_F(PbDecoderTest, ConcurrentBatchesRunOneAtATime)
+    {
+        PbDecodePool::getInstance().setThreadCount(4);
+
+        // Each thread runs its batches on the pool, every task of each batch runs once
+        auto runBatches = [](vector<size_t> &counts)
+        {
+            for (int batch = 0; batch < 50; batch++)
+            {
+                vector<atomic<size_t>> runs(500);
+                PbDecodePool::getInstance().run(runs.size(), [&](size_t i) { runs[i]++; });
+                for (const auto &r : runs)
+                {
+                    counts[r.load()]++;
+                }
+            }
+        };
+
+        vector<size_t> counts1(3, 0);
+        vector<size_t> counts2(3, 0);
+        thread t1(runBatches, ref(counts1));
+        thread t2(runBatches, ref(counts2));
+        t1.join();
+        t2.join();
+
+        ASSERT_EQ(counts1[1], 50u * 500u);
+        ASSERT_EQ(counts2[1], 50u * 500u);
+    }
+
+    TEST_F(PbDecoderTest, StatsAreExportedToCountersDb)
+    {
+        testing_db::reset();
+        PbDecodePool::getInstance().resetStats();
+
+        AddVnetMaps(10);
+        PbBatchDecoder<dash::vnet_mapping::VnetMapping> decoded("VnetMap", m_toSync);
+
+        DBConnector countersDb("COUNTERS_DB", 0);
+        Table statsTable(&countersDb, "PB_DECODE_STATS");
+        string value;
+        ASSERT_TRUE(statsTable.hget("DASH", "batches", value));
+        ASSERT_EQ(value, "1");
+        ASSERT_TRUE(statsTable.hget("DASH", "messages", value));
+        ASSERT_EQ(value, "10");
+        ASSERT_TRUE(statsTable.hget("DASH", "failures", value));
+        ASSERT_EQ(value, "0");
+
+        // Not exported again within the interval
+        PbBatchDecoder<dash::vnet_mapping::VnetMapping> decodedAgain("VnetMap", m_toSync);
+        ASSERT_EQ(PbDecodePool::getInstance().getStats().batches, 2u);
+        ASSERT_TRUE(statsTable.hget("DASH", "batches", value));
+        ASSERT_EQ(value, "1");
+    }
+
+    TEST_F(PbDecoderTest, EntryNotInBatchIsDecodedOnTake)
+    {
+        AddVnetMaps(2);
+        PbBatchDecoder<dash::vnet_mapping::VnetMapping> decoded("VnetMap", m_toSync);
+
+        dash::vnet_mapping::VnetMapping vnet_map;
+        auto it = m_toSync.begin();
+        ASSERT_TRUE(decoded.take(it->second, vnet_map));
+        ASSERT_EQ(vnet_map.underlay_ip().ipv4(), 0u);
+
+        // An entry which was already taken, or added after the batch was decoded
+        ASSERT_TRUE(decoded.take(it->second, vnet_map));
+        ASSERT_EQ(vnet_map.underlay_ip().ipv4(), 0u);
+        AddVnetMaps(3);
+        auto added = prev(m_toSync.end());
+        ASSERT_TRUE(decoded.take(added->second, vnet_map));
+        ASSERT_EQ(vnet_map.underlay_ip().ipv4(), 2u);
+    }
+}
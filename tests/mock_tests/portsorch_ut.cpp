@@ -1358,6 +1358,53 @@ namespace portsorch_test
         _unhook_sai_queue_api();
     }
 
+    TEST_F(PortsOrchTest, GetPortPtrTest)
+    {
+        _hook_sai_queue_api();
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        std::deque<KeyOpFieldsValuesTuple> entries;
+
+        auto &ports = defaultPortList;
+        ASSERT_TRUE(!ports.empty());
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // Lookups by alias and by OID resolve to the same entry
+        const Port *p = gPortsOrch->getPortPtr("Ethernet0");
+        ASSERT_NE(p, nullptr);
+        ASSERT_NE(p->m_port_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(gPortsOrch->getPortPtr(p->m_port_id), p);
+        ASSERT_EQ(gPortsOrch->getPortPtr(p->m_port_id), p);
+        ASSERT_EQ(gPortsOrch->getPortPtr("EthernetX"), nullptr);
+
+        // Updates are visible through the pointer
+        uint32_t fdb_count = p->m_fdb_count;
+        ASSERT_TRUE(gPortsOrch->updatePort("Ethernet0", [](Port &port) { port.m_fdb_count += 2; }));
+        ASSERT_EQ(p->m_fdb_count, fdb_count + 2);
+        ASSERT_TRUE(gPortsOrch->decrFdbCount("Ethernet0", 2));
+        ASSERT_TRUE(gPortsOrch->incrFdbCount("Ethernet0", 1));
+        ASSERT_EQ(p->m_fdb_count, fdb_count + 1);
+        ASSERT_TRUE(gPortsOrch->decrFdbCount("Ethernet0", 1));
+        ASSERT_FALSE(gPortsOrch->updatePort("EthernetX", [](Port &) {}));
+
+        // Removing the port drops it from the OID index
+        sai_object_id_t port_id = p->m_port_id;
+        entries.push_back({"Ethernet0", "DEL", {}});
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_PORT_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->getPortPtr("Ethernet0"), nullptr);
+        ASSERT_EQ(gPortsOrch->getPortPtr(port_id), nullptr);
+        _unhook_sai_queue_api();
+    }
+
     TEST_F(PortsOrchTest, PortPTConfigDefaultTimestampTemplate)
     {
         auto portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -101,6 +101,72 @@ namespace routeorch_test
         return old_set_route_entries_attribute(object_count, route_entry, attr_list, mode, object_statuses);
     }
 
+    // Next hop group members whose creation fails, by next hop
+    set<sai_object_id_t> failing_member_next_hops;
+    int create_member_count;
+    int remove_member_count;
+
+    sai_bulk_object_create_fn old_create_next_hop_group_members;
+    sai_bulk_object_remove_fn old_remove_next_hop_group_members;
+
+    sai_status_t _ut_stub_sai_bulk_create_next_hop_group_member(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        auto status = old_create_next_hop_group_members(switch_id, object_count, attr_count, attr_list,
+                                                        mode, object_id, object_statuses);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            for (uint32_t j = 0; j < attr_count[i]; j++)
+            {
+                if (attr_list[i][j].id == SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID &&
+                    failing_member_next_hops.count(attr_list[i][j].value.oid) &&
+                    object_statuses[i] == SAI_STATUS_SUCCESS)
+                {
+                    sai_next_hop_group_api->remove_next_hop_group_member(object_id[i]);
+                    object_id[i] = SAI_NULL_OBJECT_ID;
+                    object_statuses[i] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+                    status = SAI_STATUS_FAILURE;
+                }
+            }
+            if (object_statuses[i] == SAI_STATUS_SUCCESS)
+            {
+                create_member_count++;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_bulk_remove_next_hop_group_member(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        remove_member_count += object_count;
+        return old_remove_next_hop_group_members(object_count, object_id, mode, object_statuses);
+    }
+
+    // Next hop groups removed, with the groups queued for removal in the bulk pass at that time
+    vector<sai_object_id_t> removed_next_hop_groups;
+    vector<set<pair<NhgKeyId, sai_object_id_t>>> removed_nhg_reduced_ref_cnt;
+
+    sai_next_hop_group_api_t ut_sai_next_hop_group_api;
+    sai_next_hop_group_api_t *pold_sai_next_hop_group_api;
+
+    sai_status_t _ut_stub_sai_remove_next_hop_group(
+        _In_ sai_object_id_t next_hop_group_id)
+    {
+        removed_next_hop_groups.push_back(next_hop_group_id);
+        removed_nhg_reduced_ref_cnt.push_back(gRouteOrch->m_bulkNhgReducedRefCnt);
+        return pold_sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
+    }
+
     struct RouteOrchTest : public ::testing::Test
     {
         RouteOrchTest()
@@ -349,6 +415,33 @@ namespace routeorch_test
             static_cast<Orch *>(gRouteOrch)->doTask();
         }
 
+        /* Hack the member functions copied by the member bulker of RouteOrch */
+        void stubNextHopGroupMembers()
+        {
+            auto &bulker = gRouteOrch->getNhgMemberBulker().m_bulker;
+
+            failing_member_next_hops.clear();
+            create_member_count = 0;
+            remove_member_count = 0;
+
+            old_create_next_hop_group_members = bulker.create_entries;
+            old_remove_next_hop_group_members = bulker.remove_entries;
+            bulker.create_entries = _ut_stub_sai_bulk_create_next_hop_group_member;
+            bulker.remove_entries = _ut_stub_sai_bulk_remove_next_hop_group_member;
+        }
+
+        /* Hack the next hop group remove function */
+        void stubNextHopGroupRemove()
+        {
+            removed_next_hop_groups.clear();
+            removed_nhg_reduced_ref_cnt.clear();
+
+            ut_sai_next_hop_group_api = *sai_next_hop_group_api;
+            pold_sai_next_hop_group_api = sai_next_hop_group_api;
+            ut_sai_next_hop_group_api.remove_next_hop_group = _ut_stub_sai_remove_next_hop_group;
+            sai_next_hop_group_api = &ut_sai_next_hop_group_api;
+        }
+
         void TearDown() override
         {
             RestoreSaiApis();
@@ -392,6 +485,12 @@ namespace routeorch_test
             delete gBufferOrch;
             gBufferOrch = nullptr;
 
+            if (pold_sai_next_hop_group_api)
+            {
+                sai_next_hop_group_api = pold_sai_next_hop_group_api;
+                pold_sai_next_hop_group_api = nullptr;
+            }
+
             sai_route_api = pold_sai_route_api;
             ut_helper::uninitSaiApi();
         }
@@ -435,6 +534,33 @@ namespace routeorch_test
         ASSERT_EQ(current_set_count, set_route_count);
     }
 
+    TEST_F(RouteOrchTest, RouteOrchTestFlushDueSplitsPass)
+    {
+        // Flush every two routes, so one doTask() programs the burst in several passes
+        BulkerPolicy policy;
+        policy.max_bulk_size = 2;
+        gRouteOrch->gRouteBulker.set_policy(policy);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        for (int i = 0; i < 5; i++)
+        {
+            entries.push_back({"2.2." + to_string(i) + ".0/24", "SET", { {"ifname", "Ethernet0"},
+                                                                       {"nexthop", "10.0.0.2"}}});
+        }
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        auto current_create_count = create_route_count;
+
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        // Routes left after a flush_due() break are programmed in the same doTask()
+        ASSERT_EQ(current_create_count + 3, create_route_count);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        for (int i = 0; i < 5; i++)
+        {
+            ASSERT_TRUE(gRouteOrch->isRouteExists(IpPrefix("2.2." + to_string(i) + ".0/24")));
+        }
+    }
+
     TEST_F(RouteOrchTest, RouteOrchTestDelSetDiffNexthop)
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
@@ -628,4 +754,235 @@ namespace routeorch_test
             .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
         static_cast<Orch *>(gRouteOrch)->doTask();
     }
+
+    /* A member which fails is retried on its own, the route and the other members are kept */
+    TEST_F(RouteOrchTest, RouteOrchNhgMemberFailureIsRetried)
+    {
+        stubNextHopGroupMembers();
+
+        NextHopKey nh2(IpAddress("10.0.0.2"), "Ethernet0");
+        NextHopKey nh3(IpAddress("10.0.0.3"), "Ethernet0");
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        failing_member_next_hops.insert(gNeighOrch->getNextHopId(nh3));
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"2.2.2.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+        auto &nhg_entry = gRouteOrch->m_syncdNextHopGroups[nhg_key];
+        ASSERT_EQ(nhg_entry.ref_count, 1);
+        ASSERT_EQ(nhg_entry.nh_member_install_count, 1u);
+        ASSERT_NE(nhg_entry.nhopgroup_members[nh2].next_hop_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_entry.nhopgroup_members[nh3].next_hop_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_entry.pending_members.count(nh3), 1u);
+        ASSERT_EQ(gRouteOrch->m_nhgPendingMembers.count(nhg_key), 1u);
+        ASSERT_EQ(create_member_count, 1);
+
+        // Still failing, the member stays pending
+        gRouteOrch->retryNextHopGroupMembers();
+        ASSERT_EQ(nhg_entry.pending_members.count(nh3), 1u);
+        ASSERT_EQ(gRouteOrch->m_nhgPendingMembers.count(nhg_key), 1u);
+        ASSERT_EQ(create_member_count, 1);
+
+        // Retried before the routes of the next pass
+        failing_member_next_hops.clear();
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_TRUE(nhg_entry.pending_members.empty());
+        ASSERT_TRUE(gRouteOrch->m_nhgPendingMembers.empty());
+        ASSERT_NE(nhg_entry.nhopgroup_members[nh3].next_hop_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(nhg_entry.nh_member_install_count, 2u);
+        ASSERT_EQ(create_member_count, 2);
+        ASSERT_EQ(gRouteOrch->getNhgMemberBulker().pendingCount(), 0u);
+    }
+
+    /* A group removed in the batch which queued its members doesn't leak them */
+    TEST_F(RouteOrchTest, RouteOrchRemoveNhgWithQueuedMembers)
+    {
+        stubNextHopGroupMembers();
+
+        NextHopKey nh2(IpAddress("10.0.0.2"), "Ethernet0");
+        NextHopKey nh3(IpAddress("10.0.0.3"), "Ethernet0");
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        auto &bulker = gRouteOrch->getNhgMemberBulker();
+        auto nh2_ref_count = gNeighOrch->getNextHopRefCount(nh2);
+
+        {
+            NhgMemberBatch batch(bulker);
+
+            ASSERT_TRUE(gRouteOrch->addNextHopGroup(nhg_key));
+            ASSERT_EQ(bulker.pendingCount(), 2u);
+            ASSERT_EQ(create_member_count, 0);
+
+            ASSERT_TRUE(gRouteOrch->removeNextHopGroup(nhg_key));
+            ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+            ASSERT_EQ(bulker.pendingCount(), 0u);
+        }
+        ASSERT_EQ(create_member_count, 2);
+        ASSERT_EQ(remove_member_count, 2);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nh2), nh2_ref_count);
+
+        // Same with a member failing, only the created one is removed
+        failing_member_next_hops.insert(gNeighOrch->getNextHopId(nh3));
+        {
+            NhgMemberBatch batch(bulker);
+
+            ASSERT_TRUE(gRouteOrch->addNextHopGroup(nhg_key));
+            ASSERT_TRUE(gRouteOrch->removeNextHopGroup(nhg_key));
+            ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+        }
+        ASSERT_EQ(create_member_count, 3);
+        ASSERT_EQ(remove_member_count, 3);
+
+        // Nothing is retried for the removed group
+        failing_member_next_hops.clear();
+        gRouteOrch->retryNextHopGroupMembers();
+        ASSERT_TRUE(gRouteOrch->m_nhgPendingMembers.empty());
+        ASSERT_EQ(create_member_count, 3);
+        ASSERT_EQ(bulker.pendingCount(), 0u);
+    }
+
+    /* The failure of a member is reported even when the caller keeps a batch open */
+    TEST_F(RouteOrchTest, NhgOrchValidateNextHopInBatch)
+    {
+        stubNextHopGroupMembers();
+
+        NextHopKey nh3(IpAddress("10.0.0.3"), "Ethernet0");
+        Table nhgTable(m_app_db.get(), APP_NEXTHOP_GROUP_TABLE_NAME);
+        nhgTable.set("group1", { {"ifname", "Ethernet0,Ethernet0"},
+                                 {"nexthop", "10.0.0.2,10.0.0.3"}});
+        gNhgOrch->addExistingData(&nhgTable);
+        static_cast<Orch *>(gNhgOrch)->doTask();
+        ASSERT_TRUE(gNhgOrch->hasNhg("group1"));
+        ASSERT_EQ(create_member_count, 2);
+
+        ASSERT_TRUE(gNhgOrch->invalidateNextHop(nh3));
+        ASSERT_EQ(remove_member_count, 1);
+
+        failing_member_next_hops.insert(gNeighOrch->getNextHopId(nh3));
+        {
+            NhgMemberBatch batch(gRouteOrch->getNhgMemberBulker());
+            ASSERT_FALSE(gNhgOrch->validateNextHop(nh3));
+        }
+
+        failing_member_next_hops.clear();
+        {
+            NhgMemberBatch batch(gRouteOrch->getNhgMemberBulker());
+            ASSERT_TRUE(gNhgOrch->validateNextHop(nh3));
+        }
+        ASSERT_EQ(create_member_count, 3);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"group1", "DEL", { {} }});
+        auto consumer = dynamic_cast<Consumer *>(gNhgOrch->getExecutor(APP_NEXTHOP_GROUP_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gNhgOrch)->doTask();
+        ASSERT_FALSE(gNhgOrch->hasNhg("group1"));
+    }
+
+    /* Routes moving between ECMP sets shared by several routes, the groups are found by the id of their set */
+    TEST_F(RouteOrchTest, RouteOrchNhgSharedSetsById)
+    {
+        stubNextHopGroupRemove();
+
+        Table neighborTable = Table(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+        neighborTable.set("Ethernet0:10.0.0.4", { {"neigh", "00:00:0a:00:00:04"},
+                                                  {"family", "IPv4" }});
+        gNeighOrch->addExistingData(&neighborTable);
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        NextHopGroupKey nhg_a("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        NextHopGroupKey nhg_b("10.0.0.3@Ethernet0,10.0.0.4@Ethernet0");
+        IpPrefix prefix1("3.3.3.0/24");
+        IpPrefix prefix2("3.3.4.0/24");
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        auto &routes = gRouteOrch->m_syncdRoutes[gVirtualRouterId];
+
+        // Both routes share set A
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({prefix1.to_string(), "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                         {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        entries.push_back({prefix2.to_string(), "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                         {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        auto id_a = routes[prefix1].nhg_id;
+        ASSERT_NE(id_a, NHG_KEY_ID_INVALID);
+        ASSERT_EQ(routes[prefix2].nhg_id, id_a);
+        ASSERT_EQ(gRouteOrch->m_nhgKeyIndex.find(nhg_a), id_a);
+        auto *entry_a = gRouteOrch->getNextHopGroupEntry(id_a);
+        ASSERT_EQ(entry_a, &gRouteOrch->m_syncdNextHopGroups.at(nhg_a));
+        ASSERT_EQ(entry_a->ref_count, 2);
+        // Only the group holds the id between the passes
+        ASSERT_EQ(gRouteOrch->m_nhgKeyIndex.getRefCount(id_a), 1u);
+
+        // A -> B, A is still used by the other route
+        entries.clear();
+        entries.push_back({prefix1.to_string(), "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                         {"nexthop", "10.0.0.3,10.0.0.4"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        auto id_b = routes[prefix1].nhg_id;
+        ASSERT_NE(id_b, NHG_KEY_ID_INVALID);
+        ASSERT_NE(id_b, id_a);
+        auto *entry_b = gRouteOrch->getNextHopGroupEntry(id_b);
+        ASSERT_EQ(entry_b, &gRouteOrch->m_syncdNextHopGroups.at(nhg_b));
+        ASSERT_EQ(entry_a->ref_count, 1);
+        ASSERT_EQ(entry_b->ref_count, 1);
+        ASSERT_TRUE(removed_next_hop_groups.empty());
+        ASSERT_TRUE(gRouteOrch->m_bulkNhgReducedRefCnt.empty());
+
+        // B -> A, B is left without routes and removed at the end of the pass
+        auto nhg_b_oid = entry_b->next_hop_group_id;
+        entries.clear();
+        entries.push_back({prefix1.to_string(), "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                         {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(routes[prefix1].nhg_id, id_a);
+        ASSERT_EQ(entry_a->ref_count, 2);
+        ASSERT_EQ(removed_next_hop_groups, vector<sai_object_id_t>({ nhg_b_oid }));
+        ASSERT_EQ(removed_nhg_reduced_ref_cnt[0], (set<pair<NhgKeyId, sai_object_id_t>>({ {id_b, 0} })));
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_b));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupEntry(id_b), nullptr);
+        ASSERT_EQ(gRouteOrch->m_nhgKeyIndex.find(nhg_b), NHG_KEY_ID_INVALID);
+        ASSERT_TRUE(gRouteOrch->m_bulkNhgReducedRefCnt.empty());
+
+        // The last routes of A are removed, so is A
+        auto nhg_a_oid = entry_a->next_hop_group_id;
+        entries.clear();
+        entries.push_back({prefix1.to_string(), "DEL", { {} }});
+        entries.push_back({prefix2.to_string(), "DEL", { {} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(removed_next_hop_groups, vector<sai_object_id_t>({ nhg_b_oid, nhg_a_oid }));
+        ASSERT_EQ(removed_nhg_reduced_ref_cnt[1], (set<pair<NhgKeyId, sai_object_id_t>>({ {id_a, 0} })));
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_a));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupEntry(id_a), nullptr);
+        ASSERT_EQ(gRouteOrch->m_nhgKeyIndex.find(nhg_a), NHG_KEY_ID_INVALID);
+        ASSERT_TRUE(gRouteOrch->m_bulkNhgReducedRefCnt.empty());
+
+        // A freed id is reused for the next set, and finds its new group
+        entries.clear();
+        entries.push_back({prefix1.to_string(), "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                         {"nexthop", "10.0.0.3,10.0.0.4"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        auto id_reused = routes[prefix1].nhg_id;
+        ASSERT_TRUE(id_reused == id_a || id_reused == id_b);
+        entry_b = gRouteOrch->getNextHopGroupEntry(id_reused);
+        ASSERT_EQ(entry_b, &gRouteOrch->m_syncdNextHopGroups.at(nhg_b));
+        ASSERT_EQ(entry_b->key_id, id_reused);
+        ASSERT_EQ(entry_b->ref_count, 1);
+        ASSERT_EQ(gRouteOrch->m_nhgKeyIndex.getKey(id_reused), nhg_b);
+    }
 }
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include <stdlib.h>
+#include <fstream>
 #include <string>
 #include <unistd.h>
 #include "schema.h"
@@ -10,7 +11,9 @@
 
 #define protected public
 #include "orch.h"
+#define private public
 #include "zmqorch.h"
+#undef private
 #undef protected
 
 #define MAX_RETRY     10
@@ -127,4 +130,132 @@ TEST(ZmqOrchTest, GetFeatureStatusException)
     config_db.hset("DEVICE_METADATA|localhost", HGET_THROW_EXCEPTION_FIELD_NAME, "true");
     enabled = swss::get_feature_status(HGET_THROW_EXCEPTION_FIELD_NAME, false);
     EXPECT_FALSE(enabled);
-}
\ No newline at end of file
+}
+
+TEST(ZmqOrchTest, LoadZmqBatchSizes)
+{
+    char path[] = "/tmp/orch_zmq_batch.confXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    close(fd);
+
+    std::ofstream config(path);
+    config << "ROUTE_TABLE 256" << endl;
+    config << "DASH_VNET_MAPPING_TABLE 4096" << endl;
+    config << "DASH_ROUTE_TABLE 0" << endl;
+    config << "DASH_ENI_TABLE" << endl;
+    config << endl;
+    config.close();
+
+    auto batch_sizes = swss::load_zmq_batch_sizes(path);
+    unlink(path);
+
+    EXPECT_EQ(batch_sizes, (map<string, size_t>{ { "ROUTE_TABLE", 256 }, { "DASH_VNET_MAPPING_TABLE", 4096 } }));
+    EXPECT_TRUE(swss::load_zmq_batch_sizes("/tmp/not_exist_orch_zmq_batch.conf").empty());
+}
+
+TEST(ZmqOrchTest, ZmqConsumerStats)
+{
+    ZmqConsumerStats stats;
+    stats.record(1, false, 0, chrono::microseconds(100));
+    stats.record(100, true, 5, chrono::microseconds(300));
+    stats.record(100000, false, 2, chrono::microseconds(200));
+    // Wakeups without entries only update the queue depth
+    stats.record(0, false, 3, chrono::microseconds(1000));
+
+    auto fvs = stats.getFieldValues();
+    map<string, string> values(fvs.begin(), fvs.end());
+    EXPECT_EQ(values["executes"], "3");
+    EXPECT_EQ(values["entries"], "100101");
+    EXPECT_EQ(values["limited_executes"], "1");
+    EXPECT_EQ(values["queue_depth"], "3");
+    EXPECT_EQ(values["latency_avg_us"], "200");
+    EXPECT_EQ(values["latency_max_us"], "300");
+    EXPECT_EQ(values["batch_le_1"], "1");
+    EXPECT_EQ(values["batch_le_16"], "0");
+    EXPECT_EQ(values["batch_le_128"], "1");
+    EXPECT_EQ(values["batch_le_8192"], "0");
+    EXPECT_EQ(values["batch_gt_8192"], "1");
+}
+
+class BatchRecordingZmqOrch : public ZmqOrch
+{
+public:
+    BatchRecordingZmqOrch(DBConnector *db) : ZmqOrch(db, vector<string>(), nullptr)
+    {
+    }
+
+    void doTask(ConsumerBase &consumer) override
+    {
+        batches.push_back(consumer.m_toSync.size());
+        consumer.m_toSync.clear();
+    }
+
+    vector<size_t> batches;
+};
+
+TEST(ZmqOrchTest, ZmqConsumerBatchLimit)
+{
+    string zmq_address = "tcp://127.0.0.1:8201";
+    ZmqServer zmq_server(zmq_address);
+    ZmqClient zmq_client(zmq_address);
+
+    auto app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+    BatchRecordingZmqOrch zmq_orch(app_db.get());
+    // Pops of 3 entries, at most 4 entries per execute()
+    auto table = new ZmqConsumerStateTable(app_db.get(), "TEST_ZMQ_TABLE", zmq_server, 3, 0, false);
+    auto consumer = new ZmqConsumer(table, &zmq_orch, "TEST_ZMQ_TABLE", 4);
+    zmq_orch.addExecutor(consumer);
+
+    vector<KeyOpFieldsValuesTuple> kcos;
+    for (int i = 0; i < 10; i++)
+    {
+        kcos.emplace_back("key" + to_string(i), SET_COMMAND, vector<FieldValueTuple>{ { "field", "value" } });
+    }
+    zmq_client.sendMsg("APPL_DB", "TEST_ZMQ_TABLE", kcos);
+
+    int retry = 0;
+    while (!table->hasData() && retry++ < MAX_RETRY)
+    {
+        sleep(1);
+    }
+    ASSERT_TRUE(table->hasData());
+    // The entries of a message are queued one by one
+    usleep(100000);
+
+    // The second pop is over the limit, its last 2 entries are kept for the next execute()
+    consumer->execute();
+    EXPECT_EQ(zmq_orch.batches, (vector<size_t>{ 4 }));
+    EXPECT_EQ(consumer->m_pending.size(), 2u);
+    EXPECT_EQ(consumer->getStats().limited, 1u);
+
+    // No more ZMQ messages, the orch drains of the select loop take the rest
+    zmq_orch.doTask();
+    EXPECT_EQ(zmq_orch.batches, (vector<size_t>{ 4, 4 }));
+    EXPECT_EQ(consumer->getStats().limited, 2u);
+
+    zmq_orch.doTask();
+    EXPECT_EQ(zmq_orch.batches, (vector<size_t>{ 4, 4, 2 }));
+    EXPECT_TRUE(consumer->m_pending.empty());
+    EXPECT_FALSE(table->hasData());
+    EXPECT_EQ(consumer->getStats().limited, 2u);
+
+    // Nothing left, nothing done
+    zmq_orch.doTask();
+    EXPECT_EQ(zmq_orch.batches.size(), 3u);
+
+    // Exactly the limit with nothing left is not limited
+    kcos.resize(4);
+    zmq_client.sendMsg("APPL_DB", "TEST_ZMQ_TABLE", kcos);
+    retry = 0;
+    while (!table->hasData() && retry++ < MAX_RETRY)
+    {
+        sleep(1);
+    }
+    usleep(100000);
+
+    consumer->execute();
+    EXPECT_EQ(zmq_orch.batches, (vector<size_t>{ 4, 4, 2, 4 }));
+    EXPECT_EQ(consumer->getStats().limited, 2u);
+    EXPECT_EQ(consumer->getStats().entries, 14u);
+}
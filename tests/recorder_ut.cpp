@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "recorder.h"
+
+using namespace std;
+using namespace swss;
+
+class TestRecWriter : public RecWriter
+{
+public:
+    TestRecWriter(const string &file, bool async, bool binary)
+    {
+        setRecord(true);
+        setRotate(false);
+        setLocation("/tmp");
+        setFileName(file);
+        setName("Test");
+        setAsync(async);
+        setBinary(binary);
+    }
+};
+
+static string recPath(const string &file)
+{
+    return "/tmp/" + file;
+}
+
+/* Recorded values without their timestamp */
+static vector<string> readValues(istream &in)
+{
+    vector<string> values;
+    string line;
+
+    while (getline(in, line))
+    {
+        values.push_back(line.substr(line.find('|') + 1));
+    }
+
+    return values;
+}
+
+static vector<string> readTextFile(const string &file)
+{
+    ifstream in(recPath(file));
+    return readValues(in);
+}
+
+static const vector<string> expected = {
+    "recording started",
+    "ROUTE_TABLE:10.0.0.0/24|SET|nexthop:1.1.1.1",
+    "ROUTE_TABLE:10.0.0.0/24|DEL",
+    "",
+};
+
+TEST(recorder, async_text)
+{
+    string file = "recorder_ut_async_" + to_string(getpid()) + ".rec";
+    unlink(recPath(file).c_str());
+
+    TestRecWriter writer(file, true, false);
+    writer.startRec(false);
+    for (size_t i = 1; i < expected.size(); i++)
+    {
+        writer.record(expected[i]);
+    }
+    writer.stopRec();
+
+    EXPECT_EQ(readTextFile(file), expected);
+    unlink(recPath(file).c_str());
+}
+
+TEST(recorder, binary_to_text)
+{
+    string file = "recorder_ut_binary_" + to_string(getpid()) + ".rec";
+    unlink(recPath(file).c_str());
+
+    {
+        TestRecWriter writer(file, true, true);
+        writer.startRec(false);
+        for (size_t i = 1; i < expected.size(); i++)
+        {
+            writer.record(expected[i]);
+        }
+    }
+
+    ifstream in(recPath(file), ifstream::binary);
+    stringstream text;
+    ASSERT_TRUE(Recorder::toText(in, text));
+
+    /* Same text, timestamp included, as the text recorder */
+    string line;
+    getline(text, line);
+    ASSERT_EQ(line.size(), string("2024-01-01.00:00:00.000000|recording started").size());
+    text.seekg(0);
+    EXPECT_EQ(readValues(text), expected);
+
+    /* Truncated frame */
+    in.close();
+    ASSERT_EQ(truncate(recPath(file).c_str(), 20), 0);
+    ifstream truncated(recPath(file), ifstream::binary);
+    stringstream partial;
+    EXPECT_FALSE(Recorder::toText(truncated, partial));
+
+    unlink(recPath(file).c_str());
+}
+
+TEST(recorder, async_rotate)
+{
+    string file = "recorder_ut_rotate_" + to_string(getpid()) + ".rec";
+    string rotated = file + ".1";
+    unlink(recPath(file).c_str());
+
+    TestRecWriter writer(file, true, false);
+    writer.startRec(false);
+    writer.record("before");
+
+    /* Wait for the writer to pick up the entry, then rotate */
+    for (int i = 0; i < 100 && readTextFile(file).size() < 2; i++)
+    {
+        usleep(10000);
+    }
+    rename(recPath(file).c_str(), recPath(rotated).c_str());
+    writer.setRotate(true);
+    writer.record("after");
+    writer.stopRec();
+
+    EXPECT_EQ(readTextFile(rotated), vector<string>({"recording started", "before"}));
+    EXPECT_EQ(readTextFile(file), vector<string>({"after"}));
+
+    unlink(recPath(file).c_str());
+    unlink(recPath(rotated).c_str());
+}
+
+TEST(recorder, async_stop_while_recording)
+{
+    string file = "recorder_ut_stop_" + to_string(getpid()) + ".rec";
+    unlink(recPath(file).c_str());
+
+    const int count = 20000;
+    TestRecWriter writer(file, true, false);
+    writer.startRec(false);
+
+    /* Entries recorded around stopRec() are written either by the writer or in sync */
+    thread recording([&writer]() {
+        for (int i = 0; i < count; i++)
+        {
+            writer.record(to_string(i));
+        }
+    });
+    usleep(1000);
+    writer.stopRec();
+    recording.join();
+
+    vector<string> values = readTextFile(file);
+    ASSERT_EQ(values.size(), count + 1u);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(values[i + 1], to_string(i));
+    }
+
+    unlink(recPath(file).c_str());
+}
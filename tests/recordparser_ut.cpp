@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "recordparser.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(recordparser, set_record)
+{
+    Record record;
+    string line = "2024-01-01.00:00:00.000001|ROUTE_TABLE:10.0.0.0/24|SET|nexthop:1.1.1.1|ifname:Ethernet0";
+
+    ASSERT_TRUE(parseRecord(line, record));
+    EXPECT_EQ(string(record.timestamp, record.timestampLen), "2024-01-01.00:00:00.000001");
+    EXPECT_EQ(record.table, "ROUTE_TABLE");
+    EXPECT_EQ(record.key, "10.0.0.0/24");
+    EXPECT_EQ(record.op, "SET");
+    EXPECT_EQ(record.fvs, vector<FieldValueTuple>({{"nexthop", "1.1.1.1"}, {"ifname", "Ethernet0"}}));
+}
+
+TEST(recordparser, key_and_value_with_colons)
+{
+    Record record;
+
+    /* The table name is up to the first ':', a value is after the first ':' */
+    ASSERT_TRUE(parseRecord("2024-01-01.00:00:00.000001|NEIGH_TABLE:Vlan1000:fc00::2|SET|neigh:00:11:22:33:44:55|family", record));
+    EXPECT_EQ(record.table, "NEIGH_TABLE");
+    EXPECT_EQ(record.key, "Vlan1000:fc00::2");
+    EXPECT_EQ(record.fvs, vector<FieldValueTuple>({{"neigh", "00:11:22:33:44:55"}, {"family", ""}}));
+}
+
+TEST(recordparser, not_a_record)
+{
+    Record record;
+
+    EXPECT_FALSE(parseRecord("", record));
+    EXPECT_FALSE(parseRecord("2024-01-01.00:00:00.000000|recording started", record));
+    EXPECT_FALSE(parseRecord("2024-01-01.00:00:00.000000|no_table|SET", record));
+}
+
+TEST(recordparser, tuples_are_reused)
+{
+    Record record;
+
+    ASSERT_TRUE(parseRecord("2024-01-01.00:00:00.000001|ROUTE_TABLE:10.0.0.0/24|SET|nexthop:1.1.1.1|ifname:Ethernet0|a_field_name_longer_than_sso:1", record));
+    ASSERT_EQ(record.fvs.size(), 3u);
+    const char *buffer = record.fvs[2].first.data();
+
+    /* Fewer fields, the unused tuples are parked rather than freed */
+    ASSERT_TRUE(parseRecord("2024-01-01.00:00:00.000002|ROUTE_TABLE:10.0.0.0/24|DEL", record));
+    EXPECT_EQ(record.op, "DEL");
+    EXPECT_TRUE(record.fvs.empty());
+    EXPECT_EQ(record.spare.size(), 3u);
+
+    ASSERT_TRUE(parseRecord("2024-01-01.00:00:00.000003|ROUTE_TABLE:10.1.0.0/24|SET|nexthop:2.2.2.2", record));
+    EXPECT_EQ(record.fvs, vector<FieldValueTuple>({{"nexthop", "2.2.2.2"}}));
+    EXPECT_EQ(record.spare.size(), 2u);
+
+    ASSERT_TRUE(parseRecord("2024-01-01.00:00:00.000004|ROUTE_TABLE:10.2.0.0/24|SET|a:1|b:2|c:3", record));
+    EXPECT_EQ(record.fvs, vector<FieldValueTuple>({{"a", "1"}, {"b", "2"}, {"c", "3"}}));
+    EXPECT_TRUE(record.spare.empty());
+    EXPECT_EQ(record.fvs[2].first.data(), buffer);
+}
+
+TEST(recordparser, timestamp)
+{
+    string ts1 = "2024-01-01.00:00:59.999999";
+    string ts2 = "2024-01-01.00:01:00.000001";
+    string ts3 = "2024-01-01.00:01:30.500000";
+
+    int64_t us1 = parseTimestamp(ts1.c_str(), ts1.size());
+    ASSERT_GE(us1, 0);
+    EXPECT_EQ(parseTimestamp(ts2.c_str(), ts2.size()) - us1, 2);
+    EXPECT_EQ(parseTimestamp(ts3.c_str(), ts3.size()) - us1, 30500001);
+
+    EXPECT_EQ(parseTimestamp("2024-01-01", 10), -1);
+    string bad = "2024-01-01 00:00:00.000000";
+    EXPECT_EQ(parseTimestamp(bad.c_str(), bad.size()), -1);
+}
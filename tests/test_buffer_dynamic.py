@@ -3,7 +3,7 @@ import pytest
 import re
 import buffer_model
 
-from dvslib.dvs_common import PollingConfig
+from dvslib.dvs_common import PollingConfig, wait_for_result
 
 @pytest.fixture
 def dynamic_buffer(dvs):
@@ -905,6 +905,59 @@ class TestBufferMgrDyn(object):
             dvs.runcmd("kill -s SIGCONT {}".format(oa_pid))
 
 
+    def test_bufferCalculatorMatchesLuaPlugins(self, dvs, testlog):
+        self.setup_db(dvs)
+
+        # On vs, buffermgrd calculates the headroom and the buffer pool sizes in-process
+        # The lua plugins should come to the same results on the same database content
+        original_ingress_lossless_pool = self.config_db.get_entry('BUFFER_POOL', 'ingress_lossless_pool')
+        try:
+            self.config_db.delete_field('BUFFER_POOL', 'ingress_lossless_pool', 'size')
+        except Exception as e:
+            pass
+
+        try:
+            dvs.port_admin_set('Ethernet0', 'up')
+            self.check_queues_after_port_startup(dvs)
+            self.config_db.update_entry('BUFFER_PG', 'Ethernet0|3-4', {'profile': 'NULL'})
+
+            expectedProfile = self.make_lossless_profile_name(self.originalSpeed, self.originalCableLen)
+            profile = self.app_db.wait_for_entry("BUFFER_PROFILE_TABLE", expectedProfile)
+            self.app_db.wait_for_field_match("BUFFER_PG_TABLE", "Ethernet0:3-4", {"profile": expectedProfile})
+
+            # Headroom
+            port = self.config_db.get_entry('PORT', 'Ethernet0')
+            lanes = len(port['lanes'].split(','))
+            mtu = port.get('mtu', '9100')
+            _, output = dvs.runcmd("redis-cli --eval /usr/share/swss/buffer_headroom_vs.lua {} , {} {} {} 0 {}".format(
+                expectedProfile, self.originalSpeed, self.originalCableLen, mtu, lanes))
+            for line in output.split():
+                field, value = line.split(':')
+                assert profile[field] == value, "{} of {} is {} while lua plugin returns {}".format(field, expectedProfile, profile[field], value)
+
+            # Buffer pools, it takes a while for buffermgrd to recalculate them
+            def pools_match():
+                _, output = dvs.runcmd("redis-cli --eval /usr/share/swss/buffer_pool_vs.lua")
+                for line in output.split('\n'):
+                    items = line.strip().split(':')
+                    if len(items) < 2 or items[0] == 'debug':
+                        continue
+                    pool = self.app_db.get_entry("BUFFER_POOL_TABLE", items[0])
+                    if pool.get('size') != items[1] or (len(items) > 2 and pool.get('xoff') != items[2]):
+                        return False, "{} in APPL_DB: {}".format(line, pool)
+                return True, None
+
+            wait_for_result(pools_match, PollingConfig(polling_interval=1, timeout=60, strict=True))
+
+        finally:
+            self.config_db.delete_entry('BUFFER_PG', 'Ethernet0|3-4')
+            self.app_db.wait_for_deleted_entry("BUFFER_PG_TABLE", "Ethernet0:3-4")
+            dvs.port_admin_set('Ethernet0', 'down')
+            self.config_db.update_entry('BUFFER_POOL', 'ingress_lossless_pool', original_ingress_lossless_pool)
+
+        self.cleanup_db(dvs)
+
+
     def test_bufferPoolCalculation(self, dvs, testlog):
         self.setup_db(dvs)
 
@@ -1,7 +1,9 @@
+import os
 import time
 import pytest
 
-from dvslib.dvs_common import wait_for_result
+from swsscommon import swsscommon
+from dvslib.dvs_common import wait_for_result, PollingConfig
 
 L3_TABLE_TYPE = "L3"
 L3_TABLE_NAME = "L3_TEST"
@@ -425,6 +427,45 @@ class TestNat(object):
         # clear interfaces
         self.clear_interfaces(dvs)
 
+    # Install time of the static NAPT iptables rules, opt-in as the larger sizes take minutes:
+    # NAT_SCALE_BENCHMARK=1 pytest test_nat.py -k IptablesInstallScale -s
+    @pytest.mark.skipif(not os.environ.get("NAT_SCALE_BENCHMARK"), reason="NAT_SCALE_BENCHMARK is not set")
+    @pytest.mark.parametrize("count", [1000, 10000, 50000])
+    def test_StaticNaptIptablesInstallScale(self, dvs, testlog, count):
+        # initialize
+        self.setup_db(dvs)
+        self.set_interfaces(dvs)
+
+        cdb = swsscommon.DBConnector(4, dvs.redis_sock, 0)
+        tbl = swsscommon.Table(cdb, "STATIC_NAPT")
+        fvs = swsscommon.FieldValuePairs([("local_ip", "18.18.18.2"), ("local_port", "180")])
+
+        # every static NAPT entry has one natmgrd rule in the nat POSTROUTING chain
+        def _check_rule_count(expected):
+            def _check():
+                _, out = dvs.runcmd(["sh", "-c", "iptables -t nat -S POSTROUTING | grep -c natmgrd:"])
+                return int(out.strip() or 0) == expected, None
+            return _check
+
+        polling_config = PollingConfig(polling_interval=0.5, timeout=1800, strict=True)
+
+        start = time.time()
+        for port in range(1, count + 1):
+            tbl.set("67.66.65.1|UDP|" + str(port), fvs)
+        wait_for_result(_check_rule_count(count), polling_config)
+        install = time.time() - start
+
+        start = time.time()
+        for port in range(1, count + 1):
+            tbl._del("67.66.65.1|UDP|" + str(port))
+        wait_for_result(_check_rule_count(0), polling_config)
+        remove = time.time() - start
+
+        print("%d static NAPT entries: iptables rules installed in %.2f s, removed in %.2f s" % (count, install, remove))
+
+        # clear interfaces
+        self.clear_interfaces(dvs)
+
 # Add Dummy always-pass test at end as workaroud
 # for issue when Flaky fail on final test it invokes module tear-down before retrying
 def test_nonflaky_dummy():